@@ -0,0 +1,797 @@
+/**
+ * @file bench_all.cpp
+ */
+
+#include <algorithm>      // for std::sort
+#include <chrono>         // for std::chrono
+#include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint32_t
+#include <cstdio>         // for std::fflush, stdout
+#include <cstdlib>        // for EXIT_FAILURE, EXIT_SUCCESS, std::_Exit
+#include <exception>      // for std::exception
+#include <filesystem>     // for std::filesystem
+#include <fstream>        // for std::ifstream, std::ofstream
+#include <functional>     // for std::function
+#include <iterator>       // for std::back_inserter
+#include <memory>         // for std::unique_ptr, std::make_unique
+#include <optional>       // for std::optional
+#include <random>         // for std::mt19937
+#include <stdexcept>      // for std::runtime_error
+#include <string>         // for std::string, std::u32string
+#include <string_view>    // for std::string_view
+#include <unordered_map>  // for std::unordered_map
+#include <utility>        // for std::move
+#include <vector>         // for std::vector
+
+#if defined(__linux__)
+#include <sys/types.h>  // for pid_t
+#include <sys/wait.h>   // for waitpid
+#include <unistd.h>     // for fork
+#endif
+
+#include <fmt/format.h>
+
+#include "core/bitmap.hpp"
+#include "core/csv.hpp"
+#include "core/hangul.hpp"
+#include "core/normalization.hpp"
+#include "core/perfect_hash.hpp"
+#include "core/pronunciation.hpp"
+#include "core/query.hpp"
+#include "core/romanization.hpp"
+#include "core/string.hpp"
+#include "modules/deck.hpp"
+#include "modules/exam.hpp"
+#include "modules/image.hpp"
+#include "modules/knowledge.hpp"
+#include "modules/profiles.hpp"
+#include "modules/progress.hpp"
+#include "modules/thompson.hpp"
+#include "modules/vocabulary.hpp"
+#if defined(_WIN32)
+#include "core/io.hpp"
+#endif
+
+namespace {
+
+/**
+ * @brief Private helper function to time a function and print the median duration of one call.
+ *
+ * @param name Name of the measurement (e.g., "rescore 100k").
+ * @param num_runs Number of timed calls (e.g., "100").
+ * @param items Number of items processed by one call, used to print the throughput (e.g., "100000").
+ * @param function Function to time.
+ */
+void measure(const std::string &name,
+             const std::size_t num_runs,
+             const std::size_t items,
+             const std::function<void()> &function)
+{
+    // Warm up caches and branch predictors once
+    function();
+
+    std::vector<double> durations_us;
+    durations_us.reserve(num_runs);
+    for (std::size_t idx = 0; idx < num_runs; ++idx) {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto end = std::chrono::steady_clock::now();
+        durations_us.emplace_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    std::sort(durations_us.begin(), durations_us.end());
+    const double median_us = durations_us[durations_us.size() / 2];
+    fmt::print("{}: {:.2f} us per call, {:.1f} M items/s (median of {} runs)\n", name, median_us, median_us > 0.0 ? static_cast<double>(items) / median_us : 0.0, num_runs);
+}
+
+/**
+ * @brief Private helper function to generate a deck in the layout of an Anki export: Korean words, transliterations, quoted memos with tabs, and tags.
+ *
+ * @param num_rows Number of entries (e.g., "400000", which gives about 50 MB).
+ *
+ * @return TSV text of the deck.
+ */
+[[nodiscard]] std::string generate_deck(const std::size_t num_rows)
+{
+    std::string text = "#separator:tab\n#html:false\n";
+    text.reserve(num_rows * 130);
+    for (std::size_t idx = 0; idx < num_rows; ++idx) {
+        fmt::format_to(std::back_inserter(text), "단어{}\tdaneo-{}\t\"Word number {}, as in \"\"단어\"\"\tsee the example\"\tnoun lesson:{} level:{} {}\n", idx, idx, idx, idx % 50, idx % 6, std::string(40, 'x'));
+    }
+    return text;
+}
+
+#if defined(__linux__)
+/**
+ * @brief Private helper function to read a line of "/proc/self/status" (e.g., "RssAnon", the memory of this process alone).
+ *
+ * @param field Name of the field (e.g., "RssFile").
+ *
+ * @return Value in bytes, or 0 if the field is missing.
+ */
+[[nodiscard]] std::size_t get_status_bytes(const std::string_view field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.size() > field.size() && line.compare(0, field.size(), field) == 0 && line[field.size()] == ':') {
+            return static_cast<std::size_t>(std::stoull(line.substr(field.size() + 1))) * 1024;
+        }
+    }
+    return 0;
+}
+#endif
+
+}  // namespace
+
+namespace bench_bitmap {
+[[nodiscard]] int filter();
+}  // namespace bench_bitmap
+
+namespace bench_deck {
+[[nodiscard]] int import();
+[[nodiscard]] int reload();
+[[nodiscard]] int share();
+}  // namespace bench_deck
+
+namespace bench_exam {
+[[nodiscard]] int generate();
+}  // namespace bench_exam
+
+namespace bench_hangul {
+[[nodiscard]] int compose();
+}  // namespace bench_hangul
+
+namespace bench_knowledge {
+[[nodiscard]] int rescore();
+[[nodiscard]] int pick();
+}  // namespace bench_knowledge
+
+namespace bench_normalization {
+[[nodiscard]] int compose();
+}  // namespace bench_normalization
+
+namespace bench_perfect_hash {
+[[nodiscard]] int find();
+}  // namespace bench_perfect_hash
+
+namespace bench_profiles {
+[[nodiscard]] int find();
+}  // namespace bench_profiles
+
+namespace bench_pronunciation {
+[[nodiscard]] int pronounce();
+}  // namespace bench_pronunciation
+
+namespace bench_query {
+[[nodiscard]] int evaluate();
+}  // namespace bench_query
+
+namespace bench_romanization {
+[[nodiscard]] int romanize();
+}  // namespace bench_romanization
+
+namespace bench_string {
+[[nodiscard]] int utf8_to_utf32();
+}  // namespace bench_string
+
+namespace bench_thompson {
+[[nodiscard]] int pick();
+}  // namespace bench_thompson
+
+/**
+ * @brief Entry-point of the benchmark application.
+ *
+ * @param argc Number of command-line arguments (e.g., "2").
+ * @param argv Array of command-line arguments (e.g., {"./bin", "-h"}).
+ *
+ * @return EXIT_SUCCESS if the benchmark application ran successfully, EXIT_FAILURE otherwise.
+ */
+int main(int argc,
+         char **argv)
+{
+#if defined(_WIN32)
+    // Setup UTF-8 input/output on Windows (does nothing on other platforms)
+    if (const auto e = core::io::setup_utf8_console(); e.has_value()) {
+        fmt::print(stderr, "Warning: {}\n", *e);
+    }
+#endif
+
+    // Define the formatted help message
+    const std::string help_message = fmt::format(
+        "Usage: {} <benchmark>\n"
+        "\n"
+        "Run benchmarks.\n"
+        "\n"
+        "Positional arguments:\n"
+        "  benchmark  name of the benchmark to run ('all' to run all benchmarks)\n",
+        argv[0]);
+
+    // If no arguments, print help message and exit
+    if (argc == 1) {
+        fmt::print("{}\n", help_message);
+        return EXIT_FAILURE;
+    }
+
+    // Otherwise, define argument to function mapping
+    const std::unordered_map<std::string, std::function<int()>> benchmarks = {
+        {"bench_bitmap::filter", bench_bitmap::filter},
+        {"bench_deck::import", bench_deck::import},
+        {"bench_deck::reload", bench_deck::reload},
+        {"bench_deck::share", bench_deck::share},
+        {"bench_exam::generate", bench_exam::generate},
+        {"bench_hangul::compose", bench_hangul::compose},
+        {"bench_knowledge::rescore", bench_knowledge::rescore},
+        {"bench_knowledge::pick", bench_knowledge::pick},
+        {"bench_normalization::compose", bench_normalization::compose},
+        {"bench_perfect_hash::find", bench_perfect_hash::find},
+        {"bench_profiles::find", bench_profiles::find},
+        {"bench_pronunciation::pronounce", bench_pronunciation::pronounce},
+        {"bench_query::evaluate", bench_query::evaluate},
+        {"bench_romanization::romanize", bench_romanization::romanize},
+        {"bench_string::utf8_to_utf32", bench_string::utf8_to_utf32},
+        {"bench_thompson::pick", bench_thompson::pick},
+    };
+
+    // Get the benchmark name from the command-line arguments
+    const std::string arg = argv[1];
+
+    // If the benchmark name is found, run the corresponding benchmark
+    if (const auto it = benchmarks.find(arg); it != benchmarks.cend()) {
+        try {
+            return it->second();
+        }
+        catch (const std::exception &e) {
+            fmt::print(stderr, "Benchmark '{}' threw an exception: {}\n", arg, e.what());
+            return EXIT_FAILURE;
+        }
+    }
+    else if (arg == "all") {
+        // Run all benchmarks sequentially
+        bool all_passed = true;
+        for (const auto &[name, bench_func] : benchmarks) {
+            fmt::print("Running benchmark: {}\n", name);
+            try {
+                if (bench_func() != EXIT_SUCCESS) {
+                    all_passed = false;
+                    fmt::print(stderr, "Benchmark '{}' failed.\n", name);
+                }
+            }
+            catch (const std::exception &e) {
+                all_passed = false;
+                fmt::print(stderr, "Benchmark '{}' threw an exception: {}\n", name, e.what());
+            }
+        }
+        return all_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else {
+        fmt::print(stderr, "Error: Invalid benchmark name: '{}'\n\n{}\n", arg, help_message);
+        return EXIT_FAILURE;
+    }
+}
+
+int bench_bitmap::filter()
+{
+    // Tags of a 100k-entry deck: a dense part of speech, a medium level, and a sparse lesson
+    constexpr std::uint32_t num_entries = 100000;
+    std::mt19937 engine(42);
+    core::bitmap::Bitmap noun;
+    core::bitmap::Bitmap verb;
+    core::bitmap::Bitmap level;
+    core::bitmap::Bitmap lesson;
+    for (std::uint32_t id = 0; id < num_entries; ++id) {
+        const auto draw = static_cast<std::uint32_t>(engine() % 100);
+        (draw < 40 ? noun : verb).add(id);
+        if (draw % 3 == 0) {
+            level.add(id);
+        }
+        if (draw < 2) {
+            lesson.add(id);
+        }
+    }
+
+    std::size_t checksum = 0;
+    core::bitmap::Bitmap enabled;
+    measure("(noun OR verb) AND level AND NOT lesson over 100k entries", 1000, num_entries, [&noun, &verb, &level, &lesson, &enabled, &checksum]() {
+        enabled = noun | verb;
+        enabled &= level;
+        enabled -= lesson;
+        checksum += enabled.get_cardinality();
+    });
+    measure("core::bitmap::Bitmap::select() of 10k random ranks", 200, 10000, [&enabled, &engine, &checksum]() {
+        const std::size_t cardinality = enabled.get_cardinality();
+        for (std::size_t idx = 0; idx < 10000; ++idx) {
+            checksum += enabled.select(engine() % cardinality).value_or(0);
+        }
+    });
+    measure("core::bitmap::Bitmap::for_each() over the filtered entries", 200, enabled.get_cardinality(), [&enabled, &checksum]() {
+        enabled.for_each([&checksum](const std::uint32_t id) { checksum += id; });
+    });
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_deck::import()
+{
+    // About 50 MB of TSV
+    constexpr std::size_t num_rows = 400000;
+    const std::string text = generate_deck(num_rows);
+
+    std::size_t checksum = 0;
+    measure(fmt::format("modules::deck::parse() of {:.1f} MB of TSV (items are rows)", static_cast<double>(text.size()) / 1e6), 10, num_rows, [&text, &checksum]() {
+        std::vector<modules::vocabulary::Entry> entries;
+        const auto summary = modules::deck::parse(text, {}, entries);
+        checksum += summary.num_rows + entries.back().memo.size();
+    });
+    measure(fmt::format("core::csv::Table() of {:.1f} MB of TSV (items are bytes)", static_cast<double>(text.size()) / 1e6), 10, text.size(), [&text, &checksum]() {
+        const core::csv::Table table(text, '\t');
+        checksum += table.get_num_rows();
+    });
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_deck::reload()
+{
+    // A 400k-entry deck, of which a teacher moves 10 entries to another lesson
+    constexpr std::size_t num_rows = 400000;
+    std::vector<modules::vocabulary::Entry> previous;
+    previous.reserve(num_rows);
+    for (std::size_t idx = 0; idx < num_rows; ++idx) {
+        previous.push_back({fmt::format("단어{}", idx), fmt::format("daneo-{}", idx), "", modules::vocabulary::Category::BasicVowel, {"noun", fmt::format("lesson:{}", idx % 50)}});
+    }
+    std::vector<modules::vocabulary::Entry> current = previous;
+    for (std::size_t idx = 0; idx < 10; ++idx) {
+        current[idx * num_rows / 10].tags.back() = "lesson:1";
+    }
+
+    const modules::image::Image previous_image(previous);
+    const modules::image::Image current_image(current);
+
+    std::size_t checksum = 0;
+    measure("modules::deck::diff() of 400k entries (background)", 10, num_rows, [&previous_image, &current_image, &checksum]() {
+        checksum += modules::deck::diff(previous_image, current_image).entries.size();
+    });
+
+    // Applying the changes costs the same for any deck size; the edits alternate, so each one changes the entries
+    modules::vocabulary::Vocabulary vocabulary(previous_image);
+    const modules::vocabulary::Update edited = modules::deck::diff(previous_image, current_image);
+    const modules::vocabulary::Update restored = modules::deck::diff(current_image, previous_image);
+    bool flip = false;
+    const auto apply = [&vocabulary, &edited, &restored, &flip, &checksum]() {
+        flip = !flip;
+        checksum += vocabulary.update(flip ? edited : restored) ? 1u : 0u;
+    };
+    measure("modules::vocabulary::Vocabulary::update() of 10 entries in 400k (items are entries)", 10000, 10, apply);
+    vocabulary.set_query("noun & lesson<=5");
+    measure("modules::vocabulary::Vocabulary::update() of 10 entries in 400k, with a query on lessons (items are entries)", 1000, 10, apply);
+    fmt::print("Checksum: {}\n", checksum + vocabulary.get_num_enabled());
+    return EXIT_SUCCESS;
+}
+
+int bench_deck::share()
+{
+    // The deck of "import()", written to a file whose image every process maps
+    constexpr std::size_t num_rows = 400000;
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "aegyo_bench_share.tsv";
+    const std::filesystem::path image_path = std::filesystem::temp_directory_path() / "aegyo_bench_share.img";
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << generate_deck(num_rows);
+    }
+    std::filesystem::remove(image_path);
+
+#if defined(__linux__)
+    // Memory of a process that loads the deck and reads every entry once, measured in a child of a process that has not used the heap yet, so freed memory is never reused
+    // Anonymous memory belongs to one process, whereas the file-backed pages of a mapping are shared by every process that maps the file
+    const auto measure_memory = [&path, &image_path](const std::string &name,
+                                                     const bool is_mapped) {
+        std::fflush(stdout);
+        const pid_t pid = fork();
+        if (pid < 0) {
+            throw std::runtime_error("Failed to fork");
+        }
+        if (pid == 0) {
+            const std::size_t anon_before = get_status_bytes("RssAnon");
+            const std::size_t file_before = get_status_bytes("RssFile");
+            std::optional<modules::vocabulary::Vocabulary> vocabulary;
+            if (is_mapped) {
+                vocabulary.emplace(modules::deck::load(path, {}, image_path));
+            }
+            else {
+                std::vector<modules::vocabulary::Entry> entries;
+                static_cast<void>(modules::deck::import(path, {}, entries));
+                vocabulary.emplace(entries);
+            }
+            std::size_t size = 0;
+            for (std::size_t id = 0; id < vocabulary->get_num_entries(); ++id) {
+                size += vocabulary->get_entry(id).memo.size();
+            }
+            const std::size_t anon_after = get_status_bytes("RssAnon");
+            const std::size_t file_after = get_status_bytes("RssFile");
+            fmt::print("{}: {:.1f} MB private, {:.1f} MB shared, for {:.1f} MB of memos\n",
+                       name,
+                       static_cast<double>(anon_after > anon_before ? anon_after - anon_before : 0) / 1e6,
+                       static_cast<double>(file_after > file_before ? file_after - file_before : 0) / 1e6,
+                       static_cast<double>(size) / 1e6);
+            std::fflush(stdout);
+            std::_Exit(EXIT_SUCCESS);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+    };
+    measure_memory("Memory of a vocabulary of 400k entries, imported into each process", false);
+    measure_memory("Memory of the first vocabulary of 400k entries, which compiles the image", true);
+    measure_memory("Memory of every other vocabulary of 400k entries, which maps the image", true);
+#endif
+
+    // Startup: the first process compiles the image, and the others only map it
+    std::size_t checksum = 0;
+    std::filesystem::remove(image_path);
+    const auto start = std::chrono::steady_clock::now();
+    const modules::image::Image image = modules::deck::load(path, {}, image_path);
+    fmt::print("modules::deck::load() of 400k entries, compiling a {:.1f} MB image: {:.1f} ms\n", static_cast<double>(image.get_size()) / 1e6, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    measure("modules::deck::load() of 400k entries, mapping the image (items are entries)", 10, num_rows, [&path, &image_path, &checksum]() {
+        checksum += modules::deck::load(path, {}, image_path).get_num_entries();
+    });
+    measure("modules::deck::import() of 400k entries, as without an image (items are entries)", 5, num_rows, [&path, &checksum]() {
+        std::vector<modules::vocabulary::Entry> entries;
+        checksum += modules::deck::import(path, {}, entries).num_rows;
+    });
+    std::filesystem::remove(path);
+    std::filesystem::remove(image_path);
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_exam::generate()
+{
+    constexpr std::size_t num_entries = 1000000;
+    std::vector<std::size_t> categories(num_entries);
+    for (std::size_t idx = 0; idx < num_entries; ++idx) {
+        categories[idx] = idx % 7 == 0 ? 3 : idx % 3;
+    }
+    modules::exam::Exam exam(categories);
+
+    std::size_t checksum = 0;
+    std::uint32_t seed = 0;
+    measure("modules::exam::Exam::generate() of 1000 questions over 1M entries, proportional", 200, 1000, [&exam, &checksum, &seed]() {
+        checksum += exam.generate(1000, ++seed, modules::exam::Coverage::Proportional).front();
+    });
+    measure("modules::exam::Exam::generate() of 1000 questions over 1M entries, equal", 200, 1000, [&exam, &checksum, &seed]() {
+        checksum += exam.generate(1000, ++seed, modules::exam::Coverage::Equal).front();
+    });
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_hangul::compose()
+{
+    // About 1M jamo of 2-beolsik keystrokes, with compound vowels, double finals and finals that move to the next syllable
+    const std::string keys = "dkssudgktpdy ghksdud dlfrdj ekfrdms rkqtdl gksrnrdj ";
+    std::u32string input;
+    while (input.size() < 1000000) {
+        for (const char key : keys) {
+            const char32_t jamo = core::hangul::get_dubeolsik_jamo(key);
+            input.push_back(jamo != 0 ? jamo : static_cast<char32_t>(key));
+        }
+    }
+
+    std::u32string out;
+    out.reserve(input.size());
+    std::size_t checksum = 0;
+    measure("core::hangul::compose() of 1M jamo", 100, input.size(), [&input, &out, &checksum]() {
+        out.clear();
+        core::hangul::compose(input, out);
+        checksum += out.size();
+    });
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_knowledge::rescore()
+{
+    constexpr std::size_t num_entries = 100000;
+    modules::knowledge::Knowledge knowledge(num_entries);
+    for (std::size_t idx = 0; idx < num_entries; ++idx) {
+        knowledge.update(idx, idx % 3 != 0);
+    }
+
+    measure("modules::knowledge::Knowledge::rescore() over 100k entries", 200, num_entries, [&knowledge]() {
+        knowledge.rescore();
+    });
+    measure("modules::knowledge::Knowledge::update() 100k times", 20, num_entries, [&knowledge]() {
+        for (std::size_t idx = 0; idx < num_entries; ++idx) {
+            knowledge.update(idx, idx % 2 == 0);
+        }
+    });
+    return EXIT_SUCCESS;
+}
+
+int bench_knowledge::pick()
+{
+    // A 100k-entry deck weighted by the knowledge model, where each answer changes one weight
+    constexpr std::size_t num_entries = 100000;
+    std::vector<modules::vocabulary::Entry> entries;
+    entries.reserve(num_entries);
+    for (std::size_t idx = 0; idx < num_entries; ++idx) {
+        entries.push_back({fmt::format("단어{}", idx), fmt::format("daneo-{}", idx), "", modules::vocabulary::Category::BasicVowel, {}});
+    }
+    modules::vocabulary::Vocabulary vocabulary(entries);
+    modules::knowledge::Knowledge knowledge(num_entries);
+    for (std::size_t idx = 0; idx < num_entries; ++idx) {
+        knowledge.update(idx, idx % 3 != 0);
+    }
+    vocabulary.set_weights(knowledge.get_scores());
+
+    std::size_t checksum = 0;
+    measure("modules::vocabulary::Vocabulary::get_weighted_enabled_entry() over 100k entries", 1000, 1, [&vocabulary, &checksum]() {
+        checksum += vocabulary.get_weighted_enabled_entry().value().id;
+    });
+    measure("modules::vocabulary::Vocabulary::set_weight() after an answer over 100k entries", 1000, 1, [&vocabulary, &knowledge, &checksum]() {
+        const std::size_t id = checksum++ % num_entries;
+        knowledge.update(id, true);
+        vocabulary.set_weight(id, knowledge.get_scores()[id]);
+    });
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_normalization::compose()
+{
+    // About 1 MB each of text already in canonical form, and of the same text as conjoining jamo
+    std::string text;
+    while (text.size() < 1000000) {
+        text += "한국어 문장을 빠르게 변환합니다 (Hangul, ㅏ = a). ";
+    }
+    const std::vector<std::pair<std::string, std::string>> texts = {
+        {"canonical text", text},
+        {"conjoining jamo", core::normalization::decompose(text)},
+    };
+    std::string out;
+    std::size_t checksum = 0;
+    for (const auto &[name, sample] : texts) {
+        measure(fmt::format("core::normalization::compose() of {:.1f} MB of {} (items are bytes)", static_cast<double>(sample.size()) / 1e6, name), 200, sample.size(), [&sample = sample, &out, &checksum]() {
+            out.clear();
+            core::normalization::compose(sample, out);
+            checksum += out.size();
+        });
+    }
+    measure("core::normalization::decompose() of 1 MB of canonical text (items are bytes)", 200, text.size(), [&text, &out, &checksum]() {
+        out.clear();
+        core::normalization::decompose(text, out);
+        checksum += out.size();
+    });
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_perfect_hash::find()
+{
+    // 100k short keys, looked up in a scattered order, against the same lookups in a hash map
+    constexpr std::size_t num_keys = 100000;
+    std::vector<std::string> strings;
+    strings.reserve(num_keys);
+    for (std::size_t idx = 0; idx < num_keys; ++idx) {
+        strings.emplace_back(fmt::format("key-{}", idx));
+    }
+    const std::vector<std::string_view> keys(strings.cbegin(), strings.cend());
+    std::unordered_map<std::string_view, std::uint32_t> map;
+    for (std::size_t idx = 0; idx < num_keys; ++idx) {
+        map.emplace(keys[idx], static_cast<std::uint32_t>(idx));
+    }
+
+    std::size_t checksum = 0;
+    std::unique_ptr<core::perfect_hash::PerfectHash> hash;
+    measure("core::perfect_hash::PerfectHash() of 100k keys", 10, num_keys, [&keys, &hash]() {
+        hash = std::make_unique<core::perfect_hash::PerfectHash>(keys);
+    });
+    measure("core::perfect_hash::PerfectHash::find() 100k times", 200, num_keys, [&keys, &hash, &checksum]() {
+        for (std::size_t idx = 0; idx < num_keys; ++idx) {
+            checksum += hash->find(keys[(idx * 7919) % num_keys]).value_or(0);
+        }
+    });
+    measure("std::unordered_map::find() 100k times, for comparison", 200, num_keys, [&keys, &map, &checksum]() {
+        for (std::size_t idx = 0; idx < num_keys; ++idx) {
+            if (const auto it = map.find(keys[(idx * 7919) % num_keys]); it != map.cend()) {
+                checksum += it->second;
+            }
+        }
+    });
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_profiles::find()
+{
+    // A kiosk with thousands of learners, each with a snapshot of the 40 built-in entries
+    constexpr std::size_t num_profiles = 5000;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "aegyo_bench_profiles";
+    std::filesystem::remove_all(directory);
+    modules::profiles::Profiles profiles(directory);
+    std::vector<std::string> names;
+    names.reserve(num_profiles);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < num_profiles; ++idx) {
+        names.emplace_back(fmt::format("Learner {}", (idx * 7919) % num_profiles));
+        static_cast<void>(profiles.add(names.back()));
+    }
+    fmt::print("modules::profiles::Profiles::add() of {} profiles: {:.3f} s\n", num_profiles, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    const std::vector<std::size_t> entry_categories(40, 0);
+    std::vector<std::string> entry_keys;
+    for (std::size_t idx = 0; idx < entry_categories.size(); ++idx) {
+        entry_keys.emplace_back(std::to_string(idx));
+    }
+    constexpr std::size_t num_switches = 200;
+    for (std::size_t idx = 0; idx < num_switches; ++idx) {
+        modules::progress::Progress progress(*profiles.find(names[idx]), entry_categories, entry_keys);
+        progress.record({idx, static_cast<std::uint32_t>(idx % 40), static_cast<std::uint32_t>(idx % 40), 500, true});
+    }
+
+    std::size_t checksum = 0;
+    std::size_t next = 0;
+    measure(fmt::format("modules::profiles::Profiles::find() among {} profiles", num_profiles), 10000, 1, [&profiles, &names, &checksum, &next]() {
+        checksum += profiles.find(names[next++ % num_profiles])->native().size();
+    });
+
+    // What the app does on the UI thread: find the profile, map its progress, and swap it in; the previous progress is closed later
+    std::vector<std::unique_ptr<modules::progress::Progress>> retired;
+    retired.reserve(num_switches + 1);
+    auto progress = std::make_unique<modules::progress::Progress>(directory, entry_categories, entry_keys);
+    next = 0;
+    measure(fmt::format("Switch between {} profiles", num_profiles), num_switches - 1, 1, [&]() {
+        progress->compact();
+        auto loaded = std::make_unique<modules::progress::Progress>(*profiles.find(names[next++]), entry_categories, entry_keys);
+        retired.emplace_back(std::move(progress));
+        progress = std::move(loaded);
+        checksum += progress->get_statistics().get_total().get_attempts();
+    });
+    retired.clear();
+    progress.reset();
+    fmt::print("Checksum: {}\n", checksum);
+    std::filesystem::remove_all(directory);
+    return EXIT_SUCCESS;
+}
+
+int bench_pronunciation::pronounce()
+{
+    // About 1 MB of short words between spaces, and the same words one call each, as when a question is shown
+    const std::vector<std::string> words = {"한국말", "학교", "없어요", "신라", "같이", "좋고", "종로", "안녕하세요"};
+    std::string text;
+    while (text.size() < 1000000) {
+        for (const std::string &word : words) {
+            text += word;
+            text += ' ';
+        }
+    }
+    std::string out;
+    std::size_t checksum = 0;
+    measure("core::pronunciation::pronounce() of 1 MB of words (items are bytes)", 200, text.size(), [&text, &out, &checksum]() {
+        out.clear();
+        core::pronunciation::pronounce(text, out);
+        checksum += out.size();
+    });
+    measure("core::pronunciation::pronounce() of 1000 single words", 200, 1000, [&words, &checksum]() {
+        for (std::size_t idx = 0; idx < 1000; ++idx) {
+            checksum += core::pronunciation::pronounce(words[idx % words.size()]).size();
+        }
+    });
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_query::evaluate()
+{
+    // Tags of a 100k-entry deck: 20 lessons, a dense part of speech, and a sparse set of entries due for review
+    constexpr std::uint32_t num_entries = 100000;
+    std::mt19937 engine(42);
+    std::vector<core::bitmap::Bitmap> lessons(20);
+    core::bitmap::Bitmap vowel;
+    core::bitmap::Bitmap due;
+    core::bitmap::Bitmap universe;
+    for (std::uint32_t id = 0; id < num_entries; ++id) {
+        universe.add(id);
+        lessons[id * lessons.size() / num_entries].add(id);
+        if (engine() % 3 == 0) {
+            vowel.add(id);
+        }
+        if (engine() % 50 == 0) {
+            due.add(id);
+        }
+    }
+
+    std::size_t checksum = 0;
+    const std::string expression = "(lesson<=5 & vowel) | review-due";
+    measure("core::query::Query() of '(lesson<=5 & vowel) | review-due'", 1000, 1, [&expression, &checksum]() {
+        checksum += core::query::Query(expression).get_terms().size();
+    });
+
+    // The numbered term is resolved once, as "modules::vocabulary::Vocabulary" does, then only evaluated
+    const core::query::Query query(expression);
+    core::bitmap::Bitmap early;
+    for (std::size_t lesson = 0; lesson < lessons.size(); ++lesson) {
+        if (core::query::matches(query.get_terms()[0], fmt::format("lesson:{}", lesson + 1))) {
+            early |= lessons[lesson];
+        }
+    }
+    const std::vector<const core::bitmap::Bitmap *> inputs = {&early, &vowel, &due};
+    measure("core::query::Query::evaluate() over 100k entries", 1000, num_entries, [&query, &inputs, &universe, &checksum]() {
+        checksum += query.evaluate(inputs, universe).get_cardinality();
+    });
+    const core::query::Query negated("!(lesson<=5 & vowel) & !review-due");
+    measure("core::query::Query::evaluate() over 100k entries, with negations", 1000, num_entries, [&negated, &inputs, &universe, &checksum]() {
+        checksum += negated.evaluate(inputs, universe).get_cardinality();
+    });
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_romanization::romanize()
+{
+    // About 1 MB each of Hangul words between spaces, and of Hangul mixed with ASCII and punctuation
+    const std::vector<std::pair<std::string, std::string>> texts = {
+        {"Hangul", "안녕하세요 한국어를 읽어 보세요 국물 같이 신라 종로 "},
+        {"mixed", "한국어 (Korean), 빠르게 변환합니다! "},
+    };
+    std::string out;
+    std::size_t checksum = 0;
+    for (const auto &[name, sample] : texts) {
+        std::string text;
+        while (text.size() < 1000000) {
+            text += sample;
+        }
+        measure(fmt::format("core::romanization::romanize() of 1 MB of {} (items are bytes)", name), 200, text.size(), [&text, &out, &checksum]() {
+            out.clear();
+            core::romanization::romanize(text, out);
+            checksum += out.size();
+        });
+    }
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_thompson::pick()
+{
+    constexpr std::size_t num_entries = 100000;
+    std::vector<std::size_t> categories(num_entries);
+    for (std::size_t idx = 0; idx < num_entries; ++idx) {
+        categories[idx] = idx % 4;
+    }
+    modules::thompson::Thompson thompson(categories);
+    for (std::size_t idx = 0; idx < num_entries; ++idx) {
+        thompson.record(idx, idx % 3 != 0);
+    }
+
+    std::size_t checksum = 0;
+    measure("modules::thompson::Thompson::pick() over 100k entries", 1000, 1, [&thompson, &checksum]() {
+        checksum += thompson.pick().value_or(0);
+    });
+    measure("modules::thompson::Thompson::record() over 100k entries", 1000, 1, [&thompson, &checksum]() {
+        thompson.record(checksum % num_entries, true);
+    });
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
+
+int bench_string::utf8_to_utf32()
+{
+    // About 1 MB each of Hangul, of ASCII, and of short Korean words between spaces and punctuation
+    const std::vector<std::pair<std::string, std::string>> texts = {
+        {"Hangul", "한국어문장을빠르게변환합니다"},
+        {"ASCII", "The quick brown fox jumps over the lazy dog. "},
+        {"mixed", "한국어 문장을, 빠르게 변환합니다! (ㅏ = a) "},
+    };
+    std::vector<std::uint32_t> out;
+    std::size_t checksum = 0;
+    for (const auto &[name, sample] : texts) {
+        std::string text;
+        while (text.size() < 1000000) {
+            text += sample;
+        }
+        out.resize(text.size());
+        measure(fmt::format("core::string::utf8_to_utf32() of 1 MB of {} (items are bytes)", name), 200, text.size(), [&text, &out, &checksum]() {
+            checksum += core::string::utf8_to_utf32(text, out.data());
+        });
+    }
+    fmt::print("Checksum: {}\n", checksum);
+    return EXIT_SUCCESS;
+}
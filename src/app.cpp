@@ -2,11 +2,22 @@
  * @file app.cpp
  */
 
+#include <algorithm>      // for std::clamp, std::min
 #include <array>          // for std::array
+#include <chrono>         // for std::chrono
 #include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint32_t, std::uint64_t
+#include <exception>      // for std::exception
+#include <filesystem>     // for std::filesystem
+#include <future>         // for std::async, std::future, std::future_status
 #include <limits>         // for std::numeric_limits
+#include <memory>         // for std::unique_ptr, std::make_unique
+#include <optional>       // for std::optional, std::nullopt
+#include <random>         // for std::random_device
 #include <string>         // for std::string
+#include <string_view>    // for std::string_view
 #include <unordered_map>  // for std::unordered_map
+#include <utility>        // for std::move, std::pair
 #include <vector>         // for std::vector
 
 #include <SFML/Graphics.hpp>
@@ -16,8 +27,19 @@
 #include "app.hpp"
 #include "core/assets.hpp"
 #include "core/colors.hpp"
+#include "core/paths.hpp"
+#include "core/pronunciation.hpp"
 #include "core/rng.hpp"
 #include "core/string.hpp"
+#include "modules/deck.hpp"
+#include "modules/exam.hpp"
+#include "modules/image.hpp"
+#include "modules/knowledge.hpp"
+#include "modules/profiles.hpp"
+#include "modules/progress.hpp"
+#include "modules/statistics.hpp"
+#include "modules/thompson.hpp"
+#include "modules/typing.hpp"
 #include "modules/vocabulary.hpp"
 #include "version.hpp"
 
@@ -41,6 +63,201 @@ namespace {
     return settings;
 }
 
+/**
+ * @brief Private enum that represents how the next question is picked.
+ */
+enum class SelectionPolicy {
+    Uniform,
+    ShuffleBag,
+    Knowledge,
+    Thompson
+};
+
+/**
+ * @brief Private helper function to get the display name of a selection policy.
+ *
+ * @param policy Selection policy.
+ *
+ * @return Name of the policy (e.g., "Thompson sampling").
+ */
+[[nodiscard]] const char *get_policy_name(const SelectionPolicy policy)
+{
+    switch (policy) {
+    case SelectionPolicy::Uniform:
+        return "uniform";
+    case SelectionPolicy::ShuffleBag:
+        return "shuffle bag";
+    case SelectionPolicy::Knowledge:
+        return "knowledge tracing";
+    case SelectionPolicy::Thompson:
+        return "Thompson sampling";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Private maximum number of options per question, one per number key.
+ */
+constexpr std::size_t max_options = 9;
+
+/**
+ * @brief Private struct that represents where the answer buttons go for a given number of options.
+ */
+struct ButtonLayout final {
+    std::array<sf::Vector2f, max_options> positions;
+    float radius;
+    unsigned int character_size;
+};
+
+/**
+ * @brief Private helper function to lay out the answer buttons in rows below the question.
+ *
+ * @param num_options Number of options, between 1 and "max_options" (e.g., "4").
+ *
+ * @return Layout of the buttons; 4 options give the classic 2x2 grid.
+ */
+[[nodiscard]] ButtonLayout get_button_layout(const std::size_t num_options)
+{
+    // Split the area below the memo text into equal cells, centering a shorter last row
+    constexpr float left = 100.f;
+    constexpr float top = 275.f;
+    constexpr float width = 600.f;
+    constexpr float height = 300.f;
+    const std::size_t num_rows = num_options <= 3 ? 1 : (num_options <= 8 ? 2 : 3);
+    const std::size_t num_columns = (num_options + num_rows - 1) / num_rows;
+    const float cell_width = width / static_cast<float>(num_columns);
+    const float cell_height = height / static_cast<float>(num_rows);
+
+    ButtonLayout layout{};
+    layout.radius = std::min(60.f, 0.42f * std::min(cell_width, cell_height));
+    layout.character_size = static_cast<unsigned int>(28.f * layout.radius / 60.f + 0.5f);
+    for (std::size_t idx = 0; idx < num_options; ++idx) {
+        const std::size_t row = idx / num_columns;
+        const std::size_t row_size = std::min(num_columns, num_options - row * num_columns);
+        const float row_left = left + (width - static_cast<float>(row_size) * cell_width) / 2.f;
+        layout.positions[idx] = {row_left + (static_cast<float>(idx % num_columns) + 0.5f) * cell_width,
+                                 top + (static_cast<float>(row) + 0.5f) * cell_height};
+    }
+    return layout;
+}
+
+/**
+ * @brief Private helper function to get the number of options for a question from how well its entry is known.
+ *
+ * Entries at the initial mastery estimate start with 2 options, and well-known entries get more, so guessing pays off less.
+ *
+ * @param mastery Estimated probability that the entry is known, between 0.0 and 1.0 (e.g., "0.2").
+ * @param initial Mastery estimate of entries that were never answered (e.g., "0.2").
+ * @param num_enabled Number of enabled entries (e.g., "40").
+ *
+ * @return Number of options between 2 and "max_options", at most "num_enabled" (e.g., "2").
+ */
+[[nodiscard]] std::size_t get_num_options(const float mastery,
+                                          const float initial,
+                                          const std::size_t num_enabled)
+{
+    // Scale the mastery gained since the initial estimate, so 2 options become 9 at seven eighths of the way to certainty
+    const float gained = initial < 1.f ? std::max(mastery - initial, 0.f) / (1.f - initial) : 1.f;
+    const auto num_options = static_cast<std::size_t>(std::clamp(2.f + gained * 8.f, 2.f, static_cast<float>(max_options)));
+    return std::min(num_options, num_enabled);
+}
+
+/**
+ * @brief Private helper function to check whether a point is inside a circle.
+ *
+ * @param circle Circle with its origin at its center.
+ * @param point Point in window coordinates (e.g., the mouse position).
+ *
+ * @return True if the point is inside the circle, false otherwise.
+ */
+[[nodiscard]] bool is_inside(const sf::CircleShape &circle,
+                             const sf::Vector2i &point)
+{
+    const sf::Vector2f offset = sf::Vector2f(static_cast<float>(point.x), static_cast<float>(point.y)) - circle.getPosition();
+    return offset.x * offset.x + offset.y * offset.y <= circle.getRadius() * circle.getRadius();
+}
+
+/**
+ * @brief Private helper function to get the color of typed text.
+ *
+ * @param feedback How the typed text relates to the expected answer.
+ *
+ * @return Color of the text; prefixes of the expected answer keep the default text color.
+ */
+[[nodiscard]] sf::Color get_feedback_color(const modules::typing::Feedback feedback)
+{
+    switch (feedback) {
+    case modules::typing::Feedback::Complete:
+        return core::colors::enabled_color;
+    case modules::typing::Feedback::Wrong:
+        return core::colors::selected_wrong_answer;
+    case modules::typing::Feedback::Invalid:
+        return core::colors::disabled_color;
+    case modules::typing::Feedback::Empty:
+    case modules::typing::Feedback::OnTrack:
+    default:
+        return core::colors::text;
+    }
+}
+
+/**
+ * @brief Private helper function to get the category index of each entry in a vocabulary.
+ *
+ * @param vocabulary Vocabulary to read the entries from.
+ *
+ * @return Vector of category indices, indexed by entry ID.
+ */
+[[nodiscard]] std::vector<std::size_t> get_entry_categories(const modules::vocabulary::Vocabulary &vocabulary)
+{
+    std::vector<std::size_t> categories;
+    categories.reserve(vocabulary.get_num_entries());
+    for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+        categories.emplace_back(static_cast<std::size_t>(vocabulary.get_category(id)));
+    }
+    return categories;
+}
+
+/**
+ * @brief Private helper function to get the key of each entry in a vocabulary, which its progress is stored under.
+ *
+ * @param vocabulary Vocabulary to read the entries from.
+ *
+ * @return Vector of Korean texts, indexed by entry ID.
+ */
+[[nodiscard]] std::vector<std::string> get_entry_keys(const modules::vocabulary::Vocabulary &vocabulary)
+{
+    std::vector<std::string> keys;
+    keys.reserve(vocabulary.get_num_entries());
+    for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+        keys.emplace_back(vocabulary.get_hangul(id));
+    }
+    return keys;
+}
+
+/**
+ * @brief Private helper function to load the vocabulary from the deck file in the data directory, or the built-in deck if there is none.
+ *
+ * The deck is loaded through an image next to it, so instances of the app that run side by side (e.g., on a multi-seat machine) share one copy of the entries.
+ *
+ * @param path Path to the deck file (e.g., "~/.local/share/aegyo/deck.tsv").
+ * @param image_path Path to the image of the deck file (e.g., "~/.local/share/aegyo/deck.img").
+ *
+ * @return Vocabulary object.
+ *
+ * @throws std::runtime_error if the deck file exists but cannot be imported.
+ */
+[[nodiscard]] modules::vocabulary::Vocabulary load_vocabulary(const std::filesystem::path &path,
+                                                              const std::filesystem::path &image_path)
+{
+    if (!std::filesystem::exists(path)) {
+        return modules::vocabulary::Vocabulary();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    modules::image::Image image = modules::deck::load(path, {}, image_path);
+    fmt::print("Loaded {} entries from '{}' in {:.3f} s ({})\n", image.get_num_entries(), path.string(), std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), image.is_mapped() ? "shared" : "in memory");
+    return modules::vocabulary::Vocabulary(std::move(image));
+}
+
 /**
  * @brief Private helper class that handles the user interface.
  *
@@ -61,7 +278,20 @@ class UI final {
                   // Overwrite the default context settings with improved settings
                   get_improved_context_settings()),
           font_(core::assets::load_font()),
-          vocabulary_(),
+          deck_path_(core::paths::get_data_directory() / "deck.tsv"),
+          image_path_(core::paths::get_data_directory() / "deck.img"),
+          vocabulary_(load_vocabulary(this->deck_path_, this->image_path_)),
+          progress_(std::make_unique<modules::progress::Progress>(core::paths::get_data_directory(), get_entry_categories(this->vocabulary_), get_entry_keys(this->vocabulary_))),
+          retired_progress_(),
+          profiles_(core::paths::get_data_directory() / "profiles"),
+          profile_name_(),
+          knowledge_(this->vocabulary_.get_num_entries()),
+          thompson_(get_entry_categories(this->vocabulary_)),
+          exam_(get_entry_categories(this->vocabulary_)),
+          matcher_(this->vocabulary_),
+          reloader_(),
+          selection_policy_(SelectionPolicy::Knowledge),
+          is_typing_(false),
           toggle_labels_({"Vow", "Con", "DCon", "CompV"}),
           toggle_categories_({modules::vocabulary::Category::BasicVowel,
                               modules::vocabulary::Category::BasicConsonant,
@@ -72,7 +302,9 @@ class UI final {
                           {modules::vocabulary::Category::DoubleConsonant, true},
                           {modules::vocabulary::Category::CompoundVowel, true}}),
           button_shapes_(),
-          answer_buttons_()
+          answer_buttons_(),
+          button_layouts_(),
+          num_options_(0)
     {
         // Enable V-Sync to limit the frame rate to the refresh rate of the monitor
         this->window_.setVerticalSyncEnabled(true);
@@ -102,24 +334,19 @@ class UI final {
         this->memo_text_.setFillColor(core::colors::text);
         this->memo_text_.setPosition(400.f, 270.f);  // Position below the question circle
 
-        // Initialize answer buttons
-        constexpr float button_radius = 60.f;
-        for (std::size_t idx = 0; idx < 4; ++idx) {
-            this->button_shapes_[idx].setRadius(button_radius);
+        // Initialize typed answer text
+        this->answer_text_.setFont(this->font_);
+        this->answer_text_.setCharacterSize(48);
+        this->answer_text_.setPosition(400.f, 400.f);  // Position where the answer buttons would be
+
+        // Initialize answer buttons, and lay them out once for every number of options
+        for (std::size_t idx = 0; idx < max_options; ++idx) {
             this->button_shapes_[idx].setFillColor(core::colors::default_button);
-            this->button_shapes_[idx].setOrigin(button_radius, button_radius);
             this->answer_buttons_[idx].setFont(this->font_);
-            this->answer_buttons_[idx].setCharacterSize(28);
             this->answer_buttons_[idx].setFillColor(core::colors::text);
         }
-        this->button_shapes_[0].setPosition(250.f, 350.f);
-        this->button_shapes_[1].setPosition(550.f, 350.f);
-        this->button_shapes_[2].setPosition(250.f, 500.f);
-        this->button_shapes_[3].setPosition(550.f, 500.f);
-
-        // Set positions of answer button texts
-        for (std::size_t idx = 0; idx < 4; ++idx) {
-            this->answer_buttons_[idx].setPosition(this->button_shapes_[idx].getPosition());
+        for (std::size_t num_options = 1; num_options <= max_options; ++num_options) {
+            this->button_layouts_[num_options] = get_button_layout(num_options);
         }
 
         // Initialize percentage text
@@ -128,6 +355,20 @@ class UI final {
         this->percentage_text_.setFillColor(core::colors::text);
         this->percentage_text_.setPosition(10.f, 10.f);  // Top-left corner
 
+        // Initialize profile text
+        this->profile_text_.setFont(this->font_);
+        this->profile_text_.setCharacterSize(14);
+        this->profile_text_.setFillColor(core::colors::text);
+        this->profile_text_.setPosition(10.f, 570.f);  // Bottom-left corner
+
+        // Restore the enabled categories and the settings from the previous session
+        this->restore_progress();
+
+        // Follow the edits of a deck file, so a teacher can change it while the app runs
+        if (std::filesystem::exists(this->deck_path_)) {
+            this->reloader_.emplace(this->deck_path_, modules::deck::Options{}, this->image_path_, this->vocabulary_.get_image());
+        }
+
         // Initialize toggle buttons
         const float total_toggle_width = static_cast<float>(this->toggle_labels_.size()) * 60.f;
         const float start_x = static_cast<float>(this->window_.getSize().x) - total_toggle_width - 10.f;  // 10.f padding from the right
@@ -178,22 +419,87 @@ class UI final {
 
         modules::vocabulary::Entry correct_entry;
         std::size_t correct_index = 0;
+        std::array<std::size_t, max_options> option_ids{};
         bool is_hangul = true;
+        std::chrono::steady_clock::time_point question_shown_at;
+
+        // Exam in progress, if any: entry IDs in order, the position of the next question, and the answers so far
+        std::vector<std::size_t> exam_questions;
+        std::size_t exam_position = 0;
+        modules::statistics::Counters exam_score{0, 0, 0};
 
-        std::size_t total_questions = 0;
-        std::size_t correct_answers = 0;
+        // The score counts every answer since this baseline; it starts empty, so the saved progress is restored
+        modules::statistics::Counters score_baseline{0, 0, 0};
+
+        // Name of the learner being typed, if any
+        bool is_naming = false;
+        std::string typed_name;
 
         // Initial setup
         const auto update_percentage_text = [&]() {
-            const float percentage = total_questions > 0 ? (static_cast<float>(correct_answers) / total_questions) * 100.f : 0.f;
-            const auto percentage_str = fmt::format("게임 점수: {:.1f}%", percentage);
+            const modules::statistics::Counters total = this->progress_->get_statistics().get_total();
+            const modules::statistics::Counters score{total.correct - score_baseline.correct, total.incorrect - score_baseline.incorrect, 0};
+            const auto percentage_str = fmt::format("게임 점수: {:.1f}%", score.get_percentage());
             this->percentage_text_.setString(core::string::to_sfml_string(percentage_str));
         };
 
         update_percentage_text();
 
+        const auto update_profile_text = [&]() {
+            if (is_naming) {
+                this->profile_text_.setString(fmt::format("Profile: {}_", typed_name));
+            }
+            else {
+                this->profile_text_.setString(this->profile_name_.empty() ? std::string() : fmt::format("Profile: {}", this->profile_name_));
+            }
+        };
+
+        const auto update_answer_text = [&]() {
+            // Show a cursor while nothing is typed, so the empty answer is visible
+            const std::string_view text = this->matcher_.get_text();
+            this->answer_text_.setString(text.empty() ? std::string("_") : std::string(text));
+            this->answer_text_.setFillColor(get_feedback_color(this->matcher_.get_feedback()));
+            const sf::FloatRect answer_bounds = this->answer_text_.getLocalBounds();
+            this->answer_text_.setOrigin(answer_bounds.left + answer_bounds.width / 2.0f,
+                                         answer_bounds.top + answer_bounds.height / 2.0f);
+        };
+
+        const auto finish_exam = [&]() {
+            fmt::print("Exam finished: {}/{} correct ({:.1f}%)\n", exam_score.correct, exam_score.get_attempts(), exam_score.get_percentage());
+            exam_questions.clear();
+        };
+
+        const auto pick_entry = [&]() -> std::optional<modules::vocabulary::Entry> {
+            // Ask the exam questions in order, skipping entries whose category was disabled since the exam started
+            while (exam_position < exam_questions.size()) {
+                if (auto entry = this->vocabulary_.get_enabled_entry(exam_questions[exam_position++]); entry.has_value()) {
+                    return entry;
+                }
+            }
+            if (!exam_questions.empty()) {
+                finish_exam();
+            }
+
+            switch (this->selection_policy_) {
+            case SelectionPolicy::Knowledge:
+                // Ask entries that are likely to be answered incorrectly more often
+                return this->vocabulary_.get_weighted_enabled_entry();
+            case SelectionPolicy::ShuffleBag:
+                return this->vocabulary_.get_next_enabled_entry();
+            case SelectionPolicy::Thompson: {
+                // Recent entries are only avoided, while disabled or removed ones are never picked
+                const auto id = this->thompson_.pick([this](const std::size_t candidate) { return !this->vocabulary_.is_recent(candidate); },
+                                                     [this](const std::size_t candidate) { return this->vocabulary_.is_enabled(candidate); });
+                return id.has_value() ? this->vocabulary_.get_enabled_entry(*id) : std::nullopt;
+            }
+            case SelectionPolicy::Uniform:
+            default:
+                return this->vocabulary_.get_random_enabled_entry();
+            }
+        };
+
         const auto setup_new_question = [&]() {
-            const auto optional_entry = this->vocabulary_.get_random_enabled_entry();
+            const auto optional_entry = pick_entry();
             if (!optional_entry.has_value()) {
                 this->question_text_.setString("X");
                 this->question_text_.setCharacterSize(72);  // Increase font size for the 'X'
@@ -216,16 +522,8 @@ class UI final {
             else {
                 correct_entry = optional_entry.value();
 
-                is_hangul = core::rng::RNG::get_random_bool();
-
-                const auto options = this->vocabulary_.generate_enabled_question_options(correct_entry);
-
-                for (std::size_t idx = 0; idx < 4; ++idx) {
-                    if (options[idx].hangul == correct_entry.hangul) {
-                        correct_index = idx;
-                        break;
-                    }
-                }
+                // Typed answers are always romanizations, so the question is always in Hangul
+                is_hangul = this->is_typing_ || core::rng::RNG::get_random_bool();
 
                 this->question_text_.setCharacterSize(48);  // Reset to default size
                 this->question_text_.setString(core::string::to_sfml_string(is_hangul ? correct_entry.hangul : correct_entry.latin));
@@ -237,8 +535,38 @@ class UI final {
                 // Clear memo text
                 this->memo_text_.setString("");
 
+                question_shown_at = std::chrono::steady_clock::now();
+                game_state = GameState::WaitingForAnswer;
+
+                if (this->is_typing_) {
+                    this->matcher_.reset(correct_entry.id);
+                    update_answer_text();
+                    return;
+                }
+
+                // Apply the cached layout when the number of options changes
+                if (const std::size_t num_options = get_num_options(this->knowledge_.get_mastery(correct_entry.id), this->knowledge_.get_parameters().initial, this->vocabulary_.get_num_enabled()); num_options != this->num_options_) {
+                    const ButtonLayout &layout = this->button_layouts_[num_options];
+                    for (std::size_t idx = 0; idx < num_options; ++idx) {
+                        this->button_shapes_[idx].setRadius(layout.radius);
+                        this->button_shapes_[idx].setOrigin(layout.radius, layout.radius);
+                        this->button_shapes_[idx].setPosition(layout.positions[idx]);
+                        this->answer_buttons_[idx].setCharacterSize(layout.character_size);
+                    }
+                    this->num_options_ = num_options;
+                }
+
+                const auto options = this->vocabulary_.generate_enabled_question_options(correct_entry, this->num_options_, this->progress_->get_confusion().get_confusions(correct_entry.id));
+
+                for (std::size_t idx = 0; idx < this->num_options_; ++idx) {
+                    option_ids[idx] = options[idx].id;
+                    if (options[idx].id == correct_entry.id) {
+                        correct_index = idx;
+                    }
+                }
+
                 // Setup answer buttons
-                for (std::size_t idx = 0; idx < 4; ++idx) {
+                for (std::size_t idx = 0; idx < this->num_options_; ++idx) {
                     this->button_shapes_[idx].setFillColor(core::colors::default_button);  // Reset button colors
                     this->answer_buttons_[idx].setString(core::string::to_sfml_string(is_hangul ? options[idx].latin : options[idx].hangul));
 
@@ -249,15 +577,127 @@ class UI final {
                     // Set position to center the text within the button
                     this->answer_buttons_[idx].setPosition(this->button_shapes_[idx].getPosition());
                 }
+            }
+        };
+
+        const auto record_answer = [&](const std::size_t chosen_id,
+                                       const bool correct,
+                                       const float guess) {
+            // Record the answer; the disk is never touched on this thread
+            const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - question_shown_at);
+            const auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+            this->progress_->record({static_cast<std::uint64_t>(timestamp.count()),
+                                     static_cast<std::uint32_t>(correct_entry.id),
+                                     static_cast<std::uint32_t>(chosen_id),
+                                     static_cast<std::uint32_t>(latency.count()),
+                                     correct});
+            this->knowledge_.update(correct_entry.id, correct, guess);
+            if (const std::vector<float> &scores = this->knowledge_.get_scores(); correct_entry.id < scores.size()) {
+                this->vocabulary_.set_weight(correct_entry.id, scores[correct_entry.id]);
+            }
+            this->thompson_.record(correct_entry.id, correct);
+            update_percentage_text();
+            if (!exam_questions.empty()) {
+                exam_score.correct += correct ? 1u : 0u;
+                exam_score.incorrect += correct ? 0u : 1u;
+                if (exam_position == exam_questions.size()) {
+                    finish_exam();
+                }
+            }
 
-                game_state = GameState::WaitingForAnswer;
+            // Display memo text, after how the entry is pronounced if it is not pronounced as written
+            if (const std::string pronounced = core::pronunciation::pronounce(correct_entry.hangul); pronounced != correct_entry.hangul) {
+                this->memo_text_.setString(core::string::to_sfml_string(fmt::format("[{}] {}", pronounced, correct_entry.memo)));
+            }
+            else {
+                this->memo_text_.setString(core::string::to_sfml_string(correct_entry.memo));
+            }
+            // Center memo text
+            const sf::FloatRect memo_bounds = this->memo_text_.getLocalBounds();
+            this->memo_text_.setOrigin(memo_bounds.left + memo_bounds.width / 2.0f,
+                                       memo_bounds.top + memo_bounds.height / 2.0f);
+            game_state = GameState::ShowResult;
+        };
+
+        const auto submit_answer = [&](const std::size_t selected_index) {
+            const bool correct = selected_index == correct_index;
+            if (correct) {
+                this->button_shapes_[selected_index].setFillColor(core::colors::correct_answer);
+            }
+            else {
+                this->button_shapes_[selected_index].setFillColor(core::colors::selected_wrong_answer);
+                this->button_shapes_[correct_index].setFillColor(core::colors::correct_answer);
+            }
+            for (std::size_t jdx = 0; jdx < this->num_options_; ++jdx) {
+                if (jdx != selected_index && jdx != correct_index) {
+                    this->button_shapes_[jdx].setFillColor(core::colors::incorrect_answer);
+                }
             }
+
+            record_answer(option_ids[selected_index], correct, 1.0f / static_cast<float>(this->num_options_));
+        };
+
+        const auto submit_typed_answer = [&]() {
+            // A typed romanization of another entry counts as choosing that entry; typing is hardly ever a lucky guess
+            const bool correct = this->matcher_.is_correct();
+            if (!correct) {
+                this->answer_text_.setString(fmt::format("{} ({})", this->matcher_.get_text(), correct_entry.latin));
+                this->answer_text_.setFillColor(core::colors::disabled_color);
+                const sf::FloatRect answer_bounds = this->answer_text_.getLocalBounds();
+                this->answer_text_.setOrigin(answer_bounds.left + answer_bounds.width / 2.0f,
+                                             answer_bounds.top + answer_bounds.height / 2.0f);
+            }
+            record_answer(this->matcher_.get_match().value_or(correct_entry.id), correct, 0.0f);
+        };
+
+        const auto apply_deck_update = [&](const modules::vocabulary::Update &update) {
+            // The vocabulary changes in place; the structures built from its entries are rebuilt only if their layout changed
+            if (this->vocabulary_.update(update)) {
+                // New entries get the next IDs, which the progress has to know before they are answered, or their answers are lost on restart
+                this->progress_->add_entries(get_entry_categories(this->vocabulary_), get_entry_keys(this->vocabulary_));
+                this->rebuild_policies();
+                this->matcher_ = modules::typing::Matcher(this->vocabulary_);
+                const std::string text(this->matcher_.get_text());
+                this->matcher_.reset(correct_entry.id);
+                for (const char c : text) {
+                    static_cast<void>(this->matcher_.push(c));
+                }
+            }
+            fmt::print("Reloaded deck: {} entries new or changed, {} removed\n", update.entries.size(), update.removed.size());
+
+            // The current question stays, unless there was none
+            if (game_state == GameState::NoEntriesEnabled) {
+                setup_new_question();
+            }
+        };
+
+        const auto switch_profile = [&](const std::string &name) {
+            try {
+                this->load_profile(name);
+            }
+            catch (const std::exception &e) {
+                fmt::print(stderr, "Warning: Failed to switch to profile '{}': {}\n", name, e.what());
+                return;
+            }
+            // The exam belongs to the previous learner, and the score shows all of the new learner's saved progress
+            exam_questions.clear();
+            score_baseline = {0, 0, 0};
+            update_percentage_text();
+            this->memo_text_.setString("");
+            setup_new_question();
         };
 
         setup_new_question();
 
         // Main loop
         while (this->window_.isOpen()) {
+            // Apply the changes of the deck file between frames
+            if (this->reloader_.has_value()) {
+                if (const auto update = this->reloader_->poll(); update.has_value()) {
+                    apply_deck_update(*update);
+                }
+            }
+
             // Variables for event handling
             const sf::Vector2i mouse_pos = sf::Mouse::getPosition(this->window_);
 
@@ -267,6 +707,83 @@ class UI final {
                     this->window_.close();
                 }
 
+                // Type the name of a learner and press Enter to switch to their progress; an empty name switches back to the shared progress
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+                    is_naming = !is_naming;
+                    typed_name.clear();
+                    update_profile_text();
+                    continue;
+                }
+                if (is_naming) {
+                    // The question waits while a name is typed
+                    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
+                        is_naming = false;
+                    }
+                    else if (event.type == sf::Event::TextEntered) {
+                        const sf::Uint32 unicode = event.text.unicode;
+                        if (unicode == '\r') {
+                            is_naming = false;
+                            switch_profile(typed_name);
+                        }
+                        else if (unicode == '\b') {
+                            if (!typed_name.empty()) {
+                                typed_name.pop_back();
+                            }
+                        }
+                        else if (unicode >= ' ' && unicode < 0x7f && typed_name.size() < modules::profiles::Profiles::max_name_size) {
+                            typed_name.push_back(static_cast<char>(unicode));
+                        }
+                    }
+                    update_profile_text();
+                    continue;
+                }
+
+                // Cycle through the selection policies; the current question stays
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Tab) {
+                    switch (this->selection_policy_) {
+                    case SelectionPolicy::Uniform:
+                        this->selection_policy_ = SelectionPolicy::ShuffleBag;
+                        break;
+                    case SelectionPolicy::ShuffleBag:
+                        this->selection_policy_ = SelectionPolicy::Knowledge;
+                        break;
+                    case SelectionPolicy::Knowledge:
+                        this->selection_policy_ = SelectionPolicy::Thompson;
+                        break;
+                    case SelectionPolicy::Thompson:
+                        this->selection_policy_ = SelectionPolicy::Uniform;
+                        break;
+                    }
+                    fmt::print("Selection policy: {}\n", get_policy_name(this->selection_policy_));
+                    this->save_settings();
+                    continue;
+                }
+
+                // Switch between multiple choice and typed answers; the current question is replaced
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F2) {
+                    this->is_typing_ = !this->is_typing_;
+                    fmt::print("Answer mode: {}\n", this->is_typing_ ? "typed" : "multiple choice");
+                    this->save_settings();
+                    if (game_state != GameState::NoEntriesEnabled) {
+                        setup_new_question();
+                    }
+                    continue;
+                }
+
+                // Start an exam of up to 20 questions, split equally across the enabled categories; the seed is printed, so the exam can be generated again
+                // While typing, 'E' is part of the answer instead
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::E && !this->is_typing_) {
+                    if (const std::size_t num_questions = std::min<std::size_t>(20, this->exam_.get_num_enabled()); num_questions > 0) {
+                        const std::uint32_t seed = std::random_device{}();
+                        exam_questions = this->exam_.generate(num_questions, seed, modules::exam::Coverage::Equal);
+                        exam_position = 0;
+                        exam_score = {0, 0, 0};
+                        fmt::print("Exam started: {} questions, seed {}\n", num_questions, seed);
+                        setup_new_question();
+                    }
+                    continue;
+                }
+
                 // Handle toggle button clicks
                 if (event.type == sf::Event::MouseButtonReleased) {
                     for (std::size_t idx = 0; idx < this->toggle_buttons_.size(); ++idx) {
@@ -275,6 +792,16 @@ class UI final {
                             const bool current_state = this->toggle_states_[this->toggle_categories_[idx]];
                             this->toggle_states_[this->toggle_categories_[idx]] = !current_state;
                             this->vocabulary_.set_category_enabled(this->toggle_categories_[idx], !current_state);
+                            this->thompson_.set_category_enabled(static_cast<std::size_t>(this->toggle_categories_[idx]), !current_state);
+                            this->exam_.set_category_enabled(static_cast<std::size_t>(this->toggle_categories_[idx]), !current_state);
+                            // Save the enabled categories with the next snapshot
+                            std::uint32_t category_mask = 0;
+                            for (const auto &[category, enabled] : this->toggle_states_) {
+                                if (enabled) {
+                                    category_mask |= 1u << static_cast<unsigned int>(category);
+                                }
+                            }
+                            this->progress_->set_category_mask(category_mask);
                             // Update button appearance
                             if (this->toggle_states_[this->toggle_categories_[idx]]) {
                                 this->toggle_buttons_[idx].setFillColor(core::colors::enabled_color);  // Enabled state color
@@ -283,8 +810,7 @@ class UI final {
                                 this->toggle_buttons_[idx].setFillColor(core::colors::disabled_color);  // Disabled state color
                             }
                             // Reset the game
-                            total_questions = 0;
-                            correct_answers = 0;
+                            score_baseline = this->progress_->get_statistics().get_total();
                             update_percentage_text();
                             setup_new_question();
                             break;
@@ -305,11 +831,31 @@ class UI final {
                 }
 
                 // Game logic
-                if (game_state == GameState::WaitingForAnswer) {
+                if (game_state == GameState::WaitingForAnswer && this->is_typing_) {
+                    // Match each character as it arrives, so the feedback is drawn in the same frame
+                    if (event.type == sf::Event::TextEntered) {
+                        const sf::Uint32 unicode = event.text.unicode;
+                        if (unicode == '\r') {
+                            if (!this->matcher_.get_text().empty()) {
+                                submit_typed_answer();
+                            }
+                        }
+                        else {
+                            if (unicode == '\b') {
+                                this->matcher_.pop();
+                            }
+                            else if (unicode > ' ' && unicode < 0x7f) {
+                                static_cast<void>(this->matcher_.push(static_cast<char>(unicode)));
+                            }
+                            update_answer_text();
+                        }
+                    }
+                }
+                else if (game_state == GameState::WaitingForAnswer) {
                     if (event.type == sf::Event::MouseMoved) {
                         // Handle hover effect for answer buttons
-                        for (std::size_t idx = 0; idx < 4; ++idx) {
-                            if (this->button_shapes_[idx].getGlobalBounds().contains(static_cast<float>(mouse_pos.x), static_cast<float>(mouse_pos.y))) {
+                        for (std::size_t idx = 0; idx < this->num_options_; ++idx) {
+                            if (is_inside(this->button_shapes_[idx], mouse_pos)) {
                                 this->button_shapes_[idx].setFillColor(core::colors::hover_button);
                             }
                             else {
@@ -319,82 +865,33 @@ class UI final {
                     }
                     else if (event.type == sf::Event::MouseButtonReleased) {
                         // Handle answer button clicks
-                        for (std::size_t idx = 0; idx < 4; ++idx) {
-                            if (this->button_shapes_[idx].getGlobalBounds().contains(static_cast<float>(mouse_pos.x), static_cast<float>(mouse_pos.y))) {
-                                ++total_questions;
-                                if (idx == correct_index) {
-                                    ++correct_answers;
-                                    this->button_shapes_[idx].setFillColor(core::colors::correct_answer);
-                                }
-                                else {
-                                    this->button_shapes_[idx].setFillColor(core::colors::selected_wrong_answer);
-                                    this->button_shapes_[correct_index].setFillColor(core::colors::correct_answer);
-                                }
-                                for (std::size_t jdx = 0; jdx < 4; ++jdx) {
-                                    if (jdx != idx && jdx != correct_index) {
-                                        this->button_shapes_[jdx].setFillColor(core::colors::incorrect_answer);
-                                    }
-                                }
-                                update_percentage_text();
-                                // Display memo text
-                                this->memo_text_.setString(core::string::to_sfml_string(correct_entry.memo));
-                                // Center memo text
-                                const sf::FloatRect memo_bounds = this->memo_text_.getLocalBounds();
-                                this->memo_text_.setOrigin(memo_bounds.left + memo_bounds.width / 2.0f,
-                                                           memo_bounds.top + memo_bounds.height / 2.0f);
-                                game_state = GameState::ShowResult;
+                        for (std::size_t idx = 0; idx < this->num_options_; ++idx) {
+                            if (is_inside(this->button_shapes_[idx], mouse_pos)) {
+                                submit_answer(idx);
                                 break;
                             }
                         }
                     }
                     else if (event.type == sf::Event::KeyPressed) {
-                        // Handle keyboard input
+                        // Handle keyboard input; the number keys and the keypad keys are contiguous in SFML
                         const auto key_code = event.key.code;
                         std::size_t selected_index = std::numeric_limits<std::size_t>::max();
-                        switch (key_code) {
-                        case sf::Keyboard::Num1:
-                            selected_index = 0;
-                            break;
-                        case sf::Keyboard::Num2:
-                            selected_index = 1;
-                            break;
-                        case sf::Keyboard::Num3:
-                            selected_index = 2;
-                            break;
-                        case sf::Keyboard::Num4:
-                            selected_index = 3;
-                            break;
-                        default:
-                            break;
+                        if (key_code >= sf::Keyboard::Num1 && key_code <= sf::Keyboard::Num9) {
+                            selected_index = static_cast<std::size_t>(key_code - sf::Keyboard::Num1);
                         }
-                        if (selected_index < 4) {
-                            ++total_questions;
-                            if (selected_index == correct_index) {
-                                ++correct_answers;
-                                this->button_shapes_[selected_index].setFillColor(core::colors::correct_answer);
-                            }
-                            else {
-                                this->button_shapes_[selected_index].setFillColor(core::colors::selected_wrong_answer);
-                                this->button_shapes_[correct_index].setFillColor(core::colors::correct_answer);
-                            }
-                            for (std::size_t jdx = 0; jdx < 4; ++jdx) {
-                                if (jdx != selected_index && jdx != correct_index) {
-                                    this->button_shapes_[jdx].setFillColor(core::colors::incorrect_answer);
-                                }
-                            }
-                            update_percentage_text();
-                            // Display memo text
-                            this->memo_text_.setString(core::string::to_sfml_string(correct_entry.memo));
-                            // Center memo text
-                            const sf::FloatRect memo_bounds = this->memo_text_.getLocalBounds();
-                            this->memo_text_.setOrigin(memo_bounds.left + memo_bounds.width / 2.0f,
-                                                       memo_bounds.top + memo_bounds.height / 2.0f);
-                            game_state = GameState::ShowResult;
+                        else if (key_code >= sf::Keyboard::Numpad1 && key_code <= sf::Keyboard::Numpad9) {
+                            selected_index = static_cast<std::size_t>(key_code - sf::Keyboard::Numpad1);
+                        }
+                        if (selected_index < this->num_options_) {
+                            submit_answer(selected_index);
                         }
                     }
                 }
                 else if (game_state == GameState::ShowResult) {
-                    if (event.type == sf::Event::MouseButtonReleased || event.type == sf::Event::KeyPressed) {
+                    // While typing, only Enter proceeds, as a key press would also start typing the next answer
+                    const bool proceed = this->is_typing_ ? (event.type == sf::Event::MouseButtonReleased || (event.type == sf::Event::TextEntered && event.text.unicode == '\r'))
+                                                          : (event.type == sf::Event::MouseButtonReleased || event.type == sf::Event::KeyPressed);
+                    if (proceed) {
                         // Proceed to the next question
                         // Hide memo text
                         this->memo_text_.setString("");
@@ -413,11 +910,19 @@ class UI final {
             if (game_state == GameState::ShowResult) {
                 this->window_.draw(this->memo_text_);
             }
-            for (std::size_t idx = 0; idx < 4; ++idx) {
-                this->window_.draw(this->button_shapes_[idx]);
-                this->window_.draw(this->answer_buttons_[idx]);
+            if (this->is_typing_) {
+                if (game_state != GameState::NoEntriesEnabled) {
+                    this->window_.draw(this->answer_text_);
+                }
+            }
+            else {
+                for (std::size_t idx = 0; idx < this->num_options_; ++idx) {
+                    this->window_.draw(this->button_shapes_[idx]);
+                    this->window_.draw(this->answer_buttons_[idx]);
+                }
             }
             this->window_.draw(this->percentage_text_);
+            this->window_.draw(this->profile_text_);
             for (std::size_t idx = 0; idx < this->toggle_buttons_.size(); ++idx) {
                 this->window_.draw(this->toggle_buttons_[idx]);
                 this->window_.draw(this->toggle_texts_[idx]);
@@ -427,10 +932,117 @@ class UI final {
     }
 
   private:
+    /**
+     * @brief Restore the enabled categories and the settings saved with the progress of the learner, and rebuild the selection policies from their answers.
+     */
+    void restore_progress()
+    {
+        for (const auto category : this->toggle_categories_) {
+            const bool enabled = (this->progress_->get_category_mask() >> static_cast<unsigned int>(category)) & 1u;
+            this->toggle_states_[category] = enabled;
+            this->vocabulary_.set_category_enabled(category, enabled);
+        }
+        for (std::size_t idx = 0; idx < this->toggle_buttons_.size(); ++idx) {
+            this->toggle_buttons_[idx].setFillColor(this->toggle_states_.at(this->toggle_categories_[idx]) ? core::colors::enabled_color : core::colors::disabled_color);
+        }
+
+        // A learner without saved settings starts with the defaults
+        const auto settings = this->progress_->get_settings();
+        this->selection_policy_ = settings.has_value() && settings->selection_policy <= static_cast<std::uint32_t>(SelectionPolicy::Thompson) ? static_cast<SelectionPolicy>(settings->selection_policy) : SelectionPolicy::Knowledge;
+        this->is_typing_ = settings.has_value() && settings->is_typing;
+
+        // Estimate how well each entry is known from the answers of previous sessions
+        this->rebuild_policies();
+    }
+
+    /**
+     * @brief Save the selection policy and the answer mode with the next snapshot.
+     */
+    void save_settings()
+    {
+        this->progress_->set_settings({static_cast<std::uint32_t>(this->selection_policy_), this->is_typing_});
+    }
+
+    /**
+     * @brief Switch to the progress of another learner.
+     *
+     * The profile is found in the mapped index and its snapshot is mapped, then the progress is swapped in; the progress of the previous learner is written and closed in the background, which is only waited for when switching back to that learner.
+     *
+     * @param name Name of the learner, who is added if new (e.g., "Minji"), or empty for the shared progress in the data directory.
+     *
+     * @throws std::runtime_error If the name is invalid, or the progress cannot be loaded.
+     */
+    void load_profile(const std::string &name)
+    {
+        if (name == this->profile_name_) {
+            return;
+        }
+        const auto start = std::chrono::steady_clock::now();
+
+        // Forget the learners whose progress was closed, and wait only when switching back to one that is still being closed, as its snapshot is still being written
+        for (auto it = this->retired_progress_.begin(); it != this->retired_progress_.end();) {
+            if (it->first == name) {
+                it->second.wait();
+            }
+            if (it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                it = this->retired_progress_.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+        const std::filesystem::path directory = name.empty() ? core::paths::get_data_directory() : this->profiles_.add(name);
+
+        // Queue the snapshot of the previous learner first, as it saves the RNG state that the new snapshot replaces
+        this->progress_->compact();
+        auto progress = std::make_unique<modules::progress::Progress>(directory, get_entry_categories(this->vocabulary_), get_entry_keys(this->vocabulary_));
+        auto retirement = std::async(std::launch::async, [retired = std::move(this->progress_)]() mutable {
+            retired.reset();
+        });
+        this->retired_progress_.emplace_back(this->profile_name_, std::move(retirement));
+        this->progress_ = std::move(progress);
+        this->profile_name_ = name;
+        this->restore_progress();
+        fmt::print("Switched to {} in {:.3f} ms\n", name.empty() ? std::string("shared progress") : fmt::format("profile '{}'", name), std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    /**
+     * @brief Rebuild the selection policies from the entries of the vocabulary and the answers of the learner, keeping the enabled categories.
+     */
+    void rebuild_policies()
+    {
+        const std::vector<std::size_t> entry_categories = get_entry_categories(this->vocabulary_);
+        this->knowledge_ = modules::knowledge::Knowledge(entry_categories.size(), this->knowledge_.get_parameters());
+        this->thompson_ = modules::thompson::Thompson(entry_categories);
+        this->exam_ = modules::exam::Exam(entry_categories);
+        for (const auto &[category, enabled] : this->toggle_states_) {
+            this->thompson_.set_category_enabled(static_cast<std::size_t>(category), enabled);
+            this->exam_.set_category_enabled(static_cast<std::size_t>(category), enabled);
+        }
+        this->knowledge_.rebuild(this->progress_->get_history());
+        this->vocabulary_.set_weights(this->knowledge_.get_scores());
+        for (std::size_t id = 0; id < this->vocabulary_.get_num_entries(); ++id) {
+            this->thompson_.add(id, this->progress_->get_statistics().get_entry(id));
+        }
+    }
+
     // Member variables
     sf::RenderWindow window_;
     const sf::Font &font_;
+    std::filesystem::path deck_path_;
+    std::filesystem::path image_path_;
     modules::vocabulary::Vocabulary vocabulary_;
+    std::unique_ptr<modules::progress::Progress> progress_;
+    std::vector<std::pair<std::string, std::future<void>>> retired_progress_;
+    modules::profiles::Profiles profiles_;
+    std::string profile_name_;
+    modules::knowledge::Knowledge knowledge_;
+    modules::thompson::Thompson thompson_;
+    modules::exam::Exam exam_;
+    modules::typing::Matcher matcher_;
+    std::optional<modules::deck::Reloader> reloader_;
+    SelectionPolicy selection_policy_;
+    bool is_typing_;
 
     // Toggle button states
     std::array<std::string, 4> toggle_labels_;
@@ -442,9 +1054,15 @@ class UI final {
     sf::Text question_text_;
     sf::Text memo_text_;
     sf::Text percentage_text_;
+    sf::Text answer_text_;
+    sf::Text profile_text_;
+
+    std::array<sf::CircleShape, max_options> button_shapes_;
+    std::array<sf::Text, max_options> answer_buttons_;
 
-    std::array<sf::CircleShape, 4> button_shapes_;
-    std::array<sf::Text, 4> answer_buttons_;
+    // Answer button layout for each number of options, and the number of options of the current question
+    std::array<ButtonLayout, max_options + 1> button_layouts_;
+    std::size_t num_options_;
 
     std::vector<sf::RectangleShape> toggle_buttons_;
     std::vector<sf::Text> toggle_texts_;
@@ -0,0 +1,433 @@
+/**
+ * @file bitmap.cpp
+ */
+
+#include <algorithm>  // for std::lower_bound, std::binary_search, std::set_intersection, std::set_union, std::set_difference
+#include <cstddef>    // for std::size_t, std::ptrdiff_t
+#include <cstdint>    // for std::uint16_t, std::uint32_t, std::uint64_t
+#include <iterator>   // for std::back_inserter
+#include <optional>   // for std::optional, std::nullopt
+#include <utility>    // for std::move
+#include <vector>     // for std::vector
+
+#include "bitmap.hpp"
+#include "bits.hpp"
+
+namespace core::bitmap {
+
+namespace {
+
+/**
+ * @brief Private maximum number of integers in an array container; a bitset of 1024 words takes the same 8 KiB.
+ */
+constexpr std::size_t max_array_size = 4096;
+
+/**
+ * @brief Private number of 64-bit words in a bitset container.
+ */
+constexpr std::size_t num_words = 1024;
+
+/**
+ * @brief Private helper function to check whether the bit of a value is set in a bitset.
+ *
+ * @param words Bitset.
+ * @param low Lower 16 bits of the value.
+ *
+ * @return True if the bit is set, false otherwise.
+ */
+[[nodiscard]] inline bool test_bit(const std::vector<std::uint64_t> &words,
+                                   const std::uint16_t low)
+{
+    return ((words[low >> 6] >> (low & 63u)) & 1u) != 0;
+}
+
+/**
+ * @brief Private number of words per block of a bitset.
+ */
+constexpr std::size_t words_per_block = 64;
+
+/**
+ * @brief Private helper function to count the set bits of a bitset, per block of 64 words.
+ *
+ * @param words Bitset.
+ * @param blocks Number of set bits in each block, which is overwritten.
+ *
+ * @return Number of set bits.
+ */
+std::uint32_t count_bits(const std::vector<std::uint64_t> &words,
+                         std::vector<std::uint16_t> &blocks)
+{
+    blocks.assign(num_words / words_per_block, 0);
+    std::uint32_t count = 0;
+    for (std::size_t block = 0; block < blocks.size(); ++block) {
+        std::uint32_t block_count = 0;
+        for (std::size_t idx = block * words_per_block; idx < (block + 1) * words_per_block; ++idx) {
+            block_count += core::bits::popcount(words[idx]);
+        }
+        blocks[block] = static_cast<std::uint16_t>(block_count);
+        count += block_count;
+    }
+    return count;
+}
+
+}  // namespace
+
+Bitmap::Bitmap()
+    : containers_(),
+      cardinality_(0)
+{
+}
+
+void Bitmap::add(const std::uint32_t value)
+{
+    const auto key = static_cast<std::uint16_t>(value >> 16);
+    const auto low = static_cast<std::uint16_t>(value & 0xFFFFu);
+    std::size_t pos = this->find_container(key);
+    if (pos == this->containers_.size() || this->containers_[pos].key != key) {
+        this->containers_.insert(this->containers_.begin() + static_cast<std::ptrdiff_t>(pos), Container{key, 0, {}, {}, {}});
+    }
+    Container &container = this->containers_[pos];
+    if (container.words.empty()) {
+        const auto it = std::lower_bound(container.array.begin(), container.array.end(), low);
+        if (it != container.array.end() && *it == low) {
+            return;
+        }
+        container.array.insert(it, low);
+    }
+    else {
+        if (test_bit(container.words, low)) {
+            return;
+        }
+        container.words[low >> 6] |= std::uint64_t{1} << (low & 63u);
+        ++container.blocks[low >> 12];
+    }
+    ++container.cardinality;
+    ++this->cardinality_;
+    normalize(container);
+}
+
+void Bitmap::remove(const std::uint32_t value)
+{
+    const auto key = static_cast<std::uint16_t>(value >> 16);
+    const auto low = static_cast<std::uint16_t>(value & 0xFFFFu);
+    const std::size_t pos = this->find_container(key);
+    if (pos == this->containers_.size() || this->containers_[pos].key != key) {
+        return;
+    }
+    Container &container = this->containers_[pos];
+    if (container.words.empty()) {
+        const auto it = std::lower_bound(container.array.begin(), container.array.end(), low);
+        if (it == container.array.end() || *it != low) {
+            return;
+        }
+        container.array.erase(it);
+    }
+    else {
+        if (!test_bit(container.words, low)) {
+            return;
+        }
+        container.words[low >> 6] &= ~(std::uint64_t{1} << (low & 63u));
+        --container.blocks[low >> 12];
+    }
+    --container.cardinality;
+    --this->cardinality_;
+    if (container.cardinality == 0) {
+        this->containers_.erase(this->containers_.begin() + static_cast<std::ptrdiff_t>(pos));
+        return;
+    }
+    normalize(container);
+}
+
+bool Bitmap::contains(const std::uint32_t value) const
+{
+    const auto key = static_cast<std::uint16_t>(value >> 16);
+    const auto low = static_cast<std::uint16_t>(value & 0xFFFFu);
+    const std::size_t pos = this->find_container(key);
+    if (pos == this->containers_.size() || this->containers_[pos].key != key) {
+        return false;
+    }
+    const Container &container = this->containers_[pos];
+    return container.words.empty() ? std::binary_search(container.array.cbegin(), container.array.cend(), low) : test_bit(container.words, low);
+}
+
+std::size_t Bitmap::get_cardinality() const
+{
+    return this->cardinality_;
+}
+
+std::optional<std::uint32_t> Bitmap::select(std::size_t rank) const
+{
+    // Skip whole containers by their count, then whole blocks, then whole words by their popcount
+    for (const Container &container : this->containers_) {
+        if (rank >= container.cardinality) {
+            rank -= container.cardinality;
+            continue;
+        }
+        const std::uint32_t high = static_cast<std::uint32_t>(container.key) << 16;
+        if (container.words.empty()) {
+            return high | container.array[rank];
+        }
+        std::size_t block = 0;
+        for (; rank >= container.blocks[block]; ++block) {
+            rank -= container.blocks[block];
+        }
+        for (std::size_t word_idx = block * words_per_block; word_idx < num_words; ++word_idx) {
+            std::uint64_t word = container.words[word_idx];
+            const unsigned int count = core::bits::popcount(word);
+            if (rank >= count) {
+                rank -= count;
+                continue;
+            }
+            for (; rank > 0; --rank) {
+                word &= word - 1;
+            }
+            return high | static_cast<std::uint32_t>(word_idx * 64 + core::bits::countr_zero(word));
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<std::uint32_t> Bitmap::to_vector() const
+{
+    std::vector<std::uint32_t> values;
+    values.reserve(this->cardinality_);
+    this->for_each([&values](const std::uint32_t value) { values.emplace_back(value); });
+    return values;
+}
+
+Bitmap &Bitmap::operator&=(const Bitmap &other)
+{
+    if (&other == this) {
+        return *this;
+    }
+
+    // Containers without a counterpart in the other bitmap are emptied, and dropped by "compact()"
+    std::size_t jdx = 0;
+    for (Container &container : this->containers_) {
+        while (jdx < other.containers_.size() && other.containers_[jdx].key < container.key) {
+            ++jdx;
+        }
+        if (jdx < other.containers_.size() && other.containers_[jdx].key == container.key) {
+            combine('&', container, other.containers_[jdx]);
+        }
+        else {
+            container.cardinality = 0;
+        }
+    }
+    this->compact();
+    return *this;
+}
+
+Bitmap &Bitmap::operator|=(const Bitmap &other)
+{
+    if (&other == this) {
+        return *this;
+    }
+    std::vector<Container> merged;
+    merged.reserve(this->containers_.size() + other.containers_.size());
+    std::size_t idx = 0;
+    std::size_t jdx = 0;
+    while (idx < this->containers_.size() || jdx < other.containers_.size()) {
+        if (jdx == other.containers_.size() || (idx < this->containers_.size() && this->containers_[idx].key < other.containers_[jdx].key)) {
+            merged.emplace_back(std::move(this->containers_[idx++]));
+        }
+        else if (idx == this->containers_.size() || other.containers_[jdx].key < this->containers_[idx].key) {
+            merged.emplace_back(other.containers_[jdx++]);
+        }
+        else {
+            combine('|', this->containers_[idx], other.containers_[jdx++]);
+            merged.emplace_back(std::move(this->containers_[idx++]));
+        }
+    }
+    this->containers_ = std::move(merged);
+    this->compact();
+    return *this;
+}
+
+Bitmap &Bitmap::operator-=(const Bitmap &other)
+{
+    if (&other == this) {
+        *this = Bitmap();
+        return *this;
+    }
+    std::size_t jdx = 0;
+    for (Container &container : this->containers_) {
+        while (jdx < other.containers_.size() && other.containers_[jdx].key < container.key) {
+            ++jdx;
+        }
+        if (jdx < other.containers_.size() && other.containers_[jdx].key == container.key) {
+            combine('-', container, other.containers_[jdx]);
+        }
+    }
+    this->compact();
+    return *this;
+}
+
+bool Bitmap::operator==(const Bitmap &other) const
+{
+    // Containers are always stored in the smaller form, so equal sets have equal containers
+    if (this->cardinality_ != other.cardinality_ || this->containers_.size() != other.containers_.size()) {
+        return false;
+    }
+    for (std::size_t idx = 0; idx < this->containers_.size(); ++idx) {
+        const Container &lhs = this->containers_[idx];
+        const Container &rhs = other.containers_[idx];
+        if (lhs.key != rhs.key || lhs.cardinality != rhs.cardinality || lhs.array != rhs.array || lhs.words != rhs.words) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Bitmap::operator!=(const Bitmap &other) const
+{
+    return !(*this == other);
+}
+
+void Bitmap::combine(const char op,
+                     Container &lhs,
+                     const Container &rhs)
+{
+    // Two arrays are merged like sorted ranges
+    if (lhs.words.empty() && rhs.words.empty()) {
+        std::vector<std::uint16_t> result;
+        if (op == '&') {
+            std::set_intersection(lhs.array.cbegin(), lhs.array.cend(), rhs.array.cbegin(), rhs.array.cend(), std::back_inserter(result));
+        }
+        else if (op == '|') {
+            result.reserve(lhs.array.size() + rhs.array.size());
+            std::set_union(lhs.array.cbegin(), lhs.array.cend(), rhs.array.cbegin(), rhs.array.cend(), std::back_inserter(result));
+        }
+        else {
+            std::set_difference(lhs.array.cbegin(), lhs.array.cend(), rhs.array.cbegin(), rhs.array.cend(), std::back_inserter(result));
+        }
+        lhs.array = std::move(result);
+        lhs.cardinality = static_cast<std::uint32_t>(lhs.array.size());
+        normalize(lhs);
+        return;
+    }
+
+    // An array and a bitset are combined by testing or setting the bits of the array's values
+    if (lhs.words.empty()) {
+        if (op == '|') {
+            std::vector<std::uint64_t> words = rhs.words;
+            for (const std::uint16_t low : lhs.array) {
+                words[low >> 6] |= std::uint64_t{1} << (low & 63u);
+            }
+            lhs.array.clear();
+            lhs.words = std::move(words);
+            lhs.cardinality = count_bits(lhs.words, lhs.blocks);
+        }
+        else {
+            const bool keep = op == '&';
+            std::vector<std::uint16_t> result;
+            for (const std::uint16_t low : lhs.array) {
+                if (test_bit(rhs.words, low) == keep) {
+                    result.emplace_back(low);
+                }
+            }
+            lhs.array = std::move(result);
+            lhs.cardinality = static_cast<std::uint32_t>(lhs.array.size());
+        }
+    }
+    else if (rhs.words.empty()) {
+        if (op == '&') {
+            for (const std::uint16_t low : rhs.array) {
+                if (test_bit(lhs.words, low)) {
+                    lhs.array.emplace_back(low);
+                }
+            }
+            lhs.words.clear();
+            lhs.blocks.clear();
+            lhs.cardinality = static_cast<std::uint32_t>(lhs.array.size());
+        }
+        else {
+            for (const std::uint16_t low : rhs.array) {
+                const std::uint64_t bit = std::uint64_t{1} << (low & 63u);
+                lhs.words[low >> 6] = op == '|' ? (lhs.words[low >> 6] | bit) : (lhs.words[low >> 6] & ~bit);
+            }
+            lhs.cardinality = count_bits(lhs.words, lhs.blocks);
+        }
+    }
+
+    // Two bitsets are combined word by word
+    else {
+        for (std::size_t idx = 0; idx < num_words; ++idx) {
+            lhs.words[idx] = op == '&' ? (lhs.words[idx] & rhs.words[idx]) : op == '|' ? (lhs.words[idx] | rhs.words[idx]) : (lhs.words[idx] & ~rhs.words[idx]);
+        }
+        lhs.cardinality = count_bits(lhs.words, lhs.blocks);
+    }
+    normalize(lhs);
+}
+
+void Bitmap::normalize(Container &container)
+{
+    if (!container.words.empty() && container.cardinality <= max_array_size) {
+        container.array.clear();
+        container.array.reserve(container.cardinality);
+        for (std::size_t word_idx = 0; word_idx < num_words; ++word_idx) {
+            for (std::uint64_t word = container.words[word_idx]; word != 0; word &= word - 1) {
+                container.array.emplace_back(static_cast<std::uint16_t>(word_idx * 64 + core::bits::countr_zero(word)));
+            }
+        }
+        container.words.clear();
+        container.words.shrink_to_fit();
+        container.blocks.clear();
+    }
+    else if (container.words.empty() && container.cardinality > max_array_size) {
+        container.words.assign(num_words, 0);
+        for (const std::uint16_t low : container.array) {
+            container.words[low >> 6] |= std::uint64_t{1} << (low & 63u);
+        }
+        static_cast<void>(count_bits(container.words, container.blocks));
+        container.array.clear();
+        container.array.shrink_to_fit();
+    }
+}
+
+std::size_t Bitmap::find_container(const std::uint16_t key) const
+{
+    const auto it = std::lower_bound(this->containers_.cbegin(), this->containers_.cend(), key, [](const Container &container, const std::uint16_t value) {
+        return container.key < value;
+    });
+    return static_cast<std::size_t>(it - this->containers_.cbegin());
+}
+
+void Bitmap::compact()
+{
+    std::size_t kept = 0;
+    this->cardinality_ = 0;
+    for (std::size_t idx = 0; idx < this->containers_.size(); ++idx) {
+        if (this->containers_[idx].cardinality > 0) {
+            this->cardinality_ += this->containers_[idx].cardinality;
+            if (kept != idx) {
+                this->containers_[kept] = std::move(this->containers_[idx]);
+            }
+            ++kept;
+        }
+    }
+    this->containers_.resize(kept);
+}
+
+Bitmap operator&(Bitmap lhs,
+                 const Bitmap &rhs)
+{
+    lhs &= rhs;
+    return lhs;
+}
+
+Bitmap operator|(Bitmap lhs,
+                 const Bitmap &rhs)
+{
+    lhs |= rhs;
+    return lhs;
+}
+
+Bitmap operator-(Bitmap lhs,
+                 const Bitmap &rhs)
+{
+    lhs -= rhs;
+    return lhs;
+}
+
+}  // namespace core::bitmap
@@ -0,0 +1,243 @@
+/**
+ * @file bitmap.hpp
+ *
+ * @brief Compressed bitmap of 32-bit integers.
+ */
+
+#pragma once
+
+#include <cstddef>   // for std::size_t
+#include <cstdint>   // for std::uint16_t, std::uint32_t, std::uint64_t
+#include <optional>  // for std::optional
+#include <vector>    // for std::vector
+
+#include "bits.hpp"
+
+namespace core::bitmap {
+
+/**
+ * @brief Class that represents a set of 32-bit integers (e.g., entry IDs) as a compressed bitmap.
+ *
+ * Like a roaring bitmap, the integers are split into chunks of 65536 by their upper 16 bits, and each chunk is stored as whichever is smaller:
+ * - A sorted array of the lower 16 bits, while the chunk has at most 4096 integers.
+ * - A bitset of 1024 words, otherwise.
+ *
+ * Sparse tags (e.g., a lesson of 20 words) therefore cost a few bytes per entry, and dense ones (e.g., "noun" on a 100k-entry deck) one bit per entry.
+ * Every chunk keeps its count, so counting is O(number of chunks) and picking the n-th integer skips whole chunks.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Bitmap final {
+  public:
+    /**
+     * @brief Construct a new, empty Bitmap object.
+     */
+    explicit Bitmap();
+
+    /**
+     * @brief Add an integer. This is O(4096) at worst, within its chunk.
+     *
+     * @param value Integer to add (e.g., "3").
+     */
+    void add(const std::uint32_t value);
+
+    /**
+     * @brief Remove an integer, if present. This is O(4096) at worst, within its chunk.
+     *
+     * @param value Integer to remove (e.g., "3").
+     */
+    void remove(const std::uint32_t value);
+
+    /**
+     * @brief Check whether an integer is present. This is O(log(number of chunks) + log(4096)).
+     *
+     * @param value Integer to check (e.g., "3").
+     *
+     * @return True if the integer is present, false otherwise.
+     */
+    [[nodiscard]] bool contains(const std::uint32_t value) const;
+
+    /**
+     * @brief Get the number of integers. This is O(1).
+     *
+     * @return Number of integers (e.g., "40").
+     */
+    [[nodiscard]] std::size_t get_cardinality() const;
+
+    /**
+     * @brief Get the n-th smallest integer, e.g., to pick one uniformly at random with a random rank.
+     *
+     * @param rank Zero-based rank (e.g., "0" for the smallest).
+     *
+     * @return Integer (e.g., "3"), or std::nullopt if "rank" is not less than the cardinality.
+     */
+    [[nodiscard]] std::optional<std::uint32_t> select(const std::size_t rank) const;
+
+    /**
+     * @brief Get every integer in ascending order.
+     *
+     * @return Vector of integers (e.g., {3, 5, 8}).
+     */
+    [[nodiscard]] std::vector<std::uint32_t> to_vector() const;
+
+    /**
+     * @brief Call a function with every integer in ascending order.
+     *
+     * @param function Function that takes a "std::uint32_t".
+     */
+    template <typename Function>
+    void for_each(Function &&function) const;
+
+    /**
+     * @brief Keep only the integers that are also in another bitmap (AND).
+     *
+     * @param other Other bitmap.
+     *
+     * @return Reference to this bitmap.
+     */
+    Bitmap &operator&=(const Bitmap &other);
+
+    /**
+     * @brief Add every integer of another bitmap (OR).
+     *
+     * @param other Other bitmap.
+     *
+     * @return Reference to this bitmap.
+     */
+    Bitmap &operator|=(const Bitmap &other);
+
+    /**
+     * @brief Remove every integer of another bitmap (AND NOT).
+     *
+     * @param other Other bitmap.
+     *
+     * @return Reference to this bitmap.
+     */
+    Bitmap &operator-=(const Bitmap &other);
+
+    /**
+     * @brief Check whether two bitmaps contain the same integers.
+     *
+     * @param other Other bitmap.
+     *
+     * @return True if both contain the same integers, false otherwise.
+     */
+    [[nodiscard]] bool operator==(const Bitmap &other) const;
+
+    /**
+     * @brief Check whether two bitmaps contain different integers.
+     *
+     * @param other Other bitmap.
+     *
+     * @return True if the bitmaps differ, false otherwise.
+     */
+    [[nodiscard]] bool operator!=(const Bitmap &other) const;
+
+  private:
+    /**
+     * @brief Integers that share their upper 16 bits, stored as an array or as a bitset.
+     */
+    struct Container final {
+        std::uint16_t key;                  // Upper 16 bits
+        std::uint32_t cardinality;          // Number of integers
+        std::vector<std::uint16_t> array;   // Sorted lower 16 bits, while this is not a bitset
+        std::vector<std::uint64_t> words;   // 1024 words, or empty if this is an array
+        std::vector<std::uint16_t> blocks;  // Number of integers in each run of 64 words, so "select()" skips 4096 bits at a time
+    };
+
+    /**
+     * @brief Combine the containers of two bitmaps with the same key.
+     *
+     * @param op Operation: '&', '|' or '-'.
+     * @param lhs Container of this bitmap, which is updated.
+     * @param rhs Container of the other bitmap.
+     */
+    static void combine(const char op,
+                        Container &lhs,
+                        const Container &rhs);
+
+    /**
+     * @brief Store a container as an array if it has at most 4096 integers, and as a bitset otherwise.
+     *
+     * @param container Container to convert.
+     */
+    static void normalize(Container &container);
+
+    /**
+     * @brief Find the container with a key.
+     *
+     * @param key Upper 16 bits.
+     *
+     * @return Position of the container with the key, or where it would be inserted.
+     */
+    [[nodiscard]] std::size_t find_container(const std::uint16_t key) const;
+
+    /**
+     * @brief Drop the empty containers and recount the integers.
+     */
+    void compact();
+
+    /**
+     * @brief Containers, sorted by key.
+     */
+    std::vector<Container> containers_;
+
+    /**
+     * @brief Number of integers in all containers.
+     */
+    std::size_t cardinality_;
+};
+
+/**
+ * @brief Intersect two bitmaps (AND).
+ *
+ * @param lhs First bitmap.
+ * @param rhs Second bitmap.
+ *
+ * @return Integers in both bitmaps.
+ */
+[[nodiscard]] Bitmap operator&(Bitmap lhs,
+                               const Bitmap &rhs);
+
+/**
+ * @brief Unite two bitmaps (OR).
+ *
+ * @param lhs First bitmap.
+ * @param rhs Second bitmap.
+ *
+ * @return Integers in either bitmap.
+ */
+[[nodiscard]] Bitmap operator|(Bitmap lhs,
+                               const Bitmap &rhs);
+
+/**
+ * @brief Subtract a bitmap from another (AND NOT).
+ *
+ * @param lhs First bitmap.
+ * @param rhs Second bitmap.
+ *
+ * @return Integers in the first bitmap but not in the second.
+ */
+[[nodiscard]] Bitmap operator-(Bitmap lhs,
+                               const Bitmap &rhs);
+
+template <typename Function>
+void Bitmap::for_each(Function &&function) const
+{
+    for (const Container &container : this->containers_) {
+        const std::uint32_t high = static_cast<std::uint32_t>(container.key) << 16;
+        if (container.words.empty()) {
+            for (const std::uint16_t low : container.array) {
+                function(high | low);
+            }
+            continue;
+        }
+        for (std::size_t word_idx = 0; word_idx < container.words.size(); ++word_idx) {
+            for (std::uint64_t word = container.words[word_idx]; word != 0; word &= word - 1) {
+                function(high | static_cast<std::uint32_t>(word_idx * 64 + core::bits::countr_zero(word)));
+            }
+        }
+    }
+}
+
+}  // namespace core::bitmap
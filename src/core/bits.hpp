@@ -0,0 +1,54 @@
+/**
+ * @file bits.hpp
+ *
+ * @brief Portable bit manipulation helpers.
+ */
+
+#pragma once
+
+#include <cstdint>  // for std::uint64_t
+
+#if defined(_MSC_VER)
+#include <intrin.h>  // for __popcnt64, _BitScanForward64
+#endif
+
+namespace core::bits {
+
+/**
+ * @brief Count the set bits of a 64-bit word.
+ *
+ * @param value Word to count (e.g., "0b1011").
+ *
+ * @return Number of set bits (e.g., "3").
+ */
+[[nodiscard]] inline unsigned int popcount(const std::uint64_t value)
+{
+#if defined(_MSC_VER)
+    return static_cast<unsigned int>(__popcnt64(value));
+#else
+    return static_cast<unsigned int>(__builtin_popcountll(value));
+#endif
+}
+
+/**
+ * @brief Count the trailing zero bits of a 64-bit word.
+ *
+ * @param value Word to count (e.g., "0b1000").
+ *
+ * @return Number of trailing zero bits (e.g., "3"), or 64 if the word is zero.
+ */
+[[nodiscard]] inline unsigned int countr_zero(const std::uint64_t value)
+{
+    if (value == 0) {
+        return 64;
+    }
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctzll(value));
+#endif
+}
+
+}  // namespace core::bits
@@ -0,0 +1,329 @@
+/**
+ * @file csv.cpp
+ */
+
+#include <array>        // for std::array
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t
+#include <cstring>      // for std::memcpy
+#include <limits>       // for std::numeric_limits
+#include <stdexcept>    // for std::runtime_error
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <utility>      // for std::pair
+#include <vector>       // for std::vector
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>  // for SSE2 intrinsics
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>  // for NEON intrinsics
+#endif
+
+#include <fmt/core.h>
+
+#include "bits.hpp"
+#include "csv.hpp"
+
+namespace core::csv {
+
+namespace {
+
+/**
+ * @brief Private helper function to find the next byte that is one of three ASCII characters or not ASCII.
+ *
+ * @param data Bytes to scan.
+ * @param pos Offset to start at.
+ * @param size Number of bytes.
+ * @param a First character (e.g., the delimiter).
+ * @param b Second character (e.g., '\n').
+ * @param c Third character (e.g., '\r').
+ *
+ * @return Offset of the first such byte, or "size" if there is none.
+ */
+[[nodiscard]] std::size_t find_special(const unsigned char *data,
+                                       std::size_t pos,
+                                       const std::size_t size,
+                                       const unsigned char a,
+                                       const unsigned char b,
+                                       const unsigned char c)
+{
+    // The sign bit of each byte marks non-ASCII bytes, so one mask covers all four conditions
+#if defined(__x86_64__) || defined(_M_X64)
+    const __m128i va = _mm_set1_epi8(static_cast<char>(a));
+    const __m128i vb = _mm_set1_epi8(static_cast<char>(b));
+    const __m128i vc = _mm_set1_epi8(static_cast<char>(c));
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+        const __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, va), _mm_cmpeq_epi8(bytes, vb)), _mm_or_si128(_mm_cmpeq_epi8(bytes, vc), bytes));
+        if (const int mask = _mm_movemask_epi8(matches); mask != 0) {
+            return pos + core::bits::countr_zero(static_cast<std::uint64_t>(static_cast<unsigned int>(mask)));
+        }
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    const uint8x16_t va = vdupq_n_u8(a);
+    const uint8x16_t vb = vdupq_n_u8(b);
+    const uint8x16_t vc = vdupq_n_u8(c);
+    const uint8x16_t high = vdupq_n_u8(0x80);
+    for (; pos + 16 <= size; pos += 16) {
+        const uint8x16_t bytes = vld1q_u8(data + pos);
+        const uint8x16_t matches = vorrq_u8(vorrq_u8(vceqq_u8(bytes, va), vceqq_u8(bytes, vb)), vorrq_u8(vceqq_u8(bytes, vc), vcgeq_u8(bytes, high)));
+        if (vmaxvq_u8(matches) != 0) {
+            break;
+        }
+    }
+#endif
+    for (; pos < size; ++pos) {
+        const unsigned char byte = data[pos];
+        if (byte == a || byte == b || byte == c || byte >= 0x80) {
+            return pos;
+        }
+    }
+    return size;
+}
+
+/**
+ * @brief Private helper function to skip a run of valid multi-byte UTF-8 sequences.
+ *
+ * @param data Bytes to scan.
+ * @param pos Offset of a non-ASCII byte.
+ * @param size Number of bytes.
+ *
+ * @return Offset of the first ASCII byte after the run, or of the first invalid sequence, which is "pos" if the run starts with one.
+ */
+[[nodiscard]] std::size_t skip_utf8(const unsigned char *data,
+                                    std::size_t pos,
+                                    const std::size_t size)
+{
+    // The allowed range of the second byte excludes overlong forms, surrogates and code points past U+10FFFF (RFC 3629)
+    while (pos < size && data[pos] >= 0x80) {
+        const unsigned char lead = data[pos];
+        std::size_t length = 0;
+        unsigned char low = 0x80;
+        unsigned char high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            length = 2;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF) {
+            length = 3;
+            low = lead == 0xE0 ? 0xA0 : low;
+            high = lead == 0xED ? 0x9F : high;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4) {
+            length = 4;
+            low = lead == 0xF0 ? 0x90 : low;
+            high = lead == 0xF4 ? 0x8F : high;
+        }
+        else {
+            return pos;
+        }
+        if (pos + length > size || data[pos + 1] < low || data[pos + 1] > high) {
+            return pos;
+        }
+        for (std::size_t idx = 2; idx < length; ++idx) {
+            if ((data[pos + idx] & 0xC0) != 0x80) {
+                return pos;
+            }
+        }
+        pos += length;
+    }
+    return pos;
+}
+
+/**
+ * @brief Private helper function to skip a line.
+ *
+ * @param text Text.
+ * @param pos Offset within the line.
+ *
+ * @return Offset of the next line, or the size of the text.
+ */
+[[nodiscard]] inline std::size_t skip_line(const std::string_view text,
+                                           const std::size_t pos)
+{
+    const std::size_t end = text.find('\n', pos);
+    return end == std::string_view::npos ? text.size() : end + 1;
+}
+
+}  // namespace
+
+char detect_delimiter(const std::string_view text)
+{
+    std::size_t pos = text.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+    while (pos < text.size() && text[pos] == '#') {
+        const std::size_t end = skip_line(text, pos);
+        std::string_view line = text.substr(pos, end - pos);
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+            line.remove_suffix(1);
+        }
+        constexpr std::array<std::pair<std::string_view, char>, 6> separators = {{{"tab", '\t'}, {"comma", ','}, {"semicolon", ';'}, {"pipe", '|'}, {"colon", ':'}, {"space", ' '}}};
+        for (const auto &[name, separator] : separators) {
+            if (line.size() == 11 + name.size() && line.compare(0, 11, "#separator:") == 0 && line.compare(11, name.size(), name) == 0) {
+                return separator;
+            }
+        }
+        pos = end;
+    }
+
+    // Otherwise, count the candidates on the first line
+    const std::string_view line = text.substr(pos, skip_line(text, pos) - pos);
+    char best = ',';
+    std::size_t best_count = 0;
+    for (const char candidate : {'\t', ',', ';', '|'}) {
+        std::size_t count = 0;
+        for (const char c : line) {
+            count += c == candidate ? 1 : 0;
+        }
+        if (count > best_count) {
+            best = candidate;
+            best_count = count;
+        }
+    }
+    return best;
+}
+
+Table::Table(const std::string_view text,
+             const char delimiter)
+    : chars_(),
+      fields_(),
+      rows_(1, 0),
+      lines_()
+{
+    if (static_cast<unsigned char>(delimiter) >= 0x80 || delimiter == '"' || delimiter == '\r' || delimiter == '\n') {
+        throw std::runtime_error(fmt::format("Invalid delimiter '{}', expected an ASCII character other than a quote or a line break", delimiter));
+    }
+    if (text.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error(fmt::format("The text is {} bytes, but at most 4 GiB are supported", text.size()));
+    }
+    const auto *data = reinterpret_cast<const unsigned char *>(text.data());
+    const std::size_t size = text.size();
+    const auto separator = static_cast<unsigned char>(delimiter);
+
+    // Skip a byte order mark and the header lines of Anki exports
+    std::size_t pos = text.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+    std::size_t line = 1;
+    while (pos < size && data[pos] == '#') {
+        pos = skip_line(text, pos);
+        ++line;
+    }
+
+    // Unescaped fields are never longer than the text, so the arena is sized once and written through a pointer
+    this->chars_.resize(size - pos);
+    char *const arena = this->chars_.data();
+    std::size_t length = 0;
+    const auto copy = [data, arena, &length](const std::size_t begin,
+                                             const std::size_t end) {
+        std::memcpy(arena + length, data + begin, end - begin);
+        length += end - begin;
+    };
+    const auto fail_utf8 = [&line]() {
+        throw std::runtime_error(fmt::format("Invalid UTF-8 on line {}", line));
+    };
+
+    while (pos < size) {
+        const std::size_t row_line = line;
+        bool quoted = false;
+        for (;;) {
+            const std::size_t field_begin = length;
+
+            // A quoted field runs to the next quote that is not doubled, across delimiters and line breaks
+            quoted = pos < size && data[pos] == '"';
+            if (quoted) {
+                ++pos;
+                for (;;) {
+                    const std::size_t next = find_special(data, pos, size, '"', '\n', '"');
+                    copy(pos, next);
+                    pos = next;
+                    if (pos == size) {
+                        throw std::runtime_error(fmt::format("Unterminated quoted field on line {}", row_line));
+                    }
+                    if (data[pos] == '"') {
+                        if (pos + 1 < size && data[pos + 1] == '"') {
+                            arena[length++] = '"';
+                            pos += 2;
+                            continue;
+                        }
+                        ++pos;
+                        break;
+                    }
+                    if (data[pos] == '\n') {
+                        arena[length++] = '\n';
+                        ++pos;
+                        ++line;
+                        continue;
+                    }
+                    const std::size_t end = skip_utf8(data, pos, size);
+                    if (end == pos) {
+                        fail_utf8();
+                    }
+                    copy(pos, end);
+                    pos = end;
+                }
+            }
+
+            // The rest of the field (all of it, unless quoted) runs to the next delimiter or line break
+            for (;;) {
+                const std::size_t next = find_special(data, pos, size, separator, '\n', '\r');
+                copy(pos, next);
+                pos = next;
+                if (pos == size || data[pos] < 0x80) {
+                    break;
+                }
+                const std::size_t end = skip_utf8(data, pos, size);
+                if (end == pos) {
+                    fail_utf8();
+                }
+                copy(pos, end);
+                pos = end;
+            }
+            this->fields_.push_back({static_cast<std::uint32_t>(field_begin), static_cast<std::uint32_t>(length - field_begin)});
+            if (pos < size && data[pos] == separator) {
+                ++pos;
+                continue;
+            }
+            break;
+        }
+
+        // The row ends with a line break or the end of the text; blank lines are dropped
+        if (pos < size && data[pos] == '\r') {
+            ++pos;
+        }
+        if (pos < size && data[pos] == '\n') {
+            ++pos;
+        }
+        ++line;
+        if (!quoted && this->fields_.size() - this->rows_.back() == 1 && this->fields_.back().length == 0) {
+            this->fields_.pop_back();
+            continue;
+        }
+        this->rows_.emplace_back(static_cast<std::uint32_t>(this->fields_.size()));
+        this->lines_.emplace_back(static_cast<std::uint32_t>(row_line));
+    }
+    this->chars_.resize(length);
+}
+
+std::size_t Table::get_num_rows() const
+{
+    return this->lines_.size();
+}
+
+std::size_t Table::get_num_fields(const std::size_t row) const
+{
+    return row < this->lines_.size() ? this->rows_[row + 1] - this->rows_[row] : 0;
+}
+
+std::string_view Table::get_field(const std::size_t row,
+                                  const std::size_t column) const
+{
+    if (column >= this->get_num_fields(row)) {
+        return {};
+    }
+    const Field &field = this->fields_[this->rows_[row] + column];
+    return std::string_view(this->chars_.data() + field.offset, field.length);
+}
+
+std::size_t Table::get_line(const std::size_t row) const
+{
+    return row < this->lines_.size() ? this->lines_[row] : 0;
+}
+
+}  // namespace core::csv
@@ -0,0 +1,123 @@
+/**
+ * @file csv.hpp
+ *
+ * @brief Parse CSV and TSV text (e.g., spreadsheet or Anki exports) into an arena.
+ */
+
+#pragma once
+
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
+
+namespace core::csv {
+
+/**
+ * @brief Detect the delimiter of CSV or TSV text.
+ *
+ * An Anki "#separator:" header line wins (e.g., "#separator:tab"); otherwise, the most frequent of tab, comma, semicolon and pipe on the first line is used.
+ *
+ * @param text Text to inspect (e.g., "ㅏ\ta\n").
+ *
+ * @return Delimiter (e.g., '\t'), or ',' if none of them appears.
+ */
+[[nodiscard]] char detect_delimiter(const std::string_view text);
+
+/**
+ * @brief Class that represents a table of text fields parsed from CSV or TSV text.
+ *
+ * Parsing scans for the delimiter, line breaks and non-ASCII bytes 16 bytes at a time in SIMD registers (SSE2 on x86-64, NEON on ARM64), and copies the runs in between in one go.
+ * Every field is unescaped into a single arena, so a table of a million fields makes a handful of allocations rather than a million strings.
+ *
+ * The format follows RFC 4180, leniently:
+ * - A field that starts with '"' is quoted: it may contain the delimiter and line breaks, and '""' is a literal quote; text after the closing quote is kept.
+ * - A quote anywhere else is a literal character.
+ * - Rows end with "\n", "\r\n" or "\r", and may have different numbers of fields.
+ * - A byte order mark, leading "#" lines (e.g., Anki's "#separator:tab" header) and blank lines are skipped.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Table final {
+  public:
+    /**
+     * @brief Construct a new Table object by parsing text. This is O(size of the text).
+     *
+     * @param text CSV or TSV text, which must be valid UTF-8 (e.g., "ㅏ,a,\"looks like an 'a'\"\n").
+     * @param delimiter Field delimiter: an ASCII character other than '"', '\r' and '\n' (e.g., ',' or '\t').
+     *
+     * @throws std::runtime_error if the delimiter is not allowed, the text is not valid UTF-8, a quoted field is not closed, or the text is larger than 4 GiB, with the line of the error.
+     */
+    explicit Table(const std::string_view text,
+                   const char delimiter);
+
+    /**
+     * @brief Get the number of rows.
+     *
+     * @return Number of rows (e.g., "40").
+     */
+    [[nodiscard]] std::size_t get_num_rows() const;
+
+    /**
+     * @brief Get the number of fields of a row.
+     *
+     * @param row Index of the row (e.g., "0").
+     *
+     * @return Number of fields (e.g., "3"), or 0 if the row is out of range.
+     */
+    [[nodiscard]] std::size_t get_num_fields(const std::size_t row) const;
+
+    /**
+     * @brief Get a field, unescaped.
+     *
+     * @param row Index of the row (e.g., "0").
+     * @param column Index of the field within the row (e.g., "1").
+     *
+     * @return View into the arena of the table (e.g., "a"), or an empty view if the row or column is out of range.
+     */
+    [[nodiscard]] std::string_view get_field(const std::size_t row,
+                                             const std::size_t column) const;
+
+    /**
+     * @brief Get the line of the text that a row starts on, e.g., for error messages.
+     *
+     * @param row Index of the row (e.g., "0").
+     *
+     * @return One-based line number (e.g., "3"), or 0 if the row is out of range.
+     */
+    [[nodiscard]] std::size_t get_line(const std::size_t row) const;
+
+  private:
+    /**
+     * @brief Struct that represents the range of a field in the arena.
+     *
+     * @note This struct is marked as `final` to prevent inheritance.
+     */
+    struct Field final {
+        std::uint32_t offset;  // First byte in "chars_"
+        std::uint32_t length;  // Number of bytes
+    };
+
+    /**
+     * @brief Unescaped fields, one after another.
+     */
+    std::string chars_;
+
+    /**
+     * @brief Range of each field in "chars_", row after row.
+     */
+    std::vector<Field> fields_;
+
+    /**
+     * @brief Index of the first field of each row in "fields_", "get_num_rows() + 1" indices.
+     */
+    std::vector<std::uint32_t> rows_;
+
+    /**
+     * @brief One-based line of the text that each row starts on.
+     */
+    std::vector<std::uint32_t> lines_;
+};
+
+}  // namespace core::csv
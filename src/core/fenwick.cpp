@@ -0,0 +1,103 @@
+/**
+ * @file fenwick.cpp
+ */
+
+#include <algorithm>  // for std::max, std::min
+#include <cstddef>    // for std::size_t
+#include <vector>     // for std::vector
+
+#include "fenwick.hpp"
+
+namespace core::fenwick {
+
+FenwickTree::FenwickTree(const std::size_t size)
+    : weights_(size, 0.0),
+      nodes_(size + 1, 0.0),
+      num_changes_(0)
+{
+}
+
+void FenwickTree::set(const std::size_t item,
+                      const double weight)
+{
+    if (item >= this->weights_.size()) {
+        return;
+    }
+    const double clamped = std::max(weight, 0.0);
+    const double delta = clamped - this->weights_[item];
+    if (delta == 0.0) {
+        return;
+    }
+    this->weights_[item] = clamped;
+    if (++this->num_changes_ > this->weights_.size()) {
+        this->rebuild();
+        return;
+    }
+    for (std::size_t node = item + 1; node < this->nodes_.size(); node += node & (~node + 1)) {
+        this->nodes_[node] += delta;
+    }
+}
+
+double FenwickTree::get(const std::size_t item) const
+{
+    return item < this->weights_.size() ? this->weights_[item] : 0.0;
+}
+
+double FenwickTree::get_total() const
+{
+    double total = 0.0;
+    for (std::size_t node = this->weights_.size(); node > 0; node -= node & (~node + 1)) {
+        total += this->nodes_[node];
+    }
+    return total;
+}
+
+std::size_t FenwickTree::find(double point) const
+{
+    const std::size_t size = this->weights_.size();
+    if (size == 0) {
+        return 0;
+    }
+
+    // Descend from the largest power of two, skipping every node whose range ends at or before the point
+    std::size_t step = 1;
+    while (step * 2 <= size) {
+        step *= 2;
+    }
+    std::size_t position = 0;
+    for (; step > 0; step /= 2) {
+        if (const std::size_t next = position + step; next <= size && this->nodes_[next] <= point) {
+            position = next;
+            point -= this->nodes_[next];
+        }
+    }
+    return std::min(position, size - 1);
+}
+
+void FenwickTree::reserve(const std::size_t size)
+{
+    if (size > this->weights_.size()) {
+        this->weights_.resize(size, 0.0);
+        this->rebuild();
+    }
+}
+
+std::size_t FenwickTree::get_size() const
+{
+    return this->weights_.size();
+}
+
+void FenwickTree::rebuild()
+{
+    // Each node passes its sum on to its parent, which builds the tree in one linear pass
+    this->nodes_.assign(this->weights_.size() + 1, 0.0);
+    for (std::size_t node = 1; node < this->nodes_.size(); ++node) {
+        this->nodes_[node] += this->weights_[node - 1];
+        if (const std::size_t parent = node + (node & (~node + 1)); parent < this->nodes_.size()) {
+            this->nodes_[parent] += this->nodes_[node];
+        }
+    }
+    this->num_changes_ = 0;
+}
+
+}  // namespace core::fenwick
@@ -0,0 +1,103 @@
+/**
+ * @file fenwick.hpp
+ *
+ * @brief Fenwick tree of weights for weighted random picks.
+ */
+
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <vector>   // for std::vector
+
+namespace core::fenwick {
+
+/**
+ * @brief Class that keeps the prefix sums of a list of non-negative weights, so a weight can change and an item can be picked in proportion to its weight, both in O(log n).
+ *
+ * Each node of the tree (a binary indexed tree) holds the sum of a range of weights whose length is the lowest set bit of its index.
+ * Changing a weight adds the difference to the O(log n) nodes that cover it, which accumulates rounding errors, so the tree is rebuilt from the weights in O(n) after every n changes.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class FenwickTree final {
+  public:
+    /**
+     * @brief Construct a new FenwickTree object where every weight is zero.
+     *
+     * @param size Number of items, which are the integers in [0, size) (e.g., "40").
+     */
+    explicit FenwickTree(const std::size_t size);
+
+    /**
+     * @brief Set the weight of an item. This is O(log n).
+     *
+     * @param item Item (e.g., "3"); items out of range are ignored.
+     * @param weight Weight of the item (e.g., "0.75"); negative weights count as zero.
+     */
+    void set(const std::size_t item,
+             const double weight);
+
+    /**
+     * @brief Get the weight of an item. This is O(1).
+     *
+     * @param item Item (e.g., "3").
+     *
+     * @return Weight of the item, or 0.0 if the item is out of range.
+     */
+    [[nodiscard]] double get(const std::size_t item) const;
+
+    /**
+     * @brief Get the sum of all weights. This is O(log n).
+     *
+     * @return Sum of the weights (e.g., "12.5").
+     */
+    [[nodiscard]] double get_total() const;
+
+    /**
+     * @brief Find the item where the running sum of the weights first exceeds a point, descending the tree once. This is O(log n).
+     *
+     * Drawing the point uniformly from [0, total) picks each item with a probability proportional to its weight.
+     *
+     * @param point Point between 0.0 and the total weight (e.g., "7.3").
+     *
+     * @return Item (e.g., "9"); if rounding leaves the point past the total, the last item is returned.
+     */
+    [[nodiscard]] std::size_t find(double point) const;
+
+    /**
+     * @brief Raise the number of items, keeping the weights so far; new items weigh zero. This is O(n).
+     *
+     * @param size Number of items (e.g., "41"); a smaller number is ignored.
+     */
+    void reserve(const std::size_t size);
+
+    /**
+     * @brief Get the number of items.
+     *
+     * @return Number of items (e.g., "40").
+     */
+    [[nodiscard]] std::size_t get_size() const;
+
+  private:
+    /**
+     * @brief Rebuild every node from the weights in O(n), which discards the rounding errors of earlier changes.
+     */
+    void rebuild();
+
+    /**
+     * @brief Weight of each item.
+     */
+    std::vector<double> weights_;
+
+    /**
+     * @brief Nodes of the tree, indexed from 1; node i holds the sum of the weights of items [i - lowbit(i), i).
+     */
+    std::vector<double> nodes_;
+
+    /**
+     * @brief Number of weights changed since the last rebuild.
+     */
+    std::size_t num_changes_;
+};
+
+}  // namespace core::fenwick
@@ -0,0 +1,266 @@
+/**
+ * @file file.cpp
+ */
+
+#include <cerrno>        // for errno, EINTR, EWOULDBLOCK
+#include <cstddef>       // for std::size_t
+#include <cstdint>       // for std::uint8_t, std::intptr_t
+#include <cstdio>        // for std::FILE, std::fopen, std::fwrite, std::fflush, std::fclose
+#include <filesystem>    // for std::filesystem
+#include <optional>      // for std::optional, std::nullopt
+#include <stdexcept>     // for std::runtime_error
+#include <system_error>  // for std::error_code
+#include <utility>       // for std::exchange
+
+#include <fmt/core.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN  // Exclude rarely-used stuff from Windows headers
+#define NOMINMAX             // Prevent Windows headers from defining min and max macros
+#include <io.h>              // for _commit, _fileno
+#include <windows.h>         // for CreateFileW, CreateFileMappingW, MapViewOfFile, UnmapViewOfFile, LockFileEx, CloseHandle
+#else
+#include <fcntl.h>     // for open, O_RDONLY, O_RDWR, O_CREAT, O_CLOEXEC
+#include <sys/file.h>  // for flock, LOCK_EX, LOCK_NB
+#include <sys/mman.h>  // for mmap, munmap, PROT_READ, MAP_SHARED, MAP_FAILED
+#include <sys/stat.h>  // for fstat, struct stat
+#include <unistd.h>    // for close, fsync
+#endif
+
+#include "file.hpp"
+
+namespace core::file {
+
+MappedFile::MappedFile(const std::filesystem::path &path)
+    : data_(nullptr),
+      size_(0)
+{
+#if defined(_WIN32)
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(fmt::format("Failed to open '{}' for mapping: {}", path.string(), GetLastError()));
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        throw std::runtime_error(fmt::format("Failed to get size of '{}': {}", path.string(), GetLastError()));
+    }
+    if (file_size.QuadPart > 0) {
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            throw std::runtime_error(fmt::format("Failed to map '{}': {}", path.string(), GetLastError()));
+        }
+        const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        // The view keeps the mapping alive, so both handles can be closed right away
+        CloseHandle(mapping);
+        if (!view) {
+            CloseHandle(file);
+            throw std::runtime_error(fmt::format("Failed to map '{}': {}", path.string(), GetLastError()));
+        }
+        this->data_ = static_cast<const std::uint8_t *>(view);
+        this->size_ = static_cast<std::size_t>(file_size.QuadPart);
+    }
+    CloseHandle(file);
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(fmt::format("Failed to open '{}' for mapping", path.string()));
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error(fmt::format("Failed to get size of '{}'", path.string()));
+    }
+    if (info.st_size > 0) {
+        void *view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        if (view == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error(fmt::format("Failed to map '{}'", path.string()));
+        }
+        this->data_ = static_cast<const std::uint8_t *>(view);
+        this->size_ = static_cast<std::size_t>(info.st_size);
+    }
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    this->unmap();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0))
+{
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other) {
+        this->unmap();
+        this->data_ = std::exchange(other.data_, nullptr);
+        this->size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+const std::uint8_t *MappedFile::get_data() const
+{
+    return this->data_;
+}
+
+std::size_t MappedFile::get_size() const
+{
+    return this->size_;
+}
+
+void MappedFile::unmap()
+{
+    if (this->data_) {
+#if defined(_WIN32)
+        UnmapViewOfFile(this->data_);
+#else
+        munmap(const_cast<std::uint8_t *>(this->data_), this->size_);
+#endif
+        this->data_ = nullptr;
+        this->size_ = 0;
+    }
+}
+
+FileLock::FileLock(const std::filesystem::path &path)
+    : handle_(acquire(path, true))
+{
+}
+
+std::optional<FileLock> FileLock::try_lock(const std::filesystem::path &path)
+{
+    if (const std::intptr_t handle = acquire(path, false); handle != none) {
+        return FileLock(handle);
+    }
+    return std::nullopt;
+}
+
+FileLock::~FileLock()
+{
+    this->release();
+}
+
+FileLock::FileLock(FileLock &&other) noexcept
+    : handle_(std::exchange(other.handle_, none))
+{
+}
+
+FileLock &FileLock::operator=(FileLock &&other) noexcept
+{
+    if (this != &other) {
+        this->release();
+        this->handle_ = std::exchange(other.handle_, none);
+    }
+    return *this;
+}
+
+FileLock::FileLock(const std::intptr_t handle)
+    : handle_(handle)
+{
+}
+
+std::intptr_t FileLock::acquire(const std::filesystem::path &path,
+                                const bool wait)
+{
+#if defined(_WIN32)
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(fmt::format("Failed to open lock file '{}': {}", path.string(), GetLastError()));
+    }
+    OVERLAPPED overlapped{};
+    if (!LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK | (wait ? 0 : LOCKFILE_FAIL_IMMEDIATELY), 0, MAXDWORD, MAXDWORD, &overlapped)) {
+        const DWORD error = GetLastError();
+        CloseHandle(file);
+        if (error == ERROR_LOCK_VIOLATION) {
+            return none;
+        }
+        throw std::runtime_error(fmt::format("Failed to lock '{}': {}", path.string(), error));
+    }
+    return reinterpret_cast<std::intptr_t>(file);
+#else
+    const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error(fmt::format("Failed to open lock file '{}'", path.string()));
+    }
+    int result;
+    do {
+        result = flock(fd, LOCK_EX | (wait ? 0 : LOCK_NB));
+    } while (result != 0 && errno == EINTR);
+    if (result != 0) {
+        const bool is_held = errno == EWOULDBLOCK;
+        close(fd);
+        if (is_held) {
+            return none;
+        }
+        throw std::runtime_error(fmt::format("Failed to lock '{}'", path.string()));
+    }
+    return fd;
+#endif
+}
+
+void FileLock::release()
+{
+    // Closing the file releases the lock
+    if (this->handle_ != none) {
+#if defined(_WIN32)
+        CloseHandle(reinterpret_cast<HANDLE>(this->handle_));
+#else
+        close(static_cast<int>(this->handle_));
+#endif
+        this->handle_ = none;
+    }
+}
+
+bool sync(std::FILE *file)
+{
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+void write_atomically(const std::filesystem::path &path,
+                      const std::uint8_t *data,
+                      const std::size_t size)
+{
+    std::filesystem::path temp_path = path;
+    temp_path += ".tmp";
+
+    std::FILE *file = std::fopen(temp_path.string().c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error(fmt::format("Failed to create '{}'", temp_path.string()));
+    }
+    const bool ok = std::fwrite(data, 1, size, file) == size && sync(file);
+    std::fclose(file);
+    if (!ok) {
+        throw std::runtime_error(fmt::format("Failed to write '{}'", temp_path.string()));
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        throw std::runtime_error(fmt::format("Failed to rename '{}' to '{}': {}", temp_path.string(), path.string(), ec.message()));
+    }
+
+#if !defined(_WIN32)
+    // Sync the directory, so the rename itself survives a power loss
+    if (const int dir_fd = open(path.parent_path().empty() ? "." : path.parent_path().c_str(), O_RDONLY); dir_fd >= 0) {
+        static_cast<void>(fsync(dir_fd));
+        close(dir_fd);
+    }
+#endif
+}
+
+}  // namespace core::file
@@ -0,0 +1,205 @@
+/**
+ * @file file.hpp
+ *
+ * @brief Low-level file access: memory mapping, durable writes and locks.
+ */
+
+#pragma once
+
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::uint8_t, std::intptr_t
+#include <cstdio>      // for std::FILE
+#include <filesystem>  // for std::filesystem
+#include <optional>    // for std::optional
+
+namespace core::file {
+
+/**
+ * @brief Class that maps a whole file into memory for reading.
+ *
+ * The mapping is shared with the operating system's page cache, so loading is a matter of page faults rather than copying or parsing.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class MappedFile final {
+  public:
+    /**
+     * @brief Map a file into memory.
+     *
+     * @param path Path to the file (e.g., "~/.local/share/aegyo/snapshot.bin").
+     *
+     * @throws std::runtime_error If the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::filesystem::path &path);
+
+    /**
+     * @brief Unmap the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @brief Take over the mapping of another object, leaving it empty.
+     *
+     * @param other Object to move from.
+     */
+    MappedFile(MappedFile &&other) noexcept;
+
+    /**
+     * @brief Release the current mapping and take over the mapping of another object, leaving it empty.
+     *
+     * @param other Object to move from.
+     *
+     * @return Reference to this object.
+     */
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    /**
+     * @brief Get a pointer to the first byte of the mapped file.
+     *
+     * @return Pointer to the mapped bytes, or nullptr if the file is empty.
+     */
+    [[nodiscard]] const std::uint8_t *get_data() const;
+
+    /**
+     * @brief Get the size of the mapped file.
+     *
+     * @return Size in bytes (e.g., "4096").
+     */
+    [[nodiscard]] std::size_t get_size() const;
+
+  private:
+    /**
+     * @brief Release the mapping, if any.
+     */
+    void unmap();
+
+    /**
+     * @brief Pointer to the mapped bytes, or nullptr if nothing is mapped.
+     */
+    const std::uint8_t *data_;
+
+    /**
+     * @brief Size of the mapping in bytes.
+     */
+    std::size_t size_;
+};
+
+/**
+ * @brief Class that holds an exclusive lock on a lock file, so only one process at a time writes the files it guards.
+ *
+ * The lock is advisory (flock on POSIX, LockFileEx on Windows): it only excludes other holders of the same lock, and it is released when the object is destroyed or the process exits, even after a crash.
+ * Separate objects conflict even within one process.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class FileLock final {
+  public:
+    /**
+     * @brief Open or create a lock file and lock it, waiting until other holders release it.
+     *
+     * @param path Path to the lock file (e.g., "~/.local/share/aegyo/profiles/index.lock").
+     *
+     * @throws std::runtime_error If the file cannot be opened or locked.
+     */
+    explicit FileLock(const std::filesystem::path &path);
+
+    /**
+     * @brief Open or create a lock file and lock it, unless another holder has it.
+     *
+     * @param path Path to the lock file (e.g., "~/.local/share/aegyo/progress.lock").
+     *
+     * @return Lock, or std::nullopt if another holder (e.g., another instance of the app) has it.
+     *
+     * @throws std::runtime_error If the file cannot be opened or locked for another reason.
+     */
+    [[nodiscard]] static std::optional<FileLock> try_lock(const std::filesystem::path &path);
+
+    /**
+     * @brief Release the lock and close the lock file.
+     */
+    ~FileLock();
+
+    FileLock(const FileLock &) = delete;
+    FileLock &operator=(const FileLock &) = delete;
+
+    /**
+     * @brief Take over the lock of another object, leaving it empty.
+     *
+     * @param other Object to move from.
+     */
+    FileLock(FileLock &&other) noexcept;
+
+    /**
+     * @brief Release the current lock and take over the lock of another object, leaving it empty.
+     *
+     * @param other Object to move from.
+     *
+     * @return Reference to this object.
+     */
+    FileLock &operator=(FileLock &&other) noexcept;
+
+  private:
+    /**
+     * @brief Take over a locked handle.
+     *
+     * @param handle Handle of the locked file (a file descriptor on POSIX, a HANDLE on Windows).
+     */
+    explicit FileLock(const std::intptr_t handle);
+
+    /**
+     * @brief Open or create a lock file and lock it.
+     *
+     * @param path Path to the lock file.
+     * @param wait Whether to wait until other holders release the lock.
+     *
+     * @return Handle of the locked file, or "none" if another holder has the lock and "wait" is false.
+     *
+     * @throws std::runtime_error If the file cannot be opened or locked for another reason.
+     */
+    [[nodiscard]] static std::intptr_t acquire(const std::filesystem::path &path,
+                                               const bool wait);
+
+    /**
+     * @brief Release the lock, if any.
+     */
+    void release();
+
+    /**
+     * @brief Marker for an object that holds no lock.
+     */
+    static constexpr std::intptr_t none = -1;
+
+    /**
+     * @brief Handle of the locked file, or "none" if nothing is locked.
+     */
+    std::intptr_t handle_;
+};
+
+/**
+ * @brief Flush a file's buffers and sync its contents to the storage device.
+ *
+ * @param file File to sync.
+ *
+ * @return True if the sync succeeded, false otherwise.
+ */
+[[nodiscard]] bool sync(std::FILE *file);
+
+/**
+ * @brief Replace a file's contents atomically and durably.
+ *
+ * The data is written to a temporary file next to the target, synced, and renamed over the target, so readers see either the old or the new contents, even after a crash.
+ *
+ * @param path Path to the target file (e.g., "~/.local/share/aegyo/snapshot.bin").
+ * @param data Pointer to the bytes to write.
+ * @param size Number of bytes to write.
+ *
+ * @throws std::runtime_error If the file cannot be written, synced or renamed.
+ */
+void write_atomically(const std::filesystem::path &path,
+                      const std::uint8_t *data,
+                      const std::size_t size);
+
+}  // namespace core::file
@@ -0,0 +1,279 @@
+/**
+ * @file hangul.cpp
+ */
+
+#include <array>        // for std::array
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint8_t, std::uint32_t
+#include <string>       // for std::u32string
+#include <string_view>  // for std::u32string_view
+
+#include "hangul.hpp"
+
+namespace core::hangul {
+
+namespace {
+
+/**
+ * @brief Private first Hangul Compatibility Jamo, "ㄱ" (U+3131).
+ */
+constexpr char32_t first_jamo = U'ㄱ';
+
+/**
+ * @brief Private number of Hangul Compatibility Jamo from "ㄱ" (U+3131) to "ㅣ" (U+3163).
+ */
+constexpr std::size_t num_jamo = 51;
+
+/**
+ * @brief Private first precomposed syllable, "가" (U+AC00).
+ */
+constexpr char32_t first_syllable = U'가';
+
+/**
+ * @brief Private marker for a missing jamo or table entry.
+ */
+constexpr std::uint8_t none = 0xFF;
+
+/**
+ * @brief Private initial consonants in Unicode syllable order.
+ */
+constexpr std::array<char32_t, 19> initials = {
+    U'ㄱ', U'ㄲ', U'ㄴ', U'ㄷ', U'ㄸ', U'ㄹ', U'ㅁ', U'ㅂ', U'ㅃ', U'ㅅ', U'ㅆ', U'ㅇ', U'ㅈ', U'ㅉ', U'ㅊ', U'ㅋ', U'ㅌ', U'ㅍ', U'ㅎ'};
+
+/**
+ * @brief Private final consonants in Unicode syllable order, where index 0 is "no final".
+ */
+constexpr std::array<char32_t, 28> finals = {
+    0, U'ㄱ', U'ㄲ', U'ㄳ', U'ㄴ', U'ㄵ', U'ㄶ', U'ㄷ', U'ㄹ', U'ㄺ', U'ㄻ', U'ㄼ', U'ㄽ', U'ㄾ',
+    U'ㄿ', U'ㅀ', U'ㅁ', U'ㅂ', U'ㅄ', U'ㅅ', U'ㅆ', U'ㅇ', U'ㅈ', U'ㅊ', U'ㅋ', U'ㅌ', U'ㅍ', U'ㅎ'};
+
+/**
+ * @brief Private compound vowels and double finals, each with the two jamo it is typed as.
+ */
+constexpr std::array<std::array<char32_t, 3>, 18> compounds = {{
+    {U'ㅘ', U'ㅗ', U'ㅏ'},
+    {U'ㅙ', U'ㅗ', U'ㅐ'},
+    {U'ㅚ', U'ㅗ', U'ㅣ'},
+    {U'ㅝ', U'ㅜ', U'ㅓ'},
+    {U'ㅞ', U'ㅜ', U'ㅔ'},
+    {U'ㅟ', U'ㅜ', U'ㅣ'},
+    {U'ㅢ', U'ㅡ', U'ㅣ'},
+    {U'ㄳ', U'ㄱ', U'ㅅ'},
+    {U'ㄵ', U'ㄴ', U'ㅈ'},
+    {U'ㄶ', U'ㄴ', U'ㅎ'},
+    {U'ㄺ', U'ㄹ', U'ㄱ'},
+    {U'ㄻ', U'ㄹ', U'ㅁ'},
+    {U'ㄼ', U'ㄹ', U'ㅂ'},
+    {U'ㄽ', U'ㄹ', U'ㅅ'},
+    {U'ㄾ', U'ㄹ', U'ㅌ'},
+    {U'ㄿ', U'ㄹ', U'ㅍ'},
+    {U'ㅀ', U'ㄹ', U'ㅎ'},
+    {U'ㅄ', U'ㅂ', U'ㅅ'},
+}};
+
+/**
+ * @brief Private lookup tables of the composer, indexed by jamo index from U+3131.
+ */
+struct Tables final {
+    std::array<std::uint8_t, num_jamo> initial_index;                  // Index among "initials", or "none"
+    std::array<std::uint8_t, num_jamo> medial_index;                   // Vowel index (0 for "ㅏ" to 20 for "ㅣ"), or "none"
+    std::array<std::uint8_t, num_jamo> final_index;                    // Index among "finals", or "none"
+    std::array<std::array<std::uint8_t, num_jamo>, num_jamo> combine;  // Jamo that two jamo combine into, or "none"
+    std::array<std::array<std::uint8_t, 2>, num_jamo> split;           // Two jamo of a compound, or "none"
+};
+
+/**
+ * @brief Private helper function to build the lookup tables at compile time.
+ *
+ * @return Lookup tables.
+ */
+[[nodiscard]] constexpr Tables make_tables()
+{
+    Tables tables{};
+    for (std::size_t idx = 0; idx < num_jamo; ++idx) {
+        tables.initial_index[idx] = none;
+        tables.medial_index[idx] = idx >= 30 ? static_cast<std::uint8_t>(idx - 30) : none;
+        tables.final_index[idx] = none;
+        tables.split[idx] = {none, none};
+        for (std::size_t jdx = 0; jdx < num_jamo; ++jdx) {
+            tables.combine[idx][jdx] = none;
+        }
+    }
+    for (std::size_t idx = 0; idx < initials.size(); ++idx) {
+        tables.initial_index[initials[idx] - first_jamo] = static_cast<std::uint8_t>(idx);
+    }
+    for (std::size_t idx = 1; idx < finals.size(); ++idx) {
+        tables.final_index[finals[idx] - first_jamo] = static_cast<std::uint8_t>(idx);
+    }
+    for (const auto &[compound, first, second] : compounds) {
+        tables.combine[first - first_jamo][second - first_jamo] = static_cast<std::uint8_t>(compound - first_jamo);
+        tables.split[compound - first_jamo] = {static_cast<std::uint8_t>(first - first_jamo), static_cast<std::uint8_t>(second - first_jamo)};
+    }
+    return tables;
+}
+
+/**
+ * @brief Private lookup tables, built at compile time.
+ */
+constexpr Tables tables = make_tables();
+
+/**
+ * @brief Private 2-beolsik jamo of every ASCII key, or 0 for keys that do not type a jamo.
+ */
+constexpr std::array<char32_t, 128> dubeolsik = []() {
+    std::array<char32_t, 128> keys{};
+    constexpr std::array<char32_t, 26> lower = {
+        U'ㅁ', U'ㅠ', U'ㅊ', U'ㅇ', U'ㄷ', U'ㄹ', U'ㅎ', U'ㅗ', U'ㅑ', U'ㅓ', U'ㅏ', U'ㅣ', U'ㅡ',
+        U'ㅜ', U'ㅐ', U'ㅔ', U'ㅂ', U'ㄱ', U'ㄴ', U'ㅅ', U'ㅕ', U'ㅍ', U'ㅈ', U'ㅌ', U'ㅛ', U'ㅋ'};
+    for (std::size_t idx = 0; idx < lower.size(); ++idx) {
+        keys['a' + idx] = lower[idx];
+        keys['A' + idx] = lower[idx];
+    }
+    keys['Q'] = U'ㅃ';
+    keys['W'] = U'ㅉ';
+    keys['E'] = U'ㄸ';
+    keys['R'] = U'ㄲ';
+    keys['T'] = U'ㅆ';
+    keys['O'] = U'ㅒ';
+    keys['P'] = U'ㅖ';
+    return keys;
+}();
+
+}  // namespace
+
+Composer::Composer()
+    : initial_(none),
+      medial_(none),
+      final_(none)
+{
+}
+
+void Composer::push(const char32_t c,
+                    std::u32string &out)
+{
+    const std::uint32_t jamo = static_cast<std::uint32_t>(c - first_jamo);
+    if (c < first_jamo || jamo >= num_jamo) {
+        this->flush(out);
+        out.push_back(c);
+    }
+    else if (tables.medial_index[jamo] != none) {
+        this->push_vowel(static_cast<std::uint8_t>(jamo), out);
+    }
+    else {
+        this->push_consonant(static_cast<std::uint8_t>(jamo), out);
+    }
+}
+
+bool Composer::pop()
+{
+    // Compounds lose their second half first, as if typed as two jamo
+    if (this->final_ != none) {
+        this->final_ = tables.split[this->final_][0];
+    }
+    else if (this->medial_ != none) {
+        this->medial_ = tables.split[this->medial_][0];
+    }
+    else if (this->initial_ != none) {
+        this->initial_ = none;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+void Composer::flush(std::u32string &out)
+{
+    if (const char32_t preedit = this->get_preedit(); preedit != 0) {
+        out.push_back(preedit);
+    }
+    this->initial_ = none;
+    this->medial_ = none;
+    this->final_ = none;
+}
+
+char32_t Composer::get_preedit() const
+{
+    if (this->initial_ != none && this->medial_ != none) {
+        const std::uint32_t final_index = this->final_ != none ? tables.final_index[this->final_] : 0u;
+        return first_syllable + (static_cast<std::uint32_t>(tables.initial_index[this->initial_]) * 21 + tables.medial_index[this->medial_]) * 28 + final_index;
+    }
+    if (this->initial_ != none) {
+        return first_jamo + this->initial_;
+    }
+    if (this->medial_ != none) {
+        return first_jamo + this->medial_;
+    }
+    return 0;
+}
+
+void Composer::push_consonant(const std::uint8_t jamo,
+                              std::u32string &out)
+{
+    // A consonant after a full syllable becomes its final, or extends the final into a double final
+    if (this->initial_ != none && this->medial_ != none) {
+        if (this->final_ == none && tables.final_index[jamo] != none) {
+            this->final_ = jamo;
+            return;
+        }
+        if (this->final_ != none && tables.combine[this->final_][jamo] != none) {
+            this->final_ = tables.combine[this->final_][jamo];
+            return;
+        }
+    }
+
+    // Otherwise, it starts a new syllable, unless it can only be a final (e.g., "ㄳ")
+    this->flush(out);
+    if (tables.initial_index[jamo] != none) {
+        this->initial_ = jamo;
+    }
+    else {
+        out.push_back(first_jamo + jamo);
+    }
+}
+
+void Composer::push_vowel(const std::uint8_t jamo,
+                          std::u32string &out)
+{
+    // A vowel after a final takes it (or the second half of a double final) as the initial of a new syllable
+    if (this->final_ != none) {
+        std::uint8_t moved = this->final_;
+        this->final_ = none;
+        if (const auto &halves = tables.split[moved]; halves[0] != none) {
+            this->final_ = halves[0];
+            moved = halves[1];
+        }
+        this->flush(out);
+        this->initial_ = moved;
+        this->medial_ = jamo;
+        return;
+    }
+
+    // A vowel after a vowel extends it into a compound vowel, or starts a new syllable without an initial
+    if (this->medial_ != none) {
+        if (tables.combine[this->medial_][jamo] != none) {
+            this->medial_ = tables.combine[this->medial_][jamo];
+            return;
+        }
+        this->flush(out);
+    }
+    this->medial_ = jamo;
+}
+
+void compose(const std::u32string_view input,
+             std::u32string &out)
+{
+    Composer composer;
+    for (const char32_t c : input) {
+        composer.push(c, out);
+    }
+    composer.flush(out);
+}
+
+char32_t get_dubeolsik_jamo(const char key)
+{
+    const auto index = static_cast<unsigned char>(key);
+    return index < dubeolsik.size() ? dubeolsik[index] : 0;
+}
+
+}  // namespace core::hangul
@@ -0,0 +1,115 @@
+/**
+ * @file hangul.hpp
+ *
+ * @brief Composition of Hangul syllables from typed jamo.
+ */
+
+#pragma once
+
+#include <cstdint>      // for std::uint8_t
+#include <string>       // for std::u32string
+#include <string_view>  // for std::u32string_view
+
+namespace core::hangul {
+
+/**
+ * @brief Class that composes Hangul syllables from jamo typed one at a time, the way a 2-beolsik input method does.
+ *
+ * Jamo are Hangul Compatibility Jamo (U+3131 to U+3163), as in the vocabulary.
+ * The syllable being typed is kept as up to three jamo (initial, medial and final), and every keystroke is a few lookups into tables built at compile time: which jamo can be an initial, a medial or a final, which pairs combine into a compound vowel or double final (e.g., "ㅗ" and "ㅏ" into "ㅘ", or "ㄹ" and "ㄱ" into "ㄺ"), and how they split again.
+ * A vowel typed after a final moves the final (or the second half of a double final) to the next syllable, so "ㄷㅏㄹㄱㅣ" gives "달기".
+ * Finished syllables are precomposed (U+AC00 to U+D7A3), so typing is O(1) per keystroke and never allocates beyond the output.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Composer final {
+  public:
+    /**
+     * @brief Construct a new Composer object with nothing typed.
+     */
+    explicit Composer();
+
+    /**
+     * @brief Type one character.
+     *
+     * @param c Typed character; jamo are composed, and anything else finishes the current syllable and is passed through (e.g., U'ㅎ').
+     * @param out String that finished characters are appended to.
+     */
+    void push(const char32_t c,
+              std::u32string &out);
+
+    /**
+     * @brief Erase the last jamo of the syllable being typed (e.g., "환" becomes "화", then "호", then "ㅎ").
+     *
+     * @return True if a jamo was erased, false if no syllable is being typed, so the caller should erase a finished character instead.
+     */
+    bool pop();
+
+    /**
+     * @brief Finish the syllable being typed, if any.
+     *
+     * @param out String that the syllable is appended to.
+     */
+    void flush(std::u32string &out);
+
+    /**
+     * @brief Get the syllable being typed, as it should be displayed.
+     *
+     * @return Syllable or lone jamo (e.g., U'한'), or 0 if no syllable is being typed.
+     */
+    [[nodiscard]] char32_t get_preedit() const;
+
+  private:
+    /**
+     * @brief Private helper method to type a consonant.
+     *
+     * @param jamo Index of the consonant from U+3131 (e.g., "0" for "ㄱ").
+     * @param out String that finished characters are appended to.
+     */
+    void push_consonant(const std::uint8_t jamo,
+                        std::u32string &out);
+
+    /**
+     * @brief Private helper method to type a vowel.
+     *
+     * @param jamo Index of the vowel from U+3131 (e.g., "30" for "ㅏ").
+     * @param out String that finished characters are appended to.
+     */
+    void push_vowel(const std::uint8_t jamo,
+                    std::u32string &out);
+
+    /**
+     * @brief Initial consonant, as an index from U+3131, or "0xFF" if none.
+     */
+    std::uint8_t initial_;
+
+    /**
+     * @brief Medial vowel, as an index from U+3131, or "0xFF" if none.
+     */
+    std::uint8_t medial_;
+
+    /**
+     * @brief Final consonant, as an index from U+3131, or "0xFF" if none.
+     */
+    std::uint8_t final_;
+};
+
+/**
+ * @brief Compose a whole sequence of typed characters, e.g., to verify typed answers in bulk.
+ *
+ * @param input Typed characters (e.g., U"ㅎㅏㄴㄱㅡㄹ").
+ * @param out String that the composed text is appended to (e.g., U"한글"); reusing it across calls avoids allocations.
+ */
+void compose(const std::u32string_view input,
+             std::u32string &out);
+
+/**
+ * @brief Get the jamo that a key types on a 2-beolsik (standard Korean) keyboard.
+ *
+ * @param key ASCII key (e.g., 'g'); Shift gives the double consonants and "ㅒ" and "ㅖ" (e.g., 'R' for "ㄲ").
+ *
+ * @return Jamo (e.g., U'ㅎ'), or 0 if the key does not type a jamo.
+ */
+[[nodiscard]] char32_t get_dubeolsik_jamo(const char key);
+
+}  // namespace core::hangul
@@ -0,0 +1,252 @@
+/**
+ * @file normalization.cpp
+ */
+
+#include <algorithm>    // for std::min
+#include <array>        // for std::array
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t
+#include <cstring>      // for std::memcpy
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>  // for SSE2 intrinsics
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>  // for NEON intrinsics
+#endif
+
+#include "normalization.hpp"
+#include "utf8.hpp"
+
+namespace core::normalization {
+
+namespace {
+
+/**
+ * @brief Private first conjoining initial "ᄀ" (U+1100), vowel "ᅡ" (U+1161) and final "ᆨ" (U+11A8).
+ */
+constexpr char32_t first_initial = 0x1100;
+constexpr char32_t first_vowel = 0x1161;
+constexpr char32_t first_final = 0x11A8;
+
+/**
+ * @brief Private first compatibility jamo, "ㄱ" (U+3131), and first compatibility vowel, "ㅏ" (U+314F).
+ */
+constexpr char32_t first_jamo = U'ㄱ';
+constexpr char32_t first_jamo_vowel = U'ㅏ';
+
+/**
+ * @brief Private number of modern compatibility jamo, from "ㄱ" (U+3131) to "ㅣ" (U+3163).
+ */
+constexpr std::size_t num_jamo = 51;
+
+/**
+ * @brief Private compatibility jamo of the conjoining initials, in Unicode syllable order.
+ */
+constexpr std::array<char32_t, 19> initials = {
+    U'ㄱ', U'ㄲ', U'ㄴ', U'ㄷ', U'ㄸ', U'ㄹ', U'ㅁ', U'ㅂ', U'ㅃ', U'ㅅ', U'ㅆ', U'ㅇ', U'ㅈ', U'ㅉ', U'ㅊ', U'ㅋ', U'ㅌ', U'ㅍ', U'ㅎ'};
+
+/**
+ * @brief Private compatibility jamo of the conjoining finals, in Unicode syllable order.
+ */
+constexpr std::array<char32_t, 27> finals = {
+    U'ㄱ', U'ㄲ', U'ㄳ', U'ㄴ', U'ㄵ', U'ㄶ', U'ㄷ', U'ㄹ', U'ㄺ', U'ㄻ', U'ㄼ', U'ㄽ', U'ㄾ', U'ㄿ',
+    U'ㅀ', U'ㅁ', U'ㅂ', U'ㅄ', U'ㅅ', U'ㅆ', U'ㅇ', U'ㅈ', U'ㅊ', U'ㅋ', U'ㅌ', U'ㅍ', U'ㅎ'};
+
+/**
+ * @brief Private conjoining jamo of every compatibility jamo, indexed from "ㄱ" (U+3131): the initial if there is one, otherwise the final or the vowel.
+ */
+constexpr std::array<char32_t, num_jamo> conjoining = []() {
+    std::array<char32_t, num_jamo> table{};
+    for (std::size_t idx = 0; idx < finals.size(); ++idx) {
+        table[finals[idx] - first_jamo] = first_final + static_cast<char32_t>(idx);
+    }
+    for (std::size_t idx = 0; idx < initials.size(); ++idx) {
+        table[initials[idx] - first_jamo] = first_initial + static_cast<char32_t>(idx);
+    }
+    for (char32_t vowel = 0; vowel < 21; ++vowel) {
+        table[first_jamo_vowel - first_jamo + vowel] = first_vowel + vowel;
+    }
+    return table;
+}();
+
+/**
+ * @brief Private helper function to find the next byte within a range, which is where the next character that may need converting starts.
+ *
+ * @param data Bytes to search.
+ * @param size Number of bytes.
+ * @param first First byte of the range (e.g., "0xE1").
+ * @param last Last byte of the range (e.g., "0xE1").
+ *
+ * @return Offset of the first such byte, or "size" if there is none.
+ */
+[[nodiscard]] std::size_t find_lead(const unsigned char *data,
+                                    const std::size_t size,
+                                    const unsigned char first,
+                                    const unsigned char last)
+{
+    std::size_t pos = 0;
+
+    // A byte is in the range if its distance from "first" (wrapping around) is at most "last - first"; only the block with a match is scanned byte by byte
+#if defined(__x86_64__) || defined(_M_X64)
+    const __m128i low = _mm_set1_epi8(static_cast<char>(first));
+    const __m128i span = _mm_set1_epi8(static_cast<char>(last - first));
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i distance = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos)), low);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(distance, span), distance)) != 0) {
+            break;
+        }
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    const uint8x16_t low = vdupq_n_u8(first);
+    const uint8x16_t span = vdupq_n_u8(static_cast<std::uint8_t>(last - first));
+    for (; pos + 16 <= size; pos += 16) {
+        if (vmaxvq_u8(vcleq_u8(vsubq_u8(vld1q_u8(data + pos), low), span)) != 0) {
+            break;
+        }
+    }
+#endif
+    for (; pos < size; ++pos) {
+        if (static_cast<unsigned char>(data[pos] - first) <= static_cast<unsigned char>(last - first)) {
+            return pos;
+        }
+    }
+    return size;
+}
+
+}  // namespace
+
+void compose(const std::string_view text,
+             std::string &out)
+{
+    // Two conjoining jamo become one syllable and one becomes one compatibility jamo, all 3 bytes long, so the output never grows
+    const std::size_t start = out.size();
+    out.resize(start + text.size());
+    char *const begin = out.data() + start;
+    char *dst = begin;
+
+    // A conjoining initial is only written once it is known whether a vowel follows
+    const auto *in = reinterpret_cast<const unsigned char *>(text.data());
+    const std::size_t size = text.size();
+    char32_t initial = 0;
+    const auto flush = [&initial, &dst]() {
+        if (initial != 0) {
+            dst = utf8::encode3(initials[initial - first_initial], dst);
+            initial = 0;
+        }
+    };
+
+    std::size_t pos = 0;
+    while (pos < size) {
+        // Conjoining jamo are U+1100 to U+11FF, which all start with "E1 84" to "E1 87" in UTF-8; anything before the next "E1" is copied as is
+        if (initial == 0) {
+            const std::size_t length = find_lead(in + pos, size - pos, 0xE1, 0xE1);
+            std::memcpy(dst, in + pos, length);
+            dst += length;
+            pos += length;
+            if (pos == size) {
+                break;
+            }
+        }
+
+        const char32_t c = utf8::decode3(in + pos, size - pos);
+        if (c >= first_initial && c < first_initial + initials.size()) {
+            flush();
+            initial = c;
+        }
+        else if (c >= first_vowel && c < first_vowel + 21) {
+            if (initial != 0) {
+                dst = utf8::encode3(utf8::first_syllable + ((initial - first_initial) * 21 + (c - first_vowel)) * 28, dst);
+                initial = 0;
+            }
+            else {
+                dst = utf8::encode3(first_jamo_vowel + (c - first_vowel), dst);
+            }
+        }
+        else if (c >= first_final && c < first_final + finals.size()) {
+            // A final joins the syllable just written if it has none yet, whether it was precomposed or composed from conjoining jamo
+            const char32_t previous = initial == 0 && dst - begin >= 3 ? utf8::decode3(reinterpret_cast<const unsigned char *>(dst - 3), 3) : 0;
+            if (previous >= utf8::first_syllable && previous < utf8::first_syllable + utf8::num_syllables && (previous - utf8::first_syllable) % 28 == 0) {
+                dst = utf8::encode3(previous + (c - first_final) + 1, dst - 3);
+            }
+            else {
+                flush();
+                dst = utf8::encode3(finals[c - first_final], dst);
+            }
+        }
+        else {
+            // Anything else (including archaic conjoining jamo) is copied as is
+            flush();
+            const std::size_t length = c != 0 ? 3 : std::min(utf8::get_sequence_length(in[pos]), size - pos);
+            std::memcpy(dst, in + pos, length);
+            dst += length;
+            pos += length;
+            continue;
+        }
+        pos += 3;
+    }
+    flush();
+    out.resize(static_cast<std::size_t>(dst - out.data()));
+}
+
+std::string compose(const std::string_view text)
+{
+    std::string out;
+    compose(text, out);
+    return out;
+}
+
+void decompose(const std::string_view text,
+               std::string &out)
+{
+    // A syllable is 3 bytes and becomes at most three jamo of 3 bytes each
+    const std::size_t start = out.size();
+    out.resize(start + 3 * text.size());
+    char *dst = out.data() + start;
+
+    const auto *in = reinterpret_cast<const unsigned char *>(text.data());
+    const std::size_t size = text.size();
+    std::size_t pos = 0;
+    while (pos < size) {
+        // Compatibility jamo start with "E3" and syllables with "EA" to "ED" in UTF-8; anything before the next such byte is copied as is
+        const std::size_t length = find_lead(in + pos, size - pos, 0xE3, 0xED);
+        std::memcpy(dst, in + pos, length);
+        dst += length;
+        pos += length;
+        if (pos == size) {
+            break;
+        }
+
+        const char32_t c = utf8::decode3(in + pos, size - pos);
+        if (c >= utf8::first_syllable && c < utf8::first_syllable + utf8::num_syllables) {
+            const char32_t index = c - utf8::first_syllable;
+            dst = utf8::encode3(first_initial + index / 588, dst);
+            dst = utf8::encode3(first_vowel + (index / 28) % 21, dst);
+            if (index % 28 != 0) {
+                dst = utf8::encode3(first_final + index % 28 - 1, dst);
+            }
+            pos += 3;
+        }
+        else if (c >= first_jamo && c < first_jamo + num_jamo) {
+            dst = utf8::encode3(conjoining[c - first_jamo], dst);
+            pos += 3;
+        }
+        else {
+            const std::size_t skipped = c != 0 ? 3 : std::min(utf8::get_sequence_length(in[pos]), size - pos);
+            std::memcpy(dst, in + pos, skipped);
+            dst += skipped;
+            pos += skipped;
+        }
+    }
+    out.resize(static_cast<std::size_t>(dst - out.data()));
+}
+
+std::string decompose(const std::string_view text)
+{
+    std::string out;
+    decompose(text, out);
+    return out;
+}
+
+}  // namespace core::normalization
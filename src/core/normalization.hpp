@@ -0,0 +1,60 @@
+/**
+ * @file normalization.hpp
+ *
+ * @brief Normalize Hangul between compatibility jamo, conjoining jamo and syllables.
+ */
+
+#pragma once
+
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+
+namespace core::normalization {
+
+/**
+ * @brief Convert Hangul to the canonical form of the deck, appending the result to a string.
+ *
+ * The canonical form is the one the built-in deck is written in:
+ * - Conjoining jamo (U+1100 to U+11FF) compose into syllables, like in NFC, including a trailing final after a precomposed syllable (e.g., "ᄒ" "ᅡ" "ᆫ" gives "한", and "하" "ᆫ" gives "한").
+ * - A conjoining jamo that is not part of a syllable becomes its compatibility jamo (e.g., "ᅡ" gives "ㅏ").
+ * - Syllables and compatibility jamo (U+3131 to U+3163) are kept (e.g., "ㅎㅏ" stays "ㅎㅏ", as a deck means letters, not a syllable).
+ *
+ * Runs without conjoining jamo, which are most text, are found with SIMD and copied as is.
+ *
+ * @param text UTF-8 text (e.g., "ᄒ" "ᅡ" "ᆫ").
+ * @param out String that the composed text is appended to (e.g., "한"); it is never longer than the input.
+ */
+void compose(const std::string_view text,
+             std::string &out);
+
+/**
+ * @brief Convert Hangul to the canonical form of the deck.
+ *
+ * @param text UTF-8 text (e.g., "ᄒ" "ᅡ" "ᆫ").
+ *
+ * @return Composed text (e.g., "한").
+ */
+[[nodiscard]] std::string compose(const std::string_view text);
+
+/**
+ * @brief Convert syllables and compatibility jamo to conjoining jamo, like in NFD, appending the result to a string.
+ *
+ * Compatibility consonants become initials, except for those that can only be finals (e.g., "ㄳ").
+ * Runs without syllables or compatibility jamo are found with SIMD and copied as is.
+ *
+ * @param text UTF-8 text (e.g., "한").
+ * @param out String that the decomposed text is appended to (e.g., "ᄒ" "ᅡ" "ᆫ").
+ */
+void decompose(const std::string_view text,
+               std::string &out);
+
+/**
+ * @brief Convert syllables and compatibility jamo to conjoining jamo, like in NFD.
+ *
+ * @param text UTF-8 text (e.g., "한").
+ *
+ * @return Decomposed text (e.g., "ᄒ" "ᅡ" "ᆫ").
+ */
+[[nodiscard]] std::string decompose(const std::string_view text);
+
+}  // namespace core::normalization
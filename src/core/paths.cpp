@@ -0,0 +1,63 @@
+/**
+ * @file paths.cpp
+ */
+
+#include <cstdlib>       // for std::getenv
+#include <filesystem>    // for std::filesystem
+#include <stdexcept>     // for std::runtime_error
+#include <system_error>  // for std::error_code
+
+#include <fmt/core.h>
+
+#include "paths.hpp"
+
+namespace core::paths {
+
+namespace {
+
+/**
+ * @brief Private helper function to get the platform-specific base directory for application data.
+ *
+ * @return Path to the base directory (e.g., "/home/user/.local/share").
+ *
+ * @throws std::runtime_error If the required environment variable is not set.
+ */
+[[nodiscard]] std::filesystem::path get_base_directory()
+{
+#if defined(_WIN32)
+    if (const char *appdata = std::getenv("APPDATA"); appdata && *appdata) {
+        return std::filesystem::path(appdata);
+    }
+    throw std::runtime_error("Failed to determine data directory: 'APPDATA' is not set");
+#else
+#if !defined(__APPLE__)
+    if (const char *xdg_data_home = std::getenv("XDG_DATA_HOME"); xdg_data_home && *xdg_data_home) {
+        return std::filesystem::path(xdg_data_home);
+    }
+#endif
+    const char *home = std::getenv("HOME");
+    if (!home || !*home) {
+        throw std::runtime_error("Failed to determine data directory: 'HOME' is not set");
+    }
+#if defined(__APPLE__)
+    return std::filesystem::path(home) / "Library" / "Application Support";
+#else
+    return std::filesystem::path(home) / ".local" / "share";
+#endif
+#endif
+}
+
+}  // namespace
+
+std::filesystem::path get_data_directory()
+{
+    const std::filesystem::path directory = get_base_directory() / "aegyo";
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        throw std::runtime_error(fmt::format("Failed to create data directory '{}': {}", directory.string(), ec.message()));
+    }
+    return directory;
+}
+
+}  // namespace core::paths
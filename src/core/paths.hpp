@@ -0,0 +1,26 @@
+/**
+ * @file paths.hpp
+ *
+ * @brief Locate platform-specific directories.
+ */
+
+#pragma once
+
+#include <filesystem>  // for std::filesystem
+
+namespace core::paths {
+
+/**
+ * @brief Get the directory where the application stores persistent data, creating it if it does not exist.
+ *
+ * On macOS, this is "~/Library/Application Support/aegyo".
+ * On Windows, this is "%APPDATA%\aegyo".
+ * On GNU/Linux, this is "$XDG_DATA_HOME/aegyo" (or "~/.local/share/aegyo" if "XDG_DATA_HOME" is not set).
+ *
+ * @return Path to the data directory (e.g., "/home/user/.local/share/aegyo").
+ *
+ * @throws std::runtime_error If the base directory cannot be determined or the data directory cannot be created.
+ */
+[[nodiscard]] std::filesystem::path get_data_directory();
+
+}  // namespace core::paths
@@ -0,0 +1,204 @@
+/**
+ * @file perfect_hash.cpp
+ */
+
+#include <algorithm>    // for std::sort, std::max, std::find
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t, std::uint64_t
+#include <optional>     // for std::optional, std::nullopt
+#include <stdexcept>    // for std::runtime_error
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
+
+#include <fmt/core.h>
+
+#include "perfect_hash.hpp"
+
+namespace core::perfect_hash {
+
+namespace {
+
+/**
+ * @brief Private average number of keys per bucket; larger buckets use less memory but take longer to place.
+ */
+constexpr std::size_t keys_per_bucket = 3;
+
+/**
+ * @brief Private number of seeds tried per bucket before giving up.
+ */
+constexpr std::uint32_t max_seed = 1u << 24;
+
+/**
+ * @brief Private helper function to hash a key with 64-bit FNV-1a and a SplitMix64 finalizer.
+ *
+ * @param key Key to hash (e.g., "ㄴ").
+ *
+ * @return Hash of the key.
+ */
+[[nodiscard]] inline std::uint64_t hash_key(const std::string_view key)
+{
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    for (const char c : key) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ULL;
+    }
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 31);
+}
+
+/**
+ * @brief Private helper function to map 32 bits of a hash to [0, n) with a multiplication instead of a division.
+ *
+ * @param bits Bits of a hash.
+ * @param n Size of the range (e.g., "10").
+ *
+ * @return Number in [0, n).
+ */
+[[nodiscard]] inline std::uint32_t reduce(const std::uint32_t bits,
+                                          const std::size_t n)
+{
+    return static_cast<std::uint32_t>((static_cast<std::uint64_t>(bits) * n) >> 32);
+}
+
+/**
+ * @brief Private helper function to get the bucket of a key from its hash.
+ *
+ * @param hash Hash of the key.
+ * @param num_buckets Number of buckets.
+ *
+ * @return Bucket of the key.
+ */
+[[nodiscard]] inline std::uint32_t get_bucket(const std::uint64_t hash,
+                                              const std::size_t num_buckets)
+{
+    return reduce(static_cast<std::uint32_t>(hash), num_buckets);
+}
+
+/**
+ * @brief Private helper function to get the slot of a key from its hash and the seed of its bucket.
+ *
+ * @param hash Hash of the key.
+ * @param seed Seed of the bucket of the key.
+ * @param num_slots Number of slots.
+ *
+ * @return Slot of the key.
+ */
+[[nodiscard]] inline std::uint32_t get_slot(const std::uint64_t hash,
+                                            const std::uint32_t seed,
+                                            const std::size_t num_slots)
+{
+    std::uint64_t mixed = (hash >> 32) ^ (static_cast<std::uint64_t>(seed) * 0x9E3779B97F4A7C15ULL);
+    mixed = (mixed ^ (mixed >> 33)) * 0xFF51AFD7ED558CCDULL;
+    return reduce(static_cast<std::uint32_t>(mixed >> 32), num_slots);
+}
+
+}  // namespace
+
+PerfectHash::PerfectHash()
+    : seeds_(),
+      indices_(),
+      offsets_(1, 0),
+      chars_()
+{
+}
+
+PerfectHash::PerfectHash(const std::vector<std::string_view> &keys)
+    : seeds_(),
+      indices_(),
+      offsets_(),
+      chars_()
+{
+    // Hash every key once, and group the keys by bucket
+    const std::size_t num_slots = keys.size();
+    const std::size_t num_buckets = std::max<std::size_t>(1, num_slots / keys_per_bucket);
+    std::vector<std::uint64_t> hashes(num_slots);
+    std::vector<std::vector<std::uint32_t>> buckets(num_buckets);
+    for (std::size_t idx = 0; idx < num_slots; ++idx) {
+        hashes[idx] = hash_key(keys[idx]);
+        buckets[get_bucket(hashes[idx], num_buckets)].emplace_back(static_cast<std::uint32_t>(idx));
+    }
+
+    // Keys with the same hash can never be told apart, which for distinct keys is all but impossible with 64 bits
+    for (const auto &bucket : buckets) {
+        for (std::size_t idx = 0; idx < bucket.size(); ++idx) {
+            for (std::size_t jdx = idx + 1; jdx < bucket.size(); ++jdx) {
+                if (hashes[bucket[idx]] == hashes[bucket[jdx]]) {
+                    throw std::runtime_error(keys[bucket[idx]] == keys[bucket[jdx]]
+                                                 ? fmt::format("Duplicate key '{}'", keys[bucket[idx]])
+                                                 : fmt::format("Keys '{}' and '{}' have the same hash", keys[bucket[idx]], keys[bucket[jdx]]));
+                }
+            }
+        }
+    }
+
+    // Place the largest buckets first, while most slots are still free
+    std::vector<std::uint32_t> order(num_buckets);
+    for (std::size_t idx = 0; idx < num_buckets; ++idx) {
+        order[idx] = static_cast<std::uint32_t>(idx);
+    }
+    std::sort(order.begin(), order.end(), [&buckets](const std::uint32_t lhs, const std::uint32_t rhs) {
+        return buckets[lhs].size() != buckets[rhs].size() ? buckets[lhs].size() > buckets[rhs].size() : lhs < rhs;
+    });
+
+    // Find a seed for each bucket that sends all of its keys to distinct free slots
+    constexpr std::uint32_t free_slot = 0xFFFFFFFFu;
+    this->seeds_.assign(num_buckets, 0);
+    this->indices_.assign(num_slots, free_slot);
+    std::vector<std::uint32_t> slots;
+    for (const std::uint32_t bucket : order) {
+        if (buckets[bucket].empty()) {
+            break;
+        }
+        std::uint32_t seed = 0;
+        for (;; ++seed) {
+            if (seed == max_seed) {
+                throw std::runtime_error(fmt::format("Could not place a bucket of {} keys", buckets[bucket].size()));
+            }
+            slots.clear();
+            for (const std::uint32_t key : buckets[bucket]) {
+                const std::uint32_t slot = get_slot(hashes[key], seed, num_slots);
+                if (this->indices_[slot] != free_slot || std::find(slots.cbegin(), slots.cend(), slot) != slots.cend()) {
+                    break;
+                }
+                slots.emplace_back(slot);
+            }
+            if (slots.size() == buckets[bucket].size()) {
+                break;
+            }
+        }
+        this->seeds_[bucket] = seed;
+        for (std::size_t idx = 0; idx < slots.size(); ++idx) {
+            this->indices_[slots[idx]] = buckets[bucket][idx];
+        }
+    }
+
+    // Store the keys in slot order, so a lookup reads one contiguous key
+    this->offsets_.reserve(num_slots + 1);
+    this->offsets_.emplace_back(0);
+    for (const std::uint32_t index : this->indices_) {
+        this->chars_ += keys[index];
+        this->offsets_.emplace_back(static_cast<std::uint32_t>(this->chars_.size()));
+    }
+}
+
+std::optional<std::uint32_t> PerfectHash::find(const std::string_view key) const
+{
+    if (this->indices_.empty()) {
+        return std::nullopt;
+    }
+    const std::uint64_t hash = hash_key(key);
+    const std::uint32_t slot = get_slot(hash, this->seeds_[get_bucket(hash, this->seeds_.size())], this->indices_.size());
+    const std::uint32_t begin = this->offsets_[slot];
+    if (std::string_view(this->chars_.data() + begin, this->offsets_[slot + 1] - begin) != key) {
+        return std::nullopt;
+    }
+    return this->indices_[slot];
+}
+
+std::size_t PerfectHash::get_num_keys() const
+{
+    return this->indices_.size();
+}
+
+}  // namespace core::perfect_hash
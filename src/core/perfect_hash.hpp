@@ -0,0 +1,80 @@
+/**
+ * @file perfect_hash.hpp
+ *
+ * @brief Minimal perfect hash of a fixed set of strings.
+ */
+
+#pragma once
+
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t
+#include <optional>     // for std::optional
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
+
+namespace core::perfect_hash {
+
+/**
+ * @brief Class that maps each of a fixed set of strings to its index, with one probe per lookup.
+ *
+ * The keys are hashed into buckets of about three keys, and every bucket gets a seed such that its keys land in distinct free slots (hash and displace), largest buckets first.
+ * There are exactly as many slots as keys, so a lookup is one hash, one seed and one slot, and a single comparison with the key stored there rejects strings that are not keys.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class PerfectHash final {
+  public:
+    /**
+     * @brief Construct a new PerfectHash object without any keys.
+     */
+    explicit PerfectHash();
+
+    /**
+     * @brief Construct a new PerfectHash object. This is about O(n log n).
+     *
+     * @param keys Distinct keys (e.g., {"ㄱ", "ㄴ"}); each maps to its index.
+     *
+     * @throws std::runtime_error if a key appears twice.
+     */
+    explicit PerfectHash(const std::vector<std::string_view> &keys);
+
+    /**
+     * @brief Find the index of a key. This is O(length of the key).
+     *
+     * @param key Key to find (e.g., "ㄴ").
+     *
+     * @return Index of the key (e.g., "1"), or std::nullopt if it is not a key.
+     */
+    [[nodiscard]] std::optional<std::uint32_t> find(const std::string_view key) const;
+
+    /**
+     * @brief Get the number of keys.
+     *
+     * @return Number of keys (e.g., "2").
+     */
+    [[nodiscard]] std::size_t get_num_keys() const;
+
+  private:
+    /**
+     * @brief Seed of each bucket, which picks the slots of its keys.
+     */
+    std::vector<std::uint32_t> seeds_;
+
+    /**
+     * @brief Index of the key in each slot.
+     */
+    std::vector<std::uint32_t> indices_;
+
+    /**
+     * @brief Range of the key in each slot within "chars_", "get_num_keys() + 1" offsets.
+     */
+    std::vector<std::uint32_t> offsets_;
+
+    /**
+     * @brief Keys, one after another in slot order.
+     */
+    std::string chars_;
+};
+
+}  // namespace core::perfect_hash
@@ -0,0 +1,394 @@
+/**
+ * @file pronunciation.cpp
+ */
+
+#include <algorithm>    // for std::min
+#include <array>        // for std::array
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint8_t, std::uint32_t
+#include <cstring>      // for std::memcpy
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+
+#include "pronunciation.hpp"
+#include "utf8.hpp"
+
+namespace core::pronunciation {
+
+namespace {
+
+/**
+ * @brief Private indices of the initials in Unicode syllable order.
+ */
+enum Initial : std::uint8_t {
+    G,
+    GG,
+    N,
+    D,
+    DD,
+    R,
+    M,
+    B,
+    BB,
+    S,
+    SS,
+    Ieung,
+    J,
+    JJ,
+    CH,
+    K,
+    T,
+    P,
+    H
+};
+
+/**
+ * @brief Private indices of the finals in Unicode syllable order, where 0 is "no final", followed by the clusters whose pronunciation depends on the word.
+ */
+enum Final : std::uint8_t {
+    None,
+    FinalG,
+    FinalGG,
+    FinalGS,
+    FinalN,
+    FinalNJ,
+    FinalNH,
+    FinalD,
+    FinalL,
+    FinalLG,
+    FinalLM,
+    FinalLB,
+    FinalLS,
+    FinalLT,
+    FinalLP,
+    FinalLH,
+    FinalM,
+    FinalB,
+    FinalBS,
+    FinalS,
+    FinalSS,
+    FinalNG,
+    FinalJ,
+    FinalCH,
+    FinalK,
+    FinalT,
+    FinalP,
+    FinalH,
+    FinalLBAsB,  // "ㄼ" of "밟", which is pronounced "ㅂ" rather than "ㄹ" before a consonant
+    FinalLGNoun  // "ㄺ" of the nouns "닭", "흙", "칡" and "삵", which stays "ㄱ" before "ㄱ" unlike in verb stems
+};
+
+/**
+ * @brief Private number of finals, including the clusters whose pronunciation depends on the word.
+ */
+constexpr std::size_t num_finals = 30;
+
+/**
+ * @brief Private final that each final is pronounced as before a consonant or at the end of a word (one of ㄱ ㄴ ㄷ ㄹ ㅁ ㅂ ㅇ).
+ */
+constexpr std::array<std::uint8_t, num_finals> neutral_finals = {
+    None, FinalG, FinalG, FinalG, FinalN, FinalN, FinalN, FinalD, FinalL, FinalG, FinalM, FinalL, FinalL, FinalL,
+    FinalB, FinalL, FinalM, FinalB, FinalB, FinalD, FinalD, FinalNG, FinalD, FinalD, FinalG, FinalD, FinalB, FinalD,
+    FinalB, FinalG};
+
+/**
+ * @brief Private remaining final and moved initial of each final before "ㅇ" (liaison).
+ */
+constexpr std::array<std::array<std::uint8_t, 2>, num_finals> liaisons = {{
+    {None, Ieung},
+    {None, G},
+    {None, GG},
+    {FinalG, SS},
+    {None, N},
+    {FinalN, J},
+    {None, N},
+    {None, D},
+    {None, R},
+    {FinalL, G},
+    {FinalL, M},
+    {FinalL, B},
+    {FinalL, SS},
+    {FinalL, T},
+    {FinalL, P},
+    {None, R},
+    {None, M},
+    {None, B},
+    {FinalB, SS},
+    {None, S},
+    {None, SS},
+    {FinalNG, Ieung},
+    {None, J},
+    {None, CH},
+    {None, K},
+    {None, T},
+    {None, P},
+    {None, Ieung},
+    {FinalL, B},
+    {FinalL, G},
+}};
+
+/**
+ * @brief Private number of inputs of the automaton: 19 initials, each before "ㅣ" or before another vowel.
+ */
+constexpr std::size_t num_inputs = 19 * 2;
+
+/**
+ * @brief Private transition of the automaton.
+ */
+struct Transition final {
+    std::uint8_t final;    // Final that the previous syllable is pronounced with
+    std::uint8_t initial;  // Initial that the next syllable is pronounced with
+};
+
+/**
+ * @brief Private helper function to apply the sound changes between a final and the next initial.
+ *
+ * @param final_index Final of the previous syllable, or "None".
+ * @param initial_index Initial of the next syllable.
+ * @param before_i Whether the vowel of the next syllable is "ㅣ".
+ *
+ * @return Final and initial as they are pronounced.
+ */
+[[nodiscard]] constexpr Transition make_transition(const std::uint8_t final_index,
+                                                   const std::uint8_t initial_index,
+                                                   const bool before_i)
+{
+    if (final_index == None) {
+        return {None, initial_index};
+    }
+
+    // Liaison, where "ㄷ" and "ㅌ" are palatalized before "이"
+    if (initial_index == Ieung) {
+        if (before_i && final_index == FinalD) {
+            return {None, J};
+        }
+        if (before_i && (final_index == FinalT || final_index == FinalLT)) {
+            return {final_index == FinalLT ? FinalL : None, CH};
+        }
+        return {liaisons[final_index][0], liaisons[final_index][1]};
+    }
+
+    // Aspiration of a final before "ㅎ"
+    if (initial_index == H) {
+        switch (final_index) {
+        case FinalG:
+        case FinalGG:
+        case FinalK:
+            return {None, K};
+        case FinalLG:
+        case FinalLGNoun:
+            return {FinalL, K};
+        case FinalD:
+            return {None, before_i ? CH : T};
+        case FinalS:
+        case FinalSS:
+        case FinalT:
+            return {None, T};
+        case FinalJ:
+        case FinalCH:
+            return {None, CH};
+        case FinalNJ:
+            return {FinalN, CH};
+        case FinalB:
+        case FinalP:
+            return {None, P};
+        case FinalLB:
+        case FinalLBAsB:
+            return {FinalL, P};
+        default:
+            return {neutral_finals[final_index], H};
+        }
+    }
+
+    // Aspiration, tensification or loss of a final "ㅎ" before a consonant
+    if (final_index == FinalH || final_index == FinalNH || final_index == FinalLH) {
+        const std::uint8_t rest = final_index == FinalH ? None : (final_index == FinalNH ? FinalN : FinalL);
+        switch (initial_index) {
+        case G:
+            return {rest, K};
+        case D:
+            return {rest, T};
+        case J:
+            return {rest, CH};
+        case S:
+            return {rest, SS};
+        case N:
+            return final_index == FinalLH ? Transition{FinalL, R} : Transition{FinalN, N};
+        default:
+            break;
+        }
+    }
+
+    const std::uint8_t neutral = neutral_finals[final_index];
+
+    // Nasalization of "ㄱ", "ㄷ" and "ㅂ" before "ㄴ" and "ㅁ", and lateralization of "ㄹ" before "ㄴ"
+    if (initial_index == N || initial_index == M) {
+        if (neutral == FinalL && initial_index == N) {
+            return {FinalL, R};
+        }
+        if (neutral == FinalG) {
+            return {FinalNG, initial_index};
+        }
+        if (neutral == FinalD) {
+            return {FinalN, initial_index};
+        }
+        if (neutral == FinalB) {
+            return {FinalM, initial_index};
+        }
+        return {neutral, initial_index};
+    }
+
+    // "ㄹ" after "ㄴ" or "ㄹ" is lateralized, and after any other final it becomes "ㄴ", which nasalizes "ㄱ", "ㄷ" and "ㅂ" in turn
+    if (initial_index == R) {
+        switch (neutral) {
+        case FinalN:
+        case FinalL:
+            return {FinalL, R};
+        case FinalG:
+            return {FinalNG, N};
+        case FinalD:
+            return {FinalN, N};
+        case FinalB:
+            return {FinalM, N};
+        default:
+            return {neutral, N};
+        }
+    }
+
+    // A verb stem ending in "ㄺ" is pronounced with "ㄹ" before "ㄱ", which is tensed (e.g., "늙고" gives "늘꼬")
+    if (final_index == FinalLG && initial_index == G) {
+        return {FinalL, GG};
+    }
+
+    // Tensification of lax initials after "ㄱ", "ㄷ" and "ㅂ", and after the verb stem clusters "ㄵ", "ㄻ", "ㄼ" and "ㄾ"
+    const bool tensing = neutral == FinalG || neutral == FinalD || neutral == FinalB ||
+                         final_index == FinalNJ || final_index == FinalLM || final_index == FinalLB || final_index == FinalLT;
+    if (tensing) {
+        switch (initial_index) {
+        case G:
+            return {neutral, GG};
+        case D:
+            return {neutral, DD};
+        case B:
+            return {neutral, BB};
+        case S:
+            return {neutral, SS};
+        case J:
+            return {neutral, JJ};
+        default:
+            break;
+        }
+    }
+    return {neutral, initial_index};
+}
+
+/**
+ * @brief Private transition table of the automaton, indexed by "final * num_inputs + initial * 2 + before_i".
+ */
+constexpr std::array<Transition, num_finals * num_inputs> transitions = []() {
+    std::array<Transition, num_finals * num_inputs> table{};
+    for (std::uint8_t final_index = 0; final_index < num_finals; ++final_index) {
+        for (std::uint8_t initial_index = 0; initial_index < 19; ++initial_index) {
+            for (std::size_t before_i = 0; before_i < 2; ++before_i) {
+                table[final_index * num_inputs + initial_index * 2u + before_i] = make_transition(final_index, initial_index, before_i == 1);
+            }
+        }
+    }
+    return table;
+}();
+
+/**
+ * @brief Private helper function to get the index of a syllable from its jamo.
+ *
+ * @param initial_index Initial (e.g., "D").
+ * @param vowel_index Vowel in Unicode syllable order (e.g., "0" for "ㅏ").
+ * @param final_index Final (e.g., "FinalLG").
+ *
+ * @return Index of the syllable from "가" (e.g., the index of "닭").
+ */
+[[nodiscard]] constexpr std::uint32_t make_syllable(const std::uint8_t initial_index,
+                                                    const std::uint8_t vowel_index,
+                                                    const std::uint8_t final_index)
+{
+    return (initial_index * 21u + vowel_index) * 28u + final_index;
+}
+
+/**
+ * @brief Private helper function to get the final that the automaton continues from after a syllable.
+ *
+ * @param syllable Index of the syllable from "가" (e.g., the index of "밟").
+ *
+ * @return Final of the syllable (e.g., "FinalLB"), or a cluster whose pronunciation depends on the word (e.g., "FinalLBAsB").
+ */
+[[nodiscard]] constexpr std::uint8_t get_final(const std::uint32_t syllable)
+{
+    const auto final_index = static_cast<std::uint8_t>(syllable % 28);
+    if (final_index == FinalLB && syllable == make_syllable(B, 0, FinalLB)) {
+        return FinalLBAsB;
+    }
+    if (final_index == FinalLG && (syllable == make_syllable(D, 0, FinalLG) || syllable == make_syllable(H, 18, FinalLG) ||
+                                   syllable == make_syllable(CH, 20, FinalLG) || syllable == make_syllable(S, 0, FinalLG))) {
+        return FinalLGNoun;
+    }
+    return final_index;
+}
+
+}  // namespace
+
+void pronounce(const std::string_view text,
+               std::string &out)
+{
+    // Syllables stay 3 bytes and anything else is copied as is, so the output is exactly as long as the input
+    const std::size_t start = out.size();
+    out.resize(start + text.size());
+    char *dst = out.data() + start;
+
+    // The previous syllable (without its final) is only written once the next initial is known
+    const auto *in = reinterpret_cast<const unsigned char *>(text.data());
+    const std::size_t size = text.size();
+    std::uint32_t pending = 0;
+    std::uint8_t final_index = None;
+    bool has_pending = false;
+    const auto flush = [&pending, &final_index, &has_pending, &dst]() {
+        if (has_pending) {
+            dst = utf8::encode3(utf8::first_syllable + pending + neutral_finals[final_index], dst);
+            has_pending = false;
+        }
+        final_index = None;
+    };
+
+    std::size_t pos = 0;
+    while (pos < size) {
+        // A syllable (always 3 bytes) steps the automaton
+        if (const std::uint32_t index = utf8::decode_syllable(in + pos, size - pos); index != utf8::no_syllable) {
+            const std::uint32_t initial_index = index / 588;
+            const std::uint32_t vowel_index = (index / 28) % 21;
+            const Transition transition = transitions[final_index * num_inputs + initial_index * 2 + (vowel_index == 20 ? 1 : 0)];
+            if (has_pending) {
+                dst = utf8::encode3(utf8::first_syllable + pending + transition.final, dst);
+            }
+            pending = (transition.initial * 21u + vowel_index) * 28u;
+            final_index = get_final(index);
+            has_pending = true;
+            pos += 3;
+            continue;
+        }
+
+        // Anything else ends the word, and is copied as is
+        flush();
+        const std::size_t length = std::min(utf8::get_sequence_length(in[pos]), size - pos);
+        std::memcpy(dst, in + pos, length);
+        dst += length;
+        pos += length;
+    }
+    flush();
+}
+
+std::string pronounce(const std::string_view text)
+{
+    std::string out;
+    pronounce(text, out);
+    return out;
+}
+
+}  // namespace core::pronunciation
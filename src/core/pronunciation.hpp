@@ -0,0 +1,46 @@
+/**
+ * @file pronunciation.hpp
+ *
+ * @brief Standard pronunciation of Korean text.
+ */
+
+#pragma once
+
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+
+namespace core::pronunciation {
+
+/**
+ * @brief Write Korean text as it is pronounced, appending the result to a string.
+ *
+ * The sound changes are compiled at compile time into a deterministic automaton whose state is the final of the previous syllable and whose input is the initial of the next syllable (and whether its vowel is "ㅣ").
+ * Each transition rewrites both jamo at once, so the text is processed in a single linear pass:
+ * - Liaison, where a final moves to a following "ㅇ" (e.g., "한국어" gives "한구거", and "없어" gives "업써").
+ * - Nasalization (e.g., "한국말" gives "한궁말", and "종로" gives "종노").
+ * - Lateralization (e.g., "신라" gives "실라").
+ * - Tensification after "ㄱ", "ㄷ" and "ㅂ" sounds (e.g., "학교" gives "학꾜").
+ * - Aspiration with "ㅎ" (e.g., "좋고" gives "조코").
+ * - Palatalization (e.g., "같이" gives "가치").
+ * - Neutralization of finals before a consonant or at the end of a word (e.g., "닭" gives "닥"), where "ㄼ" becomes "ㅂ" in "밟" (e.g., "밟다" gives "밥따"), and "ㄺ" becomes "ㄹ" before "ㄱ" (e.g., "늙고" gives "늘꼬").
+ *
+ * The automaton knows no word classes, so the "ㄺ" rule of verb stems is skipped for the nouns "닭", "흙", "칡" and "삵" (e.g., "닭고기" gives "닥꼬기"), but not for rarer ones, and the "ㅂ" of "밟" is not extended to other stems (e.g., "넓죽하다").
+ *
+ * Anything that is not a syllable (e.g., spaces, Latin letters or lone jamo) ends the word and is copied as is.
+ *
+ * @param text UTF-8 text (e.g., "한국말").
+ * @param out String that the pronounced text is appended to (e.g., "한궁말"); reusing it across calls avoids allocations.
+ */
+void pronounce(const std::string_view text,
+               std::string &out);
+
+/**
+ * @brief Write Korean text as it is pronounced.
+ *
+ * @param text UTF-8 text (e.g., "한국말").
+ *
+ * @return Pronounced text (e.g., "한궁말").
+ */
+[[nodiscard]] std::string pronounce(const std::string_view text);
+
+}  // namespace core::pronunciation
@@ -0,0 +1,324 @@
+/**
+ * @file query.cpp
+ */
+
+#include <charconv>      // for std::from_chars
+#include <cstddef>       // for std::size_t
+#include <cstdint>       // for std::uint32_t
+#include <stdexcept>     // for std::runtime_error
+#include <string>        // for std::string
+#include <string_view>   // for std::string_view
+#include <system_error>  // for std::errc
+#include <utility>       // for std::move
+#include <vector>        // for std::vector
+
+#include <fmt/core.h>
+
+#include "bitmap.hpp"
+#include "query.hpp"
+
+namespace core::query {
+
+namespace {
+
+/**
+ * @brief Private helper function to check whether a character is whitespace.
+ *
+ * @param c Character to check (e.g., " ").
+ *
+ * @return True if the character is a space, a tab or a line break, false otherwise.
+ */
+[[nodiscard]] inline bool is_whitespace(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/**
+ * @brief Private helper function to check whether a character ends a tag name.
+ *
+ * @param c Character to check (e.g., "&").
+ *
+ * @return True if the character is whitespace or an operator, false otherwise.
+ */
+[[nodiscard]] inline bool is_delimiter(const char c)
+{
+    if (is_whitespace(c)) {
+        return true;
+    }
+    switch (c) {
+    case '(':
+    case ')':
+    case '&':
+    case '|':
+    case '!':
+    case '<':
+    case '>':
+    case '=':
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Private helper function to parse a whole string as an integer.
+ *
+ * @param text Text to parse (e.g., "-3").
+ * @param value Parsed integer, set on success.
+ *
+ * @return True if the whole text is an integer, false otherwise.
+ */
+[[nodiscard]] bool parse_integer(const std::string_view text,
+                                 long long &value)
+{
+    const char *const end = text.data() + text.size();
+    const auto [ptr, error] = std::from_chars(text.data(), end, value);
+    return !text.empty() && error == std::errc() && ptr == end;
+}
+
+}  // namespace
+
+bool matches(const Term &term,
+             const std::string_view tag)
+{
+    if (term.comparison == Comparison::None) {
+        return tag == term.name;
+    }
+    long long number = 0;
+    if (tag.size() <= term.name.size() || tag.compare(0, term.name.size(), term.name) != 0 || tag[term.name.size()] != ':' || !parse_integer(tag.substr(term.name.size() + 1), number)) {
+        return false;
+    }
+    switch (term.comparison) {
+    case Comparison::Less:
+        return number < term.value;
+    case Comparison::LessEqual:
+        return number <= term.value;
+    case Comparison::Equal:
+        return number == term.value;
+    case Comparison::GreaterEqual:
+        return number >= term.value;
+    case Comparison::Greater:
+        return number > term.value;
+    default:
+        return false;
+    }
+}
+
+Query::Query(const std::string_view expression)
+    : expression_(expression),
+      position_(0),
+      terms_(),
+      program_()
+{
+    this->parse_or();
+    this->skip_whitespace();
+    if (this->position_ != this->expression_.size()) {
+        this->fail("'&', '|' or the end");
+    }
+}
+
+const std::string &Query::get_expression() const
+{
+    return this->expression_;
+}
+
+const std::vector<Term> &Query::get_terms() const
+{
+    return this->terms_;
+}
+
+core::bitmap::Bitmap Query::evaluate(const std::vector<const core::bitmap::Bitmap *> &inputs,
+                                     const core::bitmap::Bitmap &universe) const
+{
+    if (inputs.size() != this->terms_.size()) {
+        throw std::runtime_error(fmt::format("Query '{}' has '{}' terms, but '{}' inputs were given", this->expression_, this->terms_.size(), inputs.size()));
+    }
+    for (std::size_t idx = 0; idx < inputs.size(); ++idx) {
+        if (inputs[idx] == nullptr) {
+            throw std::runtime_error(fmt::format("Term '{}' of query '{}' has no input", this->terms_[idx].name, this->expression_));
+        }
+    }
+
+    std::vector<core::bitmap::Bitmap> stack;
+    for (const Instruction &instruction : this->program_) {
+        if (instruction.op == Op::Load) {
+            stack.emplace_back(*inputs[instruction.operand]);
+            continue;
+        }
+        if (instruction.op == Op::Not) {
+            stack.back() = universe - stack.back();
+            continue;
+        }
+
+        // Binary operations combine the top with a term, or with the group that was pushed after it
+        core::bitmap::Bitmap group;
+        const core::bitmap::Bitmap *operand = nullptr;
+        if (instruction.operand == stack_operand) {
+            group = std::move(stack.back());
+            stack.pop_back();
+            operand = &group;
+        }
+        else {
+            operand = inputs[instruction.operand];
+        }
+        if (instruction.op == Op::And) {
+            stack.back() &= *operand;
+        }
+        else if (instruction.op == Op::Or) {
+            stack.back() |= *operand;
+        }
+        else {
+            stack.back() -= *operand;
+        }
+    }
+    return std::move(stack.back());
+}
+
+void Query::parse_or()
+{
+    this->parse_and();
+    while (this->consume("|")) {
+        // A lone operand is fused into the OR, and a chain of ANDs is pushed as a group
+        bool negated = false;
+        const std::uint32_t operand = this->parse_operand(negated);
+        if (!this->consume("&")) {
+            this->emit(Op::Or, operand, negated);
+            continue;
+        }
+        this->emit(Op::Load, operand, negated);
+        do {
+            bool next_negated = false;
+            const std::uint32_t next = this->parse_operand(next_negated);
+            this->emit(Op::And, next, next_negated);
+        } while (this->consume("&"));
+        this->program_.push_back({Op::Or, stack_operand});
+    }
+}
+
+void Query::parse_and()
+{
+    bool negated = false;
+    const std::uint32_t operand = this->parse_operand(negated);
+    this->emit(Op::Load, operand, negated);
+    while (this->consume("&")) {
+        bool next_negated = false;
+        const std::uint32_t next = this->parse_operand(next_negated);
+        this->emit(Op::And, next, next_negated);
+    }
+}
+
+std::uint32_t Query::parse_operand(bool &negated)
+{
+    if (this->consume("!")) {
+        negated = !negated;
+        return this->parse_operand(negated);
+    }
+    if (this->consume("(")) {
+        this->parse_or();
+        if (!this->consume(")")) {
+            this->fail("')'");
+        }
+        return stack_operand;
+    }
+    return this->parse_term();
+}
+
+std::uint32_t Query::parse_term()
+{
+    this->skip_whitespace();
+    const std::size_t begin = this->position_;
+    while (this->position_ < this->expression_.size() && !is_delimiter(this->expression_[this->position_])) {
+        ++this->position_;
+    }
+    if (this->position_ == begin) {
+        this->fail("a tag");
+    }
+    Term term{this->expression_.substr(begin, this->position_ - begin), Comparison::None, 0};
+
+    // A comparison turns the name into the numbered tags "name:N"
+    if (this->consume("<=")) {
+        term.comparison = Comparison::LessEqual;
+    }
+    else if (this->consume("<")) {
+        term.comparison = Comparison::Less;
+    }
+    else if (this->consume(">=")) {
+        term.comparison = Comparison::GreaterEqual;
+    }
+    else if (this->consume(">")) {
+        term.comparison = Comparison::Greater;
+    }
+    else if (this->consume("=")) {
+        term.comparison = Comparison::Equal;
+    }
+    if (term.comparison != Comparison::None) {
+        this->skip_whitespace();
+        const std::size_t number_begin = this->position_;
+        while (this->position_ < this->expression_.size() && !is_delimiter(this->expression_[this->position_])) {
+            ++this->position_;
+        }
+        if (!parse_integer(std::string_view(this->expression_).substr(number_begin, this->position_ - number_begin), term.value)) {
+            this->position_ = number_begin;
+            this->fail("an integer");
+        }
+    }
+
+    for (std::size_t idx = 0; idx < this->terms_.size(); ++idx) {
+        const Term &existing = this->terms_[idx];
+        if (existing.name == term.name && existing.comparison == term.comparison && existing.value == term.value) {
+            return static_cast<std::uint32_t>(idx);
+        }
+    }
+    this->terms_.emplace_back(std::move(term));
+    return static_cast<std::uint32_t>(this->terms_.size() - 1);
+}
+
+void Query::emit(const Op op,
+                 const std::uint32_t operand,
+                 const bool negated)
+{
+    if (!negated) {
+        // A group is already on the stack, where it is loaded
+        if (op != Op::Load || operand != stack_operand) {
+            this->program_.push_back({op, operand});
+        }
+        return;
+    }
+    if (op == Op::And) {
+        this->program_.push_back({Op::AndNot, operand});
+        return;
+    }
+
+    // Otherwise, the negation is computed on the stack
+    if (operand != stack_operand) {
+        this->program_.push_back({Op::Load, operand});
+    }
+    this->program_.push_back({Op::Not, stack_operand});
+    if (op == Op::Or) {
+        this->program_.push_back({Op::Or, stack_operand});
+    }
+}
+
+void Query::skip_whitespace()
+{
+    while (this->position_ < this->expression_.size() && is_whitespace(this->expression_[this->position_])) {
+        ++this->position_;
+    }
+}
+
+bool Query::consume(const std::string_view token)
+{
+    this->skip_whitespace();
+    if (std::string_view(this->expression_).substr(this->position_, token.size()) != token) {
+        return false;
+    }
+    this->position_ += token.size();
+    return true;
+}
+
+void Query::fail(const std::string_view expected) const
+{
+    throw std::runtime_error(fmt::format("Expected {} at position {} of query '{}'", expected, this->position_, this->expression_));
+}
+
+}  // namespace core::query
@@ -0,0 +1,224 @@
+/**
+ * @file query.hpp
+ *
+ * @brief Boolean queries over tags, compiled into bitmap operations.
+ */
+
+#pragma once
+
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
+
+#include "bitmap.hpp"
+
+namespace core::query {
+
+/**
+ * @brief Enum that represents how a term compares the number of a numbered tag (e.g., "lesson:3").
+ */
+enum class Comparison {
+    None,
+    Less,
+    LessEqual,
+    Equal,
+    GreaterEqual,
+    Greater
+};
+
+/**
+ * @brief Struct that represents one input of a query, i.e., a set of tags.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Term final {
+    /**
+     * @brief Name of the tag (e.g., "vowel"), or of the numbered tags (e.g., "lesson" for "lesson:1", "lesson:2", ...).
+     */
+    std::string name;
+
+    /**
+     * @brief Comparison with "value", or "Comparison::None" to match the tag named "name" itself.
+     */
+    Comparison comparison = Comparison::None;
+
+    /**
+     * @brief Number compared with the number of each numbered tag (e.g., "5" in "lesson<=5").
+     */
+    long long value = 0;
+};
+
+/**
+ * @brief Check whether a term matches a tag.
+ *
+ * @param term Term (e.g., "lesson<=5").
+ * @param tag Name of a tag (e.g., "lesson:3").
+ *
+ * @return True if the tag is the term's name without a comparison, or "name:N" where N satisfies the comparison, false otherwise.
+ */
+[[nodiscard]] bool matches(const Term &term,
+                           const std::string_view tag);
+
+/**
+ * @brief Class that represents a boolean query over tags, such as "(lesson<=5 & vowel) | review-due".
+ *
+ * On construction, the expression is parsed once into its distinct terms and a flat postfix program of bitmap operations.
+ * Most operations take a term directly (e.g., "a & b | c" is "load a, and b, or c"), so evaluating copies one bitmap per parenthesized group rather than one per term, and "a & !b" becomes a single AND NOT.
+ *
+ * The grammar, from the lowest precedence:
+ * - "x | y": entries in either.
+ * - "x & y": entries in both.
+ * - "!x": entries not in "x".
+ * - "(x)", "name", or "name" followed by "<", "<=", "=", ">=" or ">" and an integer.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Query final {
+  public:
+    /**
+     * @brief Construct a new Query object.
+     *
+     * @param expression Expression to compile (e.g., "(lesson<=5 & vowel) | review-due").
+     *
+     * @throws std::runtime_error if the expression is not valid, with the position of the error.
+     */
+    explicit Query(const std::string_view expression);
+
+    /**
+     * @brief Get the expression of the query.
+     *
+     * @return Const reference to the expression (e.g., "vowel & !compound").
+     */
+    [[nodiscard]] const std::string &get_expression() const;
+
+    /**
+     * @brief Get the distinct terms of the query, which are the inputs of "evaluate()".
+     *
+     * @return Const reference to a vector of terms, in order of first appearance.
+     */
+    [[nodiscard]] const std::vector<Term> &get_terms() const;
+
+    /**
+     * @brief Evaluate the query. This is O(number of operations * size of the bitmaps).
+     *
+     * @param inputs Bitmap of each term, in the order of "get_terms()".
+     * @param universe Bitmap of every entry, which "!x" is taken from.
+     *
+     * @return Bitmap of the entries that match the query.
+     *
+     * @throws std::runtime_error if the number of inputs is not the number of terms.
+     */
+    [[nodiscard]] core::bitmap::Bitmap evaluate(const std::vector<const core::bitmap::Bitmap *> &inputs,
+                                                const core::bitmap::Bitmap &universe) const;
+
+  private:
+    /**
+     * @brief Enum that represents a bitmap operation.
+     */
+    enum class Op {
+        Load,    // Push a copy of the operand
+        And,     // Intersect the top with the operand
+        Or,      // Unite the top with the operand
+        AndNot,  // Subtract the operand from the top
+        Not      // Replace the top with the universe minus the top
+    };
+
+    /**
+     * @brief Struct that represents one operation of the program.
+     *
+     * @note This struct is marked as `final` to prevent inheritance.
+     */
+    struct Instruction final {
+        Op op;                  // Operation
+        std::uint32_t operand;  // Index of the term, or "stack_operand" to pop the operand off the stack
+    };
+
+    /**
+     * @brief Operand of an instruction that pops its operand off the stack rather than reading a term.
+     */
+    static constexpr std::uint32_t stack_operand = 0xFFFFFFFFu;
+
+    /**
+     * @brief Parse "x | y | ...".
+     */
+    void parse_or();
+
+    /**
+     * @brief Parse "x & y & ...".
+     */
+    void parse_and();
+
+    /**
+     * @brief Parse "!x", "(x)" or a term, without emitting it, so the caller can fuse it into its own operation.
+     *
+     * @param negated Whether the operand is negated, which is toggled by each "!".
+     *
+     * @return Index of the term, or "stack_operand" if the operand was pushed onto the stack.
+     */
+    [[nodiscard]] std::uint32_t parse_operand(bool &negated);
+
+    /**
+     * @brief Parse a term, and add it to the terms unless it is already one.
+     *
+     * @return Index of the term.
+     */
+    [[nodiscard]] std::uint32_t parse_term();
+
+    /**
+     * @brief Emit an operation with an operand returned by "parse_operand()".
+     *
+     * @param op Operation ("Op::Load", "Op::And", or "Op::Or").
+     * @param operand Index of the term, or "stack_operand".
+     * @param negated Whether the operand is negated.
+     */
+    void emit(const Op op,
+              const std::uint32_t operand,
+              const bool negated);
+
+    /**
+     * @brief Skip spaces, tabs and line breaks.
+     */
+    void skip_whitespace();
+
+    /**
+     * @brief Skip whitespace, and consume a token if it comes next.
+     *
+     * @param token Token (e.g., "<=").
+     *
+     * @return True if the token was consumed, false otherwise.
+     */
+    [[nodiscard]] bool consume(const std::string_view token);
+
+    /**
+     * @brief Throw an error about the current position.
+     *
+     * @param expected What was expected (e.g., "')'").
+     *
+     * @throws std::runtime_error always.
+     */
+    [[noreturn]] void fail(const std::string_view expected) const;
+
+    /**
+     * @brief Expression of the query.
+     */
+    std::string expression_;
+
+    /**
+     * @brief Position of the parser in "expression_".
+     */
+    std::size_t position_;
+
+    /**
+     * @brief Distinct terms of the query.
+     */
+    std::vector<Term> terms_;
+
+    /**
+     * @brief Flat postfix program of the query.
+     */
+    std::vector<Instruction> program_;
+};
+
+}  // namespace core::query
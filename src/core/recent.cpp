@@ -0,0 +1,69 @@
+/**
+ * @file recent.cpp
+ */
+
+#include <algorithm>  // for std::min
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint64_t
+#include <vector>     // for std::vector
+
+#include "recent.hpp"
+
+namespace core::recent {
+
+RecentWindow::RecentWindow(const std::size_t capacity,
+                           const std::size_t size)
+    : ring_(size, 0),
+      head_(0),
+      clock_(0),
+      last_seen_(capacity, 0)
+{
+}
+
+void RecentWindow::push(const std::size_t item)
+{
+    if (item >= this->last_seen_.size()) {
+        return;
+    }
+    this->last_seen_[item] = ++this->clock_;
+    if (!this->ring_.empty()) {
+        this->ring_[this->head_] = item;
+        this->head_ = (this->head_ + 1) % this->ring_.size();
+    }
+}
+
+void RecentWindow::reserve(const std::size_t capacity)
+{
+    if (capacity > this->last_seen_.size()) {
+        this->last_seen_.resize(capacity, 0);
+    }
+}
+
+bool RecentWindow::contains(const std::size_t item,
+                            const std::size_t limit) const
+{
+    if (item >= this->last_seen_.size() || this->last_seen_[item] == 0) {
+        return false;
+    }
+    // The latest pick has an age of 0, so it is within any window of at least one pick
+    const std::uint64_t age = this->clock_ - this->last_seen_[item];
+    return age < std::min(this->ring_.size(), limit);
+}
+
+std::vector<std::size_t> RecentWindow::get_items() const
+{
+    const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(this->clock_, this->ring_.size()));
+    std::vector<std::size_t> items;
+    items.reserve(count);
+    for (std::size_t idx = 1; idx <= count; ++idx) {
+        items.emplace_back(this->ring_[(this->head_ + this->ring_.size() - idx) % this->ring_.size()]);
+    }
+    return items;
+}
+
+std::size_t RecentWindow::get_size() const
+{
+    return this->ring_.size();
+}
+
+}  // namespace core::recent
@@ -0,0 +1,95 @@
+/**
+ * @file recent.hpp
+ *
+ * @brief Window of recently picked items.
+ */
+
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <limits>   // for std::numeric_limits
+#include <vector>   // for std::vector
+
+namespace core::recent {
+
+/**
+ * @brief Class that remembers the last N picked items.
+ *
+ * Picks are kept in a fixed-size ring buffer, and every item also stores the stamp of its last pick, so checking whether an item is recent is O(1) and does not search the ring.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class RecentWindow final {
+  public:
+    /**
+     * @brief Construct a new, empty RecentWindow object.
+     *
+     * @param capacity Number of possible items, which are the integers in [0, capacity) (e.g., "40").
+     * @param size Number of picks to remember (e.g., "3").
+     */
+    explicit RecentWindow(const std::size_t capacity,
+                          const std::size_t size);
+
+    /**
+     * @brief Remember a pick.
+     *
+     * @param item Picked item (e.g., "3"); items out of range are ignored.
+     */
+    void push(const std::size_t item);
+
+    /**
+     * @brief Raise the number of possible items, keeping the picks so far.
+     *
+     * @param capacity Number of possible items, which are the integers in [0, capacity) (e.g., "41"); a smaller number is ignored.
+     */
+    void reserve(const std::size_t capacity);
+
+    /**
+     * @brief Check whether an item was picked within the last picks.
+     *
+     * @param item Item to check (e.g., "3").
+     * @param limit Maximum number of last picks to consider, so the window can shrink when few items are available (default: the whole window).
+     *
+     * @return True if the item was picked within the last "min(size, limit)" picks, false otherwise.
+     */
+    [[nodiscard]] bool contains(const std::size_t item,
+                                const std::size_t limit = std::numeric_limits<std::size_t>::max()) const;
+
+    /**
+     * @brief Get the remembered picks.
+     *
+     * @return Vector of items, most recent first.
+     */
+    [[nodiscard]] std::vector<std::size_t> get_items() const;
+
+    /**
+     * @brief Get the number of picks to remember.
+     *
+     * @return Number of picks (e.g., "3").
+     */
+    [[nodiscard]] std::size_t get_size() const;
+
+  private:
+    /**
+     * @brief Ring buffer of the last picks.
+     */
+    std::vector<std::size_t> ring_;
+
+    /**
+     * @brief Slot of the ring buffer that the next pick is written to.
+     */
+    std::size_t head_;
+
+    /**
+     * @brief Number of picks so far, which is also the stamp of the latest pick.
+     */
+    std::uint64_t clock_;
+
+    /**
+     * @brief Stamp of the last pick of each item, or 0 if it was never picked, indexed by item.
+     */
+    std::vector<std::uint64_t> last_seen_;
+};
+
+}  // namespace core::recent
@@ -2,9 +2,13 @@
  * @file rng.cpp
  */
 
+#include <cmath>        // for std::log, std::pow, std::sqrt
 #include <cstddef>      // for std::size_t
-#include <random>       // for std::mt19937, std::random_device, std::uniform_int_distribution, std::bernoulli_distribution
+#include <cstdint>      // for std::uint32_t
+#include <random>       // for std::mt19937, std::random_device, std::uniform_int_distribution, std::uniform_real_distribution, std::normal_distribution, std::bernoulli_distribution
+#include <sstream>      // for std::stringstream
 #include <type_traits>  // for std::is_integral_v
+#include <vector>       // for std::vector
 
 #include "rng.hpp"
 
@@ -31,6 +35,74 @@ bool RNG::get_random_bool(const double probability)
     return dist(RNG::instance());
 }
 
+double RNG::get_random_real(const double min,
+                            const double max)
+{
+    std::uniform_real_distribution<double> dist(min, max);
+    return dist(RNG::instance());
+}
+
+double RNG::get_random_gamma(const double shape)
+{
+    // Shapes below one are boosted: if X ~ Gamma(shape + 1) and U ~ Uniform(0, 1), then X * U^(1 / shape) ~ Gamma(shape)
+    if (shape < 1.0) {
+        const double uniform = RNG::get_random_real(0.0, 1.0);
+        return RNG::get_random_gamma(shape + 1.0) * std::pow(uniform, 1.0 / shape);
+    }
+
+    // Marsaglia-Tsang squeeze method, which accepts about 98% of candidates and needs no tables
+    const double d = shape - 1.0 / 3.0;
+    const double c = 1.0 / std::sqrt(9.0 * d);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    while (true) {
+        const double x = normal(RNG::instance());
+        const double t = 1.0 + c * x;
+        if (t <= 0.0) {
+            continue;
+        }
+        const double v = t * t * t;
+        const double u = RNG::get_random_real(0.0, 1.0);
+        const double x2 = x * x;
+        if (u < 1.0 - 0.0331 * x2 * x2 || std::log(u) < 0.5 * x2 + d * (1.0 - v + std::log(v))) {
+            return d * v;
+        }
+    }
+}
+
+double RNG::get_random_beta(const double alpha,
+                            const double beta)
+{
+    const double x = RNG::get_random_gamma(alpha);
+    const double y = RNG::get_random_gamma(beta);
+    return x + y > 0.0 ? x / (x + y) : 0.5;
+}
+
+std::vector<std::uint32_t> RNG::get_state()
+{
+    // The textual representation is the only portable way to access the state
+    std::stringstream stream;
+    stream << RNG::instance();
+    std::vector<std::uint32_t> state;
+    for (std::uint32_t word; stream >> word;) {
+        state.emplace_back(word);
+    }
+    return state;
+}
+
+bool RNG::set_state(const std::vector<std::uint32_t> &state)
+{
+    std::stringstream stream;
+    for (const std::uint32_t word : state) {
+        stream << word << ' ';
+    }
+    std::mt19937 engine;
+    if (!(stream >> engine)) {
+        return false;
+    }
+    RNG::instance() = engine;
+    return true;
+}
+
 // Explicit template instantiations
 template int RNG::get_random_number<int>(int, int);
 template std::size_t RNG::get_random_number<std::size_t>(std::size_t, std::size_t);
@@ -6,7 +6,9 @@
 
 #pragma once
 
-#include <random>  // for std::mt19937
+#include <cstdint>  // for std::uint32_t
+#include <random>   // for std::mt19937
+#include <vector>   // for std::vector
 
 namespace core::rng {
 
@@ -47,6 +49,53 @@ class RNG final {
      * @return Random boolean value (e.g., "true").
      */
     [[nodiscard]] static bool get_random_bool(const double probability = 0.5);
+
+    /**
+     * @brief Get a random real number in the range [min, max).
+     *
+     * @param min Minimum value (e.g., "0.0").
+     * @param max Maximum value, exclusive (e.g., "1.0").
+     *
+     * @return Random real number in the specified range (e.g., "0.42").
+     */
+    [[nodiscard]] static double get_random_real(const double min,
+                                                const double max);
+
+    /**
+     * @brief Get a random number from a gamma distribution with unit scale.
+     *
+     * @param shape Shape parameter, greater than 0.0 (e.g., "2.5").
+     *
+     * @return Random positive number (e.g., "1.7").
+     */
+    [[nodiscard]] static double get_random_gamma(const double shape);
+
+    /**
+     * @brief Get a random number from a beta distribution.
+     *
+     * @param alpha First shape parameter, greater than 0.0 (e.g., "3.0").
+     * @param beta Second shape parameter, greater than 0.0 (e.g., "1.0").
+     *
+     * @return Random number between 0.0 and 1.0 (e.g., "0.8").
+     */
+    [[nodiscard]] static double get_random_beta(const double alpha,
+                                                const double beta);
+
+    /**
+     * @brief Get the internal state of the static random number generator, so it can be saved and restored later.
+     *
+     * @return Vector of state words (e.g., 624 or 625 words, depending on the standard library).
+     */
+    [[nodiscard]] static std::vector<std::uint32_t> get_state();
+
+    /**
+     * @brief Restore the internal state of the static random number generator.
+     *
+     * @param state Vector of state words previously returned by "get_state()".
+     *
+     * @return True if the state was restored, false if it was invalid (the generator is left unchanged).
+     */
+    static bool set_state(const std::vector<std::uint32_t> &state);
 };
 
 }  // namespace core::rng
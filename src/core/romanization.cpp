@@ -0,0 +1,346 @@
+/**
+ * @file romanization.cpp
+ */
+
+#include <algorithm>    // for std::min
+#include <array>        // for std::array
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint8_t, std::uint32_t
+#include <cstring>      // for std::memcpy
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+
+#include "romanization.hpp"
+#include "utf8.hpp"
+
+namespace core::romanization {
+
+namespace {
+
+/**
+ * @brief Private struct that represents a short piece of romanized text.
+ *
+ * @note The text is copied as a whole, so it is padded with zeros.
+ */
+struct Piece final {
+    std::array<char, 4> text;
+    std::uint8_t length;
+};
+
+/**
+ * @brief Private helper function to build a piece from two strings at compile time.
+ *
+ * @param first First string (e.g., "ng").
+ * @param second Second string (e.g., "n").
+ *
+ * @return Concatenation of both strings (e.g., "ngn"), which must fit in 4 characters.
+ */
+[[nodiscard]] constexpr Piece make_piece(const std::string_view first,
+                                         const std::string_view second = "")
+{
+    Piece piece{{0, 0, 0, 0}, 0};
+    for (const std::string_view part : {first, second}) {
+        for (const char c : part) {
+            piece.text[piece.length++] = c;
+        }
+    }
+    return piece;
+}
+
+/**
+ * @brief Private initials in Unicode syllable order: ㄱ ㄲ ㄴ ㄷ ㄸ ㄹ ㅁ ㅂ ㅃ ㅅ ㅆ ㅇ ㅈ ㅉ ㅊ ㅋ ㅌ ㅍ ㅎ.
+ */
+constexpr std::array<std::string_view, 19> initials = {
+    "g", "kk", "n", "d", "tt", "r", "m", "b", "pp", "s", "ss", "", "j", "jj", "ch", "k", "t", "p", "h"};
+
+/**
+ * @brief Private vowels in Unicode syllable order: ㅏ ㅐ ㅑ ㅒ ㅓ ㅔ ㅕ ㅖ ㅗ ㅘ ㅙ ㅚ ㅛ ㅜ ㅝ ㅞ ㅟ ㅠ ㅡ ㅢ ㅣ.
+ */
+constexpr std::array<std::string_view, 21> vowels = {
+    "a", "ae", "ya", "yae", "eo", "e", "yeo", "ye", "o", "wa", "wae", "oe", "yo", "u", "wo", "we", "wi", "yu", "eu", "ui", "i"};
+
+/**
+ * @brief Private indices of the initials that the sound changes depend on.
+ */
+enum Initial : std::size_t {
+    G = 0,
+    N = 2,
+    D = 3,
+    R = 5,
+    M = 6,
+    S = 9,
+    Ieung = 11,
+    J = 12,
+    H = 18,
+    End = 19  // No syllable follows
+};
+
+/**
+ * @brief Private indices of the finals that the sound changes depend on, in Unicode syllable order.
+ */
+enum Final : std::size_t {
+    None = 0,
+    FinalG = 1,
+    FinalGG = 2,
+    FinalGS = 3,
+    FinalN = 4,
+    FinalNJ = 5,
+    FinalNH = 6,
+    FinalD = 7,
+    FinalL = 8,
+    FinalLG = 9,
+    FinalLB = 11,
+    FinalLT = 13,
+    FinalLH = 15,
+    FinalB = 17,
+    FinalS = 19,
+    FinalSS = 20,
+    FinalJ = 22,
+    FinalCH = 23,
+    FinalK = 24,
+    FinalT = 25,
+    FinalP = 26,
+    FinalH = 27
+};
+
+/**
+ * @brief Private sound of each final before a consonant or at the end of a word: ㄱ ㄲ ㄳ ㄴ ㄵ ㄶ ㄷ ㄹ ㄺ ㄻ ㄼ ㄽ ㄾ ㄿ ㅀ ㅁ ㅂ ㅄ ㅅ ㅆ ㅇ ㅈ ㅊ ㅋ ㅌ ㅍ ㅎ.
+ */
+constexpr std::array<std::string_view, 28> codas = {
+    "", "k", "k", "k", "n", "n", "n", "t", "l", "k", "m", "l", "l", "l", "p", "l", "m", "p", "p", "t", "t", "ng", "t", "t", "k", "t", "p", "t"};
+
+/**
+ * @brief Private remaining final and moved initial of each final before "ㅇ" (liaison).
+ */
+constexpr std::array<std::array<std::string_view, 2>, 28> liaisons = {{
+    {"", ""},
+    {"", "g"},
+    {"", "kk"},
+    {"k", "s"},
+    {"", "n"},
+    {"n", "j"},
+    {"", "n"},
+    {"", "d"},
+    {"", "r"},
+    {"l", "g"},
+    {"l", "m"},
+    {"l", "b"},
+    {"l", "s"},
+    {"l", "t"},
+    {"l", "p"},
+    {"", "r"},
+    {"", "m"},
+    {"", "b"},
+    {"p", "s"},
+    {"", "s"},
+    {"", "ss"},
+    {"ng", ""},
+    {"", "j"},
+    {"", "ch"},
+    {"", "k"},
+    {"", "t"},
+    {"", "p"},
+    {"", ""},
+}};
+
+/**
+ * @brief Private helper function to write a final and the next initial, applying the sound changes between them.
+ *
+ * @param final_index Index of the final of the previous syllable, or 0 if there is none.
+ * @param initial_index Index of the initial of the next syllable, or "End" if no syllable follows.
+ * @param before_i Whether the vowel of the next syllable is "ㅣ".
+ *
+ * @return Romanized final and initial (e.g., "ngn").
+ */
+[[nodiscard]] constexpr Piece make_transition(const std::size_t final_index,
+                                              const std::size_t initial_index,
+                                              const bool before_i)
+{
+    const std::string_view coda = codas[final_index];
+    if (initial_index == End) {
+        return make_piece(coda);
+    }
+    const std::string_view initial = initials[initial_index];
+    if (final_index == None) {
+        return make_piece(initial);
+    }
+
+    // Liaison, where "ㄷ" and "ㅌ" are palatalized before "이"
+    if (initial_index == Ieung) {
+        if (before_i && (final_index == FinalD || final_index == FinalT || final_index == FinalLT)) {
+            return make_piece(final_index == FinalLT ? "l" : "", final_index == FinalD ? "j" : "ch");
+        }
+        return make_piece(liaisons[final_index][0], liaisons[final_index][1]);
+    }
+
+    // Aspiration of a final before "ㅎ"
+    if (initial_index == H) {
+        switch (final_index) {
+        case FinalG:
+        case FinalGG:
+        case FinalK:
+            return make_piece("k");
+        case FinalLG:
+            return make_piece("l", "k");
+        case FinalD:
+            return make_piece(before_i ? "ch" : "t");
+        case FinalS:
+        case FinalSS:
+        case FinalT:
+        case FinalH:
+            return make_piece("t");
+        case FinalJ:
+        case FinalCH:
+            return make_piece("ch");
+        case FinalB:
+        case FinalP:
+            return make_piece("p");
+        case FinalLB:
+            return make_piece("l", "p");
+        default:
+            return make_piece(coda, initial);
+        }
+    }
+
+    // Aspiration or loss of a final "ㅎ" before a consonant
+    if (final_index == FinalH || final_index == FinalNH || final_index == FinalLH) {
+        const std::string_view rest = final_index == FinalH ? "" : (final_index == FinalNH ? "n" : "l");
+        switch (initial_index) {
+        case G:
+            return make_piece(rest, "k");
+        case D:
+            return make_piece(rest, "t");
+        case J:
+            return make_piece(rest, "ch");
+        case S:
+            return make_piece(rest, "s");
+        case N:
+            return final_index == FinalLH ? make_piece("l", "l") : make_piece("n", "n");
+        default:
+            break;
+        }
+    }
+
+    // Nasalization of "k", "t" and "p" before "ㄴ" and "ㅁ", and lateralization of "ㄹ" before "ㄴ"
+    if (initial_index == N || initial_index == M) {
+        if (coda == "l" && initial_index == N) {
+            return make_piece("l", "l");
+        }
+        if (coda == "k") {
+            return make_piece("ng", initial);
+        }
+        if (coda == "t") {
+            return make_piece("n", initial);
+        }
+        if (coda == "p") {
+            return make_piece("m", initial);
+        }
+        return make_piece(coda, initial);
+    }
+
+    // "ㄹ" after "ㄴ" or "ㄹ" is lateralized, and after any other final it is nasalized, which nasalizes "k", "t" and "p" in turn
+    if (initial_index == R) {
+        if (coda == "l" || coda == "n") {
+            return make_piece("l", "l");
+        }
+        if (coda == "k") {
+            return make_piece("ng", "n");
+        }
+        if (coda == "t") {
+            return make_piece("n", "n");
+        }
+        if (coda == "p") {
+            return make_piece("m", "n");
+        }
+        return make_piece(coda, "n");
+    }
+    return make_piece(coda, initial);
+}
+
+/**
+ * @brief Private table of every final and next initial, indexed by "(final * 20 + initial) * 2 + before_i".
+ */
+constexpr std::array<Piece, 28 * 20 * 2> transitions = []() {
+    std::array<Piece, 28 * 20 * 2> table{};
+    for (std::size_t final_index = 0; final_index < 28; ++final_index) {
+        for (std::size_t initial_index = 0; initial_index <= End; ++initial_index) {
+            for (std::size_t before_i = 0; before_i < 2; ++before_i) {
+                table[(final_index * 20 + initial_index) * 2 + before_i] = make_transition(final_index, initial_index, before_i == 1);
+            }
+        }
+    }
+    return table;
+}();
+
+/**
+ * @brief Private table of the vowels as pieces.
+ */
+constexpr std::array<Piece, 21> vowel_pieces = []() {
+    std::array<Piece, 21> table{};
+    for (std::size_t idx = 0; idx < vowels.size(); ++idx) {
+        table[idx] = make_piece(vowels[idx]);
+    }
+    return table;
+}();
+
+/**
+ * @brief Private helper function to write a piece, copying all four characters so the copy has a fixed size.
+ *
+ * @param piece Piece to write.
+ * @param dst Where to write, with room for four characters.
+ *
+ * @return Position after the piece.
+ */
+[[nodiscard]] inline char *write_piece(const Piece &piece,
+                                       char *dst)
+{
+    std::memcpy(dst, piece.text.data(), piece.text.size());
+    return dst + piece.length;
+}
+
+}  // namespace
+
+void romanize(const std::string_view text,
+              std::string &out)
+{
+    // A syllable is 3 bytes and becomes at most 7 characters; anything else is copied as is, and a piece copy may write 3 characters of padding
+    const std::size_t start = out.size();
+    out.resize(start + 3 * text.size() + 8);
+    char *dst = out.data() + start;
+
+    const auto *in = reinterpret_cast<const unsigned char *>(text.data());
+    const std::size_t size = text.size();
+    std::size_t final_index = None;
+    std::size_t pos = 0;
+    while (pos < size) {
+        // A syllable (always 3 bytes) steps the automaton
+        if (const std::uint32_t index = utf8::decode_syllable(in + pos, size - pos); index != utf8::no_syllable) {
+            const std::uint32_t initial_index = index / 588;
+            const std::uint32_t vowel_index = (index / 28) % 21;
+            dst = write_piece(transitions[(final_index * 20 + initial_index) * 2 + (vowel_index == 20 ? 1 : 0)], dst);
+            dst = write_piece(vowel_pieces[vowel_index], dst);
+            final_index = index % 28;
+            pos += 3;
+            continue;
+        }
+
+        // Anything else ends the word, and is copied as is
+        dst = write_piece(transitions[(final_index * 20 + End) * 2], dst);
+        final_index = None;
+        const std::size_t length = std::min(utf8::get_sequence_length(in[pos]), size - pos);
+        std::memcpy(dst, in + pos, length);
+        dst += length;
+        pos += length;
+    }
+    dst = write_piece(transitions[(final_index * 20 + End) * 2], dst);
+    out.resize(static_cast<std::size_t>(dst - out.data()));
+}
+
+std::string romanize(const std::string_view text)
+{
+    std::string out;
+    romanize(text, out);
+    return out;
+}
+
+}  // namespace core::romanization
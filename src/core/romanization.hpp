@@ -0,0 +1,43 @@
+/**
+ * @file romanization.hpp
+ *
+ * @brief Revised Romanization of Korean text.
+ */
+
+#pragma once
+
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+
+namespace core::romanization {
+
+/**
+ * @brief Romanize Korean text with the Revised Romanization of Korean, appending the result to a string.
+ *
+ * Syllables (U+AC00 to U+D7A3) are decomposed arithmetically into initial, vowel and final.
+ * How a final and the next initial are written depends only on the pair (and, for palatalization, on whether the next vowel is "ㅣ"), so every pair is looked up in a table built at compile time that applies the common sound changes:
+ * - Liaison, where a final moves to a following "ㅇ" (e.g., "한국어" gives "hangugeo", and "읽어" gives "ilgeo").
+ * - Nasalization (e.g., "국물" gives "gungmul", and "종로" gives "jongno").
+ * - Lateralization (e.g., "신라" gives "silla", and "설날" gives "seollal").
+ * - Aspiration with "ㅎ" (e.g., "좋고" gives "joko", and "맞히다" gives "machida").
+ * - Palatalization (e.g., "같이" gives "gachi", and "해돋이" gives "haedoji").
+ *
+ * Tensification is not written, as the Revised Romanization does not write it.
+ * Anything that is not a syllable (e.g., spaces, Latin letters or lone jamo) ends the word and is copied as is.
+ *
+ * @param text UTF-8 text (e.g., "안녕하세요").
+ * @param out String that the romanized text is appended to (e.g., "annyeonghaseyo"); reusing it across calls avoids allocations.
+ */
+void romanize(const std::string_view text,
+              std::string &out);
+
+/**
+ * @brief Romanize Korean text with the Revised Romanization of Korean.
+ *
+ * @param text UTF-8 text (e.g., "안녕하세요").
+ *
+ * @return Romanized text (e.g., "annyeonghaseyo").
+ */
+[[nodiscard]] std::string romanize(const std::string_view text);
+
+}  // namespace core::romanization
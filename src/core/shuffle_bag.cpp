@@ -0,0 +1,137 @@
+/**
+ * @file shuffle_bag.cpp
+ */
+
+#include <cstddef>     // for std::size_t
+#include <functional>  // for std::function
+#include <limits>      // for std::numeric_limits
+#include <optional>    // for std::optional, std::nullopt
+#include <utility>     // for std::swap
+#include <vector>      // for std::vector
+
+#include "rng.hpp"
+#include "shuffle_bag.hpp"
+
+namespace core::shuffle_bag {
+
+namespace {
+
+/**
+ * @brief Private marker for an absent item.
+ */
+constexpr std::size_t absent = std::numeric_limits<std::size_t>::max();
+
+}  // namespace
+
+ShuffleBag::ShuffleBag(const std::size_t capacity)
+    : items_(),
+      positions_(capacity, absent),
+      remaining_(0),
+      last_(absent)
+{
+    this->items_.reserve(capacity);
+}
+
+std::optional<std::size_t> ShuffleBag::draw(const std::function<bool(std::size_t)> &is_allowed)
+{
+    if (this->items_.empty()) {
+        return std::nullopt;
+    }
+
+    // Start a new round; every drawn item is simply back in the bag, as the order is decided one draw at a time
+    if (this->remaining_ == 0) {
+        this->remaining_ = this->items_.size();
+    }
+
+    // The item that ended the previous round must not start the next one
+    const auto accepts = [this, &is_allowed](const std::size_t item) {
+        return (item != this->last_ || this->items_.size() == 1) && (!is_allowed || is_allowed(item));
+    };
+
+    // One step of Fisher-Yates: pick a random remaining item; a few retries find an allowed one in O(1) unless most are excluded
+    std::size_t slot = rng::RNG::get_random_number<std::size_t>(0, this->remaining_ - 1);
+    for (std::size_t attempt = 0; attempt < 8 && !accepts(this->items_[slot]); ++attempt) {
+        slot = rng::RNG::get_random_number<std::size_t>(0, this->remaining_ - 1);
+    }
+    if (!accepts(this->items_[slot])) {
+        // Scan from the last random slot for any allowed item; if there is none, keep the random one rather than stall
+        for (std::size_t offset = 1; offset < this->remaining_; ++offset) {
+            if (const std::size_t candidate = (slot + offset) % this->remaining_; accepts(this->items_[candidate])) {
+                slot = candidate;
+                break;
+            }
+        }
+    }
+
+    // Swap the item to the boundary and move the boundary past it
+    this->swap_slots(slot, this->remaining_ - 1);
+    --this->remaining_;
+    this->last_ = this->items_[this->remaining_];
+    return this->last_;
+}
+
+void ShuffleBag::insert(const std::size_t item)
+{
+    if (item >= this->positions_.size() || this->positions_[item] != absent) {
+        return;
+    }
+    // Append, then swap into the undrawn part, so the item is drawn in the current round
+    this->items_.emplace_back(item);
+    this->positions_[item] = this->items_.size() - 1;
+    this->swap_slots(this->items_.size() - 1, this->remaining_);
+    ++this->remaining_;
+}
+
+void ShuffleBag::erase(const std::size_t item)
+{
+    if (item >= this->positions_.size() || this->positions_[item] == absent) {
+        return;
+    }
+    // Move the item to the drawn part, then to the very end, so it can be popped
+    std::size_t slot = this->positions_[item];
+    if (slot < this->remaining_) {
+        this->swap_slots(slot, this->remaining_ - 1);
+        --this->remaining_;
+        slot = this->remaining_;
+    }
+    this->swap_slots(slot, this->items_.size() - 1);
+    this->items_.pop_back();
+    this->positions_[item] = absent;
+}
+
+void ShuffleBag::reserve(const std::size_t capacity)
+{
+    if (capacity > this->positions_.size()) {
+        this->positions_.resize(capacity, absent);
+    }
+}
+
+bool ShuffleBag::contains(const std::size_t item) const
+{
+    return item < this->positions_.size() && this->positions_[item] != absent;
+}
+
+std::size_t ShuffleBag::get_size() const
+{
+    return this->items_.size();
+}
+
+std::size_t ShuffleBag::get_remaining() const
+{
+    return this->remaining_;
+}
+
+const std::vector<std::size_t> &ShuffleBag::get_items() const
+{
+    return this->items_;
+}
+
+void ShuffleBag::swap_slots(const std::size_t lhs,
+                            const std::size_t rhs)
+{
+    std::swap(this->items_[lhs], this->items_[rhs]);
+    this->positions_[this->items_[lhs]] = lhs;
+    this->positions_[this->items_[rhs]] = rhs;
+}
+
+}  // namespace core::shuffle_bag
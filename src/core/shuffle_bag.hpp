@@ -0,0 +1,125 @@
+/**
+ * @file shuffle_bag.hpp
+ *
+ * @brief Shuffle bag that draws every item once per round.
+ */
+
+#pragma once
+
+#include <cstddef>     // for std::size_t
+#include <functional>  // for std::function
+#include <optional>    // for std::optional
+#include <vector>      // for std::vector
+
+namespace core::shuffle_bag {
+
+/**
+ * @brief Class that draws items in random order without repeats until every item was drawn, then starts a new round.
+ *
+ * The bag is permuted lazily, one draw at a time (incremental Fisher-Yates): items before a boundary are still in the bag, and each draw swaps a random one past the boundary.
+ * Items can be inserted and erased mid-round in O(1), as an index of every item's position is kept.
+ * A new round never starts with the item that ended the previous one, so there are no back-to-back repeats.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class ShuffleBag final {
+  public:
+    /**
+     * @brief Construct a new, empty ShuffleBag object.
+     *
+     * @param capacity Number of possible items, which are the integers in [0, capacity) (e.g., "40").
+     */
+    explicit ShuffleBag(const std::size_t capacity);
+
+    /**
+     * @brief Draw the next item. This is O(1), unless most remaining items are not allowed.
+     *
+     * @param is_allowed Function that returns false for items that should not be drawn now (e.g., recently asked ones); they stay in the bag for later in the round (default: allow every item).
+     *
+     * @return Item, or std::nullopt if the bag is empty; if no remaining item is allowed, a disallowed one is drawn anyway.
+     */
+    [[nodiscard]] std::optional<std::size_t> draw(const std::function<bool(std::size_t)> &is_allowed = {});
+
+    /**
+     * @brief Insert an item into the current round. This is O(1).
+     *
+     * @param item Item to insert (e.g., "3"); items out of range or already present are ignored.
+     */
+    void insert(const std::size_t item);
+
+    /**
+     * @brief Erase an item from the bag. This is O(1).
+     *
+     * @param item Item to erase (e.g., "3"); items that are not present are ignored.
+     */
+    void erase(const std::size_t item);
+
+    /**
+     * @brief Raise the number of possible items, keeping the items in the bag and the current round.
+     *
+     * @param capacity Number of possible items, which are the integers in [0, capacity) (e.g., "41"); a smaller number is ignored.
+     */
+    void reserve(const std::size_t capacity);
+
+    /**
+     * @brief Check whether an item is in the bag, drawn or not.
+     *
+     * @param item Item to check (e.g., "3").
+     *
+     * @return True if the item is present, false otherwise.
+     */
+    [[nodiscard]] bool contains(const std::size_t item) const;
+
+    /**
+     * @brief Get the number of items in the bag, drawn or not.
+     *
+     * @return Number of items (e.g., "40").
+     */
+    [[nodiscard]] std::size_t get_size() const;
+
+    /**
+     * @brief Get the number of items left to draw in the current round.
+     *
+     * @return Number of items (e.g., "12").
+     */
+    [[nodiscard]] std::size_t get_remaining() const;
+
+    /**
+     * @brief Get every item in the bag, drawn or not, e.g., to sample from them without disturbing the round.
+     *
+     * @return Const reference to a vector of items, in no particular order; it is reordered by draws, insertions and erasures.
+     */
+    [[nodiscard]] const std::vector<std::size_t> &get_items() const;
+
+  private:
+    /**
+     * @brief Swap two slots of the bag and update the position index.
+     *
+     * @param lhs First slot.
+     * @param rhs Second slot.
+     */
+    void swap_slots(const std::size_t lhs,
+                    const std::size_t rhs);
+
+    /**
+     * @brief Items in the bag: those before "remaining_" are left to draw, the rest were drawn this round.
+     */
+    std::vector<std::size_t> items_;
+
+    /**
+     * @brief Slot of each possible item in "items_", or the maximum value if absent.
+     */
+    std::vector<std::size_t> positions_;
+
+    /**
+     * @brief Number of items left to draw in the current round.
+     */
+    std::size_t remaining_;
+
+    /**
+     * @brief Last drawn item, which must not start the next round, or the maximum value if none.
+     */
+    std::size_t last_;
+};
+
+}  // namespace core::shuffle_bag
@@ -2,17 +2,387 @@
  * @file string.cpp
  */
 
-#include <string>     // for std::string
+#include <cstddef>      // for std::size_t, std::ptrdiff_t
+#include <cstdint>      // for std::uint32_t
+#include <string_view>  // for std::string_view
+#include <type_traits>  // for std::is_same_v
+#include <vector>       // for std::vector
 
 #include <SFML/Graphics.hpp>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>  // for SSE2, SSSE3 and AVX2 intrinsics
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>  // for NEON intrinsics
+#endif
+
 #include "string.hpp"
 
 namespace core::string {
 
-sf::String to_sfml_string(const std::string &utf8_str)
+namespace {
+
+/**
+ * @brief Private replacement character for invalid input (U+FFFD).
+ */
+constexpr std::uint32_t replacement = 0xFFFD;
+
+/**
+ * @brief Private struct that represents how far a vectorized decoder got.
+ */
+struct Run final {
+    std::size_t read;     // Number of bytes read
+    std::size_t written;  // Number of code points written
+};
+
+/**
+ * @brief Private type of a vectorized decoder, which decodes blocks from the start of its input for as long as they are ASCII or Hangul, and stops at the first block that is neither.
+ */
+using Kernel = Run (*)(const unsigned char *in, const std::size_t size, std::uint32_t *out);
+
+/**
+ * @brief Private helper function to decode one code point.
+ *
+ * @param in Input bytes.
+ * @param size Number of input bytes, at least 1.
+ * @param code_point Decoded code point, or U+FFFD if the input starts with an invalid sequence.
+ *
+ * @return Number of bytes read, which is the whole maximal invalid subsequence for invalid input.
+ */
+[[nodiscard]] std::size_t decode_one(const unsigned char *in,
+                                     const std::size_t size,
+                                     std::uint32_t &code_point)
+{
+    const unsigned char lead = in[0];
+    if (lead < 0x80) {
+        code_point = lead;
+        return 1;
+    }
+
+    // The allowed range of the second byte excludes overlong forms, surrogates and code points past U+10FFFF (RFC 3629)
+    std::size_t length = 0;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+        code_point = lead & 0x1Fu;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        code_point = lead & 0x0Fu;
+        low = lead == 0xE0 ? 0xA0 : low;
+        high = lead == 0xED ? 0x9F : high;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        code_point = lead & 0x07u;
+        low = lead == 0xF0 ? 0x90 : low;
+        high = lead == 0xF4 ? 0x8F : high;
+    }
+    else {
+        code_point = replacement;
+        return 1;
+    }
+    for (std::size_t idx = 1; idx < length; ++idx) {
+        if (idx >= size || in[idx] < low || in[idx] > high) {
+            code_point = replacement;
+            return idx;
+        }
+        code_point = (code_point << 6) | (in[idx] & 0x3Fu);
+        low = 0x80;
+        high = 0xBF;
+    }
+    return length;
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+/**
+ * @brief Private helper function to decode 16 ASCII bytes with SSE2, which every x86-64 CPU has.
+ *
+ * @param in Input bytes, at least 16.
+ * @param out Output buffer, with room for 16 code points.
+ *
+ * @return True if the bytes were ASCII and were decoded, false otherwise.
+ */
+[[nodiscard]] inline bool decode_ascii_sse2(const unsigned char *in,
+                                            std::uint32_t *out)
+{
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+    if (_mm_movemask_epi8(bytes) != 0) {
+        return false;
+    }
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+    const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi16(low, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4), _mm_unpackhi_epi16(low, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpacklo_epi16(high, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 12), _mm_unpackhi_epi16(high, zero));
+    return true;
+}
+
+/**
+ * @brief Private vectorized decoder for CPUs with SSE2 only, which decodes ASCII.
+ */
+Run decode_sse2(const unsigned char *in,
+                const std::size_t size,
+                std::uint32_t *out)
+{
+    Run run{0, 0};
+    while (size - run.read >= 16 && decode_ascii_sse2(in + run.read, out + run.written)) {
+        run.read += 16;
+        run.written += 16;
+    }
+    return run;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+
+/**
+ * @brief Private helper function to decode four 3-byte sequences (e.g., Hangul syllables) with SSSE3.
+ *
+ * Each sequence is shuffled into a 32-bit lane, where its structure, its code point, and the absence of overlong forms and surrogates are checked for all four at once.
+ *
+ * @param in Input bytes, at least 16, of which 12 are decoded.
+ * @param out Output buffer, with room for 4 code points.
+ *
+ * @return True if the bytes were four valid 3-byte sequences and were decoded, false otherwise.
+ */
+[[nodiscard]] __attribute__((target("ssse3"))) inline bool decode_hangul_ssse3(const unsigned char *in,
+                                                                              std::uint32_t *out)
+{
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+    const __m128i lanes = _mm_shuffle_epi8(bytes, _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1));
+    const __m128i structure = _mm_cmpeq_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x00F0C0C0)), _mm_set1_epi32(0x00E08080));
+    const __m128i code_points = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(lanes, 4), _mm_set1_epi32(0xF000)),
+                                                          _mm_and_si128(_mm_srli_epi32(lanes, 2), _mm_set1_epi32(0x0FC0))),
+                                             _mm_and_si128(lanes, _mm_set1_epi32(0x003F)));
+    const __m128i plane = _mm_and_si128(code_points, _mm_set1_epi32(0xF800));
+    const __m128i invalid = _mm_or_si128(_mm_cmpeq_epi32(plane, _mm_setzero_si128()), _mm_cmpeq_epi32(plane, _mm_set1_epi32(0xD800)));
+    if (_mm_movemask_epi8(_mm_andnot_si128(invalid, structure)) != 0xFFFF) {
+        return false;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), code_points);
+    return true;
+}
+
+/**
+ * @brief Private vectorized decoder for CPUs with SSSE3, which decodes ASCII and Hangul.
+ */
+__attribute__((target("ssse3"))) Run decode_ssse3(const unsigned char *in,
+                                                  const std::size_t size,
+                                                  std::uint32_t *out)
+{
+    Run run{0, 0};
+    while (size - run.read >= 16) {
+        if (decode_ascii_sse2(in + run.read, out + run.written)) {
+            run.read += 16;
+            run.written += 16;
+        }
+        else if (decode_hangul_ssse3(in + run.read, out + run.written)) {
+            run.read += 12;
+            run.written += 4;
+        }
+        else {
+            break;
+        }
+    }
+    return run;
+}
+
+/**
+ * @brief Private vectorized decoder for CPUs with AVX2, which decodes ASCII and Hangul twice as wide as SSSE3.
+ */
+__attribute__((target("avx2"))) Run decode_avx2(const unsigned char *in,
+                                                const std::size_t size,
+                                                std::uint32_t *out)
+{
+    // Both 128-bit lanes get four 3-byte sequences, as the AVX2 shuffle does not cross lanes
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+                                             2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    Run run{0, 0};
+    while (size - run.read >= 32) {
+        const unsigned char *src = in + run.read;
+        std::uint32_t *dst = out + run.written;
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+        if (_mm256_movemask_epi8(bytes) == 0) {
+            for (std::size_t idx = 0; idx < 32; idx += 8) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + idx), _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + idx))));
+            }
+            run.read += 32;
+            run.written += 32;
+            continue;
+        }
+        const __m256i lanes = _mm256_shuffle_epi8(_mm256_set_m128i(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 12)),
+                                                                   _mm_loadu_si128(reinterpret_cast<const __m128i *>(src))),
+                                                  shuffle);
+        const __m256i structure = _mm256_cmpeq_epi32(_mm256_and_si256(lanes, _mm256_set1_epi32(0x00F0C0C0)), _mm256_set1_epi32(0x00E08080));
+        const __m256i code_points = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(lanes, 4), _mm256_set1_epi32(0xF000)),
+                                                                    _mm256_and_si256(_mm256_srli_epi32(lanes, 2), _mm256_set1_epi32(0x0FC0))),
+                                                    _mm256_and_si256(lanes, _mm256_set1_epi32(0x003F)));
+        const __m256i plane = _mm256_and_si256(code_points, _mm256_set1_epi32(0xF800));
+        const __m256i invalid = _mm256_or_si256(_mm256_cmpeq_epi32(plane, _mm256_setzero_si256()), _mm256_cmpeq_epi32(plane, _mm256_set1_epi32(0xD800)));
+        if (_mm256_movemask_epi8(_mm256_andnot_si256(invalid, structure)) != -1) {
+            break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), code_points);
+        run.read += 24;
+        run.written += 8;
+    }
+
+    // Finish with the narrower blocks, which need fewer bytes; clearing the upper halves first avoids a costly switch between AVX and SSE code
+    _mm256_zeroupper();
+    const Run tail = decode_ssse3(in + run.read, size - run.read, out + run.written);
+    return {run.read + tail.read, run.written + tail.written};
+}
+
+#endif  // defined(__GNUC__) || defined(__clang__)
+
+#elif defined(__aarch64__) || defined(_M_ARM64)
+
+/**
+ * @brief Private helper function to compose the code points of eight 3-byte sequences with NEON.
+ *
+ * @param lead Lead bytes.
+ * @param second Second bytes.
+ * @param third Third bytes.
+ *
+ * @return Code points, which fit in 16 bits.
+ */
+[[nodiscard]] inline uint16x8_t compose_neon(const uint8x8_t lead,
+                                              const uint8x8_t second,
+                                              const uint8x8_t third)
+{
+    return vorrq_u16(vorrq_u16(vshlq_n_u16(vandq_u16(vmovl_u8(lead), vdupq_n_u16(0x0F)), 12),
+                               vshlq_n_u16(vandq_u16(vmovl_u8(second), vdupq_n_u16(0x3F)), 6)),
+                     vandq_u16(vmovl_u8(third), vdupq_n_u16(0x3F)));
+}
+
+/**
+ * @brief Private helper function to check that code points of 3-byte sequences are neither overlong forms nor surrogates.
+ *
+ * @param code_points Code points.
+ *
+ * @return True if every code point is valid, false otherwise.
+ */
+[[nodiscard]] inline bool is_valid_neon(const uint16x8_t code_points)
+{
+    const uint16x8_t plane = vandq_u16(code_points, vdupq_n_u16(0xF800));
+    return vmaxvq_u16(vorrq_u16(vceqq_u16(plane, vdupq_n_u16(0)), vceqq_u16(plane, vdupq_n_u16(0xD800)))) == 0;
+}
+
+/**
+ * @brief Private vectorized decoder for ARM64, which decodes ASCII and Hangul with NEON.
+ *
+ * Hangul is loaded with a de-interleaving load, which puts the lead, second and third bytes of sixteen 3-byte sequences into three registers.
+ */
+Run decode_neon(const unsigned char *in,
+                const std::size_t size,
+                std::uint32_t *out)
+{
+    Run run{0, 0};
+    while (size - run.read >= 16) {
+        const unsigned char *src = in + run.read;
+        std::uint32_t *dst = out + run.written;
+        const uint8x16_t bytes = vld1q_u8(src);
+        if (vmaxvq_u8(bytes) < 0x80) {
+            const uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+            const uint16x8_t high = vmovl_high_u8(bytes);
+            vst1q_u32(dst, vmovl_u16(vget_low_u16(low)));
+            vst1q_u32(dst + 4, vmovl_high_u16(low));
+            vst1q_u32(dst + 8, vmovl_u16(vget_low_u16(high)));
+            vst1q_u32(dst + 12, vmovl_high_u16(high));
+            run.read += 16;
+            run.written += 16;
+            continue;
+        }
+        if (size - run.read < 48) {
+            break;
+        }
+        const uint8x16x3_t sequences = vld3q_u8(src);
+        const uint8x16_t structure = vandq_u8(vceqq_u8(vandq_u8(sequences.val[0], vdupq_n_u8(0xF0)), vdupq_n_u8(0xE0)),
+                                              vandq_u8(vceqq_u8(vandq_u8(sequences.val[1], vdupq_n_u8(0xC0)), vdupq_n_u8(0x80)),
+                                                       vceqq_u8(vandq_u8(sequences.val[2], vdupq_n_u8(0xC0)), vdupq_n_u8(0x80))));
+        if (vminvq_u8(structure) != 0xFF) {
+            break;
+        }
+        const uint16x8_t low = compose_neon(vget_low_u8(sequences.val[0]), vget_low_u8(sequences.val[1]), vget_low_u8(sequences.val[2]));
+        const uint16x8_t high = compose_neon(vget_high_u8(sequences.val[0]), vget_high_u8(sequences.val[1]), vget_high_u8(sequences.val[2]));
+        if (!is_valid_neon(low) || !is_valid_neon(high)) {
+            break;
+        }
+        vst1q_u32(dst, vmovl_u16(vget_low_u16(low)));
+        vst1q_u32(dst + 4, vmovl_high_u16(low));
+        vst1q_u32(dst + 8, vmovl_u16(vget_low_u16(high)));
+        vst1q_u32(dst + 12, vmovl_high_u16(high));
+        run.read += 48;
+        run.written += 16;
+    }
+    return run;
+}
+
+#endif
+
+/**
+ * @brief Private helper function to pick the widest vectorized decoder that the CPU supports.
+ *
+ * @return Decoder, or nullptr if there is none for this platform.
+ */
+[[nodiscard]] Kernel select_kernel()
+{
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+    if (__builtin_cpu_supports("avx2")) {
+        return decode_avx2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return decode_ssse3;
+    }
+    return decode_sse2;
+#elif defined(__x86_64__) || defined(_M_X64)
+    return decode_sse2;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    return decode_neon;
+#else
+    return nullptr;
+#endif
+}
+
+}  // namespace
+
+std::size_t utf8_to_utf32(const std::string_view utf8_str,
+                          std::uint32_t *out)
+{
+    static const Kernel kernel = select_kernel();
+    const auto *in = reinterpret_cast<const unsigned char *>(utf8_str.data());
+    const std::size_t size = utf8_str.size();
+    std::size_t read = 0;
+    std::size_t written = 0;
+    while (read < size) {
+        // Decode vectorized blocks for as long as possible
+        if (kernel != nullptr) {
+            const Run run = kernel(in + read, size - read, out + written);
+            read += run.read;
+            written += run.written;
+        }
+
+        // Then decode a block's worth of bytes one code point at a time, so text that mixes scripts in short runs does not retry the vectorized decoder after every character
+        for (const std::size_t resume = read + 16; read < size && read < resume; ++written) {
+            read += decode_one(in + read, size - read, out[written]);
+        }
+    }
+    return written;
+}
+
+sf::String to_sfml_string(const std::string_view utf8_str)
 {
-    return sf::String::fromUtf8(utf8_str.cbegin(), utf8_str.cend());
+    static_assert(std::is_same_v<sf::Uint32, std::uint32_t>, "SFML code points must be 32-bit unsigned integers");
+    thread_local std::vector<sf::Uint32> buffer;
+    if (buffer.size() < utf8_str.size()) {
+        buffer.resize(utf8_str.size());
+    }
+    const std::size_t length = utf8_to_utf32(utf8_str, buffer.data());
+    return sf::String::fromUtf32(buffer.cbegin(), buffer.cbegin() + static_cast<std::ptrdiff_t>(length));
 }
 
 }  // namespace core::string
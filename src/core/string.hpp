@@ -6,19 +6,37 @@
 
 #pragma once
 
-#include <string>  // for std::string
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t
+#include <string_view>  // for std::string_view
 
 #include <SFML/Graphics.hpp>
 
 namespace core::string {
 
+/**
+ * @brief Decode a UTF-8 string to UTF-32.
+ *
+ * Runs of ASCII and of 3-byte sequences (which is all of Hangul) are validated and decoded in SIMD registers where the CPU supports it (SSE2, SSSE3 or AVX2 on x86-64, NEON on ARM64), and everything else one code point at a time.
+ * Invalid input never stops the decoding: each maximal invalid subsequence (e.g., an overlong form, a surrogate or a truncated sequence) becomes one U+FFFD replacement character.
+ *
+ * @param utf8_str String to decode (e.g., "한글").
+ * @param out Buffer with room for at least "utf8_str.size()" code points, which is enough for any input.
+ *
+ * @return Number of code points written (e.g., "2").
+ */
+[[nodiscard]] std::size_t utf8_to_utf32(const std::string_view utf8_str,
+                                        std::uint32_t *out);
+
 /**
  * @brief Convert a UTF-8 string to an SFML string.
  *
+ * The string is decoded with "utf8_to_utf32()" into a per-thread buffer that is reused across calls, so only the SFML string allocates.
+ *
  * @param utf8_str String to convert (e.g., "Dzień dobry").
  *
  * @return SFML string (e.g., "Dzień dobry").
  */
-[[nodiscard]] sf::String to_sfml_string(const std::string &utf8_str);
+[[nodiscard]] sf::String to_sfml_string(const std::string_view utf8_str);
 
 }  // namespace core::string
@@ -0,0 +1,172 @@
+/**
+ * @file trie.cpp
+ */
+
+#include <algorithm>  // for std::max
+#include <array>      // for std::array
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint16_t, std::uint32_t
+#include <optional>   // for std::optional, std::nullopt
+#include <string>     // for std::string
+#include <utility>    // for std::pair
+#include <vector>     // for std::vector
+
+#include "trie.hpp"
+
+namespace core::trie {
+
+Trie::Trie(const std::vector<std::pair<std::string, std::uint32_t>> &keys)
+    : symbols_(),
+      alphabet_size_(0),
+      transitions_(),
+      value_offsets_(),
+      values_(),
+      key_ranges_(),
+      value_key_offsets_(),
+      value_keys_()
+{
+    // Number the bytes in ascending order, so visiting children by symbol visits keys in lexicographic order
+    std::array<bool, 256> used{};
+    for (const auto &[key, value] : keys) {
+        for (const char c : key) {
+            used[static_cast<unsigned char>(c)] = true;
+        }
+    }
+    for (std::size_t byte = 0; byte < used.size(); ++byte) {
+        if (used[byte]) {
+            this->symbols_[byte] = static_cast<std::uint16_t>(++this->alphabet_size_);
+        }
+    }
+
+    // Insert the keys, remembering which keys end at each node
+    this->transitions_.assign(this->alphabet_size_, dead);
+    std::vector<std::vector<std::uint32_t>> ends(1);
+    for (std::size_t idx = 0; idx < keys.size(); ++idx) {
+        if (keys[idx].first.empty()) {
+            continue;
+        }
+        State node = root;
+        for (const char c : keys[idx].first) {
+            const std::size_t slot = node * this->alphabet_size_ + this->symbols_[static_cast<unsigned char>(c)] - 1;
+            if (this->transitions_[slot] == dead) {
+                this->transitions_[slot] = static_cast<State>(ends.size());
+                this->transitions_.resize(this->transitions_.size() + this->alphabet_size_, dead);
+                ends.emplace_back();
+            }
+            node = this->transitions_[slot];
+        }
+        ends[node].emplace_back(static_cast<std::uint32_t>(idx));
+    }
+
+    // Group the values of the keys by the node they end at
+    this->value_offsets_.reserve(ends.size() + 1);
+    this->value_offsets_.emplace_back(0);
+    for (const auto &node_keys : ends) {
+        for (const std::uint32_t key : node_keys) {
+            this->values_.emplace_back(keys[key].second);
+        }
+        this->value_offsets_.emplace_back(static_cast<std::uint32_t>(this->values_.size()));
+    }
+
+    // Number the keys in lexicographic order with a depth-first walk, and store the range of numbers below each node
+    std::vector<std::uint32_t> key_numbers(keys.size(), 0);
+    this->key_ranges_.assign(ends.size(), {0, 0});
+    std::uint32_t counter = 0;
+    std::vector<std::pair<State, std::size_t>> stack = {{root, 0}};
+    this->key_ranges_[root].first = counter;
+    for (const std::uint32_t key : ends[root]) {
+        key_numbers[key] = counter++;
+    }
+    while (!stack.empty()) {
+        auto &[node, symbol] = stack.back();
+        if (symbol == this->alphabet_size_) {
+            this->key_ranges_[node].second = counter;
+            stack.pop_back();
+            continue;
+        }
+        const State child = this->transitions_[node * this->alphabet_size_ + symbol++];
+        if (child != dead) {
+            this->key_ranges_[child].first = counter;
+            for (const std::uint32_t key : ends[child]) {
+                key_numbers[key] = counter++;
+            }
+            stack.emplace_back(child, 0);
+        }
+    }
+
+    // Group the key numbers by value
+    std::uint32_t max_value = 0;
+    for (const auto &[key, value] : keys) {
+        max_value = std::max(max_value, value);
+    }
+    this->value_key_offsets_.assign(keys.empty() ? 1 : static_cast<std::size_t>(max_value) + 2, 0);
+    for (std::size_t idx = 0; idx < keys.size(); ++idx) {
+        if (!keys[idx].first.empty()) {
+            ++this->value_key_offsets_[keys[idx].second + 1];
+        }
+    }
+    for (std::size_t idx = 1; idx < this->value_key_offsets_.size(); ++idx) {
+        this->value_key_offsets_[idx] += this->value_key_offsets_[idx - 1];
+    }
+    this->value_keys_.resize(this->value_key_offsets_.back());
+    std::vector<std::uint32_t> cursors(this->value_key_offsets_.cbegin(), this->value_key_offsets_.cend() - 1);
+    for (std::size_t idx = 0; idx < keys.size(); ++idx) {
+        if (!keys[idx].first.empty()) {
+            this->value_keys_[cursors[keys[idx].second]++] = key_numbers[idx];
+        }
+    }
+}
+
+Trie::State Trie::step(const State state,
+                       const char c) const
+{
+    const std::uint16_t symbol = this->symbols_[static_cast<unsigned char>(c)];
+    if (state == dead || symbol == 0) {
+        return dead;
+    }
+    return this->transitions_[state * this->alphabet_size_ + symbol - 1];
+}
+
+bool Trie::contains(const State state,
+                    const std::uint32_t value) const
+{
+    if (state == dead) {
+        return false;
+    }
+    for (std::uint32_t idx = this->value_offsets_[state]; idx < this->value_offsets_[state + 1]; ++idx) {
+        if (this->values_[idx] == value) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Trie::can_reach(const State state,
+                     const std::uint32_t value) const
+{
+    if (state == dead || static_cast<std::size_t>(value) + 1 >= this->value_key_offsets_.size()) {
+        return false;
+    }
+    const auto [first, last] = this->key_ranges_[state];
+    for (std::uint32_t idx = this->value_key_offsets_[value]; idx < this->value_key_offsets_[value + 1]; ++idx) {
+        if (this->value_keys_[idx] >= first && this->value_keys_[idx] < last) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::optional<std::uint32_t> Trie::get_value(const State state) const
+{
+    if (state == dead || this->value_offsets_[state] == this->value_offsets_[state + 1]) {
+        return std::nullopt;
+    }
+    return this->values_[this->value_offsets_[state]];
+}
+
+std::size_t Trie::get_num_nodes() const
+{
+    return this->key_ranges_.size();
+}
+
+}  // namespace core::trie
@@ -0,0 +1,144 @@
+/**
+ * @file trie.hpp
+ *
+ * @brief Prefix trie with constant-time transitions.
+ */
+
+#pragma once
+
+#include <array>     // for std::array
+#include <cstddef>   // for std::size_t
+#include <cstdint>   // for std::uint16_t, std::uint32_t
+#include <limits>    // for std::numeric_limits
+#include <optional>  // for std::optional
+#include <string>    // for std::string
+#include <utility>   // for std::pair
+#include <vector>    // for std::vector
+
+namespace core::trie {
+
+/**
+ * @brief Class that maps strings to values and matches them one character at a time.
+ *
+ * Every node stores a dense row of transitions over the alphabet of the keys, where each byte is first mapped to its position in that alphabet, so a step is two array lookups and never allocates.
+ * Keys are numbered in lexicographic order, and every node stores the range of the keys below it, so checking whether a value is still reachable from a node is O(number of keys of that value).
+ * A key may map to several values (e.g., "k" for both "ㅋ" and "ㄱ"), and a value may have several keys (e.g., "g" and "k" for "ㄱ").
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Trie final {
+  public:
+    /**
+     * @brief Type of a position in the trie, i.e., the node reached by the characters matched so far.
+     */
+    using State = std::uint32_t;
+
+    /**
+     * @brief State before any character was matched.
+     */
+    static constexpr State root = 0;
+
+    /**
+     * @brief State after a character that no key continues with; it never leaves this state.
+     */
+    static constexpr State dead = std::numeric_limits<State>::max();
+
+    /**
+     * @brief Construct a new Trie object.
+     *
+     * @param keys Pairs of non-empty key and value (e.g., {{"g", 12}, {"k", 12}, {"k", 22}}); empty keys are ignored.
+     */
+    explicit Trie(const std::vector<std::pair<std::string, std::uint32_t>> &keys);
+
+    /**
+     * @brief Match one more character. This is O(1).
+     *
+     * @param state Current state (e.g., "Trie::root").
+     * @param c Next character (e.g., 'y').
+     *
+     * @return Next state, or "Trie::dead" if no key continues with the character.
+     */
+    [[nodiscard]] State step(const State state,
+                             const char c) const;
+
+    /**
+     * @brief Check whether the characters matched so far form a key of a value.
+     *
+     * @param state Current state.
+     * @param value Value to check (e.g., "12").
+     *
+     * @return True if a key that ends at the state maps to the value, false otherwise.
+     */
+    [[nodiscard]] bool contains(const State state,
+                                const std::uint32_t value) const;
+
+    /**
+     * @brief Check whether the characters matched so far are a prefix of a key of a value (including the key itself).
+     *
+     * @param state Current state.
+     * @param value Value to check (e.g., "12").
+     *
+     * @return True if the value can still be reached, false otherwise.
+     */
+    [[nodiscard]] bool can_reach(const State state,
+                                 const std::uint32_t value) const;
+
+    /**
+     * @brief Get the first value of the key that ends at a state.
+     *
+     * @param state Current state.
+     *
+     * @return Value (e.g., "12"), or std::nullopt if no key ends at the state.
+     */
+    [[nodiscard]] std::optional<std::uint32_t> get_value(const State state) const;
+
+    /**
+     * @brief Get the number of nodes, including the root.
+     *
+     * @return Number of nodes (e.g., "70").
+     */
+    [[nodiscard]] std::size_t get_num_nodes() const;
+
+  private:
+    /**
+     * @brief Position of each byte in the alphabet plus one, or 0 for bytes that no key contains.
+     */
+    std::array<std::uint16_t, 256> symbols_;
+
+    /**
+     * @brief Number of distinct bytes in the keys.
+     */
+    std::size_t alphabet_size_;
+
+    /**
+     * @brief Transitions of every node, "alphabet_size_" per node, where "Trie::dead" marks a missing child.
+     */
+    std::vector<State> transitions_;
+
+    /**
+     * @brief Range of the values of the keys that end at each node within "values_", "get_num_nodes() + 1" offsets.
+     */
+    std::vector<std::uint32_t> value_offsets_;
+
+    /**
+     * @brief Values of the keys that end at each node, grouped by node.
+     */
+    std::vector<std::uint32_t> values_;
+
+    /**
+     * @brief First and one-past-last lexicographic key number below each node.
+     */
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> key_ranges_;
+
+    /**
+     * @brief Range of the key numbers of each value within "value_keys_", "max value + 2" offsets.
+     */
+    std::vector<std::uint32_t> value_key_offsets_;
+
+    /**
+     * @brief Lexicographic key numbers of each value, grouped by value.
+     */
+    std::vector<std::uint32_t> value_keys_;
+};
+
+}  // namespace core::trie
@@ -0,0 +1,99 @@
+/**
+ * @file utf8.hpp
+ *
+ * @brief UTF-8 helpers shared by the text engines (romanization, pronunciation and normalization).
+ */
+
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t
+
+namespace core::utf8 {
+
+/**
+ * @brief First precomposed Hangul syllable, "가" (U+AC00).
+ */
+inline constexpr char32_t first_syllable = 0xAC00;
+
+/**
+ * @brief Number of precomposed Hangul syllables (U+AC00 to U+D7A3).
+ */
+inline constexpr std::uint32_t num_syllables = 11172;
+
+/**
+ * @brief Marker returned by "decode_syllable()" when the bytes are not a Hangul syllable.
+ */
+inline constexpr std::uint32_t no_syllable = 0xFFFFFFFF;
+
+/**
+ * @brief Decode a 3-byte UTF-8 sequence (U+0800 to U+FFFF).
+ *
+ * @param in Bytes to decode.
+ * @param size Number of bytes available (e.g., "12").
+ *
+ * @return Code point (e.g., U+D55C), or 0 if the bytes do not start with a 3-byte sequence.
+ */
+[[nodiscard]] inline char32_t decode3(const unsigned char *in,
+                                      const std::size_t size)
+{
+    if (size < 3 || (in[0] & 0xF0) != 0xE0 || (in[1] & 0xC0) != 0x80 || (in[2] & 0xC0) != 0x80) {
+        return 0;
+    }
+    return ((in[0] & 0x0Fu) << 12) | ((in[1] & 0x3Fu) << 6) | (in[2] & 0x3Fu);
+}
+
+/**
+ * @brief Encode a code point from U+0800 to U+FFFF as 3-byte UTF-8.
+ *
+ * @param code_point Code point (e.g., U+D55C).
+ * @param dst Where to write, with room for three bytes.
+ *
+ * @return Position after the sequence.
+ */
+[[nodiscard]] inline char *encode3(const char32_t code_point,
+                                   char *dst)
+{
+    dst[0] = static_cast<char>(0xE0 | (code_point >> 12));
+    dst[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    dst[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+    return dst + 3;
+}
+
+/**
+ * @brief Decode a precomposed Hangul syllable, which is always 3 bytes ("EA B0 80" to "ED 9E A3").
+ *
+ * @param in Bytes to decode.
+ * @param size Number of bytes available (e.g., "12").
+ *
+ * @return Index of the syllable from "가" (e.g., "0" for "가"), which splits into (initial * 21 + vowel) * 28 + final, or "no_syllable".
+ */
+[[nodiscard]] inline std::uint32_t decode_syllable(const unsigned char *in,
+                                                   const std::size_t size)
+{
+    const char32_t code_point = decode3(in, size);
+    return code_point >= first_syllable && code_point < first_syllable + num_syllables ? static_cast<std::uint32_t>(code_point - first_syllable) : no_syllable;
+}
+
+/**
+ * @brief Get the length of the UTF-8 character that starts with a byte.
+ *
+ * @param lead First byte.
+ *
+ * @return Number of bytes (e.g., "3"); stray continuation and invalid bytes count as one.
+ */
+[[nodiscard]] inline std::size_t get_sequence_length(const unsigned char lead)
+{
+    if (lead >= 0xF0 && lead <= 0xF4) {
+        return 4;
+    }
+    if (lead >= 0xE0 && lead <= 0xEF) {
+        return 3;
+    }
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        return 2;
+    }
+    return 1;
+}
+
+}  // namespace core::utf8
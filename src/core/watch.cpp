@@ -0,0 +1,112 @@
+/**
+ * @file watch.cpp
+ */
+
+#include <chrono>        // for std::chrono
+#include <cstddef>       // for std::size_t
+#include <cstring>       // for std::memcpy, std::strcmp
+#include <filesystem>    // for std::filesystem
+#include <string>        // for std::string
+#include <system_error>  // for std::error_code
+
+#if defined(__linux__)
+#include <sys/inotify.h>  // for inotify_init1, inotify_add_watch, struct inotify_event, IN_CLOSE_WRITE, IN_MOVED_TO
+#include <unistd.h>       // for read, close
+#endif
+
+#include "watch.hpp"
+
+namespace core::watch {
+
+FileWatcher::FileWatcher(const std::filesystem::path &path,
+                         const Mode mode,
+                         const std::chrono::milliseconds interval)
+    : path_(path),
+      interval_(interval),
+      checked_at_(std::chrono::steady_clock::now()),
+      stamp_(),
+      inotify_fd_(-1)
+{
+#if defined(__linux__)
+    // Watch the directory rather than the file, whose inode changes when an editor saves by renaming
+    if (mode == Mode::Auto) {
+        this->inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        const std::filesystem::path directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+        if (this->inotify_fd_ >= 0 && inotify_add_watch(this->inotify_fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            close(this->inotify_fd_);
+            this->inotify_fd_ = -1;
+        }
+    }
+#else
+    static_cast<void>(mode);
+#endif
+    if (this->inotify_fd_ < 0) {
+        this->stamp_ = this->get_stamp();
+    }
+}
+
+FileWatcher::~FileWatcher()
+{
+#if defined(__linux__)
+    if (this->inotify_fd_ >= 0) {
+        close(this->inotify_fd_);
+    }
+#endif
+}
+
+bool FileWatcher::has_changed()
+{
+#if defined(__linux__)
+    if (this->inotify_fd_ >= 0) {
+        // Drain every queued event, as several writes in a row (e.g., a save in chunks) need only one reload
+        bool changed = false;
+        const std::string filename = this->path_.filename().string();
+        alignas(inotify_event) char buffer[4096];
+        for (;;) {
+            const ssize_t length = read(this->inotify_fd_, buffer, sizeof(buffer));
+            if (length <= 0) {
+                break;
+            }
+            for (std::size_t offset = 0; offset < static_cast<std::size_t>(length);) {
+                inotify_event event;
+                std::memcpy(&event, buffer + offset, sizeof(event));
+                if (event.len > 0 && std::strcmp(buffer + offset + sizeof(event), filename.c_str()) == 0) {
+                    changed = true;
+                }
+                offset += sizeof(event) + event.len;
+            }
+        }
+        return changed;
+    }
+#endif
+    const auto now = std::chrono::steady_clock::now();
+    if (now - this->checked_at_ < this->interval_) {
+        return false;
+    }
+    this->checked_at_ = now;
+    const Stamp stamp = this->get_stamp();
+    if (stamp == this->stamp_) {
+        return false;
+    }
+    this->stamp_ = stamp;
+    return true;
+}
+
+bool FileWatcher::is_polling() const
+{
+    return this->inotify_fd_ < 0;
+}
+
+FileWatcher::Stamp FileWatcher::get_stamp() const
+{
+    // A missing file (e.g., between deleting and writing it again) has a stamp of its own
+    std::error_code error;
+    const auto modified = std::filesystem::last_write_time(this->path_, error);
+    if (error) {
+        return {std::filesystem::file_time_type::min(), 0};
+    }
+    const std::uintmax_t size = std::filesystem::file_size(this->path_, error);
+    return {modified, error ? 0 : size};
+}
+
+}  // namespace core::watch
@@ -0,0 +1,115 @@
+/**
+ * @file watch.hpp
+ *
+ * @brief Watch a file for changes (e.g., a deck edited while the app runs).
+ */
+
+#pragma once
+
+#include <chrono>      // for std::chrono
+#include <cstdint>     // for std::uintmax_t
+#include <filesystem>  // for std::filesystem
+
+namespace core::watch {
+
+/**
+ * @brief Enum that represents how a file is watched.
+ */
+enum class Mode {
+    Auto,     // inotify on Linux, falling back to polling if it is unavailable
+    Polling,  // Compare the modification time and size at an interval
+};
+
+/**
+ * @brief Class that reports when a file was written.
+ *
+ * On Linux, the directory of the file is watched with inotify, so a file that an editor replaces by renaming a temporary file over it is still followed, and checking costs one non-blocking read.
+ * Elsewhere, or if inotify is unavailable (e.g., out of watches), the modification time and size of the file are compared at most once per interval.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class FileWatcher final {
+  public:
+    /**
+     * @brief Start watching a file, which need not exist yet.
+     *
+     * @param path Path to the file (e.g., "~/.local/share/aegyo/deck.tsv").
+     * @param mode How to watch the file (default: inotify if available).
+     * @param interval Minimum time between two checks when polling (default: 500 ms).
+     */
+    explicit FileWatcher(const std::filesystem::path &path,
+                         const Mode mode = Mode::Auto,
+                         const std::chrono::milliseconds interval = std::chrono::milliseconds(500));
+
+    /**
+     * @brief Stop watching the file.
+     */
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher &) = delete;
+    FileWatcher &operator=(const FileWatcher &) = delete;
+
+    /**
+     * @brief Check whether the file was written or replaced since the last check, without blocking. This is cheap enough to call every frame.
+     *
+     * @return True if the file changed, false otherwise.
+     */
+    [[nodiscard]] bool has_changed();
+
+    /**
+     * @brief Check whether the file is polled rather than watched with inotify.
+     *
+     * @return True if polling, false otherwise.
+     */
+    [[nodiscard]] bool is_polling() const;
+
+  private:
+    /**
+     * @brief Struct that represents what polling compares between two checks.
+     *
+     * @note This struct is marked as `final` to prevent inheritance.
+     */
+    struct Stamp final {
+        std::filesystem::file_time_type modified;  // Last write time, or the minimum value if the file is missing
+        std::uintmax_t size;                       // Size in bytes, or 0 if the file is missing
+
+        [[nodiscard]] bool operator==(const Stamp &other) const
+        {
+            return this->modified == other.modified && this->size == other.size;
+        }
+    };
+
+    /**
+     * @brief Get the current stamp of the file.
+     *
+     * @return Stamp of the file.
+     */
+    [[nodiscard]] Stamp get_stamp() const;
+
+    /**
+     * @brief Path to the file.
+     */
+    std::filesystem::path path_;
+
+    /**
+     * @brief Minimum time between two checks when polling.
+     */
+    std::chrono::milliseconds interval_;
+
+    /**
+     * @brief Time of the last check when polling.
+     */
+    std::chrono::steady_clock::time_point checked_at_;
+
+    /**
+     * @brief Stamp of the file at the last check when polling.
+     */
+    Stamp stamp_;
+
+    /**
+     * @brief Non-blocking inotify descriptor, or -1 when polling.
+     */
+    int inotify_fd_;
+};
+
+}  // namespace core::watch
@@ -0,0 +1,223 @@
+/**
+ * @file export.cpp
+ */
+
+#include <algorithm>  // for std::min
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint32_t
+#include <cstdio>     // for std::FILE, std::fopen, std::fclose
+#include <cstdlib>    // for EXIT_FAILURE, EXIT_SUCCESS
+#include <exception>  // for std::exception
+#include <random>     // for std::random_device
+#include <stdexcept>  // for std::runtime_error
+#include <string>     // for std::string, std::stoull
+#include <utility>    // for std::pair, std::move
+#include <vector>     // for std::vector
+
+#include <fmt/core.h>
+
+#include "modules/deck.hpp"
+#include "modules/vocabulary.hpp"
+#include "modules/worksheet.hpp"
+#if defined(_WIN32)
+#include "core/io.hpp"
+#endif
+
+namespace {
+
+/**
+ * @brief Private helper function to parse a non-negative integer argument.
+ *
+ * @param name Name of the option, used in the error message (e.g., "--rows").
+ * @param value Text of the argument (e.g., "1000000").
+ *
+ * @return Parsed number (e.g., "1000000").
+ *
+ * @throws std::runtime_error If the text is not a non-negative integer.
+ */
+[[nodiscard]] std::size_t parse_number(const std::string &name,
+                                       const std::string &value)
+{
+    try {
+        std::size_t end = 0;
+        const unsigned long long number = std::stoull(value, &end);
+        if (end == value.size() && value.find('-') == std::string::npos) {
+            return static_cast<std::size_t>(number);
+        }
+    }
+    catch (const std::exception &) {
+        // Fall through to the error below
+    }
+    throw std::runtime_error(fmt::format("Invalid value '{}' for '{}', expected a non-negative integer", value, name));
+}
+
+/**
+ * @brief Private helper function to enable only the listed categories of a vocabulary.
+ *
+ * @param vocabulary Vocabulary to update.
+ * @param list Comma-separated category labels, as on the app's toggle buttons (e.g., "vow,dcon").
+ *
+ * @throws std::runtime_error If a label is unknown.
+ */
+void set_categories(modules::vocabulary::Vocabulary &vocabulary,
+                    const std::string &list)
+{
+    const std::vector<std::pair<std::string, modules::vocabulary::Category>> labels = {
+        {"vow", modules::vocabulary::Category::BasicVowel},
+        {"con", modules::vocabulary::Category::BasicConsonant},
+        {"dcon", modules::vocabulary::Category::DoubleConsonant},
+        {"compv", modules::vocabulary::Category::CompoundVowel}};
+    std::vector<bool> enabled(labels.size(), false);
+    std::size_t begin = 0;
+    while (begin <= list.size()) {
+        const std::size_t end = std::min(list.find(',', begin), list.size());
+        const std::string label = list.substr(begin, end - begin);
+        bool found = false;
+        for (std::size_t idx = 0; idx < labels.size(); ++idx) {
+            if (labels[idx].first == label) {
+                enabled[idx] = true;
+                found = true;
+            }
+        }
+        if (!found) {
+            throw std::runtime_error(fmt::format("Unknown category '{}', expected 'vow', 'con', 'dcon' or 'compv'", label));
+        }
+        begin = end + 1;
+    }
+    for (std::size_t idx = 0; idx < labels.size(); ++idx) {
+        vocabulary.set_category_enabled(labels[idx].second, enabled[idx]);
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Entry-point of the export application.
+ *
+ * @param argc Number of command-line arguments (e.g., "3").
+ * @param argv Array of command-line arguments (e.g., {"./bin", "--rows", "1000"}).
+ *
+ * @return EXIT_SUCCESS if the export application ran successfully, EXIT_FAILURE otherwise.
+ */
+int main(int argc,
+         char **argv)
+{
+#if defined(_WIN32)
+    // Setup UTF-8 input/output on Windows (does nothing on other platforms)
+    if (const auto e = core::io::setup_utf8_console(); e.has_value()) {
+        fmt::print(stderr, "Warning: {}\n", *e);
+    }
+#endif
+
+    // Define the formatted help message
+    const std::string help_message = fmt::format(
+        "Usage: {} [options]\n"
+        "\n"
+        "Export generated questions (e.g., for printed worksheets and analytics).\n"
+        "\n"
+        "Options:\n"
+        "  --format FORMAT    'tsv' or 'jsonl' (default: tsv)\n"
+        "  --rows N           number of questions (default: 1000000)\n"
+        "  --options N        number of options per question, from 2 to 9 as in the app (default: 4)\n"
+        "  --seed N           seed of the random number generators (default: random)\n"
+        "  --threads N        number of generator threads, 0 for one per hardware thread (default: 0)\n"
+        "  --categories LIST  comma-separated categories among 'vow', 'con', 'dcon' and 'compv' (default: all)\n"
+        "  --filter QUERY     only entries whose tags match, e.g., 'vowel & !compound' (default: all)\n"
+        "  --deck PATH        CSV or TSV file of entries: Korean, transliteration, memo, tags (default: built-in)\n"
+        "  --output PATH      file to write to (default: standard output)\n"
+        "  -h, --help         show this help message\n",
+        argv[0]);
+
+    try {
+        modules::worksheet::Options options{1000000, 4, std::random_device{}(), 0, modules::worksheet::Format::Tsv};
+        std::string categories;
+        std::string filter;
+        std::string deck;
+        std::string output;
+
+        // Parse the command-line arguments
+        for (int idx = 1; idx < argc; ++idx) {
+            const std::string arg = argv[idx];
+            if (arg == "-h" || arg == "--help") {
+                fmt::print("{}\n", help_message);
+                return EXIT_SUCCESS;
+            }
+            if (idx + 1 >= argc) {
+                throw std::runtime_error(fmt::format("Unknown or incomplete argument '{}'\n\n{}", arg, help_message));
+            }
+            const std::string value = argv[++idx];
+            if (arg == "--format" && (value == "tsv" || value == "jsonl")) {
+                options.format = value == "tsv" ? modules::worksheet::Format::Tsv : modules::worksheet::Format::Jsonl;
+            }
+            else if (arg == "--rows") {
+                options.num_rows = parse_number(arg, value);
+            }
+            else if (arg == "--options") {
+                options.num_options = parse_number(arg, value);
+                if (options.num_options < 2 || options.num_options > 9) {
+                    throw std::runtime_error(fmt::format("Invalid value '{}' for '{}', expected a number from 2 to 9", value, arg));
+                }
+            }
+            else if (arg == "--seed") {
+                options.seed = static_cast<std::uint32_t>(parse_number(arg, value));
+            }
+            else if (arg == "--threads") {
+                options.num_threads = parse_number(arg, value);
+            }
+            else if (arg == "--categories") {
+                categories = value;
+            }
+            else if (arg == "--filter") {
+                filter = value;
+            }
+            else if (arg == "--deck") {
+                deck = value;
+            }
+            else if (arg == "--output") {
+                output = value;
+            }
+            else {
+                throw std::runtime_error(fmt::format("Invalid argument '{} {}'\n\n{}", arg, value, help_message));
+            }
+        }
+
+        // Build the vocabulary from the deck, if any, before selecting its entries
+        std::vector<modules::vocabulary::Entry> entries;
+        if (!deck.empty()) {
+            const auto summary = modules::deck::import(deck, {}, entries);
+            fmt::print(stderr, "Imported {} entries ({:.1f} MiB) in {:.2f} s: {:.0f} rows/s\n",
+                       summary.num_rows,
+                       static_cast<double>(summary.num_bytes) / (1024.0 * 1024.0),
+                       summary.seconds,
+                       summary.get_rows_per_second());
+        }
+        modules::vocabulary::Vocabulary vocabulary = deck.empty() ? modules::vocabulary::Vocabulary() : modules::vocabulary::Vocabulary(std::move(entries));
+        if (!categories.empty()) {
+            set_categories(vocabulary, categories);
+        }
+        vocabulary.set_query(filter);
+
+        // Write to the file in binary mode, so rows end with "\n" on every platform
+        std::FILE *file = output.empty() ? stdout : std::fopen(output.c_str(), "wb");
+        if (file == nullptr) {
+            throw std::runtime_error(fmt::format("Failed to open '{}' for writing", output));
+        }
+        const auto summary = modules::worksheet::write(vocabulary, options, file);
+        if (file != stdout && std::fclose(file) != 0) {
+            throw std::runtime_error(fmt::format("Failed to close '{}'", output));
+        }
+
+        // Report on standard error, so the output can be piped
+        fmt::print(stderr, "Exported {} questions ({:.1f} MiB, seed {}) in {:.2f} s: {:.0f} questions/s\n",
+                   summary.num_rows,
+                   static_cast<double>(summary.num_bytes) / (1024.0 * 1024.0),
+                   options.seed,
+                   summary.seconds,
+                   summary.get_rows_per_second());
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "{}\n", e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+/**
+ * @file confusion.cpp
+ */
+
+#include <algorithm>  // for std::sort, std::find
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint32_t, std::uint64_t
+#include <limits>     // for std::numeric_limits
+#include <utility>    // for std::pair
+#include <vector>     // for std::vector
+
+#include "confusion.hpp"
+
+namespace modules::confusion {
+
+namespace {
+
+/**
+ * @brief Private marker for an empty slot in the sparse table.
+ */
+constexpr std::uint64_t empty_key = std::numeric_limits<std::uint64_t>::max();
+
+/**
+ * @brief Private marker for an empty slot in a list of confusions.
+ */
+constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Private helper function to pack a pair of IDs into a key.
+ *
+ * @param asked_id ID of the entry that was asked.
+ * @param chosen_id ID of the entry that was chosen instead.
+ *
+ * @return Key of the pair.
+ */
+[[nodiscard]] std::uint64_t make_key(const std::size_t asked_id,
+                                     const std::size_t chosen_id)
+{
+    return (static_cast<std::uint64_t>(asked_id) << 32) | static_cast<std::uint64_t>(chosen_id);
+}
+
+/**
+ * @brief Private helper function to get the smallest power of two that is not less than a value.
+ *
+ * @param value Value to round up (e.g., "100").
+ *
+ * @return Power of two (e.g., "128").
+ */
+[[nodiscard]] std::size_t round_up_to_power_of_two(const std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+}  // namespace
+
+Confusion::Confusion(const std::size_t num_entries,
+                     const std::size_t dense_limit,
+                     const std::size_t max_pairs)
+    : num_entries_(num_entries),
+      max_pairs_(max_pairs > 0 ? max_pairs : 1),
+      dense_(),
+      keys_(),
+      counts_(),
+      num_pairs_(0),
+      listed_(num_entries * max_listed, none)
+{
+    if (num_entries <= dense_limit) {
+        this->dense_.assign(num_entries * num_entries, 0);
+    }
+    else {
+        // Keep the load factor at or below one half, so probe sequences stay short
+        const std::size_t capacity = round_up_to_power_of_two(this->max_pairs_ * 2);
+        this->keys_.assign(capacity, empty_key);
+        this->counts_.assign(capacity, 0);
+    }
+}
+
+void Confusion::record(const std::size_t asked_id,
+                       const std::size_t chosen_id)
+{
+    if (asked_id >= this->num_entries_ || chosen_id >= this->num_entries_) {
+        return;
+    }
+    this->add({static_cast<std::uint32_t>(asked_id), static_cast<std::uint32_t>(chosen_id), 1});
+}
+
+void Confusion::add(const Pair &pair)
+{
+    if (pair.asked_id >= this->num_entries_ || pair.chosen_id >= this->num_entries_ || pair.asked_id == pair.chosen_id || pair.count == 0) {
+        return;
+    }
+    const std::uint32_t count = this->increment(pair.asked_id, pair.chosen_id, pair.count);
+    this->update_listed(pair.asked_id, pair.chosen_id, count);
+}
+
+std::uint32_t Confusion::get_count(const std::size_t asked_id,
+                                   const std::size_t chosen_id) const
+{
+    if (asked_id >= this->num_entries_ || chosen_id >= this->num_entries_) {
+        return 0;
+    }
+    if (this->is_dense()) {
+        return this->dense_[asked_id * this->num_entries_ + chosen_id];
+    }
+    const std::size_t slot = this->find_slot(make_key(asked_id, chosen_id));
+    return this->keys_[slot] == empty_key ? 0 : this->counts_[slot];
+}
+
+std::vector<std::size_t> Confusion::get_confusions(const std::size_t asked_id) const
+{
+    std::vector<std::pair<std::uint32_t, std::size_t>> counted;
+    if (asked_id >= this->num_entries_) {
+        return {};
+    }
+    for (std::size_t idx = 0; idx < max_listed; ++idx) {
+        const std::uint32_t chosen_id = this->listed_[asked_id * max_listed + idx];
+        if (chosen_id == none) {
+            continue;
+        }
+        // Counts may have decayed since the entry was listed
+        if (const std::uint32_t count = this->get_count(asked_id, chosen_id); count > 0) {
+            counted.emplace_back(count, chosen_id);
+        }
+    }
+    std::sort(counted.begin(), counted.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+    });
+
+    std::vector<std::size_t> confusions;
+    confusions.reserve(counted.size());
+    for (const auto &[count, chosen_id] : counted) {
+        confusions.emplace_back(chosen_id);
+    }
+    return confusions;
+}
+
+std::vector<Pair> Confusion::get_pairs() const
+{
+    std::vector<Pair> pairs;
+    if (this->is_dense()) {
+        for (std::size_t idx = 0; idx < this->dense_.size(); ++idx) {
+            if (this->dense_[idx] > 0) {
+                pairs.push_back({static_cast<std::uint32_t>(idx / this->num_entries_), static_cast<std::uint32_t>(idx % this->num_entries_), this->dense_[idx]});
+            }
+        }
+    }
+    else {
+        pairs.reserve(this->num_pairs_);
+        for (std::size_t slot = 0; slot < this->keys_.size(); ++slot) {
+            if (const std::uint64_t key = this->keys_[slot]; key != empty_key) {
+                pairs.push_back({static_cast<std::uint32_t>(key >> 32), static_cast<std::uint32_t>(key & 0xFFFFFFFFu), this->counts_[slot]});
+            }
+        }
+    }
+    return pairs;
+}
+
+bool Confusion::is_dense() const
+{
+    return !this->dense_.empty() || this->num_entries_ == 0;
+}
+
+std::uint32_t Confusion::increment(const std::size_t asked_id,
+                                   const std::size_t chosen_id,
+                                   const std::uint32_t count)
+{
+    // Saturate instead of wrapping around
+    const auto saturating_add = [count](std::uint32_t &value) {
+        value = value > std::numeric_limits<std::uint32_t>::max() - count ? std::numeric_limits<std::uint32_t>::max() : value + count;
+        return value;
+    };
+
+    if (this->is_dense()) {
+        return saturating_add(this->dense_[asked_id * this->num_entries_ + chosen_id]);
+    }
+
+    const std::uint64_t key = make_key(asked_id, chosen_id);
+    std::size_t slot = this->find_slot(key);
+    if (this->keys_[slot] == empty_key) {
+        // Make room before inserting a new pair; halving is amortized over the insertions that filled the table
+        while (this->num_pairs_ >= this->max_pairs_) {
+            this->decay();
+        }
+        slot = this->find_slot(key);
+        this->keys_[slot] = key;
+        this->counts_[slot] = 0;
+        ++this->num_pairs_;
+    }
+    return saturating_add(this->counts_[slot]);
+}
+
+std::size_t Confusion::find_slot(const std::uint64_t key) const
+{
+    // Fibonacci hashing spreads consecutive IDs over the whole table
+    const std::size_t mask = this->keys_.size() - 1;
+    std::size_t slot = static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+    while (this->keys_[slot] != empty_key && this->keys_[slot] != key) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void Confusion::decay()
+{
+    std::vector<std::uint64_t> old_keys(this->keys_.size(), empty_key);
+    std::vector<std::uint32_t> old_counts(this->counts_.size(), 0);
+    old_keys.swap(this->keys_);
+    old_counts.swap(this->counts_);
+    this->num_pairs_ = 0;
+
+    // Reinsert the surviving pairs, as linear probing cannot delete in place
+    for (std::size_t slot = 0; slot < old_keys.size(); ++slot) {
+        const std::uint32_t count = old_counts[slot] / 2;
+        if (old_keys[slot] == empty_key || count == 0) {
+            continue;
+        }
+        const std::size_t new_slot = this->find_slot(old_keys[slot]);
+        this->keys_[new_slot] = old_keys[slot];
+        this->counts_[new_slot] = count;
+        ++this->num_pairs_;
+    }
+}
+
+void Confusion::update_listed(const std::size_t asked_id,
+                              const std::size_t chosen_id,
+                              const std::uint32_t count)
+{
+    std::uint32_t *const listed = this->listed_.data() + asked_id * max_listed;
+    const auto id = static_cast<std::uint32_t>(chosen_id);
+    if (std::find(listed, listed + max_listed, id) != listed + max_listed) {
+        return;
+    }
+
+    // Take a free slot, or replace the least frequent listed entry if this one is more frequent
+    std::size_t weakest_slot = 0;
+    std::uint32_t weakest_count = std::numeric_limits<std::uint32_t>::max();
+    for (std::size_t idx = 0; idx < max_listed; ++idx) {
+        const std::uint32_t listed_count = listed[idx] == none ? 0 : this->get_count(asked_id, listed[idx]);
+        if (listed_count < weakest_count) {
+            weakest_slot = idx;
+            weakest_count = listed_count;
+        }
+    }
+    if (count > weakest_count) {
+        listed[weakest_slot] = id;
+    }
+}
+
+}  // namespace modules::confusion
@@ -0,0 +1,190 @@
+/**
+ * @file confusion.hpp
+ *
+ * @brief Confusion matrix that tracks which entries are mistaken for which.
+ */
+
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t, std::uint64_t
+#include <vector>   // for std::vector
+
+namespace modules::confusion {
+
+/**
+ * @brief Struct that represents how often one entry was mistaken for another.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Pair final {
+    /**
+     * @brief ID of the entry that was asked (e.g., "3").
+     */
+    std::uint32_t asked_id;
+
+    /**
+     * @brief ID of the entry that was chosen instead (e.g., "5").
+     */
+    std::uint32_t chosen_id;
+
+    /**
+     * @brief Number of times this mistake was made (e.g., "2").
+     */
+    std::uint32_t count;
+};
+
+/**
+ * @brief Class that counts wrong answers per (asked entry, chosen entry) pair.
+ *
+ * Small decks use a dense matrix of counters.
+ * Large decks (e.g., 11k syllables) use an open-addressing hash table of pairs with a fixed capacity; once it is full, all counts are halved and pairs that drop to zero are evicted, so memory stays bounded and recent mistakes weigh more.
+ * Every entry also keeps a short list of its most frequent confusions, so distractors can be looked up without scanning the matrix.
+ * All updates are O(1).
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Confusion final {
+  public:
+    /**
+     * @brief Maximum number of confusions listed per entry.
+     */
+    static constexpr std::size_t max_listed = 8;
+
+    /**
+     * @brief Construct a new Confusion object with all counts set to zero.
+     *
+     * @param num_entries Number of entries (e.g., "40").
+     * @param dense_limit Largest number of entries that uses a dense matrix (default: 256).
+     * @param max_pairs Maximum number of pairs kept by the sparse table (default: 65536).
+     */
+    explicit Confusion(const std::size_t num_entries,
+                       const std::size_t dense_limit = 256,
+                       const std::size_t max_pairs = 65536);
+
+    /**
+     * @brief Record a wrong answer.
+     *
+     * @param asked_id ID of the entry that was asked (e.g., "3").
+     * @param chosen_id ID of the entry that was chosen instead (e.g., "5"); pairs out of range or with equal IDs are ignored.
+     */
+    void record(const std::size_t asked_id,
+                const std::size_t chosen_id);
+
+    /**
+     * @brief Add previously counted mistakes (e.g., loaded from a snapshot).
+     *
+     * @param pair Pair to add; pairs out of range or with equal IDs are ignored.
+     */
+    void add(const Pair &pair);
+
+    /**
+     * @brief Get how often one entry was mistaken for another.
+     *
+     * @param asked_id ID of the entry that was asked (e.g., "3").
+     * @param chosen_id ID of the entry that was chosen instead (e.g., "5").
+     *
+     * @return Number of mistakes (e.g., "2").
+     */
+    [[nodiscard]] std::uint32_t get_count(const std::size_t asked_id,
+                                          const std::size_t chosen_id) const;
+
+    /**
+     * @brief Get the entries most often chosen instead of an entry.
+     *
+     * @param asked_id ID of the entry that was asked (e.g., "3").
+     *
+     * @return Vector of up to 8 entry IDs, most frequent first.
+     */
+    [[nodiscard]] std::vector<std::size_t> get_confusions(const std::size_t asked_id) const;
+
+    /**
+     * @brief Get every pair with a non-zero count (e.g., to save them).
+     *
+     * @return Vector of Pair objects, in no particular order.
+     */
+    [[nodiscard]] std::vector<Pair> get_pairs() const;
+
+    /**
+     * @brief Check whether the counts are stored in a dense matrix.
+     *
+     * @return True if the matrix is dense, false if it is a sparse table.
+     */
+    [[nodiscard]] bool is_dense() const;
+
+  private:
+    /**
+     * @brief Add to the count of a pair.
+     *
+     * @param asked_id ID of the entry that was asked.
+     * @param chosen_id ID of the entry that was chosen instead.
+     * @param count Number to add.
+     *
+     * @return New count of the pair.
+     */
+    std::uint32_t increment(const std::size_t asked_id,
+                            const std::size_t chosen_id,
+                            const std::uint32_t count);
+
+    /**
+     * @brief Find the slot of a pair in the sparse table.
+     *
+     * @param key Key of the pair.
+     *
+     * @return Index of the slot that holds the key, or of the empty slot where it belongs.
+     */
+    [[nodiscard]] std::size_t find_slot(const std::uint64_t key) const;
+
+    /**
+     * @brief Halve every count in the sparse table and evict the pairs that drop to zero.
+     */
+    void decay();
+
+    /**
+     * @brief Add an entry to the list of most frequent confusions of another, if it is frequent enough.
+     *
+     * @param asked_id ID of the entry that was asked.
+     * @param chosen_id ID of the entry that was chosen instead.
+     * @param count Current count of the pair.
+     */
+    void update_listed(const std::size_t asked_id,
+                       const std::size_t chosen_id,
+                       const std::uint32_t count);
+
+    /**
+     * @brief Number of entries.
+     */
+    std::size_t num_entries_;
+
+    /**
+     * @brief Maximum number of pairs kept by the sparse table.
+     */
+    std::size_t max_pairs_;
+
+    /**
+     * @brief Dense matrix of counts, indexed by "asked_id * num_entries + chosen_id"; empty if the table is sparse.
+     */
+    std::vector<std::uint32_t> dense_;
+
+    /**
+     * @brief Keys of the sparse table ("asked_id << 32 | chosen_id"), where empty slots hold the maximum value.
+     */
+    std::vector<std::uint64_t> keys_;
+
+    /**
+     * @brief Counts of the sparse table, indexed like the keys.
+     */
+    std::vector<std::uint32_t> counts_;
+
+    /**
+     * @brief Number of occupied slots in the sparse table.
+     */
+    std::size_t num_pairs_;
+
+    /**
+     * @brief Candidates for the most frequent confusions of each entry, "max_listed" slots per entry.
+     */
+    std::vector<std::uint32_t> listed_;
+};
+
+}  // namespace modules::confusion
@@ -0,0 +1,318 @@
+/**
+ * @file deck.cpp
+ */
+
+#include <chrono>         // for std::chrono
+#include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint64_t, std::uintmax_t, std::int64_t
+#include <cstdio>         // for stderr
+#include <filesystem>     // for std::filesystem
+#include <future>         // for std::async, std::future_status
+#include <optional>       // for std::optional, std::nullopt
+#include <stdexcept>      // for std::runtime_error
+#include <string>         // for std::string
+#include <string_view>    // for std::string_view
+#include <system_error>   // for std::error_code
+#include <unordered_map>  // for std::unordered_map
+#include <unordered_set>  // for std::unordered_set
+#include <utility>        // for std::move
+#include <vector>         // for std::vector
+
+#include <fmt/core.h>
+
+#include "core/csv.hpp"
+#include "core/file.hpp"
+#include "core/watch.hpp"
+#include "deck.hpp"
+#include "image.hpp"
+#include "vocabulary.hpp"
+
+namespace modules::deck {
+
+namespace {
+
+/**
+ * @brief Private helper function to describe the version of a deck file and the options it is imported with, which an image is compiled from.
+ *
+ * @param path Path to the deck file (e.g., "deck.tsv").
+ * @param options Layout of the deck file.
+ *
+ * @return Source of an image of the deck file; its size and modification time are zero if the file is missing.
+ */
+[[nodiscard]] image::Source get_source(const std::filesystem::path &path,
+                                       const Options &options)
+{
+    // Every option changes the entries, so each is mixed into the fingerprint (FNV-1a over the values)
+    image::Source source;
+    source.options = 14695981039346656037ull;
+    for (const std::uint64_t value : {std::uint64_t{static_cast<unsigned char>(options.delimiter)},
+                                      std::uint64_t{options.has_header},
+                                      std::uint64_t{options.hangul_column},
+                                      std::uint64_t{options.latin_column},
+                                      std::uint64_t{options.memo_column},
+                                      std::uint64_t{options.tags_column},
+                                      static_cast<std::uint64_t>(options.category)}) {
+        source.options = (source.options ^ value) * 1099511628211ull;
+    }
+
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(path, error);
+    if (error) {
+        return source;
+    }
+    const auto modified = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return source;
+    }
+    source.size = size;
+    source.modified = static_cast<std::int64_t>(modified.time_since_epoch().count());
+    return source;
+}
+
+/**
+ * @brief Private helper function to split a field of space-separated tags.
+ *
+ * @param field Field (e.g., "vowel  lesson:3").
+ *
+ * @return Vector of tags (e.g., {"vowel", "lesson:3"}).
+ */
+[[nodiscard]] std::vector<std::string> split_tags(const std::string_view field)
+{
+    std::vector<std::string> tags;
+    std::size_t begin = field.find_first_not_of(' ');
+    while (begin != std::string_view::npos) {
+        const std::size_t end = field.find(' ', begin);
+        tags.emplace_back(field.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin));
+        begin = end == std::string_view::npos ? end : field.find_first_not_of(' ', end);
+    }
+    return tags;
+}
+
+/**
+ * @brief Private helper function to get the category of an entry from its tags, using the labels of the app's toggle buttons.
+ *
+ * @param tags Tags of the entry (e.g., {"noun", "category:dcon"}).
+ * @param fallback Category of entries without a category tag.
+ * @param line Line of the entry, used in the error message (e.g., "3").
+ *
+ * @return Category named by the last "category:" tag (e.g., "Category::DoubleConsonant"), or "fallback" if there is none.
+ *
+ * @throws std::runtime_error If a "category:" tag names an unknown category.
+ */
+[[nodiscard]] vocabulary::Category get_category(const std::vector<std::string> &tags,
+                                                const vocabulary::Category fallback,
+                                                const std::size_t line)
+{
+    constexpr std::string_view prefix = "category:";
+    vocabulary::Category category = fallback;
+    for (const std::string &tag : tags) {
+        if (tag.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        const std::string_view label = std::string_view(tag).substr(prefix.size());
+        if (label == "vow") {
+            category = vocabulary::Category::BasicVowel;
+        }
+        else if (label == "con") {
+            category = vocabulary::Category::BasicConsonant;
+        }
+        else if (label == "dcon") {
+            category = vocabulary::Category::DoubleConsonant;
+        }
+        else if (label == "compv") {
+            category = vocabulary::Category::CompoundVowel;
+        }
+        else {
+            throw std::runtime_error(fmt::format("Line {} has unknown category tag '{}', expected 'category:vow', 'category:con', 'category:dcon' or 'category:compv'", line, tag));
+        }
+    }
+    return category;
+}
+
+}  // namespace
+
+Summary parse(const std::string_view text,
+              const Options &options,
+              std::vector<vocabulary::Entry> &entries)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const core::csv::Table table(text, options.delimiter != '\0' ? options.delimiter : core::csv::detect_delimiter(text));
+
+    // Only the fields that end up in an entry are copied out of the arena
+    const std::size_t first_row = options.has_header ? 1 : 0;
+    const std::size_t num_rows = table.get_num_rows() > first_row ? table.get_num_rows() - first_row : 0;
+    entries.reserve(entries.size() + num_rows);
+    for (std::size_t row = first_row; row < table.get_num_rows(); ++row) {
+        const std::string_view hangul = table.get_field(row, options.hangul_column);
+        const std::string_view latin = table.get_field(row, options.latin_column);
+        if (hangul.empty() || latin.empty()) {
+            throw std::runtime_error(fmt::format("Line {} has no {} in column {}", table.get_line(row), hangul.empty() ? "Korean text" : "transliteration", (hangul.empty() ? options.hangul_column : options.latin_column) + 1));
+        }
+        std::vector<std::string> tags = split_tags(table.get_field(row, options.tags_column));
+        const vocabulary::Category category = get_category(tags, options.category, table.get_line(row));
+        entries.push_back({std::string(hangul), std::string(latin), std::string(table.get_field(row, options.memo_column)), category, std::move(tags)});
+    }
+    return {num_rows, text.size(), std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+}
+
+Summary import(const std::filesystem::path &path,
+               const Options &options,
+               std::vector<vocabulary::Entry> &entries)
+{
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        const core::file::MappedFile mapping(path);
+        Summary summary = parse(std::string_view(reinterpret_cast<const char *>(mapping.get_data()), mapping.get_size()), options, entries);
+        summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return summary;
+    }
+    catch (const std::runtime_error &e) {
+        throw std::runtime_error(fmt::format("Failed to import '{}': {}", path.string(), e.what()));
+    }
+}
+
+image::Image load(const std::filesystem::path &path,
+                  const Options &options,
+                  const std::filesystem::path &image_path)
+{
+    // The source is read before the import, so a deck written during the import leaves the image out of date rather than wrong
+    const image::Source source = get_source(path, options);
+    std::error_code error;
+    if (!image_path.empty() && std::filesystem::exists(image_path, error)) {
+        try {
+            image::Image image(image_path);
+            if (image.get_source() == source) {
+                return image;
+            }
+        }
+        catch (const std::runtime_error &) {
+            // A corrupt image (e.g., from an older version of the format) is compiled again, like an out-of-date one
+        }
+    }
+
+    std::vector<vocabulary::Entry> entries;
+    static_cast<void>(import(path, options, entries));
+    image::Image image(entries, source);
+    if (image_path.empty()) {
+        return image;
+    }
+
+    // Map the written file rather than keep the compiled copy, so this process shares the pages too
+    try {
+        image.save(image_path);
+        image::Image mapped(image_path);
+        if (mapped.get_source() == source) {
+            return mapped;
+        }
+    }
+    catch (const std::runtime_error &e) {
+        fmt::print(stderr, "Warning: Keeping '{}' in memory, as its image cannot be shared: {}\n", path.string(), e.what());
+    }
+    return image;
+}
+
+vocabulary::Update diff(const image::Image &previous,
+                        const image::Image &current)
+{
+    // Both images keep the Korean text in canonical form, so the entries are compared as they are stored
+    // Decks are mostly edited in place, so each entry is first compared with the one after the previous match
+    // Anything else (e.g., a new, removed or moved entry) builds a hash index of the previous version, once
+    vocabulary::Update update;
+    std::vector<bool> is_seen(previous.get_num_entries(), false);
+    std::size_t cursor = 0;
+    std::unordered_map<std::string_view, std::size_t> index;
+    std::unordered_set<std::string_view> added;
+    for (std::size_t idx = 0; idx < current.get_num_entries(); ++idx) {
+        const std::string_view key = current.get_hangul(idx);
+        std::size_t match = cursor;
+        if (cursor >= previous.get_num_entries() || previous.get_hangul(cursor) != key) {
+            if (index.empty()) {
+                index.reserve(previous.get_num_entries());
+                for (std::size_t other = 0; other < previous.get_num_entries(); ++other) {
+                    index.emplace(previous.get_hangul(other), other);
+                }
+            }
+            const auto it = index.find(key);
+            if (it == index.cend()) {
+                if (!added.insert(key).second) {
+                    throw std::runtime_error(fmt::format("Entry '{}' appears more than once", key));
+                }
+                update.entries.emplace_back(current.get_entry(idx));
+                continue;
+            }
+            match = it->second;
+        }
+        if (is_seen[match]) {
+            throw std::runtime_error(fmt::format("Entry '{}' appears more than once", key));
+        }
+        is_seen[match] = true;
+        cursor = match + 1;
+        if (previous.get_latin(match) != current.get_latin(idx) || previous.get_memo(match) != current.get_memo(idx) ||
+            previous.get_category(match) != current.get_category(idx) || previous.get_tags(match) != current.get_tags(idx)) {
+            update.entries.emplace_back(current.get_entry(idx));
+        }
+    }
+    for (std::size_t idx = 0; idx < previous.get_num_entries(); ++idx) {
+        if (!is_seen[idx]) {
+            update.removed.emplace_back(previous.get_hangul(idx));
+        }
+    }
+    return update;
+}
+
+Reloader::Reloader(const std::filesystem::path &path,
+                   const Options &options,
+                   const std::filesystem::path &image_path,
+                   image::Image image,
+                   const core::watch::Mode mode)
+    : path_(path),
+      options_(options),
+      image_path_(image_path),
+      watcher_(path, mode),
+      image_(std::move(image)),
+      is_stale_(false),
+      pending_()
+{
+}
+
+std::optional<vocabulary::Update> Reloader::poll()
+{
+    this->is_stale_ = this->watcher_.has_changed() || this->is_stale_;
+
+    // Collect the reload in progress, if it finished
+    std::optional<vocabulary::Update> update;
+    if (this->pending_.valid()) {
+        if (this->pending_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return std::nullopt;
+        }
+        Result result = this->pending_.get();
+        if (!result.error.empty()) {
+            fmt::print(stderr, "Warning: Keeping the previous version of '{}': {}\n", this->path_.string(), result.error);
+        }
+        else {
+            this->image_ = std::move(result.image);
+            if (!result.update.is_empty()) {
+                update = std::move(result.update);
+            }
+        }
+    }
+
+    // Start the next reload, which reads the previous image but never writes it
+    if (this->is_stale_) {
+        this->is_stale_ = false;
+        this->pending_ = std::async(std::launch::async, [this]() {
+            Result result;
+            try {
+                result.image = load(this->path_, this->options_, this->image_path_);
+                result.update = diff(this->image_, result.image);
+            }
+            catch (const std::runtime_error &e) {
+                result.error = e.what();
+            }
+            return result;
+        });
+    }
+    return update;
+}
+
+}  // namespace modules::deck
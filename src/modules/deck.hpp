@@ -0,0 +1,254 @@
+/**
+ * @file deck.hpp
+ *
+ * @brief Import decks of entries from CSV or TSV files (e.g., Anki notes or spreadsheets), share them between processes as images, and reload them when they change.
+ */
+
+#pragma once
+
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint64_t
+#include <filesystem>   // for std::filesystem
+#include <future>       // for std::future
+#include <optional>     // for std::optional
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
+
+#include "core/watch.hpp"
+#include "image.hpp"
+#include "vocabulary.hpp"
+
+namespace modules::deck {
+
+/**
+ * @brief Struct that represents the layout of a deck file.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Options final {
+    /**
+     * @brief Field delimiter (e.g., '\t'), or '\0' to detect it with "core::csv::detect_delimiter()".
+     */
+    char delimiter = '\0';
+
+    /**
+     * @brief Whether the first row holds column names rather than an entry.
+     */
+    bool has_header = false;
+
+    /**
+     * @brief Column of the Korean text, which is required.
+     */
+    std::size_t hangul_column = 0;
+
+    /**
+     * @brief Column of the Latin transliteration, which is required.
+     */
+    std::size_t latin_column = 1;
+
+    /**
+     * @brief Column of the memo, which may be missing.
+     */
+    std::size_t memo_column = 2;
+
+    /**
+     * @brief Column of the space-separated tags, as in Anki exports (e.g., "vowel lesson:3"), which may be missing.
+     */
+    std::size_t tags_column = 3;
+
+    /**
+     * @brief Category of the imported entries without a category tag; a tag such as "category:dcon" (with the labels of the app's toggle buttons: "vow", "con", "dcon" or "compv") overrides it for its entry.
+     */
+    vocabulary::Category category = vocabulary::Category::BasicVowel;
+};
+
+/**
+ * @brief Struct that represents the result of an import.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Summary final {
+    /**
+     * @brief Number of imported entries (e.g., "400000").
+     */
+    std::size_t num_rows;
+
+    /**
+     * @brief Number of bytes read (e.g., "50000000").
+     */
+    std::uint64_t num_bytes;
+
+    /**
+     * @brief Wall-clock duration of the import in seconds (e.g., "0.2").
+     */
+    double seconds;
+
+    /**
+     * @brief Get the throughput of the import.
+     *
+     * @return Number of entries per second (e.g., "2000000.0"), or 0.0 if no time was measured.
+     */
+    [[nodiscard]] double get_rows_per_second() const
+    {
+        return this->seconds > 0.0 ? static_cast<double>(this->num_rows) / this->seconds : 0.0;
+    }
+};
+
+/**
+ * @brief Parse the entries of a deck from CSV or TSV text.
+ *
+ * The text is parsed by "core::csv::Table" into one arena, and each entry is then built from views into it.
+ *
+ * @param text CSV or TSV text (e.g., "ㅏ\ta\tLooks like an 'a'\tvowel\n").
+ * @param options Layout of the text.
+ * @param entries Vector to append the entries to.
+ *
+ * @return Summary of the import.
+ *
+ * @throws std::runtime_error if the text is not valid CSV or TSV, or if a row lacks the Korean text or the transliteration or has an unknown category tag, with the line of the error.
+ */
+[[nodiscard]] Summary parse(const std::string_view text,
+                            const Options &options,
+                            std::vector<vocabulary::Entry> &entries);
+
+/**
+ * @brief Import the entries of a deck from a CSV or TSV file, which is mapped into memory rather than read.
+ *
+ * @param path Path to the file (e.g., "korean.tsv").
+ * @param options Layout of the file.
+ * @param entries Vector to append the entries to.
+ *
+ * @return Summary of the import.
+ *
+ * @throws std::runtime_error if the file cannot be mapped, or for the reasons of "parse()", with the path of the file.
+ */
+[[nodiscard]] Summary import(const std::filesystem::path &path,
+                             const Options &options,
+                             std::vector<vocabulary::Entry> &entries);
+
+/**
+ * @brief Load a deck file through an image, which every process that loads the same deck maps and shares, rather than each parsing its own copy.
+ *
+ * The image is mapped as it is if it was compiled from the current version of the deck file with the same options; otherwise, the deck file is imported, and the image is compiled and written again.
+ * If the image cannot be written (e.g., the directory is read-only), the deck is kept in memory, and a warning is printed.
+ *
+ * @param path Path to the deck file (e.g., "deck.tsv").
+ * @param options Layout of the deck file.
+ * @param image_path Path to the image (e.g., "deck.img"), or an empty path to compile the deck in memory.
+ *
+ * @return Image of the entries, mapped from "image_path" if possible.
+ *
+ * @throws std::runtime_error for the reasons of "import()".
+ */
+[[nodiscard]] image::Image load(const std::filesystem::path &path,
+                                const Options &options,
+                                const std::filesystem::path &image_path);
+
+/**
+ * @brief Compute the changes between two versions of a deck, matching entries by Korean text. This is O(number of entries).
+ *
+ * Entries are compared in order while both versions line up, so an edit in place (e.g., a corrected memo) needs no hashing; a new, removed or moved entry hashes the previous version once.
+ *
+ * @param previous Image of the previous version.
+ * @param current Image of the current version.
+ *
+ * @return Entries of "current" that are new or differ in any field, in order, and the Korean text of the entries of "previous" that are gone.
+ *
+ * @throws std::runtime_error if two entries of "current" have the same Korean text.
+ */
+[[nodiscard]] vocabulary::Update diff(const image::Image &previous,
+                                      const image::Image &current);
+
+/**
+ * @brief Class that reloads a deck file whenever it is written, for a vocabulary to apply between frames.
+ *
+ * The file is watched with "core::watch::FileWatcher"; a change starts a background task that loads the file with "load()" and computes the changes against the previous version, so the thread that calls "poll()" never parses.
+ * Of several processes that follow the same file, the first to finish writes the image, which the others then map instead of parsing.
+ * A file that is written again while it is parsed is parsed once more afterwards, so the last version always wins.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Reloader final {
+  public:
+    /**
+     * @brief Start watching a deck file.
+     *
+     * @param path Path to the file (e.g., "deck.tsv").
+     * @param options Layout of the file.
+     * @param image_path Path to the image of the file (e.g., "deck.img"), or an empty path to compile each version in memory.
+     * @param image Image of the version that was loaded last (e.g., by "load()"), which the first change is compared to.
+     * @param mode How to watch the file (default: inotify if available).
+     */
+    explicit Reloader(const std::filesystem::path &path,
+                      const Options &options,
+                      const std::filesystem::path &image_path,
+                      image::Image image,
+                      const core::watch::Mode mode = core::watch::Mode::Auto);
+
+    /**
+     * @brief Stop watching the file, waiting for a reload in progress, if any.
+     */
+    ~Reloader() = default;
+
+    Reloader(const Reloader &) = delete;
+    Reloader &operator=(const Reloader &) = delete;
+
+    /**
+     * @brief Check for a finished reload, and start one if the file changed, without blocking. This is cheap enough to call every frame.
+     *
+     * A file that fails to import (e.g., saved halfway) is reported on stderr and skipped, so the previous version stays until the next write.
+     *
+     * @return Changes since the previous version (e.g., for "vocabulary::Vocabulary::update()"), or std::nullopt if no reload finished or nothing changed.
+     */
+    [[nodiscard]] std::optional<vocabulary::Update> poll();
+
+  private:
+    /**
+     * @brief Struct that represents the outcome of a background reload.
+     *
+     * @note This struct is marked as `final` to prevent inheritance.
+     */
+    struct Result final {
+        image::Image image;         // Image of the new version
+        vocabulary::Update update;  // Changes since the previous version
+        std::string error;          // Reason of a failed import, or empty on success
+    };
+
+    /**
+     * @brief Path to the file.
+     */
+    std::filesystem::path path_;
+
+    /**
+     * @brief Layout of the file.
+     */
+    Options options_;
+
+    /**
+     * @brief Path to the image of the file, or an empty path.
+     */
+    std::filesystem::path image_path_;
+
+    /**
+     * @brief Watcher of the file.
+     */
+    core::watch::FileWatcher watcher_;
+
+    /**
+     * @brief Image of the previous version, which only the background task reads while it runs.
+     */
+    image::Image image_;
+
+    /**
+     * @brief Whether the file changed since the last reload started.
+     */
+    bool is_stale_;
+
+    /**
+     * @brief Reload in progress, if any; destroyed first, so it never outlives the members it reads.
+     */
+    std::future<Result> pending_;
+};
+
+}  // namespace modules::deck
@@ -0,0 +1,205 @@
+/**
+ * @file exam.cpp
+ */
+
+#include <algorithm>  // for std::max_element, std::sort
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint32_t, std::uint64_t
+#include <random>     // for std::mt19937
+#include <stdexcept>  // for std::runtime_error
+#include <utility>    // for std::swap
+#include <vector>     // for std::vector
+
+#include <fmt/core.h>
+
+#include "exam.hpp"
+
+namespace modules::exam {
+
+namespace {
+
+/**
+ * @brief Private helper function to draw a random number in [0, bound), the same way on every standard library.
+ *
+ * @param engine Seeded random number generator.
+ * @param bound Exclusive upper bound, greater than 0 (e.g., "40").
+ *
+ * @return Random number (e.g., "17").
+ */
+[[nodiscard]] std::size_t get_bounded(std::mt19937 &engine,
+                                      const std::size_t bound)
+{
+    // Reject the lowest values, which would otherwise make the smallest results slightly more likely
+    const std::uint64_t range = std::uint64_t{1} << 32;
+    const std::uint64_t threshold = range % bound;
+    while (true) {
+        if (const std::uint64_t value = engine(); value >= threshold) {
+            return static_cast<std::size_t>(value % bound);
+        }
+    }
+}
+
+/**
+ * @brief Private helper function to split the questions of an exam across categories.
+ *
+ * @param sizes Number of available entries in each category, 0 for disabled ones.
+ * @param num_questions Number of questions, at most the sum of "sizes".
+ * @param coverage How the questions are split.
+ * @param engine Seeded random number generator, used to break ties.
+ *
+ * @return Number of questions for each category, indexed by category.
+ */
+[[nodiscard]] std::vector<std::size_t> get_quotas(const std::vector<std::size_t> &sizes,
+                                                  const std::size_t num_questions,
+                                                  const Coverage coverage,
+                                                  std::mt19937 &engine)
+{
+    std::vector<std::size_t> quotas(sizes.size(), 0);
+    std::vector<std::size_t> open;
+    for (std::size_t category = 0; category < sizes.size(); ++category) {
+        if (sizes[category] > 0) {
+            open.emplace_back(category);
+        }
+    }
+    std::size_t remaining = num_questions;
+
+    if (coverage == Coverage::Proportional) {
+        // Largest remainder method: round every share down, then hand the leftover questions to the largest fractional parts
+        std::size_t total = 0;
+        for (const std::size_t size : sizes) {
+            total += size;
+        }
+        std::vector<std::size_t> remainders(sizes.size(), 0);
+        for (const std::size_t category : open) {
+            const std::uint64_t exact = static_cast<std::uint64_t>(num_questions) * sizes[category];
+            quotas[category] = static_cast<std::size_t>(exact / total);
+            remainders[category] = static_cast<std::size_t>(exact % total);
+            remaining -= quotas[category];
+        }
+        std::sort(open.begin(), open.end(), [&remainders](const std::size_t lhs, const std::size_t rhs) {
+            return remainders[lhs] != remainders[rhs] ? remainders[lhs] > remainders[rhs] : lhs < rhs;
+        });
+        for (std::size_t idx = 0; idx < remaining; ++idx) {
+            ++quotas[open[idx]];
+        }
+        return quotas;
+    }
+
+    // Equal shares: fill the categories too small for an equal share completely, then split the rest evenly among the others
+    while (remaining > 0) {
+        const std::size_t share = remaining / open.size();
+        std::vector<std::size_t> still_open;
+        for (const std::size_t category : open) {
+            if (sizes[category] <= share) {
+                quotas[category] = sizes[category];
+                remaining -= sizes[category];
+            }
+            else {
+                still_open.emplace_back(category);
+            }
+        }
+        if (still_open.size() == open.size()) {
+            // Every open category has room for its share plus one, so the leftover questions go to random categories
+            for (const std::size_t category : open) {
+                quotas[category] = share;
+            }
+            remaining -= share * open.size();
+            for (std::size_t idx = 0; idx < remaining; ++idx) {
+                std::swap(open[idx], open[idx + get_bounded(engine, open.size() - idx)]);
+                ++quotas[open[idx]];
+            }
+            break;
+        }
+        open.swap(still_open);
+    }
+    return quotas;
+}
+
+}  // namespace
+
+Exam::Exam(const std::vector<std::size_t> &entry_categories)
+    : buckets_(entry_categories.empty() ? 0 : *std::max_element(entry_categories.cbegin(), entry_categories.cend()) + 1),
+      enabled_(this->buckets_.size(), true)
+{
+    for (std::size_t id = 0; id < entry_categories.size(); ++id) {
+        this->buckets_[entry_categories[id]].emplace_back(id);
+    }
+}
+
+void Exam::set_category_enabled(const std::size_t category,
+                                const bool enabled)
+{
+    if (category < this->enabled_.size()) {
+        this->enabled_[category] = enabled;
+    }
+}
+
+std::vector<std::size_t> Exam::generate(const std::size_t num_questions,
+                                        const std::uint32_t seed,
+                                        const Coverage coverage)
+{
+    if (const std::size_t num_enabled = this->get_num_enabled(); num_questions > num_enabled) {
+        throw std::runtime_error(fmt::format("Requested an exam of '{}' questions, but only '{}' entries are enabled", num_questions, num_enabled));
+    }
+    if (num_questions == 0) {
+        return {};
+    }
+
+    std::mt19937 engine(seed);
+    std::vector<std::size_t> sizes(this->buckets_.size(), 0);
+    for (std::size_t category = 0; category < this->buckets_.size(); ++category) {
+        sizes[category] = this->enabled_[category] ? this->buckets_[category].size() : 0;
+    }
+    const std::vector<std::size_t> quotas = get_quotas(sizes, num_questions, coverage, engine);
+
+    // Draw each category's share with a partial Fisher-Yates shuffle, remembering the swaps so they can be undone
+    std::vector<std::size_t> questions;
+    questions.reserve(num_questions);
+    std::vector<std::size_t> swaps;
+    for (std::size_t category = 0; category < this->buckets_.size(); ++category) {
+        std::vector<std::size_t> &bucket = this->buckets_[category];
+        swaps.clear();
+        for (std::size_t idx = 0; idx < quotas[category]; ++idx) {
+            const std::size_t other = idx + get_bounded(engine, bucket.size() - idx);
+            std::swap(bucket[idx], bucket[other]);
+            swaps.emplace_back(other);
+            questions.emplace_back(bucket[idx]);
+        }
+        // Restore the bucket, so the next exam with the same seed draws the same entries
+        for (std::size_t idx = swaps.size(); idx-- > 0;) {
+            std::swap(bucket[idx], bucket[swaps[idx]]);
+        }
+    }
+
+    // Interleave the categories
+    for (std::size_t idx = questions.size() - 1; idx > 0; --idx) {
+        std::swap(questions[idx], questions[get_bounded(engine, idx + 1)]);
+    }
+    return questions;
+}
+
+std::vector<std::vector<std::size_t>> Exam::generate_class(const std::size_t num_exams,
+                                                           const std::size_t num_questions,
+                                                           const std::uint32_t seed,
+                                                           const Coverage coverage)
+{
+    std::vector<std::vector<std::size_t>> exams;
+    exams.reserve(num_exams);
+    for (std::size_t idx = 0; idx < num_exams; ++idx) {
+        exams.emplace_back(this->generate(num_questions, static_cast<std::uint32_t>(seed + idx), coverage));
+    }
+    return exams;
+}
+
+std::size_t Exam::get_num_enabled() const
+{
+    std::size_t count = 0;
+    for (std::size_t category = 0; category < this->buckets_.size(); ++category) {
+        if (this->enabled_[category]) {
+            count += this->buckets_[category].size();
+        }
+    }
+    return count;
+}
+
+}  // namespace modules::exam
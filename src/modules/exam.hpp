@@ -0,0 +1,101 @@
+/**
+ * @file exam.hpp
+ *
+ * @brief Reproducible exams with balanced category coverage.
+ */
+
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t
+#include <vector>   // for std::vector
+
+namespace modules::exam {
+
+/**
+ * @brief Enum that represents how the questions of an exam are split across categories.
+ */
+enum class Coverage {
+    Proportional,  // Each category gets questions in proportion to its number of entries
+    Equal          // Each category gets the same number of questions, as far as its entries allow
+};
+
+/**
+ * @brief Class that generates fixed-length exams without repeated entries by stratified sampling.
+ *
+ * Entry IDs are kept in one bucket per category.
+ * An exam first splits its questions across the enabled categories, then draws each category's share with a partial Fisher-Yates shuffle of its bucket, and finally shuffles the questions, so generating an exam of N questions takes O(N) regardless of the deck size.
+ * The bucket swaps are undone after each exam, and random numbers are derived from the seed without "std::uniform_int_distribution" (whose results differ between standard libraries), so a seed always yields the same exam.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Exam final {
+  public:
+    /**
+     * @brief Construct a new Exam object where every category is enabled.
+     *
+     * @param entry_categories Category index of each entry, indexed by entry ID (e.g., {0, 0, 1, 2}).
+     */
+    explicit Exam(const std::vector<std::size_t> &entry_categories);
+
+    /**
+     * @brief Enable or disable a category, so its entries are never part of an exam.
+     *
+     * @param category Category index (e.g., "1"); indices out of range are ignored.
+     * @param enabled Whether to enable or disable the category.
+     */
+    void set_category_enabled(const std::size_t category,
+                              const bool enabled);
+
+    /**
+     * @brief Generate an exam.
+     *
+     * @param num_questions Number of questions (e.g., "20").
+     * @param seed Seed that determines the exam (e.g., "12345").
+     * @param coverage How the questions are split across categories (default: Coverage::Proportional).
+     *
+     * @return Vector of entry IDs in the order they are asked, without repeats.
+     *
+     * @throws std::runtime_error If fewer entries than "num_questions" are enabled.
+     */
+    [[nodiscard]] std::vector<std::size_t> generate(const std::size_t num_questions,
+                                                    const std::uint32_t seed,
+                                                    const Coverage coverage = Coverage::Proportional);
+
+    /**
+     * @brief Generate one exam per student of a class, each with its own seed ("seed", "seed + 1", etc.), so any student's exam can be generated again on its own.
+     *
+     * @param num_exams Number of exams (e.g., "30").
+     * @param num_questions Number of questions per exam (e.g., "20").
+     * @param seed Seed of the first exam (e.g., "12345").
+     * @param coverage How the questions are split across categories (default: Coverage::Proportional).
+     *
+     * @return Vector of exams, each a vector of entry IDs.
+     *
+     * @throws std::runtime_error If fewer entries than "num_questions" are enabled.
+     */
+    [[nodiscard]] std::vector<std::vector<std::size_t>> generate_class(const std::size_t num_exams,
+                                                                       const std::size_t num_questions,
+                                                                       const std::uint32_t seed,
+                                                                       const Coverage coverage = Coverage::Proportional);
+
+    /**
+     * @brief Get the number of entries in the enabled categories, which is the longest possible exam.
+     *
+     * @return Number of entries (e.g., "40").
+     */
+    [[nodiscard]] std::size_t get_num_enabled() const;
+
+  private:
+    /**
+     * @brief IDs of the entries of each category, indexed by category.
+     */
+    std::vector<std::vector<std::size_t>> buckets_;
+
+    /**
+     * @brief Whether each category is enabled, indexed by category.
+     */
+    std::vector<bool> enabled_;
+};
+
+}  // namespace modules::exam
@@ -0,0 +1,233 @@
+/**
+ * @file history.cpp
+ */
+
+#include <algorithm>  // for std::min, std::sort
+#include <array>      // for std::array
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t
+#include <limits>     // for std::numeric_limits
+#include <vector>     // for std::vector
+
+#include "core/bits.hpp"
+#include "history.hpp"
+
+namespace modules::history {
+
+namespace {
+
+/**
+ * @brief Private marker for the end of a bucket list.
+ */
+constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Private table that maps a number of outcomes and correct answers to the rank of their accuracy, where equal fractions share a rank.
+ */
+struct RankTable final {
+    std::array<std::array<std::uint16_t, History::capacity + 1>, History::capacity + 1> ranks{};
+    std::size_t num_ranks = 0;
+};
+
+/**
+ * @brief Private helper function to get the rank table, built on first use.
+ *
+ * @return Const reference to the table.
+ */
+[[nodiscard]] const RankTable &get_rank_table()
+{
+    static const RankTable table = []() {
+        struct Fraction final {
+            std::uint16_t correct;
+            std::uint16_t length;
+        };
+        std::vector<Fraction> fractions;
+        for (std::uint16_t length = 1; length <= History::capacity; ++length) {
+            for (std::uint16_t correct = 0; correct <= length; ++correct) {
+                fractions.push_back({correct, length});
+            }
+        }
+        // Compare "a/b < c/d" as "a*d < c*b" to stay exact
+        const auto less = [](const Fraction &lhs, const Fraction &rhs) {
+            return lhs.correct * rhs.length < rhs.correct * lhs.length;
+        };
+        std::sort(fractions.begin(), fractions.end(), less);
+
+        RankTable result;
+        for (std::size_t idx = 0; idx < fractions.size(); ++idx) {
+            if (idx > 0 && less(fractions[idx - 1], fractions[idx])) {
+                ++result.num_ranks;
+            }
+            result.ranks[fractions[idx].length][fractions[idx].correct] = static_cast<std::uint16_t>(result.num_ranks);
+        }
+        ++result.num_ranks;
+        return result;
+    }();
+    return table;
+}
+
+/**
+ * @brief Private helper function to get the accuracy rank of a register.
+ *
+ * @param length Number of valid outcomes between 1 and 64.
+ * @param outcomes Shift register.
+ *
+ * @return Rank, where 0 is the lowest accuracy.
+ */
+[[nodiscard]] std::size_t get_rank(const std::size_t length,
+                                   const std::uint64_t outcomes)
+{
+    return get_rank_table().ranks[length][core::bits::popcount(outcomes)];
+}
+
+/**
+ * @brief Private helper function to get the mask of the valid outcomes of a register.
+ *
+ * @param length Number of valid outcomes between 0 and 64.
+ *
+ * @return Mask with the lowest "length" bits set.
+ */
+[[nodiscard]] std::uint64_t get_mask(const std::size_t length)
+{
+    return length >= History::capacity ? ~std::uint64_t{0} : (std::uint64_t{1} << length) - 1;
+}
+
+}  // namespace
+
+History::History(const std::size_t num_entries)
+    : outcomes_(num_entries, 0),
+      lengths_(num_entries, 0),
+      next_(num_entries, none),
+      previous_(num_entries, none),
+      heads_(get_rank_table().num_ranks, none),
+      occupied_((get_rank_table().num_ranks + 63) / 64, 0)
+{
+}
+
+void History::record(const std::size_t entry_id,
+                     const bool correct)
+{
+    if (entry_id >= this->outcomes_.size()) {
+        return;
+    }
+    const std::size_t old_length = this->lengths_[entry_id];
+    const std::uint64_t old_outcomes = this->outcomes_[entry_id];
+    this->outcomes_[entry_id] = (old_outcomes << 1) | (correct ? 1u : 0u);
+    if (old_length < capacity) {
+        ++this->lengths_[entry_id];
+    }
+    this->rebucket(entry_id, old_length, old_outcomes);
+}
+
+void History::set(const std::size_t entry_id,
+                  const std::uint64_t outcomes,
+                  const std::size_t length)
+{
+    if (entry_id >= this->outcomes_.size()) {
+        return;
+    }
+    const std::size_t old_length = this->lengths_[entry_id];
+    const std::uint64_t old_outcomes = this->outcomes_[entry_id];
+    const std::size_t clamped_length = std::min(length, capacity);
+    this->outcomes_[entry_id] = outcomes & get_mask(clamped_length);
+    this->lengths_[entry_id] = static_cast<std::uint8_t>(clamped_length);
+    this->rebucket(entry_id, old_length, old_outcomes);
+}
+
+std::uint64_t History::get_outcomes(const std::size_t entry_id) const
+{
+    return entry_id < this->outcomes_.size() ? this->outcomes_[entry_id] : 0;
+}
+
+std::size_t History::get_length(const std::size_t entry_id) const
+{
+    return entry_id < this->lengths_.size() ? this->lengths_[entry_id] : 0;
+}
+
+double History::get_accuracy(const std::size_t entry_id) const
+{
+    const std::size_t length = this->get_length(entry_id);
+    if (length == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(core::bits::popcount(this->outcomes_[entry_id])) / static_cast<double>(length);
+}
+
+int History::get_streak(const std::size_t entry_id) const
+{
+    const std::size_t length = this->get_length(entry_id);
+    if (length == 0) {
+        return 0;
+    }
+    // The streak ends at the first bit that differs from bit 0; bits beyond the length are zero, so cap the count
+    const std::uint64_t outcomes = this->outcomes_[entry_id];
+    const bool last_correct = (outcomes & 1u) != 0;
+    const std::size_t streak = std::min<std::size_t>(core::bits::countr_zero(last_correct ? ~outcomes : outcomes), length);
+    return last_correct ? static_cast<int>(streak) : -static_cast<int>(streak);
+}
+
+std::vector<std::size_t> History::get_weakest(const std::size_t count) const
+{
+    std::vector<std::size_t> weakest;
+    weakest.reserve(std::min(count, this->outcomes_.size()));
+    for (std::size_t word = 0; word < this->occupied_.size() && weakest.size() < count; ++word) {
+        // Visit the non-empty buckets of this word from the lowest rank, clearing each bit once visited
+        for (std::uint64_t bits = this->occupied_[word]; bits != 0 && weakest.size() < count; bits &= bits - 1) {
+            const std::size_t rank = word * 64 + core::bits::countr_zero(bits);
+            for (std::uint32_t entry = this->heads_[rank]; entry != none && weakest.size() < count; entry = this->next_[entry]) {
+                weakest.emplace_back(entry);
+            }
+        }
+    }
+    return weakest;
+}
+
+std::size_t History::get_num_entries() const
+{
+    return this->outcomes_.size();
+}
+
+void History::rebucket(const std::size_t entry_id,
+                       const std::size_t old_length,
+                       const std::uint64_t old_outcomes)
+{
+    const auto id = static_cast<std::uint32_t>(entry_id);
+
+    // Unlink from the old bucket
+    if (old_length > 0) {
+        const std::size_t old_rank = get_rank(old_length, old_outcomes);
+        const std::uint32_t previous = this->previous_[entry_id];
+        const std::uint32_t next = this->next_[entry_id];
+        if (previous != none) {
+            this->next_[previous] = next;
+        }
+        else {
+            this->heads_[old_rank] = next;
+        }
+        if (next != none) {
+            this->previous_[next] = previous;
+        }
+        if (this->heads_[old_rank] == none) {
+            this->occupied_[old_rank / 64] &= ~(std::uint64_t{1} << (old_rank % 64));
+        }
+    }
+
+    // Link at the front of the new bucket
+    const std::size_t length = this->lengths_[entry_id];
+    if (length == 0) {
+        this->next_[entry_id] = none;
+        this->previous_[entry_id] = none;
+        return;
+    }
+    const std::size_t rank = get_rank(length, this->outcomes_[entry_id]);
+    const std::uint32_t head = this->heads_[rank];
+    this->next_[entry_id] = head;
+    this->previous_[entry_id] = none;
+    if (head != none) {
+        this->previous_[head] = id;
+    }
+    this->heads_[rank] = id;
+    this->occupied_[rank / 64] |= std::uint64_t{1} << (rank % 64);
+}
+
+}  // namespace modules::history
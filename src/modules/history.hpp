@@ -0,0 +1,156 @@
+/**
+ * @file history.hpp
+ *
+ * @brief Rolling history of the most recent answers per entry.
+ */
+
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t
+#include <vector>   // for std::vector
+
+namespace modules::history {
+
+/**
+ * @brief Class that keeps the last 64 outcomes of every entry.
+ *
+ * Each entry owns a 64-bit shift register: recording an answer shifts it left and stores the outcome in bit 0, so bit N is the answer given N answers ago (1 for correct).
+ * Recent accuracy and streaks are computed with a single popcount or bit scan.
+ * Entries are also kept in buckets ordered by accuracy, which are updated in O(1) per answer, so the weakest entries can be listed without scanning the whole deck.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class History final {
+  public:
+    /**
+     * @brief Maximum number of outcomes kept per entry.
+     */
+    static constexpr std::size_t capacity = 64;
+
+    /**
+     * @brief Construct a new History object with no outcomes.
+     *
+     * @param num_entries Number of entries (e.g., "40").
+     */
+    explicit History(const std::size_t num_entries);
+
+    /**
+     * @brief Record the outcome of an answer.
+     *
+     * @param entry_id ID of the entry that was asked (e.g., "3"); IDs out of range are ignored.
+     * @param correct Whether the answer was correct.
+     */
+    void record(const std::size_t entry_id,
+                const bool correct);
+
+    /**
+     * @brief Restore the outcomes of an entry (e.g., loaded from a snapshot).
+     *
+     * @param entry_id ID of the entry (e.g., "3"); IDs out of range are ignored.
+     * @param outcomes Shift register, where bit N is the answer given N answers ago (e.g., "0b1101").
+     * @param length Number of valid outcomes, clamped to 64 (e.g., "4").
+     */
+    void set(const std::size_t entry_id,
+             const std::uint64_t outcomes,
+             const std::size_t length);
+
+    /**
+     * @brief Get the shift register of an entry.
+     *
+     * @param entry_id ID of the entry (e.g., "3").
+     *
+     * @return Outcomes, where bit N is the answer given N answers ago, or 0 if the ID is out of range.
+     */
+    [[nodiscard]] std::uint64_t get_outcomes(const std::size_t entry_id) const;
+
+    /**
+     * @brief Get the number of outcomes kept for an entry.
+     *
+     * @param entry_id ID of the entry (e.g., "3").
+     *
+     * @return Number of outcomes between 0 and 64 (e.g., "12").
+     */
+    [[nodiscard]] std::size_t get_length(const std::size_t entry_id) const;
+
+    /**
+     * @brief Get the accuracy of an entry over its kept outcomes.
+     *
+     * @param entry_id ID of the entry (e.g., "3").
+     *
+     * @return Accuracy between 0.0 and 1.0 (e.g., "0.75"), or 0.0 if there are no outcomes.
+     */
+    [[nodiscard]] double get_accuracy(const std::size_t entry_id) const;
+
+    /**
+     * @brief Get the current streak of an entry: the number of most recent answers with the same outcome.
+     *
+     * @param entry_id ID of the entry (e.g., "3").
+     *
+     * @return Positive length for a streak of correct answers (e.g., "3"), negative length for incorrect answers (e.g., "-2"), or 0 if there are no outcomes.
+     */
+    [[nodiscard]] int get_streak(const std::size_t entry_id) const;
+
+    /**
+     * @brief Get the entries with the lowest accuracy over their kept outcomes, weakest first.
+     *
+     * Entries without outcomes are skipped, and ties are returned most recently answered first.
+     * This walks the accuracy buckets from the bottom, so it takes O(k) regardless of the number of entries.
+     *
+     * @param count Maximum number of entries to return (e.g., "20").
+     *
+     * @return Vector of entry IDs, weakest first.
+     */
+    [[nodiscard]] std::vector<std::size_t> get_weakest(const std::size_t count) const;
+
+    /**
+     * @brief Get the number of entries.
+     *
+     * @return Number of entries (e.g., "40").
+     */
+    [[nodiscard]] std::size_t get_num_entries() const;
+
+  private:
+    /**
+     * @brief Move an entry into the bucket that matches its current outcomes.
+     *
+     * @param entry_id ID of the entry (e.g., "3").
+     * @param old_length Number of outcomes before the update, which selects the bucket to leave.
+     * @param old_outcomes Outcomes before the update, which select the bucket to leave.
+     */
+    void rebucket(const std::size_t entry_id,
+                  const std::size_t old_length,
+                  const std::uint64_t old_outcomes);
+
+    /**
+     * @brief Shift register of each entry, indexed by entry ID.
+     */
+    std::vector<std::uint64_t> outcomes_;
+
+    /**
+     * @brief Number of valid outcomes of each entry, indexed by entry ID.
+     */
+    std::vector<std::uint8_t> lengths_;
+
+    /**
+     * @brief Next entry in the same bucket, indexed by entry ID.
+     */
+    std::vector<std::uint32_t> next_;
+
+    /**
+     * @brief Previous entry in the same bucket, indexed by entry ID.
+     */
+    std::vector<std::uint32_t> previous_;
+
+    /**
+     * @brief First entry of each bucket, indexed by accuracy rank (weakest first).
+     */
+    std::vector<std::uint32_t> heads_;
+
+    /**
+     * @brief Bitmap of non-empty buckets, so empty ones are skipped 64 at a time.
+     */
+    std::vector<std::uint64_t> occupied_;
+};
+
+}  // namespace modules::history
@@ -0,0 +1,288 @@
+/**
+ * @file image.cpp
+ */
+
+#include <array>          // for std::array
+#include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint8_t, std::uint32_t, std::uint64_t, std::int64_t
+#include <cstring>        // for std::memcpy
+#include <filesystem>     // for std::filesystem
+#include <limits>         // for std::numeric_limits
+#include <memory>         // for std::make_shared
+#include <stdexcept>      // for std::runtime_error
+#include <string>         // for std::string
+#include <string_view>    // for std::string_view
+#include <type_traits>    // for std::is_trivially_copyable_v
+#include <unordered_map>  // for std::unordered_map
+#include <utility>        // for std::move
+#include <vector>         // for std::vector
+
+#include <fmt/core.h>
+
+#include "core/file.hpp"
+#include "core/normalization.hpp"
+#include "image.hpp"
+#include "vocabulary.hpp"
+
+namespace modules::image {
+
+namespace {
+
+/**
+ * @brief Private magic bytes that identify an image file.
+ */
+constexpr std::array<char, 8> image_magic = {'A', 'E', 'G', 'Y', 'O', 'D', 'C', 'K'};
+
+/**
+ * @brief Private version of the image file format.
+ */
+constexpr std::uint32_t image_version = 1;
+
+/**
+ * @brief Private marker that detects images written on a machine with a different byte order.
+ */
+constexpr std::uint32_t byte_order_marker = 0x01020304u;
+
+/**
+ * @brief Private size reserved for the header; the records start at this offset.
+ */
+constexpr std::size_t header_size = 64;
+
+/**
+ * @brief Private header of an image file, stored in native byte order.
+ *
+ * The header is followed by "entry_count" records (36 bytes each), "tag_count" tag spans (8 bytes each), and "text_size" bytes of text that the records and tags point into.
+ */
+struct ImageHeader final {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t entry_count;
+    std::uint32_t tag_count;
+    std::uint64_t text_size;
+    std::uint64_t source_size;
+    std::int64_t source_modified;
+    std::uint64_t source_options;
+};
+
+static_assert(std::is_trivially_copyable_v<ImageHeader>, "ImageHeader must be trivially copyable to be memcpy'd in and out of the file.");
+static_assert(sizeof(ImageHeader) <= header_size, "ImageHeader must fit into the reserved header space.");
+
+}  // namespace
+
+Image::Image()
+    : Image(std::vector<vocabulary::Entry>{})
+{
+}
+
+Image::Image(const std::vector<vocabulary::Entry> &entries,
+             const Source &source)
+    : buffer_(),
+      mapping_(),
+      source_(source),
+      num_entries_(entries.size()),
+      tags_offset_(0),
+      text_offset_(0)
+{
+    static_assert(std::is_trivially_copyable_v<Record> && sizeof(Record) == 36, "Record must be 36 trivially copyable bytes to be memcpy'd in and out of the file.");
+    static_assert(std::is_trivially_copyable_v<Span> && sizeof(Span) == 8, "Span must be 8 trivially copyable bytes to be memcpy'd in and out of the file.");
+
+    // Tags repeat across entries (e.g., "noun" or "lesson:3"), so each distinct tag is stored once
+    std::string text;
+    std::vector<Record> records;
+    records.reserve(entries.size());
+    std::vector<Span> tags;
+    std::unordered_map<std::string_view, Span> tag_spans;
+    const auto append = [&text](const std::string_view value) {
+        if (text.size() + value.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::runtime_error(fmt::format("Deck has more than {} bytes of text, which is too much for an image", std::numeric_limits<std::uint32_t>::max()));
+        }
+        const Span span{static_cast<std::uint32_t>(text.size()), static_cast<std::uint32_t>(value.size())};
+        text.append(value);
+        return span;
+    };
+    std::string hangul;
+    for (const vocabulary::Entry &entry : entries) {
+        hangul.clear();
+        core::normalization::compose(entry.hangul, hangul);
+        Record record{append(hangul), append(entry.latin), append(entry.memo), static_cast<std::uint32_t>(entry.category), static_cast<std::uint32_t>(tags.size()), static_cast<std::uint32_t>(entry.tags.size())};
+        for (const std::string &tag : entry.tags) {
+            const auto [it, inserted] = tag_spans.try_emplace(tag);
+            if (inserted) {
+                it->second = append(tag);
+            }
+            tags.emplace_back(it->second);
+        }
+        records.emplace_back(record);
+    }
+
+    ImageHeader header{};
+    header.magic = image_magic;
+    header.version = image_version;
+    header.byte_order = byte_order_marker;
+    header.entry_count = static_cast<std::uint32_t>(records.size());
+    header.tag_count = static_cast<std::uint32_t>(tags.size());
+    header.text_size = text.size();
+    header.source_size = source.size;
+    header.source_modified = source.modified;
+    header.source_options = source.options;
+
+    this->tags_offset_ = header_size + records.size() * sizeof(Record);
+    this->text_offset_ = this->tags_offset_ + tags.size() * sizeof(Span);
+    this->buffer_.resize(this->text_offset_ + text.size(), 0);
+    std::memcpy(this->buffer_.data(), &header, sizeof(header));
+    // Empty vectors may have no storage at all, and passing their null data to std::memcpy is undefined even for 0 bytes
+    if (!records.empty()) {
+        std::memcpy(this->buffer_.data() + header_size, records.data(), records.size() * sizeof(Record));
+    }
+    if (!tags.empty()) {
+        std::memcpy(this->buffer_.data() + this->tags_offset_, tags.data(), tags.size() * sizeof(Span));
+    }
+    std::memcpy(this->buffer_.data() + this->text_offset_, text.data(), text.size());
+}
+
+Image::Image(const std::filesystem::path &path)
+    : buffer_(),
+      mapping_(std::make_shared<const core::file::MappedFile>(path)),
+      source_(),
+      num_entries_(0),
+      tags_offset_(0),
+      text_offset_(0)
+{
+    const std::uint8_t *data = this->mapping_->get_data();
+    const std::size_t size = this->mapping_->get_size();
+
+    ImageHeader header;
+    if (size < header_size) {
+        throw std::runtime_error(fmt::format("Image '{}' is truncated ({} bytes)", path.string(), size));
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != image_magic || header.version != image_version) {
+        throw std::runtime_error(fmt::format("Image '{}' has an unsupported format", path.string()));
+    }
+    if (header.byte_order != byte_order_marker) {
+        throw std::runtime_error(fmt::format("Image '{}' was written on a machine with a different byte order", path.string()));
+    }
+    const std::uint64_t tags_offset = header_size + std::uint64_t{header.entry_count} * sizeof(Record);
+    const std::uint64_t text_offset = tags_offset + std::uint64_t{header.tag_count} * sizeof(Span);
+    if (header.text_size > std::numeric_limits<std::uint32_t>::max() || size < text_offset + header.text_size) {
+        throw std::runtime_error(fmt::format("Image '{}' is truncated ({} bytes for {} entries)", path.string(), size, header.entry_count));
+    }
+    this->source_ = {header.source_size, header.source_modified, header.source_options};
+    this->num_entries_ = header.entry_count;
+    this->tags_offset_ = static_cast<std::size_t>(tags_offset);
+    this->text_offset_ = static_cast<std::size_t>(text_offset);
+
+    // Check every span once, so the getters never read past the mapping; this reads the records, but copies none of them
+    const auto is_valid = [&header](const Span &span) {
+        return std::uint64_t{span.offset} + span.size <= header.text_size;
+    };
+    for (std::uint32_t idx = 0; idx < header.tag_count; ++idx) {
+        Span tag;
+        std::memcpy(&tag, data + this->tags_offset_ + idx * sizeof(Span), sizeof(tag));
+        if (!is_valid(tag)) {
+            throw std::runtime_error(fmt::format("Image '{}' is corrupt at tag {}", path.string(), idx));
+        }
+    }
+    for (std::size_t id = 0; id < this->num_entries_; ++id) {
+        const Record record = this->get_record(id);
+        if (!is_valid(record.hangul) || !is_valid(record.latin) || !is_valid(record.memo) ||
+            record.category > static_cast<std::uint32_t>(vocabulary::Category::CompoundVowel) ||
+            std::uint64_t{record.first_tag} + record.num_tags > header.tag_count) {
+            throw std::runtime_error(fmt::format("Image '{}' is corrupt at entry {}", path.string(), id));
+        }
+    }
+}
+
+void Image::save(const std::filesystem::path &path) const
+{
+    core::file::write_atomically(path, this->get_data(), this->get_size());
+}
+
+bool Image::is_mapped() const
+{
+    return this->mapping_ != nullptr;
+}
+
+const Source &Image::get_source() const
+{
+    return this->source_;
+}
+
+std::size_t Image::get_size() const
+{
+    return this->mapping_ ? this->mapping_->get_size() : this->buffer_.size();
+}
+
+std::size_t Image::get_num_entries() const
+{
+    return this->num_entries_;
+}
+
+std::string_view Image::get_hangul(const std::size_t id) const
+{
+    return this->get_text(this->get_record(id).hangul);
+}
+
+std::string_view Image::get_latin(const std::size_t id) const
+{
+    return this->get_text(this->get_record(id).latin);
+}
+
+std::string_view Image::get_memo(const std::size_t id) const
+{
+    return this->get_text(this->get_record(id).memo);
+}
+
+vocabulary::Category Image::get_category(const std::size_t id) const
+{
+    return static_cast<vocabulary::Category>(this->get_record(id).category);
+}
+
+std::vector<std::string_view> Image::get_tags(const std::size_t id) const
+{
+    const Record record = this->get_record(id);
+    std::vector<std::string_view> tags;
+    tags.reserve(record.num_tags);
+    for (std::uint32_t idx = 0; idx < record.num_tags; ++idx) {
+        tags.emplace_back(this->get_tag(record.first_tag + idx));
+    }
+    return tags;
+}
+
+vocabulary::Entry Image::get_entry(const std::size_t id) const
+{
+    const Record record = this->get_record(id);
+    std::vector<std::string> tags;
+    tags.reserve(record.num_tags);
+    for (std::uint32_t idx = 0; idx < record.num_tags; ++idx) {
+        tags.emplace_back(this->get_tag(record.first_tag + idx));
+    }
+    return {std::string(this->get_text(record.hangul)), std::string(this->get_text(record.latin)), std::string(this->get_text(record.memo)), static_cast<vocabulary::Category>(record.category), std::move(tags), id};
+}
+
+const std::uint8_t *Image::get_data() const
+{
+    return this->mapping_ ? this->mapping_->get_data() : this->buffer_.data();
+}
+
+Image::Record Image::get_record(const std::size_t id) const
+{
+    Record record;
+    std::memcpy(&record, this->get_data() + header_size + id * sizeof(Record), sizeof(record));
+    return record;
+}
+
+std::string_view Image::get_tag(const std::size_t index) const
+{
+    Span span;
+    std::memcpy(&span, this->get_data() + this->tags_offset_ + index * sizeof(Span), sizeof(span));
+    return this->get_text(span);
+}
+
+std::string_view Image::get_text(const Span &span) const
+{
+    return {reinterpret_cast<const char *>(this->get_data() + this->text_offset_ + span.offset), span.size};
+}
+
+}  // namespace modules::image
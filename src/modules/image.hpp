@@ -0,0 +1,271 @@
+/**
+ * @file image.hpp
+ *
+ * @brief Compile the entries of a deck into a compact, read-only image, which several processes can map from one file and share.
+ */
+
+#pragma once
+
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint8_t, std::uint32_t, std::uint64_t, std::int64_t
+#include <filesystem>   // for std::filesystem
+#include <memory>       // for std::shared_ptr
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
+
+#include "core/file.hpp"
+
+namespace modules::vocabulary {
+enum class Category;
+struct Entry;
+}  // namespace modules::vocabulary
+
+namespace modules::image {
+
+/**
+ * @brief Struct that represents the deck file an image was compiled from, to tell whether the image is out of date.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Source final {
+    /**
+     * @brief Size of the deck file in bytes (e.g., "50000000").
+     */
+    std::uint64_t size = 0;
+
+    /**
+     * @brief Last write time of the deck file, in ticks of "std::filesystem::file_time_type".
+     */
+    std::int64_t modified = 0;
+
+    /**
+     * @brief Fingerprint of the layout the deck file was imported with (e.g., its columns).
+     */
+    std::uint64_t options = 0;
+
+    [[nodiscard]] bool operator==(const Source &other) const
+    {
+        return this->size == other.size && this->modified == other.modified && this->options == other.options;
+    }
+};
+
+/**
+ * @brief Class that stores entries as fixed-size records and one block of text, in the same bytes in memory as on disk.
+ *
+ * An image is either compiled in memory, or mapped read-only from a file written by "save()".
+ * Mapped images are backed by the page cache, so every process that maps the same file shares one physical copy of the entries, and its own memory holds only what it computes from them.
+ * A file is only ever replaced by renaming a new one over it, never written in place, so a mapping stays valid for as long as it is open.
+ *
+ * Copies of a mapped image share the mapping, which is unmapped with the last copy.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Image final {
+  public:
+    /**
+     * @brief Construct a new Image object without any entries.
+     */
+    explicit Image();
+
+    /**
+     * @brief Compile entries into a new Image object in memory. This is O(number of entries).
+     *
+     * @param entries Entries, whose IDs are assigned from their order; the Korean text is stored in the canonical form of "core::normalization::compose()".
+     * @param source Deck file the entries were imported from (default: none).
+     *
+     * @throws std::runtime_error if the entries hold more than 4 GiB of text.
+     */
+    explicit Image(const std::vector<vocabulary::Entry> &entries,
+                   const Source &source = {});
+
+    /**
+     * @brief Map an image file. This is O(number of entries), as every record is checked, but copies nothing.
+     *
+     * @param path Path to the file (e.g., "~/.local/share/aegyo/deck.img").
+     *
+     * @throws std::runtime_error if the file cannot be mapped, or is not a valid image (e.g., truncated, or written on a machine with a different byte order).
+     */
+    explicit Image(const std::filesystem::path &path);
+
+    /**
+     * @brief Write the image to a file atomically, so processes that map the previous file keep reading it.
+     *
+     * @param path Path to the file (e.g., "~/.local/share/aegyo/deck.img").
+     *
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void save(const std::filesystem::path &path) const;
+
+    /**
+     * @brief Check whether the image is mapped from a file, rather than compiled in memory.
+     *
+     * @return True if mapped, false otherwise.
+     */
+    [[nodiscard]] bool is_mapped() const;
+
+    /**
+     * @brief Get the deck file the image was compiled from.
+     *
+     * @return Source of the image, which is all zeros if there is none.
+     */
+    [[nodiscard]] const Source &get_source() const;
+
+    /**
+     * @brief Get the size of the image.
+     *
+     * @return Number of bytes (e.g., "30000000").
+     */
+    [[nodiscard]] std::size_t get_size() const;
+
+    /**
+     * @brief Get the number of entries.
+     *
+     * @return Number of entries (e.g., "40").
+     */
+    [[nodiscard]] std::size_t get_num_entries() const;
+
+    /**
+     * @brief Get the Korean text of an entry. This and the other getters are O(1) and never allocate.
+     *
+     * @param id ID of the entry, which must be less than "get_num_entries()" (e.g., "3").
+     *
+     * @return View of the text in canonical form (e.g., "ㅕ"), valid for as long as the image.
+     */
+    [[nodiscard]] std::string_view get_hangul(const std::size_t id) const;
+
+    /**
+     * @brief Get the Latin transliteration of an entry.
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return View of the transliteration (e.g., "yeo"), valid for as long as the image.
+     */
+    [[nodiscard]] std::string_view get_latin(const std::size_t id) const;
+
+    /**
+     * @brief Get the memo of an entry.
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return View of the memo, which may be empty, valid for as long as the image.
+     */
+    [[nodiscard]] std::string_view get_memo(const std::size_t id) const;
+
+    /**
+     * @brief Get the category of an entry.
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return Category (e.g., "Category::BasicVowel").
+     */
+    [[nodiscard]] vocabulary::Category get_category(const std::size_t id) const;
+
+    /**
+     * @brief Get the tags of an entry.
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return Views of the tags, in their original order (e.g., {"vowel", "iotized"}), valid for as long as the image.
+     */
+    [[nodiscard]] std::vector<std::string_view> get_tags(const std::size_t id) const;
+
+    /**
+     * @brief Copy an entry out of the image.
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return Entry object, whose ID is "id".
+     */
+    [[nodiscard]] vocabulary::Entry get_entry(const std::size_t id) const;
+
+  private:
+    /**
+     * @brief Struct that represents a range of the text block.
+     *
+     * @note This struct is marked as `final` to prevent inheritance.
+     */
+    struct Span final {
+        std::uint32_t offset;  // Offset of the first byte in the text block
+        std::uint32_t size;    // Number of bytes
+    };
+
+    /**
+     * @brief Struct that represents an entry, stored in native byte order.
+     *
+     * @note This struct is marked as `final` to prevent inheritance.
+     */
+    struct Record final {
+        Span hangul;              // Korean text
+        Span latin;               // Latin transliteration
+        Span memo;                // Memo
+        std::uint32_t category;   // Category, as the value of "vocabulary::Category"
+        std::uint32_t first_tag;  // Index of the first tag in the tag table
+        std::uint32_t num_tags;   // Number of tags
+    };
+
+    /**
+     * @brief Get the bytes of the image, wherever they are.
+     *
+     * @return Pointer to the first byte.
+     */
+    [[nodiscard]] const std::uint8_t *get_data() const;
+
+    /**
+     * @brief Read the record of an entry.
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return Record of the entry.
+     */
+    [[nodiscard]] Record get_record(const std::size_t id) const;
+
+    /**
+     * @brief Get the text of a tag in the tag table.
+     *
+     * @param index Index of the tag in the tag table (e.g., "7").
+     *
+     * @return View of the tag (e.g., "vowel"), valid for as long as the image.
+     */
+    [[nodiscard]] std::string_view get_tag(const std::size_t index) const;
+
+    /**
+     * @brief Get the text of a span.
+     *
+     * @param span Range of the text block.
+     *
+     * @return View of the text, valid for as long as the image.
+     */
+    [[nodiscard]] std::string_view get_text(const Span &span) const;
+
+    /**
+     * @brief Bytes of an image compiled in memory, or empty if mapped.
+     */
+    std::vector<std::uint8_t> buffer_;
+
+    /**
+     * @brief Mapping of an image file, shared by the copies of the image, or nullptr if compiled in memory.
+     */
+    std::shared_ptr<const core::file::MappedFile> mapping_;
+
+    /**
+     * @brief Deck file the image was compiled from.
+     */
+    Source source_;
+
+    /**
+     * @brief Number of entries.
+     */
+    std::size_t num_entries_;
+
+    /**
+     * @brief Offset of the tag table in bytes.
+     */
+    std::size_t tags_offset_;
+
+    /**
+     * @brief Offset of the text block in bytes.
+     */
+    std::size_t text_offset_;
+};
+
+}  // namespace modules::image
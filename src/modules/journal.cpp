@@ -0,0 +1,486 @@
+/**
+ * @file journal.cpp
+ */
+
+#include <algorithm>     // for std::min, std::equal, std::copy
+#include <array>         // for std::array
+#include <chrono>        // for std::chrono
+#include <cstddef>       // for std::size_t
+#include <cstdint>       // for std::uint8_t, std::uint32_t, std::uint64_t, std::uintmax_t
+#include <cstdio>        // for std::FILE, std::fopen, std::fwrite, std::fclose
+#include <filesystem>    // for std::filesystem
+#include <fstream>       // for std::ifstream
+#include <functional>    // for std::function
+#include <ios>           // for std::ios, std::streamsize
+#include <mutex>         // for std::mutex, std::lock_guard, std::unique_lock
+#include <stdexcept>     // for std::runtime_error
+#include <system_error>  // for std::error_code
+#include <thread>        // for std::thread
+#include <utility>       // for std::move, std::pair
+#include <vector>        // for std::vector
+
+#include <fmt/core.h>
+
+#include "core/file.hpp"
+#include "journal.hpp"
+
+namespace modules::journal {
+
+namespace {
+
+/**
+ * @brief Private magic bytes that identify a journal file.
+ */
+constexpr std::array<std::uint8_t, 8> header_magic = {'A', 'E', 'G', 'Y', 'O', 'J', 'N', 'L'};
+
+/**
+ * @brief Private version of the journal file format.
+ */
+constexpr std::uint32_t header_version = 1;
+
+/**
+ * @brief Private size of the file header in bytes (magic, version, generation).
+ */
+constexpr std::size_t header_size = 16;
+
+/**
+ * @brief Private size of a single encoded record in bytes (timestamp, entry ID, chosen ID, latency and correct flag, checksum).
+ */
+constexpr std::size_t record_size = 24;
+
+/**
+ * @brief Private bit of the latency field that stores the correct flag.
+ */
+constexpr std::uint32_t correct_flag = 0x80000000u;
+
+/**
+ * @brief Private helper function to build the CRC-32 (IEEE 802.3) lookup table at compile time.
+ *
+ * @return Lookup table with 256 entries.
+ */
+[[nodiscard]] constexpr std::array<std::uint32_t, 256> make_crc32_table()
+{
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t idx = 0; idx < 256; ++idx) {
+        std::uint32_t value = idx;
+        for (int bit = 0; bit < 8; ++bit) {
+            value = (value & 1u) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+        }
+        table[idx] = value;
+    }
+    return table;
+}
+
+/**
+ * @brief Private CRC-32 lookup table.
+ */
+constexpr std::array<std::uint32_t, 256> crc32_table = make_crc32_table();
+
+/**
+ * @brief Private helper function to compute the CRC-32 checksum of a byte range.
+ *
+ * @param data Pointer to the first byte.
+ * @param size Number of bytes.
+ *
+ * @return CRC-32 checksum.
+ */
+[[nodiscard]] std::uint32_t crc32(const std::uint8_t *data,
+                                  const std::size_t size)
+{
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        crc = crc32_table[(crc ^ data[idx]) & 0xFFu] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @brief Private helper function to write an unsigned integer in little-endian byte order.
+ *
+ * @tparam T Unsigned integer type.
+ * @param out Pointer to the destination, which must have room for "sizeof(T)" bytes.
+ * @param value Value to write.
+ */
+template <typename T>
+void store_le(std::uint8_t *out,
+              const T value)
+{
+    for (std::size_t idx = 0; idx < sizeof(T); ++idx) {
+        out[idx] = static_cast<std::uint8_t>(value >> (8 * idx));
+    }
+}
+
+/**
+ * @brief Private helper function to read an unsigned integer in little-endian byte order.
+ *
+ * @tparam T Unsigned integer type.
+ * @param in Pointer to the source, which must hold at least "sizeof(T)" bytes.
+ *
+ * @return Decoded value.
+ */
+template <typename T>
+[[nodiscard]] T load_le(const std::uint8_t *in)
+{
+    T value = 0;
+    for (std::size_t idx = 0; idx < sizeof(T); ++idx) {
+        value = static_cast<T>(value | (static_cast<T>(in[idx]) << (8 * idx)));
+    }
+    return value;
+}
+
+/**
+ * @brief Private helper function to encode a record into its fixed-size on-disk form.
+ *
+ * @param record Record to encode.
+ * @param out Pointer to the destination, which must have room for "record_size" bytes.
+ */
+void encode_record(const Record &record,
+                   std::uint8_t *out)
+{
+    const std::uint32_t latency = std::min(record.latency_ms, correct_flag - 1);
+    store_le<std::uint64_t>(out, record.timestamp_ms);
+    store_le<std::uint32_t>(out + 8, record.entry_id);
+    store_le<std::uint32_t>(out + 12, record.chosen_id);
+    store_le<std::uint32_t>(out + 16, record.correct ? (latency | correct_flag) : latency);
+    store_le<std::uint32_t>(out + 20, crc32(out, 20));
+}
+
+/**
+ * @brief Private helper function to decode a record from its fixed-size on-disk form.
+ *
+ * @param in Pointer to the source, which must hold at least "record_size" bytes.
+ * @param record Record to fill in.
+ *
+ * @return True if the checksum matches, false if the record is torn or corrupted.
+ */
+[[nodiscard]] bool decode_record(const std::uint8_t *in,
+                                 Record &record)
+{
+    if (load_le<std::uint32_t>(in + 20) != crc32(in, 20)) {
+        return false;
+    }
+    const std::uint32_t latency = load_le<std::uint32_t>(in + 16);
+    record.timestamp_ms = load_le<std::uint64_t>(in);
+    record.entry_id = load_le<std::uint32_t>(in + 8);
+    record.chosen_id = load_le<std::uint32_t>(in + 12);
+    record.latency_ms = latency & ~correct_flag;
+    record.correct = (latency & correct_flag) != 0;
+    return true;
+}
+
+/**
+ * @brief Private helper function to create a journal file that holds only a header.
+ *
+ * @param path Path to the journal file.
+ * @param generation Generation number to store in the header.
+ *
+ * @return True if the header was written and synced, false otherwise.
+ */
+[[nodiscard]] bool write_header(const std::filesystem::path &path,
+                                const std::uint32_t generation)
+{
+    std::array<std::uint8_t, header_size> header{};
+    std::copy(header_magic.cbegin(), header_magic.cend(), header.begin());
+    store_le<std::uint32_t>(header.data() + 8, header_version);
+    store_le<std::uint32_t>(header.data() + 12, generation);
+    std::FILE *file = std::fopen(path.string().c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    const bool ok = std::fwrite(header.data(), 1, header.size(), file) == header.size() && core::file::sync(file);
+    std::fclose(file);
+    return ok;
+}
+
+/**
+ * @brief Private helper function to decode the records of a journal file without changing it.
+ *
+ * Records are decoded until the first torn or corrupted slot.
+ *
+ * @param path Path to the journal file.
+ * @param min_generation Oldest generation whose records are still needed.
+ * @param generation Generation of the journal, set only if it has a valid header.
+ * @param valid_size Size of the header and the valid records in bytes, or 0 if the file is missing, unrecognized, or older than "min_generation".
+ * @param file_size Size of the file in bytes.
+ *
+ * @return Decoded records.
+ *
+ * @throws std::runtime_error If the journal file exists but cannot be read.
+ */
+[[nodiscard]] std::vector<Record> decode_file(const std::filesystem::path &path,
+                                              const std::uint32_t min_generation,
+                                              std::uint32_t &generation,
+                                              std::size_t &valid_size,
+                                              std::size_t &file_size)
+{
+    std::vector<std::uint8_t> bytes;
+    std::error_code ec;
+    if (const auto size = std::filesystem::file_size(path, ec); !ec) {
+        bytes.resize(static_cast<std::size_t>(size));
+        std::ifstream in(path, std::ios::binary);
+        if (!in.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+            throw std::runtime_error(fmt::format("Failed to read journal '{}'", path.string()));
+        }
+    }
+    file_size = bytes.size();
+    valid_size = 0;
+
+    const bool valid_header = bytes.size() >= header_size &&
+                              std::equal(header_magic.cbegin(), header_magic.cend(), bytes.cbegin()) &&
+                              load_le<std::uint32_t>(bytes.data() + 8) == header_version &&
+                              load_le<std::uint32_t>(bytes.data() + 12) >= min_generation;
+    if (!valid_header) {
+        return {};
+    }
+    generation = load_le<std::uint32_t>(bytes.data() + 12);
+
+    std::vector<Record> records;
+    records.reserve((bytes.size() - header_size) / record_size);
+    std::size_t offset = header_size;
+    for (Record record{}; offset + record_size <= bytes.size() && decode_record(bytes.data() + offset, record); offset += record_size) {
+        records.emplace_back(record);
+    }
+    valid_size = offset;
+    return records;
+}
+
+/**
+ * @brief Private helper function to replay an existing journal file and repair it.
+ *
+ * Anything after the last valid record is cut off, so new records are appended right after it.
+ * A missing or unrecognized file, or a file older than "min_generation", is replaced by an empty journal.
+ *
+ * @param path Path to the journal file.
+ * @param min_generation Oldest generation whose records are still needed.
+ * @param generation Generation of the journal after recovery.
+ *
+ * @return Recovered records.
+ *
+ * @throws std::runtime_error If the journal file cannot be read, created or truncated.
+ */
+[[nodiscard]] std::vector<Record> recover(const std::filesystem::path &path,
+                                          const std::uint32_t min_generation,
+                                          std::uint32_t &generation)
+{
+    std::size_t valid_size;
+    std::size_t file_size;
+    std::vector<Record> records = decode_file(path, min_generation, generation, valid_size, file_size);
+    if (valid_size == 0) {
+        // Start a fresh journal
+        generation = min_generation;
+        if (!write_header(path, generation)) {
+            throw std::runtime_error(fmt::format("Failed to write journal header to '{}'", path.string()));
+        }
+        return {};
+    }
+
+    // Cut off the torn tail, if any
+    if (valid_size != file_size) {
+        std::error_code ec;
+        std::filesystem::resize_file(path, valid_size, ec);
+        if (ec) {
+            throw std::runtime_error(fmt::format("Failed to truncate torn journal '{}': {}", path.string(), ec.message()));
+        }
+        fmt::print(stderr, "Warning: Discarded {} bytes of torn journal tail in '{}'\n", file_size - valid_size, path.string());
+    }
+    return records;
+}
+
+}  // namespace
+
+Journal::Journal(const std::filesystem::path &path,
+                 const std::uint32_t min_generation,
+                 const std::chrono::milliseconds commit_interval)
+    : path_(path),
+      commit_interval_(commit_interval),
+      recovered_records_(),
+      file_(nullptr),
+      size_(0),
+      generation_(0),
+      appended_count_(0),
+      processed_count_(0),
+      durable_count_(0),
+      failed_(false),
+      flush_requested_(false),
+      stopping_(false)
+{
+    this->recovered_records_ = recover(path, min_generation, this->generation_);
+    this->size_ = header_size + this->recovered_records_.size() * record_size;
+    this->file_ = std::fopen(path.string().c_str(), "ab");
+    if (!this->file_) {
+        throw std::runtime_error(fmt::format("Failed to open journal '{}' for appending", path.string()));
+    }
+    this->writer_ = std::thread(&Journal::writer_loop, this);
+}
+
+Journal::~Journal()
+{
+    {
+        const std::lock_guard<std::mutex> lock(this->mutex_);
+        this->stopping_ = true;
+    }
+    this->wake_.notify_one();
+    this->writer_.join();
+    if (this->file_) {
+        std::fclose(this->file_);
+    }
+}
+
+void Journal::append(const Record &record)
+{
+    {
+        const std::lock_guard<std::mutex> lock(this->mutex_);
+        this->pending_.emplace_back(record);
+        ++this->appended_count_;
+    }
+    this->wake_.notify_one();
+}
+
+void Journal::checkpoint(std::function<bool(std::uint32_t)> write_snapshot)
+{
+    {
+        const std::lock_guard<std::mutex> lock(this->mutex_);
+        this->pending_checkpoints_.emplace_back(this->pending_.size(), std::move(write_snapshot));
+        ++this->appended_count_;
+    }
+    this->wake_.notify_one();
+}
+
+bool Journal::flush()
+{
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    const std::uint64_t target = this->appended_count_;
+    if (this->processed_count_ < target) {
+        this->flush_requested_ = true;
+        this->wake_.notify_one();
+        this->durable_.wait(lock, [this, target] { return this->processed_count_ >= target; });
+    }
+    return this->durable_count_ >= target;
+}
+
+std::uint32_t Journal::get_generation()
+{
+    const std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->generation_;
+}
+
+const std::vector<Record> &Journal::get_recovered_records() const
+{
+    return this->recovered_records_;
+}
+
+std::vector<Record> Journal::read(const std::filesystem::path &path,
+                                  const std::uint32_t min_generation)
+{
+    std::uint32_t generation;
+    std::size_t valid_size;
+    std::size_t file_size;
+    return decode_file(path, min_generation, generation, valid_size, file_size);
+}
+
+void Journal::writer_loop()
+{
+    std::vector<Record> batch;
+    std::vector<std::pair<std::size_t, std::function<bool(std::uint32_t)>>> checkpoints;
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    while (true) {
+        this->wake_.wait(lock, [this] { return this->stopping_ || !this->pending_.empty() || !this->pending_checkpoints_.empty(); });
+        if (this->pending_.empty() && this->pending_checkpoints_.empty()) {
+            break;  // Stopping and nothing left to commit
+        }
+
+        // Let more records join this commit, unless someone is waiting for durability
+        this->wake_.wait_for(lock, this->commit_interval_, [this] { return this->stopping_ || this->flush_requested_; });
+
+        batch.swap(this->pending_);
+        checkpoints.swap(this->pending_checkpoints_);
+        const std::uint64_t committed_count = this->appended_count_;
+        std::uint32_t generation = this->generation_;
+        bool failed = this->failed_;
+        lock.unlock();
+
+        // Commit the records between checkpoints, rotating the journal after each successful snapshot, which also holds any records that failed to commit
+        std::size_t begin = 0;
+        for (auto &[position, write_snapshot] : checkpoints) {
+            failed = !this->commit(batch, begin, position) || failed;
+            begin = position;
+            if (write_snapshot(generation + 1)) {
+                // The journal follows the snapshot to its generation, even if the file cannot be truncated, in which case it stays closed
+                this->rotate(++generation);
+                failed = false;
+            }
+        }
+        failed = !this->commit(batch, begin, batch.size()) || failed;
+        batch.clear();
+        checkpoints.clear();
+
+        lock.lock();
+        this->generation_ = generation;
+        this->processed_count_ = committed_count;
+        this->failed_ = failed;
+        if (!failed) {
+            this->durable_count_ = committed_count;
+        }
+        if (this->processed_count_ == this->appended_count_) {
+            this->flush_requested_ = false;
+        }
+        this->durable_.notify_all();
+    }
+}
+
+bool Journal::commit(const std::vector<Record> &batch,
+                     const std::size_t begin,
+                     const std::size_t end)
+{
+    if (begin == end) {
+        return true;
+    }
+    if (!this->file_) {
+        fmt::print(stderr, "Warning: Dropped {} records, because journal '{}' is not open\n", end - begin, this->path_.string());
+        return false;
+    }
+    std::vector<std::uint8_t> buffer((end - begin) * record_size);
+    for (std::size_t idx = begin; idx < end; ++idx) {
+        encode_record(batch[idx], buffer.data() + (idx - begin) * record_size);
+    }
+    if (std::fwrite(buffer.data(), 1, buffer.size(), this->file_) == buffer.size() && core::file::sync(this->file_)) {
+        this->size_ += buffer.size();
+        return true;
+    }
+
+    // The writer runs in the background, so report the failure instead of throwing
+    fmt::print(stderr, "Warning: Failed to commit {} records to journal '{}'\n", end - begin, this->path_.string());
+
+    // Cut off whatever part of the batch reached the file, as recovery would discard every record after a torn one
+    std::fclose(this->file_);
+    this->file_ = nullptr;
+    std::error_code ec;
+    std::filesystem::resize_file(this->path_, this->size_, ec);
+    if (!ec) {
+        this->file_ = std::fopen(this->path_.string().c_str(), "ab");
+    }
+    if (!this->file_) {
+        fmt::print(stderr, "Warning: Closed journal '{}' until the next snapshot, because it could not be truncated back to its last committed record\n", this->path_.string());
+    }
+    return false;
+}
+
+void Journal::rotate(const std::uint32_t generation)
+{
+    if (this->file_) {
+        std::fclose(this->file_);
+        this->file_ = nullptr;
+    }
+    // Never append to a header that still names an older generation, as recovery discards the records of a journal older than its snapshot
+    if (!write_header(this->path_, generation)) {
+        fmt::print(stderr, "Warning: Closed journal '{}' until the next snapshot, because it could not be truncated\n", this->path_.string());
+        return;
+    }
+    this->size_ = header_size;
+    this->file_ = std::fopen(this->path_.string().c_str(), "ab");
+    if (!this->file_) {
+        fmt::print(stderr, "Warning: Failed to reopen journal '{}' for appending\n", this->path_.string());
+    }
+}
+
+}  // namespace modules::journal
@@ -0,0 +1,262 @@
+/**
+ * @file journal.hpp
+ *
+ * @brief Append-only journal of answers.
+ */
+
+#pragma once
+
+#include <chrono>              // for std::chrono
+#include <condition_variable>  // for std::condition_variable
+#include <cstddef>             // for std::size_t
+#include <cstdint>             // for std::uint32_t, std::uint64_t, std::uintmax_t
+#include <cstdio>              // for std::FILE
+#include <filesystem>          // for std::filesystem
+#include <functional>          // for std::function
+#include <mutex>               // for std::mutex
+#include <thread>              // for std::thread
+#include <utility>             // for std::pair
+#include <vector>              // for std::vector
+
+namespace modules::journal {
+
+/**
+ * @brief Struct that represents a single answer stored in the journal.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Record final {
+    /**
+     * @brief Time of the answer in milliseconds since the Unix epoch (e.g., "1729123200000").
+     */
+    std::uint64_t timestamp_ms;
+
+    /**
+     * @brief ID of the entry that was asked (e.g., "3").
+     */
+    std::uint32_t entry_id;
+
+    /**
+     * @brief ID of the entry that was chosen as the answer (e.g., "5").
+     */
+    std::uint32_t chosen_id;
+
+    /**
+     * @brief Time between showing the question and answering it in milliseconds (e.g., "850").
+     */
+    std::uint32_t latency_ms;
+
+    /**
+     * @brief Whether the chosen answer was correct.
+     */
+    bool correct;
+};
+
+/**
+ * @brief Class that appends answers to a binary journal file.
+ *
+ * Each record is stored in a fixed-size, checksummed 24-byte slot after a small file header.
+ * Appending is non-blocking: records are queued and written by a background thread, which commits every queued record with a single write and a single sync to disk (group commit).
+ * On construction, the existing journal is replayed; a torn or corrupted tail left by a crash or power loss is discarded.
+ * If a commit fails (e.g., the disk is full), the file is truncated back to its last committed record, so a half-written record never hides the ones appended after it.
+ *
+ * The journal can be compacted with checkpoints: once the records before a checkpoint are committed, a snapshot is written and the journal is truncated, starting a new generation.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Journal final {
+  public:
+    /**
+     * @brief Open or create a journal file and start the background writer.
+     *
+     * @param path Path to the journal file (e.g., "~/.local/share/aegyo/journal.bin").
+     * @param min_generation Oldest generation whose records are still needed; an older journal was already folded into a snapshot, so its records are discarded (default: 0).
+     * @param commit_interval How long the writer waits for more records before committing a batch (default: 250 ms).
+     *
+     * @throws std::runtime_error If the journal file cannot be opened or repaired.
+     */
+    explicit Journal(const std::filesystem::path &path,
+                     const std::uint32_t min_generation = 0,
+                     const std::chrono::milliseconds commit_interval = std::chrono::milliseconds(250));
+
+    /**
+     * @brief Commit all queued records, stop the background writer and close the journal file.
+     */
+    ~Journal();
+
+    Journal(const Journal &) = delete;
+    Journal &operator=(const Journal &) = delete;
+
+    /**
+     * @brief Queue a record for the next group commit. This never waits for the disk.
+     *
+     * @param record Record to append.
+     */
+    void append(const Record &record);
+
+    /**
+     * @brief Queue a checkpoint after the records appended so far. This never waits for the disk.
+     *
+     * Once every earlier record is committed, the background writer calls "write_snapshot" with the next generation number.
+     * If it returns true, the journal is truncated and continues with that generation; otherwise, the journal is left as is.
+     *
+     * @param write_snapshot Function that durably stores everything folded from the journal so far, tagged with the given generation.
+     */
+    void checkpoint(std::function<bool(std::uint32_t)> write_snapshot);
+
+    /**
+     * @brief Block until every record and checkpoint queued so far has been processed by the background writer.
+     *
+     * @return True if every record appended so far is durable, either in the journal file or in a snapshot, false if a commit failed since the last successful checkpoint.
+     */
+    [[nodiscard]] bool flush();
+
+    /**
+     * @brief Get the current generation of the journal, which is incremented by every successful checkpoint.
+     *
+     * @return Generation number (e.g., "3").
+     */
+    [[nodiscard]] std::uint32_t get_generation();
+
+    /**
+     * @brief Get the records that were recovered from the journal file on construction.
+     *
+     * @return Const reference to a vector of Record objects, in the order they were appended.
+     */
+    [[nodiscard]] const std::vector<Record> &get_recovered_records() const;
+
+    /**
+     * @brief Read the records of a journal file without changing it (e.g., while another process owns it).
+     *
+     * @param path Path to the journal file (e.g., "~/.local/share/aegyo/journal.bin").
+     * @param min_generation Oldest generation whose records are still needed (default: 0).
+     *
+     * @return Records up to the first torn or corrupted one, or an empty vector if the file is missing, unrecognized, or older than "min_generation".
+     *
+     * @throws std::runtime_error If the journal file exists but cannot be read.
+     */
+    [[nodiscard]] static std::vector<Record> read(const std::filesystem::path &path,
+                                                  const std::uint32_t min_generation = 0);
+
+  private:
+    /**
+     * @brief Background thread loop that batches queued records and commits them.
+     */
+    void writer_loop();
+
+    /**
+     * @brief Write a range of a batch of records to the journal file and sync it to disk.
+     *
+     * If the write or the sync fails, the file is truncated back to its last committed record.
+     *
+     * @param batch Records to write.
+     * @param begin Index of the first record to write.
+     * @param end Index past the last record to write.
+     *
+     * @return True if the records were committed, false otherwise.
+     */
+    [[nodiscard]] bool commit(const std::vector<Record> &batch,
+                              const std::size_t begin,
+                              const std::size_t end);
+
+    /**
+     * @brief Truncate the journal file and start a new generation.
+     *
+     * If the new header cannot be written, the file is left closed, and records are dropped until the next rotation, rather than appended to a journal that recovery would discard.
+     *
+     * @param generation Generation number to store in the new header.
+     */
+    void rotate(const std::uint32_t generation);
+
+    /**
+     * @brief Path to the journal file.
+     */
+    std::filesystem::path path_;
+
+    /**
+     * @brief How long the writer waits for more records before committing a batch.
+     */
+    std::chrono::milliseconds commit_interval_;
+
+    /**
+     * @brief Records recovered from the journal file on construction.
+     */
+    std::vector<Record> recovered_records_;
+
+    /**
+     * @brief Journal file opened for appending, owned by the background writer after construction.
+     */
+    std::FILE *file_;
+
+    /**
+     * @brief Size of the journal file up to its last committed record in bytes, owned by the background writer after construction.
+     */
+    std::uintmax_t size_;
+
+    /**
+     * @brief Current generation of the journal.
+     */
+    std::uint32_t generation_;
+
+    /**
+     * @brief Mutex that protects the queue and the counters below.
+     */
+    std::mutex mutex_;
+
+    /**
+     * @brief Condition variable that wakes the background writer.
+     */
+    std::condition_variable wake_;
+
+    /**
+     * @brief Condition variable that wakes threads waiting in "flush()".
+     */
+    std::condition_variable durable_;
+
+    /**
+     * @brief Records waiting for the next group commit.
+     */
+    std::vector<Record> pending_;
+
+    /**
+     * @brief Checkpoints waiting for the next group commit, each with the number of pending records that precede it.
+     */
+    std::vector<std::pair<std::size_t, std::function<bool(std::uint32_t)>>> pending_checkpoints_;
+
+    /**
+     * @brief Number of records and checkpoints queued since construction.
+     */
+    std::uint64_t appended_count_;
+
+    /**
+     * @brief Number of records and checkpoints processed by the background writer since construction, whether or not they were committed.
+     */
+    std::uint64_t processed_count_;
+
+    /**
+     * @brief Number of records and checkpoints synced to disk since construction; this stops advancing while "failed_" is set.
+     */
+    std::uint64_t durable_count_;
+
+    /**
+     * @brief Whether a commit failed since the last successful checkpoint, so some records exist only in memory.
+     */
+    bool failed_;
+
+    /**
+     * @brief Whether a thread is waiting in "flush()", so the writer should commit without waiting.
+     */
+    bool flush_requested_;
+
+    /**
+     * @brief Whether the background writer should exit after committing the queued records.
+     */
+    bool stopping_;
+
+    /**
+     * @brief Background writer thread.
+     */
+    std::thread writer_;
+};
+
+}  // namespace modules::journal
@@ -0,0 +1,114 @@
+/**
+ * @file knowledge.cpp
+ */
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <vector>   // for std::vector
+
+#include "history.hpp"
+#include "knowledge.hpp"
+
+namespace modules::knowledge {
+
+namespace {
+
+/**
+ * @brief Private helper function to get the probability of answering correctly.
+ *
+ * @param mastery Probability that the entry is known.
+ * @param parameters Parameters of the model.
+ *
+ * @return Probability between 0.0 and 1.0.
+ */
+[[nodiscard]] float get_correct_probability(const float mastery,
+                                            const Parameters &parameters)
+{
+    return mastery * (1.0f - parameters.slip) + (1.0f - mastery) * parameters.guess;
+}
+
+}  // namespace
+
+Knowledge::Knowledge(const std::size_t num_entries,
+                     const Parameters &parameters)
+    : parameters_(parameters),
+      mastery_(num_entries, parameters.initial),
+      scores_(num_entries, 0.0f)
+{
+    this->rescore();
+}
+
+void Knowledge::update(const std::size_t entry_id,
+                       const bool correct)
+{
+    this->update(entry_id, correct, this->parameters_.guess);
+}
+
+void Knowledge::update(const std::size_t entry_id,
+                       const bool correct,
+                       const float guess)
+{
+    if (entry_id >= this->mastery_.size()) {
+        return;
+    }
+    const Parameters &p = this->parameters_;
+    const float mastery = this->mastery_[entry_id];
+
+    // Posterior that the entry is known given the answer, followed by a chance to learn it
+    const float known = correct ? mastery * (1.0f - p.slip) : mastery * p.slip;
+    const float unknown = correct ? (1.0f - mastery) * guess : (1.0f - mastery) * (1.0f - guess);
+    const float posterior = known + unknown > 0.0f ? known / (known + unknown) : mastery;
+    const float updated = posterior + (1.0f - posterior) * p.learn;
+
+    this->mastery_[entry_id] = updated;
+    this->scores_[entry_id] = 1.0f - get_correct_probability(updated, p);
+}
+
+void Knowledge::rebuild(const history::History &history)
+{
+    for (std::size_t idx = 0; idx < this->mastery_.size(); ++idx) {
+        this->mastery_[idx] = this->parameters_.initial;
+        const std::size_t length = history.get_length(idx);
+        const std::uint64_t outcomes = history.get_outcomes(idx);
+        for (std::size_t bit = length; bit > 0; --bit) {
+            this->update(idx, ((outcomes >> (bit - 1)) & 1u) != 0);
+        }
+    }
+    this->rescore();
+}
+
+void Knowledge::rescore()
+{
+    // Hoist the parameters into locals and keep the loop free of branches and aliasing, so it compiles to packed SIMD arithmetic
+    const float known_correct = 1.0f - this->parameters_.slip;
+    const float guess = this->parameters_.guess;
+    const std::size_t num_entries = this->mastery_.size();
+    const float *const mastery = this->mastery_.data();
+    float *const scores = this->scores_.data();
+    for (std::size_t idx = 0; idx < num_entries; ++idx) {
+        scores[idx] = 1.0f - (mastery[idx] * known_correct + (1.0f - mastery[idx]) * guess);
+    }
+}
+
+void Knowledge::set_parameters(const Parameters &parameters)
+{
+    this->parameters_ = parameters;
+    this->rescore();
+}
+
+const Parameters &Knowledge::get_parameters() const
+{
+    return this->parameters_;
+}
+
+float Knowledge::get_mastery(const std::size_t entry_id) const
+{
+    return entry_id < this->mastery_.size() ? this->mastery_[entry_id] : 0.0f;
+}
+
+const std::vector<float> &Knowledge::get_scores() const
+{
+    return this->scores_;
+}
+
+}  // namespace modules::knowledge
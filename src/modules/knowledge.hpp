@@ -0,0 +1,143 @@
+/**
+ * @file knowledge.hpp
+ *
+ * @brief Bayesian knowledge tracing model of how well each entry is known.
+ */
+
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <vector>   // for std::vector
+
+#include "history.hpp"
+
+namespace modules::knowledge {
+
+/**
+ * @brief Struct that represents the parameters of the knowledge tracing model.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Parameters final {
+    /**
+     * @brief Probability that an entry is known before it is ever asked (e.g., "0.2").
+     */
+    float initial = 0.2f;
+
+    /**
+     * @brief Probability that an unknown entry becomes known after being asked (e.g., "0.15").
+     */
+    float learn = 0.15f;
+
+    /**
+     * @brief Probability of answering a known entry incorrectly (e.g., "0.1").
+     */
+    float slip = 0.1f;
+
+    /**
+     * @brief Probability of answering an unknown entry correctly, which is one over the number of options for multiple choice (e.g., "0.25").
+     */
+    float guess = 0.25f;
+};
+
+/**
+ * @brief Class that estimates the probability that each entry is known, using Bayesian knowledge tracing.
+ *
+ * After each answer, the estimate of the asked entry is updated in O(1): the answer is weighed against the slip and guess probabilities, then a chance of learning is applied.
+ * Selection scores (the probability of answering incorrectly) are kept in a separate contiguous array and recomputed for the whole deck in one branch-free pass, which the compiler vectorizes; this is needed whenever the parameters change (e.g., the number of options, and thus the guess probability).
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Knowledge final {
+  public:
+    /**
+     * @brief Construct a new Knowledge object where no entry has been asked yet.
+     *
+     * @param num_entries Number of entries (e.g., "40").
+     * @param parameters Parameters of the model (default: Parameters{}).
+     */
+    explicit Knowledge(const std::size_t num_entries,
+                       const Parameters &parameters = {});
+
+    /**
+     * @brief Update the estimate of an entry after an answer.
+     *
+     * @param entry_id ID of the entry that was asked (e.g., "3"); IDs out of range are ignored.
+     * @param correct Whether the answer was correct.
+     */
+    void update(const std::size_t entry_id,
+                const bool correct);
+
+    /**
+     * @brief Update the estimate of an entry after an answer to a question with its own guess probability (e.g., 1/3 for a question with three options).
+     *
+     * The selection scores keep using the guess probability of the parameters.
+     *
+     * @param entry_id ID of the entry that was asked (e.g., "3"); IDs out of range are ignored.
+     * @param correct Whether the answer was correct.
+     * @param guess Probability of answering the question correctly without knowing the entry (e.g., "0.33").
+     */
+    void update(const std::size_t entry_id,
+                const bool correct,
+                const float guess);
+
+    /**
+     * @brief Rebuild every estimate by replaying the rolling answer history, oldest answer first.
+     *
+     * @param history History of the most recent answers per entry.
+     */
+    void rebuild(const history::History &history);
+
+    /**
+     * @brief Recompute the selection scores of all entries.
+     */
+    void rescore();
+
+    /**
+     * @brief Set the parameters of the model and recompute the selection scores.
+     *
+     * @param parameters Parameters of the model.
+     */
+    void set_parameters(const Parameters &parameters);
+
+    /**
+     * @brief Get the parameters of the model.
+     *
+     * @return Const reference to the parameters.
+     */
+    [[nodiscard]] const Parameters &get_parameters() const;
+
+    /**
+     * @brief Get the estimated probability that an entry is known.
+     *
+     * @param entry_id ID of the entry (e.g., "3").
+     *
+     * @return Probability between 0.0 and 1.0 (e.g., "0.85"), or 0.0 if the ID is out of range.
+     */
+    [[nodiscard]] float get_mastery(const std::size_t entry_id) const;
+
+    /**
+     * @brief Get the selection scores, where entries that are more likely to be answered incorrectly score higher.
+     *
+     * @return Const reference to a vector of scores between 0.0 and 1.0, indexed by entry ID.
+     */
+    [[nodiscard]] const std::vector<float> &get_scores() const;
+
+  private:
+    /**
+     * @brief Parameters of the model.
+     */
+    Parameters parameters_;
+
+    /**
+     * @brief Probability that each entry is known, indexed by entry ID.
+     */
+    std::vector<float> mastery_;
+
+    /**
+     * @brief Selection score of each entry, indexed by entry ID.
+     */
+    std::vector<float> scores_;
+};
+
+}  // namespace modules::knowledge
@@ -0,0 +1,217 @@
+/**
+ * @file profiles.cpp
+ */
+
+#include <algorithm>     // for std::any_of
+#include <array>         // for std::array
+#include <cstddef>       // for std::size_t, offsetof
+#include <cstdint>       // for std::uint8_t, std::uint32_t
+#include <cstring>       // for std::memcpy, std::memchr
+#include <filesystem>    // for std::filesystem
+#include <optional>      // for std::optional, std::nullopt
+#include <stdexcept>     // for std::runtime_error
+#include <string>        // for std::to_string
+#include <string_view>   // for std::string_view
+#include <system_error>  // for std::error_code
+#include <type_traits>   // for std::is_trivially_copyable_v
+#include <utility>       // for std::move
+#include <vector>        // for std::vector
+
+#include <fmt/core.h>
+
+#include "core/file.hpp"
+#include "profiles.hpp"
+
+namespace modules::profiles {
+
+namespace {
+
+/**
+ * @brief Private magic bytes that identify an index file.
+ */
+constexpr std::array<char, 8> index_magic = {'A', 'E', 'G', 'Y', 'O', 'P', 'R', 'F'};
+
+/**
+ * @brief Private version of the index file format.
+ */
+constexpr std::uint32_t index_version = 1;
+
+/**
+ * @brief Private marker that detects indexes written on a machine with a different byte order.
+ */
+constexpr std::uint32_t byte_order_marker = 0x01020304u;
+
+/**
+ * @brief Private size reserved for the header; the records start at this offset.
+ */
+constexpr std::size_t header_size = 32;
+
+/**
+ * @brief Private header of an index file, stored in native byte order.
+ *
+ * The header is followed by "profile_count" records, sorted by name.
+ */
+struct IndexHeader final {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t profile_count;
+    std::uint32_t next_id;
+};
+
+/**
+ * @brief Private record of a profile in an index file: its name, padded with zeros, and its ID.
+ */
+struct IndexRecord final {
+    std::array<char, Profiles::max_name_size> name;
+    std::uint32_t id;
+};
+
+static_assert(std::is_trivially_copyable_v<IndexHeader>, "IndexHeader must be trivially copyable to be memcpy'd in and out of the file.");
+static_assert(sizeof(IndexHeader) <= header_size, "IndexHeader must fit into the reserved header space.");
+static_assert(std::is_trivially_copyable_v<IndexRecord> && sizeof(IndexRecord) == 64, "IndexRecord must be 64 trivially copyable bytes to be memcpy'd in and out of the file.");
+
+}  // namespace
+
+Profiles::Profiles(const std::filesystem::path &directory)
+    : directory_(directory),
+      index_path_(directory / "index.bin"),
+      mapping_(),
+      num_profiles_(0),
+      next_id_(0)
+{
+    this->map();
+}
+
+std::optional<std::filesystem::path> Profiles::find(const std::string_view name) const
+{
+    if (const std::size_t index = this->lower_bound(name); index < this->num_profiles_ && this->get_name(index) == name) {
+        return this->directory_ / std::to_string(this->get_id(index));
+    }
+    return std::nullopt;
+}
+
+std::filesystem::path Profiles::add(const std::string_view name)
+{
+    if (name.empty() || name.size() > max_name_size) {
+        throw std::runtime_error(fmt::format("Profile name '{}' must be 1 to {} bytes long", name, max_name_size));
+    }
+    if (std::any_of(name.cbegin(), name.cend(), [](const char c) { return static_cast<std::uint8_t>(c) < 0x20 || c == 0x7f; })) {
+        throw std::runtime_error(fmt::format("Profile name '{}' contains a control character", name));
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(this->directory_, ec);
+    if (ec) {
+        throw std::runtime_error(fmt::format("Failed to create profile directory '{}': {}", this->directory_.string(), ec.message()));
+    }
+
+    // Other processes add profiles too, so the index is read, extended and replaced under a lock, or one of two concurrent additions would be lost
+    const core::file::FileLock lock(this->directory_ / "index.lock");
+    this->map();
+    const std::size_t index = this->lower_bound(name);
+    if (index < this->num_profiles_ && this->get_name(index) == name) {
+        return this->directory_ / std::to_string(this->get_id(index));
+    }
+
+    // Claim an ID by creating its directory, which fails if another process claimed it first
+    std::uint32_t id = this->next_id_;
+    while (!std::filesystem::create_directory(this->directory_ / std::to_string(id), ec)) {
+        if (ec) {
+            throw std::runtime_error(fmt::format("Failed to create profile '{}' in '{}': {}", name, this->directory_.string(), ec.message()));
+        }
+        ++id;
+    }
+
+    // Insert the new record in order; the records around it are copied as they are
+    IndexHeader header{};
+    header.magic = index_magic;
+    header.version = index_version;
+    header.byte_order = byte_order_marker;
+    header.profile_count = static_cast<std::uint32_t>(this->num_profiles_ + 1);
+    header.next_id = id + 1;
+    IndexRecord record{};
+    std::memcpy(record.name.data(), name.data(), name.size());
+    record.id = id;
+    const std::uint8_t *records = this->mapping_.has_value() ? this->mapping_->get_data() + header_size : nullptr;
+    std::vector<std::uint8_t> image(header_size + (this->num_profiles_ + 1) * sizeof(IndexRecord), 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    if (index > 0) {
+        std::memcpy(image.data() + header_size, records, index * sizeof(IndexRecord));
+    }
+    std::memcpy(image.data() + header_size + index * sizeof(IndexRecord), &record, sizeof(record));
+    if (index < this->num_profiles_) {
+        std::memcpy(image.data() + header_size + (index + 1) * sizeof(IndexRecord), records + index * sizeof(IndexRecord), (this->num_profiles_ - index) * sizeof(IndexRecord));
+    }
+    core::file::write_atomically(this->index_path_, image.data(), image.size());
+    this->map();
+    return this->directory_ / std::to_string(id);
+}
+
+std::size_t Profiles::get_num_profiles() const
+{
+    return this->num_profiles_;
+}
+
+std::string_view Profiles::get_name(const std::size_t index) const
+{
+    // The name ends at the first zero, or fills the whole field
+    const char *name = reinterpret_cast<const char *>(this->mapping_->get_data() + header_size + index * sizeof(IndexRecord));
+    const void *end = std::memchr(name, '\0', max_name_size);
+    return {name, end ? static_cast<std::size_t>(static_cast<const char *>(end) - name) : max_name_size};
+}
+
+void Profiles::map()
+{
+    if (!std::filesystem::exists(this->index_path_)) {
+        this->mapping_.reset();
+        this->num_profiles_ = 0;
+        this->next_id_ = 0;
+        return;
+    }
+
+    core::file::MappedFile mapping(this->index_path_);
+    const std::size_t size = mapping.get_size();
+    IndexHeader header;
+    if (size < header_size) {
+        throw std::runtime_error(fmt::format("Profile index '{}' is truncated ({} bytes)", this->index_path_.string(), size));
+    }
+    std::memcpy(&header, mapping.get_data(), sizeof(header));
+    if (header.magic != index_magic || header.version != index_version) {
+        throw std::runtime_error(fmt::format("Profile index '{}' has an unsupported format", this->index_path_.string()));
+    }
+    if (header.byte_order != byte_order_marker) {
+        throw std::runtime_error(fmt::format("Profile index '{}' was written on a machine with a different byte order", this->index_path_.string()));
+    }
+    if (size < header_size + std::size_t{header.profile_count} * sizeof(IndexRecord)) {
+        throw std::runtime_error(fmt::format("Profile index '{}' is truncated ({} bytes for {} profiles)", this->index_path_.string(), size, header.profile_count));
+    }
+    this->mapping_ = std::move(mapping);
+    this->num_profiles_ = header.profile_count;
+    this->next_id_ = header.next_id;
+}
+
+std::uint32_t Profiles::get_id(const std::size_t index) const
+{
+    std::uint32_t id;
+    std::memcpy(&id, this->mapping_->get_data() + header_size + index * sizeof(IndexRecord) + offsetof(IndexRecord, id), sizeof(id));
+    return id;
+}
+
+std::size_t Profiles::lower_bound(const std::string_view name) const
+{
+    std::size_t first = 0;
+    std::size_t count = this->num_profiles_;
+    while (count > 0) {
+        const std::size_t half = count / 2;
+        if (this->get_name(first + half) < name) {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+}  // namespace modules::profiles
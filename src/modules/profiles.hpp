@@ -0,0 +1,137 @@
+/**
+ * @file profiles.hpp
+ *
+ * @brief Index of learner profiles, each of which keeps its progress in its own directory.
+ */
+
+#pragma once
+
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t
+#include <filesystem>   // for std::filesystem
+#include <optional>     // for std::optional
+#include <string_view>  // for std::string_view
+
+#include "core/file.hpp"
+
+namespace modules::profiles {
+
+/**
+ * @brief Class that looks up learner profiles by name in a small index file, which is mapped rather than read.
+ *
+ * Profiles are kept in a directory:
+ * - "index.bin": fixed-size records of a name and an ID, sorted by name, behind a small header.
+ * - "<ID>/": the progress files of each profile (e.g., "17/snapshot.bin"), named by ID, so names never become paths.
+ *
+ * Finding a profile is a binary search over the mapped index, so it costs the same with thousands of profiles as with one, and never lists the directory.
+ * Adding a profile rewrites the index atomically, so other processes keep reading the previous one, while an "index.lock" file keeps processes from adding profiles at the same time.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Profiles final {
+  public:
+    /**
+     * @brief Maximum length of a profile name in bytes.
+     */
+    static constexpr std::size_t max_name_size = 60;
+
+    /**
+     * @brief Map the index of a directory of profiles, if any.
+     *
+     * @param directory Directory that holds the index and the profiles (e.g., "~/.local/share/aegyo/profiles").
+     *
+     * @throws std::runtime_error If the index cannot be mapped, or is not a valid index (e.g., truncated, or written on a machine with a different byte order).
+     */
+    explicit Profiles(const std::filesystem::path &directory);
+
+    /**
+     * @brief Find a profile by name. This is O(log(number of profiles)) and touches no other file.
+     *
+     * @param name Name of the profile (e.g., "Minji").
+     *
+     * @return Directory of the profile (e.g., "~/.local/share/aegyo/profiles/17"), or std::nullopt if there is no such profile.
+     */
+    [[nodiscard]] std::optional<std::filesystem::path> find(const std::string_view name) const;
+
+    /**
+     * @brief Add a profile, unless there is one with that name. This is O(number of profiles), as the index is rewritten.
+     *
+     * The index is locked and mapped again first, so the profiles that other processes added are kept, and the directory of the profile is created.
+     *
+     * @param name Name of the profile, of 1 to "max_name_size" bytes without control characters (e.g., "Minji").
+     *
+     * @return Directory of the profile (e.g., "~/.local/share/aegyo/profiles/17").
+     *
+     * @throws std::runtime_error If the name is invalid, or the index or the directory cannot be written.
+     */
+    std::filesystem::path add(const std::string_view name);
+
+    /**
+     * @brief Get the number of profiles.
+     *
+     * @return Number of profiles (e.g., "3000").
+     */
+    [[nodiscard]] std::size_t get_num_profiles() const;
+
+    /**
+     * @brief Get the name of a profile, in the order of the index.
+     *
+     * @param index Position of the profile in the index, which must be less than "get_num_profiles()" (e.g., "3").
+     *
+     * @return View of the name (e.g., "Minji"), valid until the next "add()".
+     */
+    [[nodiscard]] std::string_view get_name(const std::size_t index) const;
+
+  private:
+    /**
+     * @brief Map the index file again, picking up the profiles that other processes added.
+     *
+     * @throws std::runtime_error If the index cannot be mapped, or is not a valid index.
+     */
+    void map();
+
+    /**
+     * @brief Get the ID of a profile, in the order of the index.
+     *
+     * @param index Position of the profile in the index (e.g., "3").
+     *
+     * @return ID of the profile, which is the name of its directory (e.g., "17").
+     */
+    [[nodiscard]] std::uint32_t get_id(const std::size_t index) const;
+
+    /**
+     * @brief Find the first profile whose name is not less than a name.
+     *
+     * @param name Name of the profile (e.g., "Minji").
+     *
+     * @return Position in the index, which is "get_num_profiles()" if every name is less.
+     */
+    [[nodiscard]] std::size_t lower_bound(const std::string_view name) const;
+
+    /**
+     * @brief Directory that holds the index and the profiles.
+     */
+    std::filesystem::path directory_;
+
+    /**
+     * @brief Path to the index file.
+     */
+    std::filesystem::path index_path_;
+
+    /**
+     * @brief Mapping of the index file, or std::nullopt if there is none yet.
+     */
+    std::optional<core::file::MappedFile> mapping_;
+
+    /**
+     * @brief Number of profiles in the index.
+     */
+    std::size_t num_profiles_;
+
+    /**
+     * @brief ID to try for the next profile.
+     */
+    std::uint32_t next_id_;
+};
+
+}  // namespace modules::profiles
@@ -0,0 +1,530 @@
+/**
+ * @file progress.cpp
+ */
+
+#include <algorithm>      // for std::copy
+#include <array>          // for std::array
+#include <cstddef>        // for std::size_t, offsetof
+#include <cstdint>        // for std::uint8_t, std::uint32_t, std::uint64_t
+#include <cstring>        // for std::memcpy, std::memcmp
+#include <exception>      // for std::exception
+#include <filesystem>     // for std::filesystem
+#include <limits>         // for std::numeric_limits
+#include <optional>       // for std::optional
+#include <stdexcept>      // for std::runtime_error
+#include <string>         // for std::string
+#include <string_view>    // for std::string_view
+#include <system_error>   // for std::error_code
+#include <type_traits>    // for std::is_trivially_copyable_v
+#include <unordered_map>  // for std::unordered_map
+#include <utility>        // for std::move
+#include <vector>         // for std::vector
+
+#include <fmt/core.h>
+
+#include "core/file.hpp"
+#include "core/rng.hpp"
+#include "journal.hpp"
+#include "progress.hpp"
+
+namespace modules::progress {
+
+namespace {
+
+/**
+ * @brief Private magic bytes that identify a snapshot file.
+ */
+constexpr std::array<char, 8> snapshot_magic = {'A', 'E', 'G', 'Y', 'O', 'S', 'N', 'P'};
+
+/**
+ * @brief Private version of the snapshot file format.
+ *
+ * Version 2 added the rolling answer history, version 3 the confusion matrix, version 4 the settings and version 5 the entry keys; older snapshots are still read.
+ */
+constexpr std::uint32_t snapshot_version = 5;
+
+/**
+ * @brief Private marker that detects snapshots written on a machine with a different byte order.
+ */
+constexpr std::uint32_t byte_order_marker = 0x01020304u;
+
+/**
+ * @brief Private maximum number of RNG state words stored in the header.
+ */
+constexpr std::size_t max_rng_words = 625;
+
+/**
+ * @brief Private size reserved for the header; the statistics arrays start at this page-aligned offset.
+ */
+constexpr std::size_t header_size = 4096;
+
+/**
+ * @brief Private header of a snapshot file, stored in native byte order.
+ *
+ * The header is followed by arrays of "entry_count" elements: total latencies (8 bytes each), answer histories (8 bytes each, since version 2), attempts (4 bytes each), correct answers (4 bytes each) and history lengths (1 byte each, since version 2).
+ * Since version 3, the arrays are followed by "confusion_count" confusion pairs (12 bytes each).
+ * Since version 5, these are followed by the length of each entry's key (4 bytes each) and "key_size" bytes of keys.
+ * Fields added by later versions are appended to the header, so they read as zero in older snapshots.
+ */
+struct SnapshotHeader final {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t generation;
+    std::uint32_t entry_count;
+    std::uint64_t total_answers;
+    std::uint64_t total_correct;
+    std::uint32_t category_mask;
+    std::uint32_t rng_word_count;
+    std::array<std::uint32_t, max_rng_words> rng_words;
+    std::uint32_t confusion_count;
+    std::uint32_t has_settings;
+    std::uint32_t selection_policy;
+    std::uint32_t is_typing;
+    std::uint64_t key_size;
+};
+
+static_assert(std::is_trivially_copyable_v<SnapshotHeader>, "SnapshotHeader must be trivially copyable to be memcpy'd in and out of the file.");
+static_assert(sizeof(SnapshotHeader) <= header_size, "SnapshotHeader must fit into the reserved header space.");
+static_assert(std::is_trivially_copyable_v<confusion::Pair> && sizeof(confusion::Pair) == 12, "Pair must be 12 trivially copyable bytes to be memcpy'd in and out of the file.");
+
+/**
+ * @brief Private helper function to get the size of a snapshot file.
+ *
+ * @param entry_count Number of entries in the snapshot.
+ * @param confusion_count Number of confusion pairs in the snapshot.
+ * @param key_size Number of bytes of entry keys in the snapshot.
+ * @param version Version of the snapshot file format (default: current version).
+ *
+ * @return Size in bytes.
+ */
+[[nodiscard]] constexpr std::size_t snapshot_size(const std::size_t entry_count,
+                                                  const std::size_t confusion_count,
+                                                  const std::size_t key_size,
+                                                  const std::uint32_t version = snapshot_version)
+{
+    const std::size_t history_size = version >= 2 ? sizeof(std::uint64_t) + sizeof(std::uint8_t) : 0;
+    const std::size_t confusion_size = version >= 3 ? confusion_count * sizeof(confusion::Pair) : 0;
+    const std::size_t keys_size = version >= 5 ? entry_count * sizeof(std::uint32_t) + key_size : 0;
+    return header_size + entry_count * (sizeof(std::uint64_t) + 2 * sizeof(std::uint32_t) + history_size) + confusion_size + keys_size;
+}
+
+/**
+ * @brief Private helper function to lay out the keys of the entries as they are stored in a snapshot.
+ *
+ * @param entry_keys Key of each entry, indexed by entry ID.
+ *
+ * @return Length of each key (4 bytes each), followed by the bytes of every key.
+ */
+[[nodiscard]] std::vector<std::uint8_t> make_key_table(const std::vector<std::string> &entry_keys)
+{
+    std::size_t key_size = 0;
+    for (const std::string &key : entry_keys) {
+        key_size += key.size();
+    }
+    std::vector<std::uint8_t> table(entry_keys.size() * sizeof(std::uint32_t) + key_size);
+    std::uint8_t *bytes = table.data() + entry_keys.size() * sizeof(std::uint32_t);
+    for (std::size_t idx = 0; idx < entry_keys.size(); ++idx) {
+        const auto length = static_cast<std::uint32_t>(entry_keys[idx].size());
+        std::memcpy(table.data() + idx * sizeof(std::uint32_t), &length, sizeof(length));
+        if (length > 0) {
+            std::memcpy(bytes, entry_keys[idx].data(), length);
+            bytes += length;
+        }
+    }
+    return table;
+}
+
+}  // namespace
+
+Progress::Progress(const std::filesystem::path &directory,
+                   const std::vector<std::size_t> &entry_categories,
+                   const std::vector<std::string> &entry_keys,
+                   const std::size_t compaction_threshold)
+    : lock_(),
+      snapshot_path_(directory / "snapshot.bin"),
+      compaction_threshold_(compaction_threshold),
+      key_table_(make_key_table(entry_keys)),
+      current_ids_(),
+      statistics_(entry_categories),
+      history_(entry_categories.size()),
+      confusion_(entry_categories.size()),
+      category_mask_(std::numeric_limits<std::uint32_t>::max()),
+      settings_(),
+      replayed_count_(0),
+      tail_count_(0),
+      dirty_(false)
+{
+    if (entry_keys.size() != entry_categories.size()) {
+        throw std::runtime_error(fmt::format("Progress has {} keys for {} entries", entry_keys.size(), entry_categories.size()));
+    }
+
+    // Two writers would truncate each other's journal and overwrite each other's snapshots, so only the first instance writes
+    this->lock_ = core::file::FileLock::try_lock(directory / "progress.lock");
+    if (!this->lock_.has_value()) {
+        fmt::print(stderr, "Warning: Progress in '{}' is in use by another instance, so it is opened read-only and new answers are not saved\n", directory.string());
+    }
+
+    bool is_current = false;
+    std::uint32_t generation = 0;
+    try {
+        generation = this->load_snapshot(entry_keys, is_current);
+    }
+    catch (const std::runtime_error &e) {
+        // Keep the corrupt snapshot aside for inspection, and start from the journal alone; the arrays are only read once the whole file was checked
+        const std::filesystem::path corrupt_path = this->snapshot_path_.string() + ".corrupt";
+        std::error_code ec;
+        if (this->lock_.has_value()) {
+            std::filesystem::rename(this->snapshot_path_, corrupt_path, ec);
+        }
+        fmt::print(stderr, "Warning: Ignored snapshot: {}; {}\n", e.what(), !this->lock_.has_value() ? std::string("it is owned by another instance") : ec ? fmt::format("it could not be moved aside: {}", ec.message()) : fmt::format("it was moved to '{}'", corrupt_path.string()));
+        this->category_mask_ = std::numeric_limits<std::uint32_t>::max();
+        this->settings_.reset();
+        this->current_ids_.clear();
+        is_current = false;
+    }
+
+    // Replay the answers recorded since the snapshot, whose IDs are those of the snapshot; an older journal was already folded into it
+    std::vector<journal::Record> read_records;
+    if (this->lock_.has_value()) {
+        this->journal_.emplace(directory / "journal.bin", generation);
+    }
+    else {
+        read_records = journal::Journal::read(directory / "journal.bin", generation);
+    }
+    const std::vector<journal::Record> &records = this->journal_.has_value() ? this->journal_->get_recovered_records() : read_records;
+    for (journal::Record record : records) {
+        record.entry_id = static_cast<std::uint32_t>(this->get_current_id(record.entry_id));
+        record.chosen_id = static_cast<std::uint32_t>(this->get_current_id(record.chosen_id));
+        this->apply(record);
+    }
+    this->replayed_count_ = records.size();
+    this->tail_count_ = this->replayed_count_;
+    this->current_ids_.clear();
+
+    // Store the current IDs before any answer is journaled with them, and keep the next startup short if the previous session never compacted (e.g., power loss)
+    if (!is_current || this->tail_count_ >= this->compaction_threshold_) {
+        this->compact();
+    }
+}
+
+Progress::~Progress()
+{
+    if (this->dirty_ || this->tail_count_ > 0) {
+        this->compact();
+    }
+}
+
+void Progress::record(const journal::Record &record)
+{
+    if (this->journal_.has_value()) {
+        this->journal_->append(record);
+    }
+    this->apply(record);
+    if (++this->tail_count_ >= this->compaction_threshold_) {
+        this->compact();
+    }
+}
+
+void Progress::compact()
+{
+    if (!this->journal_.has_value()) {
+        return;
+    }
+
+    // Build the whole file image now; the background writer only has to stamp the generation and write it
+    const std::vector<statistics::Counters> entries = this->statistics_.get_entries();
+    const statistics::Counters total = this->statistics_.get_total();
+    const std::vector<confusion::Pair> pairs = this->confusion_.get_pairs();
+    const std::size_t entry_count = entries.size();
+    const std::size_t key_size = this->key_table_.size() - entry_count * sizeof(std::uint32_t);
+    std::vector<std::uint8_t> image(snapshot_size(entry_count, pairs.size(), key_size), 0);
+
+    SnapshotHeader header{};
+    header.magic = snapshot_magic;
+    header.version = snapshot_version;
+    header.byte_order = byte_order_marker;
+    header.generation = 0;  // Stamped by the writer
+    header.entry_count = static_cast<std::uint32_t>(entry_count);
+    header.total_answers = total.get_attempts();
+    header.total_correct = total.correct;
+    header.category_mask = this->category_mask_;
+    const auto rng_state = core::rng::RNG::get_state();
+    header.rng_word_count = static_cast<std::uint32_t>(rng_state.size() <= max_rng_words ? rng_state.size() : 0);
+    std::copy(rng_state.cbegin(), rng_state.cbegin() + header.rng_word_count, header.rng_words.begin());
+    header.confusion_count = static_cast<std::uint32_t>(pairs.size());
+    if (this->settings_.has_value()) {
+        header.has_settings = 1;
+        header.selection_policy = this->settings_->selection_policy;
+        header.is_typing = this->settings_->is_typing ? 1 : 0;
+    }
+    header.key_size = key_size;
+    std::memcpy(image.data(), &header, sizeof(header));
+
+    std::vector<std::uint64_t> latency_ms(entry_count);
+    std::vector<std::uint64_t> outcomes(entry_count);
+    std::vector<std::uint32_t> attempts(entry_count);
+    std::vector<std::uint32_t> correct(entry_count);
+    std::vector<std::uint8_t> lengths(entry_count);
+    for (std::size_t idx = 0; idx < entry_count; ++idx) {
+        latency_ms[idx] = entries[idx].latency_ms;
+        outcomes[idx] = this->history_.get_outcomes(idx);
+        attempts[idx] = static_cast<std::uint32_t>(entries[idx].get_attempts());
+        correct[idx] = static_cast<std::uint32_t>(entries[idx].correct);
+        lengths[idx] = static_cast<std::uint8_t>(this->history_.get_length(idx));
+    }
+    // Empty vectors may have no storage at all, and passing their null data to std::memcpy is undefined even for 0 bytes
+    std::uint8_t *arrays = image.data() + header_size;
+    const auto write = [&arrays](const void *data,
+                                 const std::size_t size) {
+        if (size > 0) {
+            std::memcpy(arrays, data, size);
+            arrays += size;
+        }
+    };
+    write(latency_ms.data(), entry_count * sizeof(std::uint64_t));
+    write(outcomes.data(), entry_count * sizeof(std::uint64_t));
+    write(attempts.data(), entry_count * sizeof(std::uint32_t));
+    write(correct.data(), entry_count * sizeof(std::uint32_t));
+    write(lengths.data(), entry_count * sizeof(std::uint8_t));
+    write(pairs.data(), pairs.size() * sizeof(confusion::Pair));
+    write(this->key_table_.data(), this->key_table_.size());
+
+    this->journal_->checkpoint([path = this->snapshot_path_, image = std::move(image)](const std::uint32_t generation) mutable {
+        std::memcpy(image.data() + offsetof(SnapshotHeader, generation), &generation, sizeof(generation));
+        try {
+            core::file::write_atomically(path, image.data(), image.size());
+            return true;
+        }
+        catch (const std::exception &e) {
+            // The writer runs in the background, so report the failure instead of throwing; the journal keeps the records
+            fmt::print(stderr, "Warning: Failed to write snapshot: {}\n", e.what());
+            return false;
+        }
+    });
+    this->tail_count_ = 0;
+    this->dirty_ = false;
+}
+
+void Progress::add_entries(const std::vector<std::size_t> &entry_categories,
+                           const std::vector<std::string> &entry_keys)
+{
+    if (entry_keys.size() != entry_categories.size()) {
+        throw std::runtime_error(fmt::format("Progress has {} keys for {} entries", entry_keys.size(), entry_categories.size()));
+    }
+    const std::size_t old_count = this->statistics_.get_num_entries();
+    if (entry_categories.size() <= old_count) {
+        return;
+    }
+
+    // The counters are sized on construction, so copy them into larger ones; answers to entries that no longer exist stay in the total
+    const std::vector<statistics::Counters> entries = this->statistics_.get_entries();
+    statistics::Counters remainder = this->statistics_.get_total();
+    statistics::Statistics statistics(entry_categories);
+    history::History history(entry_categories.size());
+    for (std::size_t id = 0; id < old_count; ++id) {
+        remainder.correct -= entries[id].correct;
+        remainder.incorrect -= entries[id].incorrect;
+        remainder.latency_ms -= entries[id].latency_ms;
+        statistics.add(id, entries[id]);
+        if (const std::size_t length = this->history_.get_length(id); length > 0) {
+            history.set(id, this->history_.get_outcomes(id), length);
+        }
+    }
+    statistics.add(entry_categories.size(), remainder);
+    confusion::Confusion confusion(entry_categories.size());
+    for (const confusion::Pair &pair : this->confusion_.get_pairs()) {
+        confusion.add(pair);
+    }
+
+    this->statistics_ = std::move(statistics);
+    this->history_ = std::move(history);
+    this->confusion_ = std::move(confusion);
+    this->key_table_ = make_key_table(entry_keys);
+
+    // Store the new IDs before any answer is journaled with them, as the constructor does
+    this->compact();
+}
+
+const statistics::Statistics &Progress::get_statistics() const
+{
+    return this->statistics_;
+}
+
+const history::History &Progress::get_history() const
+{
+    return this->history_;
+}
+
+const confusion::Confusion &Progress::get_confusion() const
+{
+    return this->confusion_;
+}
+
+std::uint32_t Progress::get_category_mask() const
+{
+    return this->category_mask_;
+}
+
+void Progress::set_category_mask(const std::uint32_t mask)
+{
+    if (mask != this->category_mask_) {
+        this->category_mask_ = mask;
+        this->dirty_ = true;
+    }
+}
+
+std::optional<Settings> Progress::get_settings() const
+{
+    return this->settings_;
+}
+
+void Progress::set_settings(const Settings &settings)
+{
+    if (!this->settings_.has_value() || settings.selection_policy != this->settings_->selection_policy || settings.is_typing != this->settings_->is_typing) {
+        this->settings_ = settings;
+        this->dirty_ = true;
+    }
+}
+
+std::size_t Progress::get_replayed_count() const
+{
+    return this->replayed_count_;
+}
+
+bool Progress::is_read_only() const
+{
+    return !this->journal_.has_value();
+}
+
+std::uint32_t Progress::load_snapshot(const std::vector<std::string> &entry_keys,
+                                      bool &is_current)
+{
+    is_current = false;
+    if (!std::filesystem::exists(this->snapshot_path_)) {
+        return 0;
+    }
+
+    const core::file::MappedFile mapping(this->snapshot_path_);
+    const std::uint8_t *data = mapping.get_data();
+    const std::size_t size = mapping.get_size();
+
+    SnapshotHeader header;
+    if (size < header_size) {
+        throw std::runtime_error(fmt::format("Snapshot '{}' is truncated ({} bytes)", this->snapshot_path_.string(), size));
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != snapshot_magic || header.version < 1 || header.version > snapshot_version) {
+        throw std::runtime_error(fmt::format("Snapshot '{}' has an unsupported format", this->snapshot_path_.string()));
+    }
+    if (header.byte_order != byte_order_marker) {
+        throw std::runtime_error(fmt::format("Snapshot '{}' was written on a machine with a different byte order", this->snapshot_path_.string()));
+    }
+    const std::size_t key_size = header.version >= 5 ? header.key_size : 0;
+    if (key_size > size || size < snapshot_size(header.entry_count, header.confusion_count, key_size, header.version)) {
+        throw std::runtime_error(fmt::format("Snapshot '{}' is truncated ({} bytes for {} entries)", this->snapshot_path_.string(), size, header.entry_count));
+    }
+
+    this->category_mask_ = header.category_mask;
+    if (header.has_settings != 0) {
+        this->settings_ = Settings{header.selection_policy, header.is_typing != 0};
+    }
+    if (header.rng_word_count > 0 && header.rng_word_count <= max_rng_words) {
+        static_cast<void>(core::rng::RNG::set_state({header.rng_words.cbegin(), header.rng_words.cbegin() + header.rng_word_count}));
+    }
+
+    const std::size_t stored_count = header.entry_count;
+    const bool has_history = header.version >= 2;
+    const std::uint8_t *latency_ms = data + header_size;
+    const std::uint8_t *outcomes = latency_ms + stored_count * sizeof(std::uint64_t);
+    const std::uint8_t *attempts = outcomes + (has_history ? stored_count * sizeof(std::uint64_t) : 0);
+    const std::uint8_t *correct = attempts + stored_count * sizeof(std::uint32_t);
+    const std::uint8_t *lengths = correct + stored_count * sizeof(std::uint32_t);
+    const std::uint8_t *pairs = lengths + (has_history ? stored_count * sizeof(std::uint8_t) : 0);
+
+    // Match the stored entries to the current ones by key; snapshots before version 5 have no keys, so their IDs are taken as they are
+    if (header.version >= 5) {
+        const std::uint8_t *key_table = pairs + std::size_t{header.confusion_count} * sizeof(confusion::Pair);
+        const std::size_t table_size = stored_count * sizeof(std::uint32_t) + key_size;
+        is_current = table_size == this->key_table_.size() && (table_size == 0 || std::memcmp(key_table, this->key_table_.data(), table_size) == 0);
+        if (!is_current) {
+            std::unordered_map<std::string_view, std::size_t> current_ids;
+            current_ids.reserve(entry_keys.size());
+            for (std::size_t idx = 0; idx < entry_keys.size(); ++idx) {
+                current_ids.emplace(entry_keys[idx], idx);
+            }
+            const char *keys = reinterpret_cast<const char *>(key_table + stored_count * sizeof(std::uint32_t));
+            std::size_t offset = 0;
+            this->current_ids_.assign(stored_count, entry_keys.size());
+            for (std::size_t idx = 0; idx < stored_count; ++idx) {
+                std::uint32_t length;
+                std::memcpy(&length, key_table + idx * sizeof(std::uint32_t), sizeof(length));
+                if (length > key_size - offset) {
+                    throw std::runtime_error(fmt::format("Snapshot '{}' has a corrupted key table", this->snapshot_path_.string()));
+                }
+                if (const auto it = current_ids.find({keys + offset, length}); it != current_ids.cend()) {
+                    this->current_ids_[idx] = it->second;
+                }
+                offset += length;
+            }
+        }
+    }
+
+    // Read the arrays straight out of the mapping; entries that no longer exist only count towards the total
+    statistics::Counters remainder{header.total_correct, header.total_answers - header.total_correct, 0};
+    for (std::size_t idx = 0; idx < stored_count; ++idx) {
+        std::uint64_t entry_latency_ms;
+        std::uint32_t entry_attempts;
+        std::uint32_t entry_correct;
+        std::memcpy(&entry_latency_ms, latency_ms + idx * sizeof(std::uint64_t), sizeof(entry_latency_ms));
+        std::memcpy(&entry_attempts, attempts + idx * sizeof(std::uint32_t), sizeof(entry_attempts));
+        std::memcpy(&entry_correct, correct + idx * sizeof(std::uint32_t), sizeof(entry_correct));
+        if (entry_attempts == 0) {
+            continue;
+        }
+        const std::size_t id = this->get_current_id(idx);
+        if (has_history) {
+            std::uint64_t entry_outcomes;
+            std::memcpy(&entry_outcomes, outcomes + idx * sizeof(std::uint64_t), sizeof(entry_outcomes));
+            this->history_.set(id, entry_outcomes, lengths[idx]);
+        }
+        const statistics::Counters counters{entry_correct, entry_attempts - entry_correct, entry_latency_ms};
+        remainder.correct -= counters.correct;
+        remainder.incorrect -= counters.incorrect;
+        this->statistics_.add(id, counters);
+    }
+    // Answers to entries that no longer exist
+    this->statistics_.add(this->statistics_.get_num_entries(), remainder);
+
+    if (header.version >= 3) {
+        for (std::size_t idx = 0; idx < header.confusion_count; ++idx) {
+            confusion::Pair pair;
+            std::memcpy(&pair, pairs + idx * sizeof(confusion::Pair), sizeof(pair));
+            pair.asked_id = static_cast<std::uint32_t>(this->get_current_id(pair.asked_id));
+            pair.chosen_id = static_cast<std::uint32_t>(this->get_current_id(pair.chosen_id));
+            this->confusion_.add(pair);
+        }
+    }
+
+    return header.generation;
+}
+
+void Progress::apply(const journal::Record &record)
+{
+    this->statistics_.record(record.entry_id, record.correct, record.latency_ms);
+    this->history_.record(record.entry_id, record.correct);
+    if (!record.correct) {
+        this->confusion_.record(record.entry_id, record.chosen_id);
+    }
+    this->dirty_ = true;
+}
+
+std::size_t Progress::get_current_id(const std::size_t stored_id) const
+{
+    if (this->current_ids_.empty()) {
+        return stored_id;
+    }
+    return stored_id < this->current_ids_.size() ? this->current_ids_[stored_id] : this->statistics_.get_num_entries();
+}
+
+}  // namespace modules::progress
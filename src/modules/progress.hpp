@@ -0,0 +1,279 @@
+/**
+ * @file progress.hpp
+ *
+ * @brief Persistent learner progress: snapshot plus journal tail.
+ */
+
+#pragma once
+
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::uint32_t
+#include <filesystem>  // for std::filesystem
+#include <optional>    // for std::optional
+#include <string>      // for std::string
+#include <vector>      // for std::vector
+
+#include "confusion.hpp"
+#include "core/file.hpp"
+#include "history.hpp"
+#include "journal.hpp"
+#include "statistics.hpp"
+
+namespace modules::progress {
+
+/**
+ * @brief Struct that represents the settings of a learner, which are saved with their progress.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Settings final {
+    /**
+     * @brief How the next question is picked, as a value defined by the app (e.g., "2").
+     */
+    std::uint32_t selection_policy;
+
+    /**
+     * @brief Whether the answers are typed rather than chosen.
+     */
+    bool is_typing;
+};
+
+/**
+ * @brief Class that stores learner progress in a data directory.
+ *
+ * Progress is kept in two files:
+ * - "snapshot.bin": a compacted image with per-entry statistics and history arrays plus confusion pairs behind a fixed header (generation, totals, scheduler and RNG state, settings), laid out to be memory-mapped and copied without parsing.
+ * - "journal.bin": the answers recorded since that snapshot.
+ *
+ * Entries are stored by ID, and the snapshot also stores the key of each ID (its canonical Korean text).
+ * If the entries changed since the snapshot was written (e.g., a row was inserted in the middle of a deck, or another deck was loaded), the stored progress follows the keys to the new IDs, and a new snapshot is written right away, so the journal always uses the IDs of its snapshot.
+ *
+ * On construction, the snapshot is mapped and only the short journal tail is replayed.
+ * A snapshot that cannot be read (e.g., truncated, or written on a machine with a different byte order) is moved aside to "snapshot.bin.corrupt", and the progress starts from the journal alone.
+ *
+ * Only one instance at a time writes to a directory, which it locks through a "progress.lock" file; other instances open the progress read-only, and their answers only count in memory.
+ * Once the tail grows past a threshold, and again on destruction, the state is compacted into a new snapshot by the journal's background writer.
+ *
+ * @note This class is marked as `final` to prevent inheritance. Recording is meant for a single thread (e.g., the UI); other threads can keep their own Statistics objects.
+ */
+class Progress final {
+  public:
+    /**
+     * @brief Load the progress stored in a data directory.
+     *
+     * @param directory Directory that holds the snapshot and journal files (e.g., "~/.local/share/aegyo").
+     * @param entry_categories Category index of each entry in the vocabulary, indexed by entry ID (e.g., {0, 0, 1, 2}).
+     * @param entry_keys Key of each entry in the vocabulary, which identifies it across decks and edits, indexed by entry ID (e.g., {"ㅏ", "ㅑ", "ㄱ", "ㅐ"}).
+     * @param compaction_threshold Number of journal records after which a new snapshot is written (default: 4096).
+     *
+     * @throws std::runtime_error If the number of keys differs from the number of entries, or the journal cannot be opened.
+     */
+    explicit Progress(const std::filesystem::path &directory,
+                      const std::vector<std::size_t> &entry_categories,
+                      const std::vector<std::string> &entry_keys,
+                      const std::size_t compaction_threshold = 4096);
+
+    /**
+     * @brief Compact any unsaved progress into a snapshot and close the journal.
+     */
+    ~Progress();
+
+    Progress(const Progress &) = delete;
+    Progress &operator=(const Progress &) = delete;
+
+    /**
+     * @brief Record an answer. This never waits for the disk.
+     *
+     * @param record Answer to record.
+     */
+    void record(const journal::Record &record);
+
+    /**
+     * @brief Queue a compaction of the current state into a new snapshot. This never waits for the disk.
+     */
+    void compact();
+
+    /**
+     * @brief Make room for entries added to the vocabulary since construction (e.g., by a deck reload), keeping the progress so far.
+     *
+     * The entries keep their IDs, and the new ones are appended; a new snapshot is queued right away, so the answers journaled with the new IDs are found again on the next startup.
+     *
+     * @param entry_categories Category index of each entry in the vocabulary, indexed by entry ID (e.g., {0, 0, 1, 2, 2}).
+     * @param entry_keys Key of each entry in the vocabulary, indexed by entry ID (e.g., {"ㅏ", "ㅑ", "ㄱ", "ㅐ", "ㄴ"}).
+     *
+     * @throws std::runtime_error If the number of keys differs from the number of entries.
+     *
+     * @note Nothing changes if there are no more entries than before. The statistics, history and confusion objects are replaced, so references to them must be fetched again.
+     */
+    void add_entries(const std::vector<std::size_t> &entry_categories,
+                     const std::vector<std::string> &entry_keys);
+
+    /**
+     * @brief Get the answer statistics, including everything loaded from disk.
+     *
+     * @return Const reference to the Statistics object.
+     */
+    [[nodiscard]] const statistics::Statistics &get_statistics() const;
+
+    /**
+     * @brief Get the rolling history of the most recent answers per entry, including everything loaded from disk.
+     *
+     * @return Const reference to the History object.
+     */
+    [[nodiscard]] const history::History &get_history() const;
+
+    /**
+     * @brief Get the confusion matrix of wrong answers, including everything loaded from disk.
+     *
+     * @return Const reference to the Confusion object.
+     */
+    [[nodiscard]] const confusion::Confusion &get_confusion() const;
+
+    /**
+     * @brief Get the saved scheduler state: a bitmask of enabled categories, where bit N corresponds to the category with value N.
+     *
+     * @return Category bitmask (e.g., "0b1111"); all bits are set if nothing was saved.
+     */
+    [[nodiscard]] std::uint32_t get_category_mask() const;
+
+    /**
+     * @brief Set the scheduler state that is saved with the next snapshot.
+     *
+     * @param mask Category bitmask, where bit N corresponds to the category with value N.
+     */
+    void set_category_mask(const std::uint32_t mask);
+
+    /**
+     * @brief Get the saved settings.
+     *
+     * @return Settings, or std::nullopt if nothing was saved.
+     */
+    [[nodiscard]] std::optional<Settings> get_settings() const;
+
+    /**
+     * @brief Set the settings that are saved with the next snapshot.
+     *
+     * @param settings Settings to save.
+     */
+    void set_settings(const Settings &settings);
+
+    /**
+     * @brief Get the number of journal records replayed on construction.
+     *
+     * @return Number of records (e.g., "12").
+     */
+    [[nodiscard]] std::size_t get_replayed_count() const;
+
+    /**
+     * @brief Check whether the progress was opened read-only, because another instance writes to the directory.
+     *
+     * @return True if new answers are not saved, false otherwise.
+     */
+    [[nodiscard]] bool is_read_only() const;
+
+  private:
+    /**
+     * @brief Load the snapshot file, if any.
+     *
+     * @param entry_keys Key of each entry in the vocabulary, indexed by entry ID.
+     * @param is_current Set to true if the snapshot exists and was written with the same keys, false otherwise.
+     *
+     * @return Generation of the loaded snapshot, or 0 if there is none.
+     *
+     * @throws std::runtime_error If the snapshot is corrupted, in which case only the settings may have been loaded.
+     */
+    [[nodiscard]] std::uint32_t load_snapshot(const std::vector<std::string> &entry_keys,
+                                              bool &is_current);
+
+    /**
+     * @brief Fold an answer into the in-memory state.
+     *
+     * @param record Answer to fold.
+     */
+    void apply(const journal::Record &record);
+
+    /**
+     * @brief Get the current ID of an entry from the ID it was stored with.
+     *
+     * @param stored_id ID in the snapshot and its journal (e.g., "3").
+     *
+     * @return Current ID, or the number of entries if the entry no longer exists (e.g., "4").
+     */
+    [[nodiscard]] std::size_t get_current_id(const std::size_t stored_id) const;
+
+    /**
+     * @brief Lock on the directory, or std::nullopt if another instance holds it and the progress is read-only.
+     *
+     * @note This is declared first, so it is released last, once the journal has written everything.
+     */
+    std::optional<core::file::FileLock> lock_;
+
+    /**
+     * @brief Path to the snapshot file.
+     */
+    std::filesystem::path snapshot_path_;
+
+    /**
+     * @brief Number of journal records after which a new snapshot is written.
+     */
+    std::size_t compaction_threshold_;
+
+    /**
+     * @brief Keys of the entries as stored in a snapshot: the length of each key, then their bytes.
+     */
+    std::vector<std::uint8_t> key_table_;
+
+    /**
+     * @brief Current ID of each ID in the loaded snapshot, or empty if the IDs are unchanged.
+     */
+    std::vector<std::size_t> current_ids_;
+
+    /**
+     * @brief Answer statistics, indexed by entry ID.
+     */
+    statistics::Statistics statistics_;
+
+    /**
+     * @brief Rolling history of the most recent answers per entry, indexed by entry ID.
+     */
+    history::History history_;
+
+    /**
+     * @brief Confusion matrix of wrong answers.
+     */
+    confusion::Confusion confusion_;
+
+    /**
+     * @brief Bitmask of enabled categories.
+     */
+    std::uint32_t category_mask_;
+
+    /**
+     * @brief Saved settings, or std::nullopt if there are none.
+     */
+    std::optional<Settings> settings_;
+
+    /**
+     * @brief Number of journal records replayed on construction.
+     */
+    std::size_t replayed_count_;
+
+    /**
+     * @brief Number of journal records since the last compaction.
+     */
+    std::size_t tail_count_;
+
+    /**
+     * @brief Whether anything changed since the last compaction.
+     */
+    bool dirty_;
+
+    /**
+     * @brief Journal of answers since the last snapshot, opened once the snapshot's generation is known, or std::nullopt if the progress is read-only.
+     *
+     * @note This is declared last, so it is destroyed (and its queued snapshots are written) first.
+     */
+    std::optional<journal::Journal> journal_;
+};
+
+}  // namespace modules::progress
@@ -0,0 +1,143 @@
+/**
+ * @file statistics.cpp
+ */
+
+#include <algorithm>    // for std::max, std::min, std::max_element
+#include <atomic>       // for std::atomic, std::memory_order_relaxed
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t, std::uint64_t
+#include <memory>       // for std::make_unique
+#include <thread>       // for std::thread
+#include <type_traits>  // for std::remove_reference_t
+#include <utility>      // for std::move
+#include <vector>       // for std::vector
+
+#include "statistics.hpp"
+
+namespace modules::statistics {
+
+namespace {
+
+/**
+ * @brief Private helper function to get the shard index of the calling thread.
+ *
+ * Threads are numbered in the order they first record an answer, so a handful of writers end up in distinct shards.
+ *
+ * @return Thread index (e.g., "2").
+ */
+[[nodiscard]] std::size_t get_thread_index()
+{
+    static std::atomic<std::size_t> next_index{0};
+    thread_local const std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+}  // namespace
+
+Statistics::Statistics(const std::vector<std::size_t> &entry_categories,
+                       const std::size_t num_shards)
+    : entry_categories_(entry_categories),
+      num_categories_(entry_categories.empty() ? 0 : *std::max_element(entry_categories.cbegin(), entry_categories.cend()) + 1),
+      shards_()
+{
+    const std::size_t shard_count = num_shards > 0 ? num_shards : std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), 8);
+    this->shards_.reserve(shard_count);
+    for (std::size_t idx = 0; idx < shard_count; ++idx) {
+        auto shard = std::make_unique<Shard>();
+        shard->entries = std::make_unique<EntryCell[]>(this->entry_categories_.size());
+        shard->categories = std::make_unique<TotalCell[]>(this->num_categories_);
+        this->shards_.emplace_back(std::move(shard));
+    }
+}
+
+void Statistics::record(const std::size_t entry_id,
+                        const bool correct,
+                        const std::uint64_t latency_ms)
+{
+    this->add(entry_id, {correct ? 1u : 0u, correct ? 0u : 1u, latency_ms});
+}
+
+void Statistics::add(const std::size_t entry_id,
+                     const Counters &counters)
+{
+    Shard &shard = this->get_local_shard();
+    const auto add_to = [&counters](auto &cell) {
+        using CorrectType = typename std::remove_reference_t<decltype(cell.correct)>::value_type;
+        cell.correct.fetch_add(static_cast<CorrectType>(counters.correct), std::memory_order_relaxed);
+        cell.incorrect.fetch_add(static_cast<CorrectType>(counters.incorrect), std::memory_order_relaxed);
+        cell.latency_ms.fetch_add(counters.latency_ms, std::memory_order_relaxed);
+    };
+    if (entry_id < this->entry_categories_.size()) {
+        add_to(shard.entries[entry_id]);
+        add_to(shard.categories[this->entry_categories_[entry_id]]);
+    }
+    add_to(shard.total);
+}
+
+Counters Statistics::get_entry(const std::size_t entry_id) const
+{
+    Counters counters{0, 0, 0};
+    if (entry_id >= this->entry_categories_.size()) {
+        return counters;
+    }
+    for (const auto &shard : this->shards_) {
+        const EntryCell &cell = shard->entries[entry_id];
+        counters.correct += cell.correct.load(std::memory_order_relaxed);
+        counters.incorrect += cell.incorrect.load(std::memory_order_relaxed);
+        counters.latency_ms += cell.latency_ms.load(std::memory_order_relaxed);
+    }
+    return counters;
+}
+
+Counters Statistics::get_category(const std::size_t category) const
+{
+    Counters counters{0, 0, 0};
+    if (category >= this->num_categories_) {
+        return counters;
+    }
+    for (const auto &shard : this->shards_) {
+        const TotalCell &cell = shard->categories[category];
+        counters.correct += cell.correct.load(std::memory_order_relaxed);
+        counters.incorrect += cell.incorrect.load(std::memory_order_relaxed);
+        counters.latency_ms += cell.latency_ms.load(std::memory_order_relaxed);
+    }
+    return counters;
+}
+
+Counters Statistics::get_total() const
+{
+    Counters counters{0, 0, 0};
+    for (const auto &shard : this->shards_) {
+        counters.correct += shard->total.correct.load(std::memory_order_relaxed);
+        counters.incorrect += shard->total.incorrect.load(std::memory_order_relaxed);
+        counters.latency_ms += shard->total.latency_ms.load(std::memory_order_relaxed);
+    }
+    return counters;
+}
+
+std::vector<Counters> Statistics::get_entries() const
+{
+    std::vector<Counters> entries(this->entry_categories_.size(), Counters{0, 0, 0});
+    // Walk each shard sequentially, so the merge streams through memory
+    for (const auto &shard : this->shards_) {
+        for (std::size_t idx = 0; idx < entries.size(); ++idx) {
+            const EntryCell &cell = shard->entries[idx];
+            entries[idx].correct += cell.correct.load(std::memory_order_relaxed);
+            entries[idx].incorrect += cell.incorrect.load(std::memory_order_relaxed);
+            entries[idx].latency_ms += cell.latency_ms.load(std::memory_order_relaxed);
+        }
+    }
+    return entries;
+}
+
+std::size_t Statistics::get_num_entries() const
+{
+    return this->entry_categories_.size();
+}
+
+Statistics::Shard &Statistics::get_local_shard()
+{
+    return *this->shards_[get_thread_index() % this->shards_.size()];
+}
+
+}  // namespace modules::statistics
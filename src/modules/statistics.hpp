@@ -0,0 +1,189 @@
+/**
+ * @file statistics.hpp
+ *
+ * @brief Concurrent per-entry and per-category answer statistics.
+ */
+
+#pragma once
+
+#include <atomic>   // for std::atomic
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t, std::uint64_t
+#include <memory>   // for std::unique_ptr
+#include <vector>   // for std::vector
+
+namespace modules::statistics {
+
+/**
+ * @brief Struct that represents aggregated answer counters.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Counters final {
+    /**
+     * @brief Number of correct answers (e.g., "9").
+     */
+    std::uint64_t correct;
+
+    /**
+     * @brief Number of incorrect answers (e.g., "3").
+     */
+    std::uint64_t incorrect;
+
+    /**
+     * @brief Total answer latency in milliseconds (e.g., "10200").
+     */
+    std::uint64_t latency_ms;
+
+    /**
+     * @brief Get the total number of answers.
+     *
+     * @return Number of answers (e.g., "12").
+     */
+    [[nodiscard]] std::uint64_t get_attempts() const
+    {
+        return this->correct + this->incorrect;
+    }
+
+    /**
+     * @brief Get the percentage of correct answers.
+     *
+     * @return Percentage between 0.0 and 100.0 (e.g., "75.0"), or 0.0 if there are no answers.
+     */
+    [[nodiscard]] double get_percentage() const
+    {
+        const std::uint64_t attempts = this->get_attempts();
+        return attempts > 0 ? static_cast<double>(this->correct) / static_cast<double>(attempts) * 100.0 : 0.0;
+    }
+};
+
+/**
+ * @brief Class that counts answers per entry, per category and in total, from any number of threads.
+ *
+ * Counters are split into shards, and each thread records into its own shard with relaxed atomic additions, so concurrent writers (e.g., the UI, simulation threads and a server) never contend on a lock or a cache line.
+ * Reads merge the shards on demand.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Statistics final {
+  public:
+    /**
+     * @brief Construct a new Statistics object with all counters set to zero.
+     *
+     * @param entry_categories Category index of each entry, indexed by entry ID (e.g., {0, 0, 1, 2}).
+     * @param num_shards Number of shards; 0 picks one per hardware thread, up to 8 (default: 0).
+     */
+    explicit Statistics(const std::vector<std::size_t> &entry_categories,
+                        const std::size_t num_shards = 0);
+
+    /**
+     * @brief Record a single answer. This is lock-free and safe to call from any thread.
+     *
+     * @param entry_id ID of the entry that was asked (e.g., "3"); IDs out of range only count towards the total.
+     * @param correct Whether the answer was correct.
+     * @param latency_ms Answer latency in milliseconds (e.g., "850").
+     */
+    void record(const std::size_t entry_id,
+                const bool correct,
+                const std::uint64_t latency_ms);
+
+    /**
+     * @brief Add previously aggregated counters (e.g., loaded from a snapshot). This is lock-free and safe to call from any thread.
+     *
+     * @param entry_id ID of the entry (e.g., "3"); IDs out of range only count towards the total.
+     * @param counters Counters to add.
+     */
+    void add(const std::size_t entry_id,
+             const Counters &counters);
+
+    /**
+     * @brief Get the merged counters of an entry.
+     *
+     * @param entry_id ID of the entry (e.g., "3").
+     *
+     * @return Counters of the entry, or zeros if the ID is out of range.
+     */
+    [[nodiscard]] Counters get_entry(const std::size_t entry_id) const;
+
+    /**
+     * @brief Get the merged counters of a category.
+     *
+     * @param category Category index (e.g., "1").
+     *
+     * @return Counters of the category, or zeros if the index is out of range.
+     */
+    [[nodiscard]] Counters get_category(const std::size_t category) const;
+
+    /**
+     * @brief Get the merged counters of all answers.
+     *
+     * @return Total counters.
+     */
+    [[nodiscard]] Counters get_total() const;
+
+    /**
+     * @brief Get the merged counters of every entry in a single pass over the shards (e.g., for exports).
+     *
+     * @return Vector of counters, indexed by entry ID.
+     */
+    [[nodiscard]] std::vector<Counters> get_entries() const;
+
+    /**
+     * @brief Get the number of entries.
+     *
+     * @return Number of entries (e.g., "40").
+     */
+    [[nodiscard]] std::size_t get_num_entries() const;
+
+  private:
+    /**
+     * @brief Counters of one entry in one shard.
+     */
+    struct alignas(16) EntryCell final {
+        std::atomic<std::uint32_t> correct{0};
+        std::atomic<std::uint32_t> incorrect{0};
+        std::atomic<std::uint64_t> latency_ms{0};
+    };
+
+    /**
+     * @brief Counters of one category (or the total) in one shard, padded to a cache line, as every answer updates them.
+     */
+    struct alignas(64) TotalCell final {
+        std::atomic<std::uint64_t> correct{0};
+        std::atomic<std::uint64_t> incorrect{0};
+        std::atomic<std::uint64_t> latency_ms{0};
+    };
+
+    /**
+     * @brief Counters written by one group of threads.
+     */
+    struct Shard final {
+        std::unique_ptr<EntryCell[]> entries;
+        std::unique_ptr<TotalCell[]> categories;
+        TotalCell total;
+    };
+
+    /**
+     * @brief Get the shard that the calling thread records into.
+     *
+     * @return Reference to the shard.
+     */
+    [[nodiscard]] Shard &get_local_shard();
+
+    /**
+     * @brief Category index of each entry, indexed by entry ID.
+     */
+    std::vector<std::size_t> entry_categories_;
+
+    /**
+     * @brief Number of categories.
+     */
+    std::size_t num_categories_;
+
+    /**
+     * @brief Shards of counters.
+     */
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace modules::statistics
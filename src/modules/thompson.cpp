@@ -0,0 +1,173 @@
+/**
+ * @file thompson.cpp
+ */
+
+#include <algorithm>   // for std::max, std::max_element, std::min, std::find
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::uint32_t
+#include <functional>  // for std::function
+#include <limits>      // for std::numeric_limits
+#include <optional>    // for std::optional, std::nullopt
+#include <utility>     // for std::move
+#include <vector>      // for std::vector
+
+#include "core/rng.hpp"
+#include "statistics.hpp"
+#include "thompson.hpp"
+
+namespace modules::thompson {
+
+namespace {
+
+/**
+ * @brief Private marker for a missing parent.
+ */
+constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+}  // namespace
+
+Thompson::Thompson(const std::vector<std::size_t> &entry_categories,
+                   const std::size_t fanout)
+    : nodes_(),
+      children_(),
+      category_nodes_(),
+      entry_parents_(entry_categories.size(), none),
+      incorrect_(entry_categories.size(), 0.0),
+      correct_(entry_categories.size(), 0.0)
+{
+    const std::size_t group_size = std::max<std::size_t>(fanout, 2);
+    const std::size_t num_categories = entry_categories.empty() ? 0 : *std::max_element(entry_categories.cbegin(), entry_categories.cend()) + 1;
+
+    // Append a node that owns a range of children, and point the children back at it
+    const auto add_node = [this](const std::vector<std::uint32_t> &items,
+                                 const std::size_t begin,
+                                 const std::size_t end,
+                                 const bool has_entries) {
+        const auto index = static_cast<std::uint32_t>(this->nodes_.size());
+        Node node{static_cast<std::uint32_t>(this->children_.size()), static_cast<std::uint32_t>(end - begin), none, 0, has_entries, true, 0.0, 0.0};
+        for (std::size_t idx = begin; idx < end; ++idx) {
+            this->children_.emplace_back(items[idx]);
+            if (has_entries) {
+                this->entry_parents_[items[idx]] = index;
+                ++node.num_entries;
+            }
+            else {
+                this->nodes_[items[idx]].parent = index;
+                node.num_entries += this->nodes_[items[idx]].num_entries;
+            }
+        }
+        this->nodes_.emplace_back(node);
+        return index;
+    };
+
+    // Build each category bottom-up, grouping "group_size" items at a time until they fit under one node
+    std::vector<std::vector<std::uint32_t>> category_entries(num_categories);
+    for (std::size_t idx = 0; idx < entry_categories.size(); ++idx) {
+        category_entries[entry_categories[idx]].emplace_back(static_cast<std::uint32_t>(idx));
+    }
+    for (const auto &entries : category_entries) {
+        std::vector<std::uint32_t> items = entries;
+        bool has_entries = true;
+        while (items.size() > group_size) {
+            std::vector<std::uint32_t> groups;
+            for (std::size_t begin = 0; begin < items.size(); begin += group_size) {
+                groups.emplace_back(add_node(items, begin, std::min(begin + group_size, items.size()), has_entries));
+            }
+            items = std::move(groups);
+            has_entries = false;
+        }
+        this->category_nodes_.emplace_back(add_node(items, 0, items.size(), has_entries));
+    }
+
+    // The root comes last, as its children must exist first
+    static_cast<void>(add_node(this->category_nodes_, 0, this->category_nodes_.size(), false));
+}
+
+void Thompson::record(const std::size_t entry_id,
+                      const bool correct)
+{
+    this->add(entry_id, {correct ? 1u : 0u, correct ? 0u : 1u, 0});
+}
+
+void Thompson::add(const std::size_t entry_id,
+                   const statistics::Counters &counters)
+{
+    if (entry_id >= this->entry_parents_.size()) {
+        return;
+    }
+    const auto incorrect = static_cast<double>(counters.incorrect);
+    const auto correct = static_cast<double>(counters.correct);
+    this->incorrect_[entry_id] += incorrect;
+    this->correct_[entry_id] += correct;
+    for (std::uint32_t node = this->entry_parents_[entry_id]; node != none; node = this->nodes_[node].parent) {
+        this->nodes_[node].incorrect += incorrect;
+        this->nodes_[node].correct += correct;
+    }
+}
+
+void Thompson::set_category_enabled(const std::size_t category,
+                                    const bool enabled)
+{
+    if (category < this->category_nodes_.size()) {
+        this->nodes_[this->category_nodes_[category]].enabled = enabled;
+    }
+}
+
+std::optional<std::size_t> Thompson::pick(const std::function<bool(std::size_t)> &is_allowed,
+                                          const std::function<bool(std::size_t)> &is_eligible) const
+{
+    // Groups in which no entry turned out to be allowed; the walk goes back up and samples among their siblings instead
+    std::vector<std::uint32_t> excluded;
+    auto node_index = static_cast<std::uint32_t>(this->nodes_.size() - 1);
+    while (true) {
+        const Node &node = this->nodes_[node_index];
+        double best_sample = -1.0;
+        std::uint32_t best_child = none;
+        for (std::uint32_t idx = node.first_child; idx < node.first_child + node.num_children; ++idx) {
+            const std::uint32_t child = this->children_[idx];
+            double alpha;
+            double beta;
+            if (node.has_entries) {
+                if ((is_eligible && !is_eligible(child)) || (is_allowed && !is_allowed(child))) {
+                    continue;
+                }
+                alpha = 1.0 + this->incorrect_[child];
+                beta = 1.0 + this->correct_[child];
+            }
+            else {
+                // Score a group like its average entry, so large groups are not overconfident
+                const Node &group = this->nodes_[child];
+                if (!group.enabled || group.num_entries == 0 || std::find(excluded.cbegin(), excluded.cend(), child) != excluded.cend()) {
+                    continue;
+                }
+                const auto size = static_cast<double>(group.num_entries);
+                alpha = 1.0 + group.incorrect / size;
+                beta = 1.0 + group.correct / size;
+            }
+            if (const double sample = core::rng::RNG::get_random_beta(alpha, beta); sample > best_sample) {
+                best_sample = sample;
+                best_child = child;
+            }
+        }
+        if (best_child != none) {
+            if (node.has_entries) {
+                return best_child;
+            }
+            node_index = best_child;
+            continue;
+        }
+        if (node.parent == none) {
+            break;
+        }
+        excluded.emplace_back(node_index);
+        node_index = node.parent;
+    }
+
+    // No eligible entry is allowed, so pick among all eligible ones rather than none
+    if (is_allowed) {
+        return this->pick({}, is_eligible);
+    }
+    return std::nullopt;
+}
+
+}  // namespace modules::thompson
@@ -0,0 +1,155 @@
+/**
+ * @file thompson.hpp
+ *
+ * @brief Thompson-sampling item selector.
+ */
+
+#pragma once
+
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::uint32_t
+#include <functional>  // for std::function
+#include <optional>    // for std::optional
+#include <vector>      // for std::vector
+
+#include "statistics.hpp"
+
+namespace modules::thompson {
+
+/**
+ * @brief Class that picks entries by Thompson sampling, favoring entries that are likely to be answered incorrectly.
+ *
+ * Each entry is a Beta-Bernoulli arm whose reward is a wrong answer: Beta(1 + incorrect, 1 + correct).
+ * Instead of sampling every arm, entries are grouped into a tree: the root has one child per category, and each category is split into groups of at most "fanout" children.
+ * A pick walks down from the root, sampling one Beta variate per child and following the highest, where a group is scored like its average entry.
+ * Both picking and recording an answer therefore take O(fanout * log(n)).
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Thompson final {
+  public:
+    /**
+     * @brief Construct a new Thompson object where no entry has been answered yet and every category is enabled.
+     *
+     * @param entry_categories Category index of each entry, indexed by entry ID (e.g., {0, 0, 1, 2}).
+     * @param fanout Maximum number of children per group, at least 2 (default: 16).
+     */
+    explicit Thompson(const std::vector<std::size_t> &entry_categories,
+                      const std::size_t fanout = 16);
+
+    /**
+     * @brief Record an answer.
+     *
+     * @param entry_id ID of the entry that was asked (e.g., "3"); IDs out of range are ignored.
+     * @param correct Whether the answer was correct.
+     */
+    void record(const std::size_t entry_id,
+                const bool correct);
+
+    /**
+     * @brief Add previously counted answers to an entry (e.g., from the saved statistics).
+     *
+     * @param entry_id ID of the entry (e.g., "3"); IDs out of range are ignored.
+     * @param counters Counters to add.
+     */
+    void add(const std::size_t entry_id,
+             const statistics::Counters &counters);
+
+    /**
+     * @brief Enable or disable a category, so its entries are never picked.
+     *
+     * @param category Category index (e.g., "1"); indices out of range are ignored.
+     * @param enabled Whether to enable or disable the category.
+     */
+    void set_category_enabled(const std::size_t category,
+                              const bool enabled);
+
+    /**
+     * @brief Pick an entry.
+     *
+     * @param is_allowed Function that returns false for entries that should not be picked now (e.g., recently asked ones); if every entry of the chosen group is excluded, the walk backs up and samples among the other groups, and only if no eligible entry is allowed, one is picked anyway (default: allow every entry).
+     * @param is_eligible Function that returns false for entries that must never be picked, not even then (e.g., ones removed from the deck) (default: every entry is eligible).
+     *
+     * @return ID of the picked entry, or std::nullopt if no eligible entries are enabled.
+     */
+    [[nodiscard]] std::optional<std::size_t> pick(const std::function<bool(std::size_t)> &is_allowed = {},
+                                                  const std::function<bool(std::size_t)> &is_eligible = {}) const;
+
+  private:
+    /**
+     * @brief Struct that represents a group of entries or of other groups.
+     */
+    struct Node final {
+        /**
+         * @brief Index of the first child in "children_".
+         */
+        std::uint32_t first_child;
+
+        /**
+         * @brief Number of children.
+         */
+        std::uint32_t num_children;
+
+        /**
+         * @brief Index of the parent node, or "none" for the root.
+         */
+        std::uint32_t parent;
+
+        /**
+         * @brief Number of entries in the subtree.
+         */
+        std::uint32_t num_entries;
+
+        /**
+         * @brief Whether the children are entry IDs rather than node indices.
+         */
+        bool has_entries;
+
+        /**
+         * @brief Whether the subtree can be picked (false for disabled categories).
+         */
+        bool enabled;
+
+        /**
+         * @brief Number of wrong answers in the subtree.
+         */
+        double incorrect;
+
+        /**
+         * @brief Number of correct answers in the subtree.
+         */
+        double correct;
+    };
+
+    /**
+     * @brief Nodes of the tree, where the last node is the root.
+     */
+    std::vector<Node> nodes_;
+
+    /**
+     * @brief Children of all nodes, stored contiguously per node.
+     */
+    std::vector<std::uint32_t> children_;
+
+    /**
+     * @brief Index of the node of each category, indexed by category.
+     */
+    std::vector<std::uint32_t> category_nodes_;
+
+    /**
+     * @brief Index of the parent node of each entry, indexed by entry ID.
+     */
+    std::vector<std::uint32_t> entry_parents_;
+
+    /**
+     * @brief Number of wrong answers per entry, indexed by entry ID.
+     */
+    std::vector<double> incorrect_;
+
+    /**
+     * @brief Number of correct answers per entry, indexed by entry ID.
+     */
+    std::vector<double> correct_;
+};
+
+}  // namespace modules::thompson
@@ -0,0 +1,156 @@
+/**
+ * @file typing.cpp
+ */
+
+#include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint32_t
+#include <optional>       // for std::optional, std::nullopt
+#include <string>         // for std::string
+#include <string_view>    // for std::string_view
+#include <unordered_map>  // for std::unordered_map
+#include <utility>        // for std::move, std::pair
+#include <vector>         // for std::vector
+
+#include "core/perfect_hash.hpp"
+#include "core/trie.hpp"
+#include "typing.hpp"
+#include "vocabulary.hpp"
+
+namespace modules::typing {
+
+namespace {
+
+/**
+ * @brief Private helper function to collect every romanization of a vocabulary as trie keys.
+ *
+ * @param vocabulary Vocabulary to read the entries from.
+ *
+ * @return Pairs of lowercase romanization and entry ID (e.g., {{"g", 12}, {"k", 12}}).
+ */
+[[nodiscard]] std::vector<std::pair<std::string, std::uint32_t>> get_keys(const vocabulary::Vocabulary &vocabulary)
+{
+    std::vector<std::pair<std::string, std::uint32_t>> keys;
+    for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+        const std::string_view latin = vocabulary.get_latin(id);
+        std::size_t begin = 0;
+        while (begin <= latin.size()) {
+            std::size_t end = latin.find('/', begin);
+            end = end == std::string_view::npos ? latin.size() : end;
+            std::string key(latin.substr(begin, end - begin));
+            for (char &c : key) {
+                c = c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+            }
+            keys.emplace_back(std::move(key), static_cast<std::uint32_t>(id));
+            begin = end + 1;
+        }
+    }
+    return keys;
+}
+
+}  // namespace
+
+Matcher::Matcher(const vocabulary::Vocabulary &vocabulary)
+    : trie_(get_keys(vocabulary)),
+      match_index_(),
+      match_offsets_(),
+      match_ids_(),
+      expected_id_(0),
+      text_(),
+      states_(),
+      length_(0)
+{
+    this->states_[0] = core::trie::Trie::root;
+
+    // Group the entry IDs by romanization (e.g., "k" for both "ㄱ" and "ㅋ"), and index the distinct romanizations
+    const std::vector<std::pair<std::string, std::uint32_t>> keys = get_keys(vocabulary);
+    std::unordered_map<std::string_view, std::size_t> positions;
+    std::vector<std::string_view> names;
+    std::vector<std::vector<std::uint32_t>> groups;
+    for (const auto &[key, id] : keys) {
+        const auto [it, inserted] = positions.try_emplace(key, names.size());
+        if (inserted) {
+            names.emplace_back(key);
+            groups.emplace_back();
+        }
+        groups[it->second].emplace_back(id);
+    }
+    this->match_index_ = core::perfect_hash::PerfectHash(names);
+    this->match_offsets_.reserve(groups.size() + 1);
+    this->match_offsets_.emplace_back(0);
+    for (const auto &group : groups) {
+        this->match_ids_.insert(this->match_ids_.end(), group.cbegin(), group.cend());
+        this->match_offsets_.emplace_back(static_cast<std::uint32_t>(this->match_ids_.size()));
+    }
+}
+
+void Matcher::reset(const std::size_t expected_id)
+{
+    this->expected_id_ = expected_id;
+    this->length_ = 0;
+}
+
+bool Matcher::push(const char c)
+{
+    if (this->length_ == max_length) {
+        return false;
+    }
+    const char lower = c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    this->text_[this->length_] = lower;
+    this->states_[this->length_ + 1] = this->trie_.step(this->states_[this->length_], lower);
+    ++this->length_;
+    return true;
+}
+
+void Matcher::pop()
+{
+    if (this->length_ > 0) {
+        --this->length_;
+    }
+}
+
+Feedback Matcher::get_feedback() const
+{
+    const core::trie::Trie::State state = this->states_[this->length_];
+    const auto expected = static_cast<std::uint32_t>(this->expected_id_);
+    if (this->length_ == 0) {
+        return Feedback::Empty;
+    }
+    if (state == core::trie::Trie::dead) {
+        return Feedback::Invalid;
+    }
+    if (this->trie_.contains(state, expected)) {
+        return Feedback::Complete;
+    }
+    return this->trie_.can_reach(state, expected) ? Feedback::OnTrack : Feedback::Wrong;
+}
+
+std::string_view Matcher::get_text() const
+{
+    return {this->text_.data(), this->length_};
+}
+
+bool Matcher::is_correct() const
+{
+    return this->get_feedback() == Feedback::Complete;
+}
+
+std::optional<std::size_t> Matcher::get_match() const
+{
+    if (this->length_ == 0) {
+        return std::nullopt;
+    }
+    const auto position = this->match_index_.find(this->get_text());
+    if (!position.has_value()) {
+        return std::nullopt;
+    }
+    const std::uint32_t begin = this->match_offsets_[*position];
+    const std::uint32_t end = this->match_offsets_[*position + 1];
+    for (std::uint32_t idx = begin; idx < end; ++idx) {
+        if (this->match_ids_[idx] == this->expected_id_) {
+            return this->expected_id_;
+        }
+    }
+    return static_cast<std::size_t>(this->match_ids_[begin]);
+}
+
+}  // namespace modules::typing
@@ -0,0 +1,147 @@
+/**
+ * @file typing.hpp
+ *
+ * @brief Keystroke-by-keystroke matching of typed romanizations.
+ */
+
+#pragma once
+
+#include <array>        // for std::array
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t
+#include <optional>     // for std::optional
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
+
+#include "core/perfect_hash.hpp"
+#include "core/trie.hpp"
+#include "vocabulary.hpp"
+
+namespace modules::typing {
+
+/**
+ * @brief Enum that represents how the text typed so far relates to the expected answer.
+ */
+enum class Feedback {
+    Empty,     // Nothing was typed yet
+    OnTrack,   // The text is a prefix of a romanization of the expected entry
+    Complete,  // The text is a romanization of the expected entry
+    Wrong,     // The text only leads to other entries (e.g., "ya" when "a" is expected)
+    Invalid    // The text is not a prefix of any romanization (e.g., "x")
+};
+
+/**
+ * @brief Class that matches typed text against the romanizations of a vocabulary.
+ *
+ * Every "latin" form is split on '/', so each alternate (e.g., "g" and "k" for "ㄱ", or "-" and "ng" for "ㅇ") is a key of a trie.
+ * The trie state after each typed character is kept on a fixed-size stack, so typing a character or erasing one is O(1) and never allocates.
+ * The submitted text is looked up with one probe of a perfect hash over the same keys.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Matcher final {
+  public:
+    /**
+     * @brief Maximum number of characters of typed text; longer input is ignored, as no romanization comes close.
+     */
+    static constexpr std::size_t max_length = 15;
+
+    /**
+     * @brief Construct a new Matcher object.
+     *
+     * @param vocabulary Vocabulary whose entries are matched, including any removed by "vocabulary::Vocabulary::update()".
+     */
+    explicit Matcher(const vocabulary::Vocabulary &vocabulary);
+
+    /**
+     * @brief Clear the typed text and set the entry whose romanization is expected.
+     *
+     * @param expected_id ID of the expected entry (e.g., "3").
+     */
+    void reset(const std::size_t expected_id);
+
+    /**
+     * @brief Type one character. ASCII letters are matched case-insensitively.
+     *
+     * @param c Typed character (e.g., 'y').
+     *
+     * @return True if the character was added, false if the text is already "max_length" characters long.
+     */
+    bool push(const char c);
+
+    /**
+     * @brief Erase the last typed character, if any.
+     */
+    void pop();
+
+    /**
+     * @brief Get how the typed text relates to the expected answer.
+     *
+     * @return Feedback (e.g., "Feedback::OnTrack").
+     */
+    [[nodiscard]] Feedback get_feedback() const;
+
+    /**
+     * @brief Get the typed text, lowercased.
+     *
+     * @return View of the text (e.g., "ye"), valid until the next call to "reset()", "push()" or "pop()".
+     */
+    [[nodiscard]] std::string_view get_text() const;
+
+    /**
+     * @brief Check whether the typed text is a romanization of the expected entry.
+     *
+     * @return True if the answer is correct, false otherwise.
+     */
+    [[nodiscard]] bool is_correct() const;
+
+    /**
+     * @brief Get the entry whose romanization was typed, preferring the expected entry when several share it (e.g., "k" for "ㄱ" and "ㅋ").
+     *
+     * @return ID of the entry (e.g., "3"), or std::nullopt if the text is not a complete romanization.
+     */
+    [[nodiscard]] std::optional<std::size_t> get_match() const;
+
+  private:
+    /**
+     * @brief Trie over every romanization, mapping to entry IDs.
+     */
+    core::trie::Trie trie_;
+
+    /**
+     * @brief Perfect hash from each distinct romanization to its position in "match_offsets_".
+     */
+    core::perfect_hash::PerfectHash match_index_;
+
+    /**
+     * @brief Range of the entry IDs of each distinct romanization within "match_ids_", one more than the number of romanizations.
+     */
+    std::vector<std::uint32_t> match_offsets_;
+
+    /**
+     * @brief Entry IDs of each distinct romanization, grouped by romanization in entry order.
+     */
+    std::vector<std::uint32_t> match_ids_;
+
+    /**
+     * @brief ID of the expected entry.
+     */
+    std::size_t expected_id_;
+
+    /**
+     * @brief Typed characters.
+     */
+    std::array<char, max_length> text_;
+
+    /**
+     * @brief Trie state after each prefix of the typed text, where the first is the root.
+     */
+    std::array<core::trie::Trie::State, max_length + 1> states_;
+
+    /**
+     * @brief Number of typed characters.
+     */
+    std::size_t length_;
+};
+
+}  // namespace modules::typing
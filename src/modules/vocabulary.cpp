@@ -2,116 +2,379 @@
  * @file vocabulary.cpp
  */
 
-#include <algorithm>  // for std::shuffle
-#include <cstddef>    // for std::size_t
-#include <optional>   // for std::optional, std::nullopt
-#include <stdexcept>  // for std::runtime_error
-#include <vector>     // for std::vector
+#include <algorithm>    // for std::shuffle, std::any_of, std::equal
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t
+#include <optional>     // for std::optional, std::nullopt
+#include <random>       // for std::mt19937, std::bernoulli_distribution, std::uniform_int_distribution
+#include <stdexcept>    // for std::runtime_error
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <utility>      // for std::swap, std::move
+#include <vector>       // for std::vector
 
 #include <fmt/core.h>
 
+#include "core/bitmap.hpp"
+#include "core/normalization.hpp"
+#include "core/perfect_hash.hpp"
+#include "core/query.hpp"
+#include "core/recent.hpp"
 #include "core/rng.hpp"
+#include "core/shuffle_bag.hpp"
+#include "image.hpp"
 #include "vocabulary.hpp"
 
 namespace modules::vocabulary {
 
 Vocabulary::Vocabulary()
     // Transliteration reference: http://letslearnhangul.com/
-    // Note: The number of entries in each category must be greater than 3 (i.e., 4, 5, 6, 7, 8, 9, etc.).
-    // If 3 or fewer entries are present in a category, the generate_enabled_question_options will throw an exception and the program will crash.
-    // The automated tests count the number of entries in each category to ensure this requirement is met.
-    : entries_{
+    // Note: A question never has more options than there are enabled entries, so a small category (e.g., the 5 double consonants) only lowers the number of options when it is enabled alone.
+    // The automated tests count the number of entries in each category to keep every category at 4 or more entries.
+    : Vocabulary(std::vector<Entry>{
           // Basic vowels
-          {"ㅏ", "a", "Looks like an 'a' without the crossbar", Category::BasicVowel},
-          {"ㅑ", "ya", "It's 'ㅏ' with an extra line (adds 'y')", Category::BasicVowel},
-          {"ㅓ", "eo", "Think of 'eo' as 'uh' sound", Category::BasicVowel},
-          {"ㅕ", "yeo", "It's 'ㅓ' with an extra line (adds 'y')", Category::BasicVowel},
-          {"ㅗ", "o", "Line 'o'ver the bar", Category::BasicVowel},
-          {"ㅛ", "yo", "It's 'ㅗ' with an extra line (adds 'y')", Category::BasicVowel},
-          {"ㅜ", "u", "Line 'u'nder the bar", Category::BasicVowel},
-          {"ㅠ", "yu", "It's 'ㅜ' with an extra line (adds 'y')", Category::BasicVowel},
-          {"ㅡ", "eu", "A horizontal line, sounds like 'oo' in 'good'", Category::BasicVowel},
-          {"ㅣ", "i", "Looks like the letter 'i'", Category::BasicVowel},
-          {"ㅐ", "ae", "'ㅏ' plus an extra line", Category::BasicVowel},
-          {"ㅔ", "e", "'ㅓ' plus an extra line", Category::BasicVowel},
+          {"ㅏ", "a", "Looks like an 'a' without the crossbar", Category::BasicVowel, {"vowel"}},
+          {"ㅑ", "ya", "It's 'ㅏ' with an extra line (adds 'y')", Category::BasicVowel, {"vowel", "iotized"}},
+          {"ㅓ", "eo", "Think of 'eo' as 'uh' sound", Category::BasicVowel, {"vowel"}},
+          {"ㅕ", "yeo", "It's 'ㅓ' with an extra line (adds 'y')", Category::BasicVowel, {"vowel", "iotized"}},
+          {"ㅗ", "o", "Line 'o'ver the bar", Category::BasicVowel, {"vowel"}},
+          {"ㅛ", "yo", "It's 'ㅗ' with an extra line (adds 'y')", Category::BasicVowel, {"vowel", "iotized"}},
+          {"ㅜ", "u", "Line 'u'nder the bar", Category::BasicVowel, {"vowel"}},
+          {"ㅠ", "yu", "It's 'ㅜ' with an extra line (adds 'y')", Category::BasicVowel, {"vowel", "iotized"}},
+          {"ㅡ", "eu", "A horizontal line, sounds like 'oo' in 'good'", Category::BasicVowel, {"vowel"}},
+          {"ㅣ", "i", "Looks like the letter 'i'", Category::BasicVowel, {"vowel"}},
+          {"ㅐ", "ae", "'ㅏ' plus an extra line", Category::BasicVowel, {"vowel"}},
+          {"ㅔ", "e", "'ㅓ' plus an extra line", Category::BasicVowel, {"vowel"}},
 
           // Basic consonants
-          {"ㄱ", "g/k", "Looks like a 'gun'", Category::BasicConsonant},
-          {"ㄴ", "n", "Nike swoosh or 'n' rotated", Category::BasicConsonant},
-          {"ㄷ", "d/t", "Door frame shape", Category::BasicConsonant},
-          {"ㄹ", "r/l", "Resembles 'r' and 'l' combined", Category::BasicConsonant},
-          {"ㅁ", "m", "Looks like a mouth", Category::BasicConsonant},
-          {"ㅂ", "b/p", "Bucket shape", Category::BasicConsonant},
-          {"ㅅ", "s", "Looks like a mountain", Category::BasicConsonant},
-          {"ㅇ", "-/ng", "Circle like 'zero' sound", Category::BasicConsonant},
-          {"ㅈ", "j", "Looks like 'ㅅ' with a line", Category::BasicConsonant},
-          {"ㅊ", "ch", "It's 'ㅈ' with an extra line on top", Category::BasicConsonant},
-          {"ㅋ", "k", "Looks like a 'key'", Category::BasicConsonant},
-          {"ㅌ", "t", "Looks like a 't' with a hat", Category::BasicConsonant},
-          {"ㅍ", "p", "Looks like a 'pi' symbol", Category::BasicConsonant},
-          {"ㅎ", "h", "Man with a hat on", Category::BasicConsonant},
+          {"ㄱ", "g/k", "Looks like a 'gun'", Category::BasicConsonant, {"consonant"}},
+          {"ㄴ", "n", "Nike swoosh or 'n' rotated", Category::BasicConsonant, {"consonant"}},
+          {"ㄷ", "d/t", "Door frame shape", Category::BasicConsonant, {"consonant"}},
+          {"ㄹ", "r/l", "Resembles 'r' and 'l' combined", Category::BasicConsonant, {"consonant"}},
+          {"ㅁ", "m", "Looks like a mouth", Category::BasicConsonant, {"consonant"}},
+          {"ㅂ", "b/p", "Bucket shape", Category::BasicConsonant, {"consonant"}},
+          {"ㅅ", "s", "Looks like a mountain", Category::BasicConsonant, {"consonant"}},
+          {"ㅇ", "-/ng", "Circle like 'zero' sound", Category::BasicConsonant, {"consonant"}},
+          {"ㅈ", "j", "Looks like 'ㅅ' with a line", Category::BasicConsonant, {"consonant"}},
+          {"ㅊ", "ch", "It's 'ㅈ' with an extra line on top", Category::BasicConsonant, {"consonant", "aspirated"}},
+          {"ㅋ", "k", "Looks like a 'key'", Category::BasicConsonant, {"consonant", "aspirated"}},
+          {"ㅌ", "t", "Looks like a 't' with a hat", Category::BasicConsonant, {"consonant", "aspirated"}},
+          {"ㅍ", "p", "Looks like a 'pi' symbol", Category::BasicConsonant, {"consonant", "aspirated"}},
+          {"ㅎ", "h", "Man with a hat on", Category::BasicConsonant, {"consonant"}},
 
           // Double consonants
-          {"ㄲ", "kk", "Double 'ㄱ'", Category::DoubleConsonant},
-          {"ㄸ", "tt", "Double 'ㄷ'", Category::DoubleConsonant},
-          {"ㅃ", "pp", "Double 'ㅂ'", Category::DoubleConsonant},
-          {"ㅆ", "ss", "Double 'ㅅ'", Category::DoubleConsonant},
-          {"ㅉ", "jj", "Double 'ㅈ'", Category::DoubleConsonant},
+          {"ㄲ", "kk", "Double 'ㄱ'", Category::DoubleConsonant, {"consonant", "tense"}},
+          {"ㄸ", "tt", "Double 'ㄷ'", Category::DoubleConsonant, {"consonant", "tense"}},
+          {"ㅃ", "pp", "Double 'ㅂ'", Category::DoubleConsonant, {"consonant", "tense"}},
+          {"ㅆ", "ss", "Double 'ㅅ'", Category::DoubleConsonant, {"consonant", "tense"}},
+          {"ㅉ", "jj", "Double 'ㅈ'", Category::DoubleConsonant, {"consonant", "tense"}},
 
           // Compound vowels
-          {"ㅒ", "yae", "Combination of 'ㅑ' and 'ㅣ'", Category::CompoundVowel},
-          {"ㅖ", "ye", "Combination of 'ㅕ' and 'ㅣ'", Category::CompoundVowel},
-          {"ㅘ", "wa", "'ㅗ' plus 'ㅏ'", Category::CompoundVowel},
-          {"ㅙ", "wae", "'ㅗ' plus 'ㅐ'", Category::CompoundVowel},
-          {"ㅚ", "oe", "'ㅗ' plus 'ㅣ'", Category::CompoundVowel},
-          {"ㅝ", "wo", "'ㅜ' plus 'ㅓ'", Category::CompoundVowel},
-          {"ㅞ", "we", "'ㅜ' plus 'ㅔ'", Category::CompoundVowel},
-          {"ㅟ", "wi", "'ㅜ' plus 'ㅣ'", Category::CompoundVowel},
-          {"ㅢ", "ui", "'ㅡ' plus 'ㅣ'", Category::CompoundVowel}},
-      category_enabled_{{Category::BasicVowel, true}, {Category::BasicConsonant, true}, {Category::DoubleConsonant, true}, {Category::CompoundVowel, true}}
+          {"ㅒ", "yae", "Combination of 'ㅑ' and 'ㅣ'", Category::CompoundVowel, {"vowel", "compound", "iotized"}},
+          {"ㅖ", "ye", "Combination of 'ㅕ' and 'ㅣ'", Category::CompoundVowel, {"vowel", "compound", "iotized"}},
+          {"ㅘ", "wa", "'ㅗ' plus 'ㅏ'", Category::CompoundVowel, {"vowel", "compound"}},
+          {"ㅙ", "wae", "'ㅗ' plus 'ㅐ'", Category::CompoundVowel, {"vowel", "compound"}},
+          {"ㅚ", "oe", "'ㅗ' plus 'ㅣ'", Category::CompoundVowel, {"vowel", "compound"}},
+          {"ㅝ", "wo", "'ㅜ' plus 'ㅓ'", Category::CompoundVowel, {"vowel", "compound"}},
+          {"ㅞ", "we", "'ㅜ' plus 'ㅔ'", Category::CompoundVowel, {"vowel", "compound"}},
+          {"ㅟ", "wi", "'ㅜ' plus 'ㅣ'", Category::CompoundVowel, {"vowel", "compound"}},
+          {"ㅢ", "ui", "'ㅡ' plus 'ㅣ'", Category::CompoundVowel, {"vowel", "compound"}}})
 {
 }
 
+Vocabulary::Vocabulary(const std::vector<Entry> &entries)
+    : Vocabulary(image::Image(entries))
+{
+}
+
+Vocabulary::Vocabulary(image::Image image)
+    : image_(std::move(image)),
+      changed_(),
+      num_entries_(this->image_.get_num_entries()),
+      hangul_index_(),
+      added_index_(),
+      category_enabled_{{Category::BasicVowel, true}, {Category::BasicConsonant, true}, {Category::DoubleConsonant, true}, {Category::CompoundVowel, true}},
+      category_ids_(),
+      tag_ids_(),
+      all_ids_(),
+      query_(),
+      query_inputs_(),
+      filter_(),
+      enabled_ids_(),
+      shuffle_bag_(this->num_entries_),
+      weights_(this->num_entries_, 1.0f),
+      weight_tree_(this->num_entries_),
+      recent_(this->num_entries_, 3)
+{
+    // Index each entry by category and tag, and enable it, as every category starts enabled
+    for (std::size_t idx = 0; idx < this->num_entries_; ++idx) {
+        this->index(idx);
+        this->enabled_ids_.add(static_cast<std::uint32_t>(idx));
+        this->shuffle_bag_.insert(idx);
+        this->weight_tree_.set(idx, 1.0);
+    }
+
+    // Index the entries by character, which the image keeps in canonical form; this throws if two entries share one
+    std::vector<std::string_view> keys;
+    keys.reserve(this->num_entries_);
+    for (std::size_t idx = 0; idx < this->num_entries_; ++idx) {
+        keys.emplace_back(this->image_.get_hangul(idx));
+    }
+    this->hangul_index_ = core::perfect_hash::PerfectHash(keys);
+}
+
+bool Vocabulary::update(const Update &update)
+{
+    bool is_layout_changed = false;
+    bool is_set_changed = false;
+    std::vector<std::string> changed_tags;
+    std::vector<std::size_t> changed_ids;
+    changed_ids.reserve(update.entries.size() + update.removed.size());
+    const auto collect_tags = [&changed_tags](const auto &tags) {
+        changed_tags.insert(changed_tags.end(), tags.cbegin(), tags.cend());
+    };
+
+    for (const std::string &hangul : update.removed) {
+        const auto id = this->lookup(core::normalization::compose(hangul));
+        if (!id.has_value() || !this->contains(*id)) {
+            continue;
+        }
+        collect_tags(this->get_entry_tags(*id));
+        this->unindex(*id);
+        changed_ids.emplace_back(*id);
+        is_layout_changed = true;
+        is_set_changed = true;
+    }
+
+    for (const Entry &source : update.entries) {
+        Entry entry = source;
+        entry.hangul = core::normalization::compose(entry.hangul);
+        auto id = this->lookup(entry.hangul);
+        if (!id.has_value()) {
+            // A new character gets the next ID, which the shuffle bag, the weights and the recent window make room for
+            id = this->num_entries_++;
+            this->added_index_.emplace(entry.hangul, *id);
+            this->shuffle_bag_.reserve(this->num_entries_);
+            this->weights_.resize(this->num_entries_, 1.0f);
+            this->weight_tree_.reserve(this->num_entries_);
+            this->recent_.reserve(this->num_entries_);
+            collect_tags(entry.tags);
+            is_layout_changed = true;
+            is_set_changed = true;
+        }
+        else if (this->contains(*id)) {
+            is_layout_changed = is_layout_changed || this->get_category(*id) != entry.category || this->get_latin(*id) != entry.latin;
+            if (const std::vector<std::string_view> tags = this->get_entry_tags(*id); !std::equal(tags.cbegin(), tags.cend(), entry.tags.cbegin(), entry.tags.cend())) {
+                collect_tags(tags);
+                collect_tags(entry.tags);
+            }
+            this->unindex(*id);
+        }
+        else {
+            // A removed character that is added back keeps its old ID, and with it its statistics
+            collect_tags(entry.tags);
+            is_layout_changed = true;
+            is_set_changed = true;
+        }
+        entry.id = *id;
+        this->changed_[*id] = std::move(entry);
+        this->index(*id);
+        changed_ids.emplace_back(*id);
+    }
+
+    // The query depends on the tags and, through negations, on the set of all entries; otherwise, only the changed entries can change their state
+    if (this->query_.has_value()) {
+        bool is_query_changed = is_set_changed;
+        const std::vector<core::query::Term> &terms = this->query_->get_terms();
+        for (std::size_t idx = 0; idx < terms.size(); ++idx) {
+            if (std::any_of(changed_tags.cbegin(), changed_tags.cend(), [&terms, idx](const std::string &tag) { return core::query::matches(terms[idx], tag); })) {
+                this->query_inputs_[idx] = this->resolve_term(terms[idx]);
+                is_query_changed = true;
+            }
+        }
+        if (is_query_changed) {
+            this->evaluate_query();
+            return is_layout_changed;
+        }
+    }
+    for (const std::size_t id : changed_ids) {
+        const auto key = static_cast<std::uint32_t>(id);
+        const bool is_enabled = this->contains(id) && this->category_enabled_.at(this->get_category(id)) && (!this->filter_.has_value() || this->filter_->contains(key));
+        if (is_enabled && !this->enabled_ids_.contains(key)) {
+            this->enabled_ids_.add(key);
+            this->shuffle_bag_.insert(id);
+            this->weight_tree_.set(id, this->weights_[id]);
+        }
+        else if (!is_enabled && this->enabled_ids_.contains(key)) {
+            this->enabled_ids_.remove(key);
+            this->shuffle_bag_.erase(id);
+            this->weight_tree_.set(id, 0.0);
+        }
+    }
+    return is_layout_changed;
+}
+
 std::optional<Entry> Vocabulary::get_random_enabled_entry()
 {
-    // Collect enabled entries
-    std::vector<Entry> enabled_entries;
-    for (const auto &entry : this->entries_) {
-        if (this->category_enabled_.at(entry.category)) {
-            enabled_entries.emplace_back(entry);
+    const std::size_t num_enabled = this->enabled_ids_.get_cardinality();
+    if (num_enabled == 0) {
+        return std::nullopt;
+    }
+
+    // Draw random ranks among the enabled IDs until one was not asked recently, which rarely takes more than a few draws
+    for (std::size_t attempt = 0; attempt < 16; ++attempt) {
+        const auto rank = core::rng::RNG::get_random_number<std::size_t>(0, num_enabled - 1);
+        if (const std::uint32_t id = *this->enabled_ids_.select(rank); !this->is_recent(id)) {
+            this->recent_.push(id);
+            return this->get_entry(id);
+        }
+    }
+
+    // Otherwise (e.g., most enabled entries were asked recently), pick among the others, or among all if none is left
+    std::vector<std::uint32_t> candidates;
+    this->enabled_ids_.for_each([this, &candidates](const std::uint32_t id) {
+        if (!this->is_recent(id)) {
+            candidates.emplace_back(id);
+        }
+    });
+    if (candidates.empty()) {
+        candidates = this->enabled_ids_.to_vector();
+    }
+    const std::uint32_t id = candidates[core::rng::RNG::get_random_number<std::size_t>(0, candidates.size() - 1)];
+    this->recent_.push(id);
+    return this->get_entry(id);
+}
+
+std::optional<Entry> Vocabulary::get_weighted_enabled_entry()
+{
+    // Take the recently asked entries out of the tree for this pick only, which is O(window size * log n)
+    std::vector<std::size_t> excluded;
+    for (const std::size_t id : this->recent_.get_items()) {
+        if (this->is_recent(id) && this->weight_tree_.get(id) > 0.0) {
+            excluded.emplace_back(id);
+            this->weight_tree_.set(id, 0.0);
         }
     }
+    const double total_weight = this->weight_tree_.get_total();
+    const std::size_t id = total_weight > 0.0 ? this->weight_tree_.find(core::rng::RNG::get_random_real(0.0, total_weight)) : 0;
+    const bool is_picked = total_weight > 0.0 && this->weight_tree_.get(id) > 0.0;
+    for (const std::size_t recent_id : excluded) {
+        this->weight_tree_.set(recent_id, this->weights_[recent_id]);
+    }
+
+    // Fall back to a uniform pick if every such entry has zero weight, or if rounding landed the point on one
+    if (!is_picked) {
+        return this->get_random_enabled_entry();
+    }
+    this->recent_.push(id);
+    return this->get_entry(id);
+}
+
+void Vocabulary::set_weights(const std::vector<float> &weights)
+{
+    for (std::size_t id = 0; id < this->num_entries_; ++id) {
+        this->set_weight(id, id < weights.size() ? weights[id] : 1.0f);
+    }
+}
+
+void Vocabulary::set_weight(const std::size_t id,
+                            const float weight)
+{
+    if (id >= this->num_entries_) {
+        return;
+    }
+    this->weights_[id] = weight;
+    if (this->enabled_ids_.contains(static_cast<std::uint32_t>(id))) {
+        this->weight_tree_.set(id, weight);
+    }
+}
 
-    if (enabled_entries.empty()) {
+std::optional<Entry> Vocabulary::get_next_enabled_entry()
+{
+    // Recently asked entries stay in the bag for later in the round
+    const auto id = this->shuffle_bag_.draw([this](const std::size_t candidate) { return !this->is_recent(candidate); });
+    if (!id.has_value()) {
         return std::nullopt;
     }
+    this->recent_.push(*id);
+    return this->get_entry(*id);
+}
 
-    const auto index = core::rng::RNG::get_random_number<std::size_t>(0, enabled_entries.size() - 1);
-    return enabled_entries.at(index);
+std::optional<Entry> Vocabulary::get_enabled_entry(const std::size_t id)
+{
+    if (!this->is_enabled(id)) {
+        return std::nullopt;
+    }
+    this->recent_.push(id);
+    return this->get_entry(id);
+}
+
+bool Vocabulary::is_recent(const std::size_t id) const
+{
+    // Shrink the window when few entries are enabled, so there is always at least one entry left to ask
+    const std::size_t num_enabled = this->get_num_enabled();
+    return this->recent_.contains(id, num_enabled > 0 ? num_enabled - 1 : 0);
+}
+
+void Vocabulary::set_recent_window(const std::size_t size)
+{
+    this->recent_ = core::recent::RecentWindow(this->num_entries_, size);
 }
 
 std::vector<Entry> Vocabulary::generate_enabled_question_options(const Entry &correct_entry,
-                                                                 const std::size_t num_options)
+                                                                 const std::size_t num_options,
+                                                                 const std::vector<std::size_t> &confusions)
 {
-    std::vector<Entry> options = {correct_entry};
+    return this->generate_enabled_question_options(correct_entry, num_options, confusions, core::rng::RNG::instance());
+}
 
-    // Collect possible wrong entries
-    std::vector<Entry> wrong_entries;
-    for (const auto &entry : this->entries_) {
-        if (this->category_enabled_.at(entry.category) && entry.hangul != correct_entry.hangul) {
-            wrong_entries.emplace_back(entry);
+std::vector<Entry> Vocabulary::generate_enabled_question_options(const Entry &correct_entry,
+                                                                 const std::size_t num_options,
+                                                                 const std::vector<std::size_t> &confusions,
+                                                                 std::mt19937 &engine) const
+{
+    std::vector<Entry> options;
+    options.reserve(num_options);
+    options.emplace_back(correct_entry);
+
+    // Give known confusions a coin flip each, but leave at least half of the wrong options to chance
+    const std::size_t max_confusions = num_options > 1 ? (num_options - 1) / 2 : 0;
+    for (const std::size_t id : confusions) {
+        if (options.size() - 1 >= max_confusions) {
+            break;
+        }
+        if (this->is_enabled(id) && id != correct_entry.id && std::bernoulli_distribution(0.5)(engine)) {
+            options.emplace_back(this->get_entry(id));
         }
     }
+    const auto is_chosen = [&options](const std::size_t id) {
+        return std::any_of(options.cbegin(), options.cend(), [id](const Entry &option) { return option.id == id; });
+    };
 
-    // Shuffle wrong entries
-    std::shuffle(wrong_entries.begin(), wrong_entries.end(), core::rng::RNG::instance());
+    // Draw the other wrong options by rejection sampling from the enabled IDs, which takes O(num_options) while the enabled entries far outnumber the options
+    const std::vector<std::size_t> &enabled_ids = this->shuffle_bag_.get_items();
+    if (enabled_ids.size() >= 2 * num_options) {
+        std::uniform_int_distribution<std::size_t> pick(0, enabled_ids.size() - 1);
+        for (std::size_t attempt = 0; attempt < 4 * num_options && options.size() < num_options; ++attempt) {
+            if (const std::size_t id = enabled_ids[pick(engine)]; id != correct_entry.id && !is_chosen(id)) {
+                options.emplace_back(this->get_entry(id));
+            }
+        }
+    }
 
-    // Add unique wrong entries until we have the desired number of options
-    for (const auto &wrong_entry : wrong_entries) {
-        if (options.size() >= num_options) {
-            break;
+    // Otherwise (few enabled entries, or unlucky draws), add unique wrong entries with a partial Fisher-Yates shuffle of all possible ones
+    if (options.size() < num_options) {
+        std::vector<std::size_t> wrong_ids;
+        wrong_ids.reserve(enabled_ids.size());
+        for (const std::size_t id : enabled_ids) {
+            if (id != correct_entry.id && !is_chosen(id)) {
+                wrong_ids.emplace_back(id);
+            }
+        }
+        for (std::size_t idx = 0; idx < wrong_ids.size() && options.size() < num_options; ++idx) {
+            std::swap(wrong_ids[idx], wrong_ids[std::uniform_int_distribution<std::size_t>(idx, wrong_ids.size() - 1)(engine)]);
+            options.emplace_back(this->get_entry(wrong_ids[idx]));
         }
-        options.emplace_back(wrong_entry);
     }
 
     // Throw if the number of options is less than the desired number
@@ -120,7 +383,7 @@ std::vector<Entry> Vocabulary::generate_enabled_question_options(const Entry &co
     }
 
     // Shuffle the options
-    std::shuffle(options.begin(), options.end(), core::rng::RNG::instance());
+    std::shuffle(options.begin(), options.end(), engine);
 
     return options;
 }
@@ -128,12 +391,273 @@ std::vector<Entry> Vocabulary::generate_enabled_question_options(const Entry &co
 void Vocabulary::set_category_enabled(const Category category,
                                       const bool enabled)
 {
-    this->category_enabled_.at(category) = enabled;
+    bool &current = this->category_enabled_.at(category);
+    if (current == enabled) {
+        return;
+    }
+    current = enabled;
+    this->update_enabled();
+}
+
+bool Vocabulary::is_category_enabled(const Category category) const
+{
+    return this->category_enabled_.at(category);
+}
+
+std::size_t Vocabulary::get_num_enabled() const
+{
+    return this->enabled_ids_.get_cardinality();
 }
 
-const std::vector<Entry> &Vocabulary::get_entries() const
+bool Vocabulary::is_enabled(const std::size_t id) const
 {
-    return this->entries_;
+    return id < this->num_entries_ && this->enabled_ids_.contains(static_cast<std::uint32_t>(id));
+}
+
+const core::bitmap::Bitmap &Vocabulary::get_enabled_ids() const
+{
+    return this->enabled_ids_;
+}
+
+void Vocabulary::set_filter(const std::optional<core::bitmap::Bitmap> &filter)
+{
+    this->query_.reset();
+    this->query_inputs_.clear();
+    this->filter_ = filter;
+    this->update_enabled();
+}
+
+void Vocabulary::set_query(const std::string_view expression)
+{
+    if (expression.find_first_not_of(" \t\r\n") == std::string_view::npos) {
+        this->set_filter(std::nullopt);
+        return;
+    }
+
+    // Compile before changing anything, so an invalid query keeps the current one
+    core::query::Query query(expression);
+    std::vector<core::bitmap::Bitmap> inputs;
+    inputs.reserve(query.get_terms().size());
+    for (const core::query::Term &term : query.get_terms()) {
+        inputs.emplace_back(this->resolve_term(term));
+    }
+    this->query_ = std::move(query);
+    this->query_inputs_ = std::move(inputs);
+    this->evaluate_query();
+}
+
+void Vocabulary::set_tag_ids(const std::string_view tag,
+                             const core::bitmap::Bitmap &ids)
+{
+    const auto it = this->tag_ids_.find(tag);
+    if (it == this->tag_ids_.end()) {
+        if (ids.get_cardinality() == 0) {
+            return;
+        }
+        this->tag_ids_.emplace(std::string(tag), ids);
+    }
+    else if (it->second == ids) {
+        return;
+    }
+    else if (ids.get_cardinality() == 0) {
+        this->tag_ids_.erase(it);
+    }
+    else {
+        it->second = ids;
+    }
+
+    // Only the terms that match the tag are resolved again, and the query is evaluated only if there is one
+    if (!this->query_.has_value()) {
+        return;
+    }
+    bool changed = false;
+    const std::vector<core::query::Term> &terms = this->query_->get_terms();
+    for (std::size_t idx = 0; idx < terms.size(); ++idx) {
+        if (core::query::matches(terms[idx], tag)) {
+            this->query_inputs_[idx] = this->resolve_term(terms[idx]);
+            changed = true;
+        }
+    }
+    if (changed) {
+        this->evaluate_query();
+    }
+}
+
+std::vector<std::string> Vocabulary::get_tags() const
+{
+    std::vector<std::string> tags;
+    tags.reserve(this->tag_ids_.size());
+    for (const auto &[tag, ids] : this->tag_ids_) {
+        tags.emplace_back(tag);
+    }
+    return tags;
+}
+
+const core::bitmap::Bitmap &Vocabulary::get_tag_ids(const std::string_view tag) const
+{
+    static const core::bitmap::Bitmap empty;
+    const auto it = this->tag_ids_.find(tag);
+    return it != this->tag_ids_.cend() ? it->second : empty;
+}
+
+std::optional<std::size_t> Vocabulary::find_id(const std::string_view hangul) const
+{
+    if (const auto id = this->lookup(hangul); id.has_value() && this->contains(*id)) {
+        return id;
+    }
+    return std::nullopt;
+}
+
+bool Vocabulary::contains(const std::size_t id) const
+{
+    return id < this->num_entries_ && this->all_ids_.contains(static_cast<std::uint32_t>(id));
+}
+
+std::size_t Vocabulary::get_num_entries() const
+{
+    return this->num_entries_;
+}
+
+Entry Vocabulary::get_entry(const std::size_t id) const
+{
+    if (const Entry *entry = this->find_changed(id)) {
+        return *entry;
+    }
+    return this->image_.get_entry(id);
+}
+
+std::string_view Vocabulary::get_hangul(const std::size_t id) const
+{
+    const Entry *entry = this->find_changed(id);
+    return entry ? std::string_view(entry->hangul) : this->image_.get_hangul(id);
+}
+
+std::string_view Vocabulary::get_latin(const std::size_t id) const
+{
+    const Entry *entry = this->find_changed(id);
+    return entry ? std::string_view(entry->latin) : this->image_.get_latin(id);
+}
+
+Category Vocabulary::get_category(const std::size_t id) const
+{
+    const Entry *entry = this->find_changed(id);
+    return entry ? entry->category : this->image_.get_category(id);
+}
+
+const image::Image &Vocabulary::get_image() const
+{
+    return this->image_;
+}
+
+const Entry *Vocabulary::find_changed(const std::size_t id) const
+{
+    // Most vocabularies are never updated, so reading an entry costs no hashing
+    if (this->changed_.empty()) {
+        return nullptr;
+    }
+    const auto it = this->changed_.find(id);
+    return it != this->changed_.cend() ? &it->second : nullptr;
+}
+
+std::vector<std::string_view> Vocabulary::get_entry_tags(const std::size_t id) const
+{
+    if (const Entry *entry = this->find_changed(id)) {
+        return {entry->tags.cbegin(), entry->tags.cend()};
+    }
+    return this->image_.get_tags(id);
+}
+
+std::optional<std::size_t> Vocabulary::lookup(const std::string_view hangul) const
+{
+    if (const auto index = this->hangul_index_.find(hangul); index.has_value()) {
+        return static_cast<std::size_t>(*index);
+    }
+    if (this->added_index_.empty()) {
+        return std::nullopt;
+    }
+    const auto it = this->added_index_.find(std::string(hangul));
+    return it != this->added_index_.cend() ? std::optional<std::size_t>(it->second) : std::nullopt;
+}
+
+void Vocabulary::index(const std::size_t id)
+{
+    const auto key = static_cast<std::uint32_t>(id);
+    this->category_ids_[this->get_category(id)].add(key);
+    for (const std::string_view tag : this->get_entry_tags(id)) {
+        auto it = this->tag_ids_.find(tag);
+        if (it == this->tag_ids_.end()) {
+            it = this->tag_ids_.emplace(std::string(tag), core::bitmap::Bitmap()).first;
+        }
+        it->second.add(key);
+    }
+    this->all_ids_.add(key);
+}
+
+void Vocabulary::unindex(const std::size_t id)
+{
+    const auto key = static_cast<std::uint32_t>(id);
+    this->category_ids_[this->get_category(id)].remove(key);
+    for (const std::string_view tag : this->get_entry_tags(id)) {
+        if (const auto it = this->tag_ids_.find(tag); it != this->tag_ids_.end()) {
+            it->second.remove(key);
+            if (it->second.get_cardinality() == 0) {
+                this->tag_ids_.erase(it);
+            }
+        }
+    }
+    this->all_ids_.remove(key);
+}
+
+core::bitmap::Bitmap Vocabulary::resolve_term(const core::query::Term &term) const
+{
+    if (term.comparison == core::query::Comparison::None) {
+        return this->get_tag_ids(term.name);
+    }
+
+    // Numbered tags "name:N" are next to each other in the sorted map
+    core::bitmap::Bitmap ids;
+    const std::string prefix = term.name + ':';
+    for (auto it = this->tag_ids_.lower_bound(prefix); it != this->tag_ids_.cend() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+        if (core::query::matches(term, it->first)) {
+            ids |= it->second;
+        }
+    }
+    return ids;
+}
+
+void Vocabulary::evaluate_query()
+{
+    std::vector<const core::bitmap::Bitmap *> inputs;
+    inputs.reserve(this->query_inputs_.size());
+    for (const core::bitmap::Bitmap &input : this->query_inputs_) {
+        inputs.emplace_back(&input);
+    }
+    this->filter_ = this->query_->evaluate(inputs, this->all_ids_);
+    this->update_enabled();
+}
+
+void Vocabulary::update_enabled()
+{
+    core::bitmap::Bitmap enabled;
+    for (const auto &[category, ids] : this->category_ids_) {
+        if (this->category_enabled_.at(category)) {
+            enabled |= ids;
+        }
+    }
+    if (this->filter_.has_value()) {
+        enabled &= *this->filter_;
+    }
+
+    // Only the entries that changed enter or leave the shuffle bag and the weight tree, so the current round continues with the others
+    (this->enabled_ids_ - enabled).for_each([this](const std::uint32_t id) {
+        this->shuffle_bag_.erase(id);
+        this->weight_tree_.set(id, 0.0);
+    });
+    (enabled - this->enabled_ids_).for_each([this](const std::uint32_t id) {
+        this->shuffle_bag_.insert(id);
+        this->weight_tree_.set(id, this->weights_[id]);
+    });
+    this->enabled_ids_ = std::move(enabled);
 }
 
 }  // namespace modules::vocabulary
@@ -7,11 +7,23 @@
 #pragma once
 
 #include <cstddef>        // for std::size_t
+#include <functional>     // for std::less
+#include <map>            // for std::map
 #include <optional>       // for std::optional
+#include <random>         // for std::mt19937
 #include <string>         // for std::string
+#include <string_view>    // for std::string_view
 #include <unordered_map>  // for std::unordered_map
 #include <vector>         // for std::vector
 
+#include "core/bitmap.hpp"
+#include "core/fenwick.hpp"
+#include "core/perfect_hash.hpp"
+#include "core/query.hpp"
+#include "core/recent.hpp"
+#include "core/shuffle_bag.hpp"
+#include "image.hpp"
+
 namespace modules::vocabulary {
 
 /**
@@ -32,6 +44,8 @@ enum class Category {
 struct Entry final {
     /**
      * @brief Korean character (e.g., "ㅏ").
+     *
+     * @note This is kept in the canonical form of "core::normalization::compose()" by the Vocabulary class.
      */
     std::string hangul;
 
@@ -49,41 +63,200 @@ struct Entry final {
      * @brief Category of the Korean character (e.g., "Category::BasicVowel").
      */
     Category category;
+
+    /**
+     * @brief Tags of the entry, which may overlap freely (e.g., {"consonant", "aspirated"}).
+     */
+    std::vector<std::string> tags = {};
+
+    /**
+     * @brief ID of the entry, which is its index in the vocabulary (e.g., "0").
+     *
+     * @note This is assigned by the Vocabulary class on construction or by "Vocabulary::update()", and stays the same for as long as the vocabulary does, so entries are compared by ID rather than by text.
+     */
+    std::size_t id = 0;
+};
+
+/**
+ * @brief Struct that represents the changes between two versions of a deck (e.g., computed by "modules::deck::diff()").
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Update final {
+    /**
+     * @brief Entries that are new or changed, matched by Korean text; their IDs are ignored.
+     */
+    std::vector<Entry> entries;
+
+    /**
+     * @brief Korean text of the entries that were removed (e.g., {"ㅑ"}).
+     */
+    std::vector<std::string> removed;
+
+    /**
+     * @brief Check whether nothing changed.
+     *
+     * @return True if there are no new, changed or removed entries, false otherwise.
+     */
+    [[nodiscard]] bool is_empty() const
+    {
+        return this->entries.empty() && this->removed.empty();
+    }
 };
 
 /**
  * @brief Class that manages the Korean vocabulary.
  *
- * On construction, the class initializes the vocabulary with a set of Korean characters and their Latin equivalents.
+ * On construction, the class initializes the vocabulary with a set of Korean characters and their Latin equivalents, or with an imported deck.
+ * Every Korean character must be unique, as an entry is identified by its ID and found by its character.
+ *
+ * The entries are read from an "image::Image" rather than copied out of it, so a vocabulary built from a mapped image holds only its indexes and session state (e.g., the enabled entries) in its own memory.
  *
  * @note This class is marked as `final` to prevent inheritance.
  */
 class Vocabulary final {
   public:
     /**
-     * @brief Construct a new Vocabulary object.
+     * @brief Construct a new Vocabulary object with the built-in deck of Korean characters.
      */
     explicit Vocabulary();
 
+    /**
+     * @brief Construct a new Vocabulary object with a deck of entries (e.g., imported by "modules::deck::import()").
+     *
+     * @param entries Entries of the deck, whose IDs are assigned from their order.
+     *
+     * @throws std::runtime_error if two entries have the same Korean text.
+     */
+    explicit Vocabulary(const std::vector<Entry> &entries);
+
+    /**
+     * @brief Construct a new Vocabulary object with the entries of an image (e.g., mapped by "modules::deck::load()"), which is kept rather than copied.
+     *
+     * @param image Image of the entries, whose IDs are their indices.
+     *
+     * @throws std::runtime_error if two entries have the same Korean text.
+     */
+    explicit Vocabulary(image::Image image);
+
+    /**
+     * @brief Apply the changes of a deck (e.g., one edited while the app runs), in O(number of changes) rather than O(number of entries).
+     *
+     * Entries are matched by Korean text, so an entry keeps its ID, and with it every statistic indexed by ID, for as long as the vocabulary does:
+     * - A changed entry is updated in place.
+     * - A new entry gets the next ID, and joins the current round of the shuffle bag if it is enabled.
+     * - A removed entry keeps its ID but is never enabled again, unless a later update adds it back under the same ID.
+     *
+     * The image is never written; new and changed entries are kept next to it, in memory proportional to the changes.
+     * The query, if any, is evaluated again only if the entries of a tag or the set of entries changed.
+     *
+     * @param update Changes to apply.
+     *
+     * @return True if an entry was added or removed, or changed its category or transliteration, so structures built from the entries (e.g., "modules::typing::Matcher") are out of date, false otherwise.
+     */
+    bool update(const Update &update);
+
     /**
      * @brief Get a random entry from the vocabulary.
      *
+     * Like every method that picks an entry, this skips entries asked recently (see "set_recent_window()").
+     *
      * @return Entry object where the category is enabled, or std::nullopt if no categories are enabled.
      */
     [[nodiscard]] std::optional<Entry> get_random_enabled_entry();
 
+    /**
+     * @brief Get a random entry from the vocabulary, where each entry is picked with a probability proportional to its weight (see "set_weights()"). This is O(log n).
+     *
+     * The weights of the enabled entries are kept in a Fenwick tree, so a pick descends the tree once instead of summing every weight; if every entry that was not asked recently weighs zero, the pick is uniform.
+     *
+     * @return Entry object where the category is enabled, or std::nullopt if no categories are enabled.
+     */
+    [[nodiscard]] std::optional<Entry> get_weighted_enabled_entry();
+
+    /**
+     * @brief Set the weight of every entry for "get_weighted_enabled_entry()". This is O(n log n).
+     *
+     * @param weights Non-negative weight of each entry, indexed by entry ID (e.g., scores from a knowledge model); entries without a weight count as 1.0, which is also the weight of every entry until this is called.
+     */
+    void set_weights(const std::vector<float> &weights);
+
+    /**
+     * @brief Set the weight of one entry for "get_weighted_enabled_entry()", e.g., after its score changed. This is O(log n).
+     *
+     * @param id ID of the entry (e.g., "3"); IDs out of range are ignored.
+     * @param weight Non-negative weight (e.g., "0.75").
+     */
+    void set_weight(const std::size_t id,
+                    const float weight);
+
+    /**
+     * @brief Get the next entry from a shuffle bag, which returns every enabled entry once per round, in random order.
+     *
+     * Entries of a category enabled mid-round join the current round, and entries of a disabled category leave it.
+     *
+     * @return Entry object where the category is enabled, or std::nullopt if no categories are enabled.
+     */
+    [[nodiscard]] std::optional<Entry> get_next_enabled_entry();
+
+    /**
+     * @brief Get an entry picked by a policy outside of the vocabulary (e.g., Thompson sampling), and remember it as recently asked.
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return Entry object, or std::nullopt if the ID is out of range or its category is disabled.
+     */
+    [[nodiscard]] std::optional<Entry> get_enabled_entry(const std::size_t id);
+
+    /**
+     * @brief Check whether an entry was asked within the recent-history window. This is O(1).
+     *
+     * The window shrinks to one less than the number of enabled entries, so a small enabled set (e.g., 5 double consonants) never runs out of entries to ask.
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return True if the entry should not be asked again yet, false otherwise.
+     */
+    [[nodiscard]] bool is_recent(const std::size_t id) const;
+
+    /**
+     * @brief Set how many of the last asked entries are excluded from being asked again, and forget the entries asked so far.
+     *
+     * @param size Number of questions (e.g., "3"); 0 disables the exclusion.
+     */
+    void set_recent_window(const std::size_t size);
+
     /**
      * @brief Get a set of unique options for a question.
      *
      * @param correct_entry Correct Entry object that should be included in the options.
      * @param num_options Total number of options to generate (default: 4).
+     * @param confusions IDs of entries often mistaken for the correct entry, most frequent first; each gets a better chance to be an option (default: none).
      *
      * @return Vector of Entry objects representing the question options.
      *
      * @throws std::runtime_error if the size of the vector is less than "num_options" because there are not enough unique entries.
      */
     [[nodiscard]] std::vector<Entry> generate_enabled_question_options(const Entry &correct_entry,
-                                                                       const std::size_t num_options = 4);
+                                                                       const std::size_t num_options = 4,
+                                                                       const std::vector<std::size_t> &confusions = {});
+
+    /**
+     * @brief Get a set of unique options for a question, drawing random numbers from a given generator instead of the shared one. This is safe to call from several threads, each with its own generator.
+     *
+     * @param correct_entry Correct Entry object that should be included in the options.
+     * @param num_options Total number of options to generate (e.g., "4").
+     * @param confusions IDs of entries often mistaken for the correct entry, most frequent first; each gets a better chance to be an option.
+     * @param engine Random number generator (e.g., one per export thread).
+     *
+     * @return Vector of Entry objects representing the question options.
+     *
+     * @throws std::runtime_error if the size of the vector is less than "num_options" because there are not enough unique entries.
+     */
+    [[nodiscard]] std::vector<Entry> generate_enabled_question_options(const Entry &correct_entry,
+                                                                       const std::size_t num_options,
+                                                                       const std::vector<std::size_t> &confusions,
+                                                                       std::mt19937 &engine) const;
 
     /**
      * @brief Enable or disable a category in the vocabulary.
@@ -95,22 +268,293 @@ class Vocabulary final {
                               const bool enabled);
 
     /**
-     * @brief Get a vector of all vocabulary entries.
+     * @brief Check whether a category in the vocabulary is enabled.
+     *
+     * @param category Category to check.
+     *
+     * @return True if the category is enabled, false otherwise.
+     */
+    [[nodiscard]] bool is_category_enabled(const Category category) const;
+
+    /**
+     * @brief Get the number of entries in the enabled categories.
+     *
+     * @return Number of entries (e.g., "40").
+     */
+    [[nodiscard]] std::size_t get_num_enabled() const;
+
+    /**
+     * @brief Check whether an entry is enabled, i.e., its category is enabled and it passes the filter.
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return True if the entry is enabled, false otherwise.
+     */
+    [[nodiscard]] bool is_enabled(const std::size_t id) const;
+
+    /**
+     * @brief Get the IDs of the enabled entries, which is the union of the enabled categories intersected with the filter.
+     *
+     * @return Const reference to a bitmap of entry IDs.
+     */
+    [[nodiscard]] const core::bitmap::Bitmap &get_enabled_ids() const;
+
+    /**
+     * @brief Restrict the enabled entries to a set of IDs, on top of the enabled categories (e.g., the entries of some tags).
+     *
+     * @param filter Bitmap of entry IDs, or std::nullopt to enable every entry of the enabled categories. This replaces the query, if any.
+     */
+    void set_filter(const std::optional<core::bitmap::Bitmap> &filter);
+
+    /**
+     * @brief Restrict the enabled entries to a boolean query over tags, on top of the enabled categories.
+     *
+     * The query is compiled once, and evaluated again only when "set_tag_ids()" changes one of its tags; enabling a category does not evaluate it.
+     *
+     * @param expression Query in the grammar of "core::query::Query" (e.g., "(lesson<=5 & vowel) | review-due"), or an empty string to enable every entry of the enabled categories.
+     *
+     * @throws std::runtime_error if the query is not valid, in which case the enabled entries do not change.
+     */
+    void set_query(const std::string_view expression);
+
+    /**
+     * @brief Set the IDs of the entries with a tag, e.g., for tags that change while learning ("review-due").
+     *
+     * @param tag Name of the tag (e.g., "review-due").
+     * @param ids Bitmap of entry IDs; an empty bitmap removes the tag.
+     */
+    void set_tag_ids(const std::string_view tag,
+                     const core::bitmap::Bitmap &ids);
+
+    /**
+     * @brief Get the names of all tags.
+     *
+     * @return Vector of tag names in alphabetical order (e.g., {"aspirated", "consonant", "vowel"}).
+     */
+    [[nodiscard]] std::vector<std::string> get_tags() const;
+
+    /**
+     * @brief Get the IDs of the entries with a tag.
+     *
+     * @param tag Name of the tag (e.g., "vowel").
+     *
+     * @return Const reference to a bitmap of entry IDs, which is empty if no entry has the tag.
+     */
+    [[nodiscard]] const core::bitmap::Bitmap &get_tag_ids(const std::string_view tag) const;
+
+    /**
+     * @brief Find the entry of a Korean character with one probe of a perfect hash.
      *
-     * @return Const reference to a vector of Entry objects.
+     * @param hangul Korean character in the canonical form of "core::normalization::compose()" (e.g., "ㅏ").
+     *
+     * @return ID of the entry (e.g., "0"), or std::nullopt if no entry has this character or it was removed by "update()".
+     */
+    [[nodiscard]] std::optional<std::size_t> find_id(const std::string_view hangul) const;
+
+    /**
+     * @brief Check whether an entry exists, i.e., its ID is in range and it was not removed by "update()".
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return True if the entry exists, false otherwise.
      */
-    [[nodiscard]] const std::vector<Entry> &get_entries() const;
+    [[nodiscard]] bool contains(const std::size_t id) const;
+
+    /**
+     * @brief Get the number of entries, including those removed by "update()"; every ID is less than this.
+     *
+     * @return Number of entries (e.g., "40").
+     */
+    [[nodiscard]] std::size_t get_num_entries() const;
+
+    /**
+     * @brief Copy an entry out of the vocabulary, including one removed by "update()".
+     *
+     * @param id ID of the entry, which must be less than "get_num_entries()" (e.g., "3").
+     *
+     * @return Entry object.
+     */
+    [[nodiscard]] Entry get_entry(const std::size_t id) const;
+
+    /**
+     * @brief Get the Korean text of an entry without copying it, e.g., to write many entries.
+     *
+     * @param id ID of the entry, which must be less than "get_num_entries()" (e.g., "3").
+     *
+     * @return View of the text in canonical form (e.g., "ㅕ"), valid until the next call to "update()".
+     */
+    [[nodiscard]] std::string_view get_hangul(const std::size_t id) const;
+
+    /**
+     * @brief Get the Latin transliteration of an entry without copying it.
+     *
+     * @param id ID of the entry, which must be less than "get_num_entries()" (e.g., "3").
+     *
+     * @return View of the transliteration (e.g., "yeo"), valid until the next call to "update()".
+     */
+    [[nodiscard]] std::string_view get_latin(const std::size_t id) const;
+
+    /**
+     * @brief Get the category of an entry.
+     *
+     * @param id ID of the entry, which must be less than "get_num_entries()" (e.g., "3").
+     *
+     * @return Category (e.g., "Category::BasicVowel").
+     */
+    [[nodiscard]] Category get_category(const std::size_t id) const;
+
+    /**
+     * @brief Get the image the vocabulary was constructed with, without the changes of "update()".
+     *
+     * @return Const reference to the image.
+     */
+    [[nodiscard]] const image::Image &get_image() const;
 
   private:
     /**
-     * @brief Vector of all vocabulary entries.
+     * @brief Find an entry that "update()" added or changed.
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return Pointer to the entry, or nullptr if the image holds the entry.
+     */
+    [[nodiscard]] const Entry *find_changed(const std::size_t id) const;
+
+    /**
+     * @brief Get the tags of an entry.
+     *
+     * @param id ID of the entry (e.g., "3").
+     *
+     * @return Views of the tags (e.g., {"vowel", "iotized"}), valid until the next call to "update()".
+     */
+    [[nodiscard]] std::vector<std::string_view> get_entry_tags(const std::size_t id) const;
+
+    /**
+     * @brief Find the ID of a Korean character, including removed entries.
+     *
+     * @param hangul Korean character in canonical form (e.g., "ㅏ").
+     *
+     * @return ID of the entry (e.g., "0"), or std::nullopt if no entry ever had this character.
      */
-    std::vector<Entry> entries_;
+    [[nodiscard]] std::optional<std::size_t> lookup(const std::string_view hangul) const;
+
+    /**
+     * @brief Add an entry to the sets of IDs of its category and tags, and to the set of all IDs.
+     *
+     * @param id ID of the entry (e.g., "3").
+     */
+    void index(const std::size_t id);
+
+    /**
+     * @brief Remove an entry from the sets of IDs of its category and tags, and from the set of all IDs; tags without entries are removed.
+     *
+     * @param id ID of the entry (e.g., "3").
+     */
+    void unindex(const std::size_t id);
+
+    /**
+     * @brief Recompute the enabled entries, and add or remove the entries that changed to or from the shuffle bag, so the current round continues.
+     */
+    void update_enabled();
+
+    /**
+     * @brief Get the IDs of the entries with any tag that matches a term of a query.
+     *
+     * @param term Term (e.g., "lesson<=5").
+     *
+     * @return Bitmap of entry IDs.
+     */
+    [[nodiscard]] core::bitmap::Bitmap resolve_term(const core::query::Term &term) const;
+
+    /**
+     * @brief Evaluate the query into the filter, and recompute the enabled entries.
+     */
+    void evaluate_query();
+
+    /**
+     * @brief Entries as constructed, which may be mapped from a file shared with other processes.
+     */
+    image::Image image_;
+
+    /**
+     * @brief Entries added or changed by "update()", by ID, which take the place of those in the image.
+     */
+    std::unordered_map<std::size_t, Entry> changed_;
+
+    /**
+     * @brief Number of entries, including those added by "update()".
+     */
+    std::size_t num_entries_;
+
+    /**
+     * @brief Perfect hash from the Korean character of each entry to its ID.
+     */
+    core::perfect_hash::PerfectHash hangul_index_;
+
+    /**
+     * @brief ID of each entry added by "update()", by Korean character, as the perfect hash cannot grow.
+     */
+    std::unordered_map<std::string, std::size_t> added_index_;
 
     /**
      * @brief Map indicating whether each category is enabled.
      */
     std::unordered_map<Category, bool> category_enabled_;
+
+    /**
+     * @brief IDs of the entries of each category.
+     */
+    std::unordered_map<Category, core::bitmap::Bitmap> category_ids_;
+
+    /**
+     * @brief IDs of the entries of each tag, by tag name.
+     */
+    std::map<std::string, core::bitmap::Bitmap, std::less<>> tag_ids_;
+
+    /**
+     * @brief IDs of all entries, which negations in a query are taken from.
+     */
+    core::bitmap::Bitmap all_ids_;
+
+    /**
+     * @brief Optional query over tags, which computes the filter.
+     */
+    std::optional<core::query::Query> query_;
+
+    /**
+     * @brief IDs of the entries of each term of the query, kept until one of its tags changes.
+     */
+    std::vector<core::bitmap::Bitmap> query_inputs_;
+
+    /**
+     * @brief Optional restriction of the enabled entries.
+     */
+    std::optional<core::bitmap::Bitmap> filter_;
+
+    /**
+     * @brief IDs of the enabled entries, which the shuffle bag always matches.
+     */
+    core::bitmap::Bitmap enabled_ids_;
+
+    /**
+     * @brief Shuffle bag of the IDs of enabled entries.
+     */
+    core::shuffle_bag::ShuffleBag shuffle_bag_;
+
+    /**
+     * @brief Weight of each entry for weighted picks, by ID, whether or not it is enabled.
+     */
+    std::vector<float> weights_;
+
+    /**
+     * @brief Fenwick tree of the weights of the enabled entries, where disabled entries weigh zero.
+     */
+    core::fenwick::FenwickTree weight_tree_;
+
+    /**
+     * @brief Window of the IDs of recently asked entries (default: last 3 questions).
+     */
+    core::recent::RecentWindow recent_;
 };
 
 }  // namespace modules::vocabulary
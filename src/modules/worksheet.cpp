@@ -0,0 +1,260 @@
+/**
+ * @file worksheet.cpp
+ */
+
+#include <algorithm>           // for std::max, std::min
+#include <atomic>              // for std::atomic
+#include <chrono>              // for std::chrono
+#include <condition_variable>  // for std::condition_variable
+#include <cstddef>             // for std::size_t
+#include <cstdint>             // for std::uint32_t, std::uint64_t
+#include <cstdio>              // for std::FILE, std::fwrite, std::fflush
+#include <exception>           // for std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <iterator>            // for std::back_inserter
+#include <mutex>               // for std::mutex, std::lock_guard, std::unique_lock
+#include <random>              // for std::mt19937, std::seed_seq, std::uniform_int_distribution
+#include <stdexcept>           // for std::runtime_error
+#include <string>              // for std::string
+#include <string_view>         // for std::string_view
+#include <thread>              // for std::thread
+#include <utility>             // for std::move
+#include <vector>              // for std::vector
+
+#include <fmt/format.h>
+
+#include "vocabulary.hpp"
+#include "worksheet.hpp"
+
+namespace modules::worksheet {
+
+namespace {
+
+/**
+ * @brief Private number of questions per block; a block of 4-option questions is roughly 1 MB of output.
+ */
+constexpr std::size_t rows_per_block = 16384;
+
+/**
+ * @brief Private helper function to append a field to a row, so it cannot break the file format.
+ *
+ * @param out String to append to.
+ * @param text Text of the field (e.g., "ㅏ").
+ * @param format File format.
+ */
+void append_field(std::string &out,
+                  const std::string_view text,
+                  const Format format)
+{
+    if (format == Format::Tsv) {
+        // Tabs and newlines would start a new column or row
+        for (const char c : text) {
+            out.push_back(c == '\t' || c == '\n' || c == '\r' ? ' ' : c);
+        }
+        return;
+    }
+    out.push_back('"');
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+            out.push_back(c);
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned int>(c));
+        }
+        else {
+            out.push_back(c);
+        }
+    }
+    out.push_back('"');
+}
+
+/**
+ * @brief Private helper function to generate and format one block of questions.
+ *
+ * @param vocabulary Vocabulary to draw the questions and options from.
+ * @param enabled_ids IDs of the enabled entries.
+ * @param options Settings of the export.
+ * @param block Index of the block (e.g., "3").
+ *
+ * @return Formatted rows of the block.
+ */
+[[nodiscard]] std::string generate_block(const vocabulary::Vocabulary &vocabulary,
+                                         const std::vector<std::size_t> &enabled_ids,
+                                         const Options &options,
+                                         const std::size_t block)
+{
+    std::seed_seq sequence{options.seed, static_cast<std::uint32_t>(block), static_cast<std::uint32_t>(static_cast<std::uint64_t>(block) >> 32)};
+    std::mt19937 engine(sequence);
+    std::uniform_int_distribution<std::size_t> pick(0, enabled_ids.size() - 1);
+
+    const std::size_t first_row = block * rows_per_block;
+    const std::size_t last_row = std::min(first_row + rows_per_block, options.num_rows);
+    std::string out;
+    out.reserve((last_row - first_row) * (24 + 8 * options.num_options));
+    for (std::size_t row = first_row; row < last_row; ++row) {
+        const vocabulary::Entry correct_entry = vocabulary.get_entry(enabled_ids[pick(engine)]);
+        const auto question_options = vocabulary.generate_enabled_question_options(correct_entry, options.num_options, {}, engine);
+        std::size_t answer = 0;
+        if (options.format == Format::Tsv) {
+            fmt::format_to(std::back_inserter(out), "{}\t", row);
+            append_field(out, correct_entry.hangul, options.format);
+            for (std::size_t idx = 0; idx < question_options.size(); ++idx) {
+                out.push_back('\t');
+                append_field(out, question_options[idx].latin, options.format);
+                answer = question_options[idx].id == correct_entry.id ? idx + 1 : answer;
+            }
+            fmt::format_to(std::back_inserter(out), "\t{}\n", answer);
+        }
+        else {
+            fmt::format_to(std::back_inserter(out), "{{\"id\":{},\"prompt\":", row);
+            append_field(out, correct_entry.hangul, options.format);
+            out.append(",\"options\":[");
+            for (std::size_t idx = 0; idx < question_options.size(); ++idx) {
+                if (idx > 0) {
+                    out.push_back(',');
+                }
+                append_field(out, question_options[idx].latin, options.format);
+                answer = question_options[idx].id == correct_entry.id ? idx + 1 : answer;
+            }
+            fmt::format_to(std::back_inserter(out), "],\"answer\":{}}}\n", answer);
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Private helper function to write a buffer to a file.
+ *
+ * @param file File to write to.
+ * @param data Data to write.
+ *
+ * @throws std::runtime_error If writing fails.
+ */
+void write_all(std::FILE *file,
+               const std::string_view data)
+{
+    if (std::fwrite(data.data(), 1, data.size(), file) != data.size()) {
+        throw std::runtime_error(fmt::format("Failed to write '{}' bytes of exported questions", data.size()));
+    }
+}
+
+}  // namespace
+
+Summary write(const vocabulary::Vocabulary &vocabulary,
+              const Options &options,
+              std::FILE *file)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::size_t> enabled_ids;
+    for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+        if (vocabulary.is_enabled(id)) {
+            enabled_ids.emplace_back(id);
+        }
+    }
+    if (options.num_options == 0 || enabled_ids.size() < options.num_options) {
+        throw std::runtime_error(fmt::format("Cannot export questions with '{}' options, as '{}' entries are enabled", options.num_options, enabled_ids.size()));
+    }
+
+    std::uint64_t num_bytes = 0;
+    if (options.format == Format::Tsv) {
+        std::string header = "id\tprompt";
+        for (std::size_t idx = 1; idx <= options.num_options; ++idx) {
+            fmt::format_to(std::back_inserter(header), "\toption_{}", idx);
+        }
+        header.append("\tanswer\n");
+        write_all(file, header);
+        num_bytes += header.size();
+    }
+
+    const std::size_t num_blocks = (options.num_rows + rows_per_block - 1) / rows_per_block;
+    const std::size_t num_threads = std::min<std::size_t>(options.num_threads > 0 ? options.num_threads : std::max(1u, std::thread::hardware_concurrency()), std::max<std::size_t>(num_blocks, 1));
+
+    // Finished blocks wait in a ring of slots until the calling thread writes them in order; a generator never runs more than "window" blocks ahead
+    const std::size_t window = 2 * num_threads;
+    std::vector<std::string> slots(window);
+    std::vector<bool> filled(window, false);
+    std::size_t next_to_write = 0;
+    bool failed = false;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable block_ready;
+    std::condition_variable slot_free;
+    std::atomic<std::size_t> next_block{0};
+
+    const auto generate = [&]() {
+        while (true) {
+            const std::size_t block = next_block.fetch_add(1);
+            if (block >= num_blocks) {
+                return;
+            }
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                slot_free.wait(lock, [&]() { return failed || block < next_to_write + window; });
+                if (failed) {
+                    return;
+                }
+            }
+            try {
+                std::string out = generate_block(vocabulary, enabled_ids, options, block);
+                const std::lock_guard<std::mutex> lock(mutex);
+                slots[block % window] = std::move(out);
+                filled[block % window] = true;
+            }
+            catch (...) {
+                const std::lock_guard<std::mutex> lock(mutex);
+                failed = true;
+                error = std::current_exception();
+            }
+            block_ready.notify_one();
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (std::size_t idx = 0; idx < num_threads; ++idx) {
+        threads.emplace_back(generate);
+    }
+
+    // Write the blocks in order; the disk is the only thing this thread waits for
+    try {
+        for (std::size_t block = 0; block < num_blocks; ++block) {
+            std::string out;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                block_ready.wait(lock, [&]() { return failed || filled[block % window]; });
+                if (failed) {
+                    break;
+                }
+                out = std::move(slots[block % window]);
+            }
+            write_all(file, out);
+            num_bytes += out.size();
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                filled[block % window] = false;
+                ++next_to_write;
+            }
+            slot_free.notify_all();
+        }
+    }
+    catch (...) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        failed = true;
+        error = std::current_exception();
+    }
+    slot_free.notify_all();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (std::fflush(file) != 0) {
+        throw std::runtime_error("Failed to flush exported questions");
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {options.num_rows, num_bytes, elapsed.count()};
+}
+
+}  // namespace modules::worksheet
@@ -0,0 +1,107 @@
+/**
+ * @file worksheet.hpp
+ *
+ * @brief Bulk export of generated questions (e.g., for printed worksheets and analytics).
+ */
+
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t, std::uint64_t
+#include <cstdio>   // for std::FILE
+
+#include "vocabulary.hpp"
+
+namespace modules::worksheet {
+
+/**
+ * @brief Enum that represents the file format of exported questions.
+ */
+enum class Format {
+    Tsv,   // Tab-separated values with a header row: id, prompt, one column per option, answer (1-based position of the correct option)
+    Jsonl  // One JSON object per line: {"id": 0, "prompt": "ㅏ", "options": ["a", "ya", "eo", "o"], "answer": 1}
+};
+
+/**
+ * @brief Struct that represents the settings of an export.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Options final {
+    /**
+     * @brief Number of questions to export (e.g., "1000000").
+     */
+    std::size_t num_rows;
+
+    /**
+     * @brief Number of options per question, including the correct one (e.g., "4").
+     */
+    std::size_t num_options;
+
+    /**
+     * @brief Seed of the random number generators (e.g., "12345").
+     */
+    std::uint32_t seed;
+
+    /**
+     * @brief Number of generator threads; 0 picks one per hardware thread (e.g., "8").
+     */
+    std::size_t num_threads;
+
+    /**
+     * @brief File format.
+     */
+    Format format;
+};
+
+/**
+ * @brief Struct that represents the result of an export.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Summary final {
+    /**
+     * @brief Number of exported questions (e.g., "1000000").
+     */
+    std::size_t num_rows;
+
+    /**
+     * @brief Number of bytes written (e.g., "41000000").
+     */
+    std::uint64_t num_bytes;
+
+    /**
+     * @brief Wall-clock duration of the export in seconds (e.g., "0.8").
+     */
+    double seconds;
+
+    /**
+     * @brief Get the throughput of the export.
+     *
+     * @return Number of questions per second (e.g., "1250000.0"), or 0.0 if no time was measured.
+     */
+    [[nodiscard]] double get_rows_per_second() const
+    {
+        return this->seconds > 0.0 ? static_cast<double>(this->num_rows) / this->seconds : 0.0;
+    }
+};
+
+/**
+ * @brief Generate questions from the enabled entries of a vocabulary and write them to a file.
+ *
+ * Questions are generated in fixed-size blocks, and each block has its own random number generator seeded from the seed and the block index, so the output depends on the seed alone, not on the number of threads.
+ * Generator threads claim blocks and format them into memory; the calling thread writes the finished blocks in order, one large write per block, while a bounded number of blocks is in flight.
+ *
+ * @param vocabulary Vocabulary to draw the questions and options from; it is only read, so it must not change during the export.
+ * @param options Settings of the export.
+ * @param file File to write to, opened in binary mode (e.g., "stdout").
+ *
+ * @return Summary of the export.
+ *
+ * @throws std::runtime_error If fewer entries than options per question are enabled, or if writing fails.
+ */
+[[nodiscard]] Summary write(const vocabulary::Vocabulary &vocabulary,
+                            const Options &options,
+                            std::FILE *file);
+
+}  // namespace modules::worksheet
@@ -2,21 +2,62 @@
  * @file test_all.cpp
  */
 
+#include <algorithm>      // for std::sort, std::count, std::find_if, std::adjacent_find, std::binary_search, std::equal, std::find
+#include <chrono>         // for std::chrono
+#include <cstdint>        // for std::uint32_t, std::uint64_t
+#include <cstdio>         // for std::FILE, std::tmpfile, std::rewind, std::fread, std::fclose
 #include <cstdlib>        // for EXIT_FAILURE, EXIT_SUCCESS
 #include <exception>      // for std::exception
+#include <filesystem>     // for std::filesystem
+#include <fstream>        // for std::ofstream
 #include <functional>     // for std::function
+#include <limits>         // for std::numeric_limits
+#include <memory>         // for std::make_unique
+#include <optional>       // for std::optional
 #include <random>         // for std::mt19937, std::shuffle
-#include <string>         // for std::string
+#include <set>            // for std::set
+#include <string>         // for std::string, std::u32string
+#include <string_view>    // for std::string_view
+#include <thread>         // for std::thread
 #include <unordered_map>  // for std::unordered_map
+#include <utility>        // for std::move, std::pair
 #include <vector>         // for std::vector
 
 #include <SFML/Graphics.hpp>
 #include <fmt/core.h>
 
 #include "core/assets.hpp"
+#include "core/bitmap.hpp"
+#include "core/csv.hpp"
+#include "core/fenwick.hpp"
+#include "core/file.hpp"
+#include "core/hangul.hpp"
+#include "core/normalization.hpp"
+#include "core/paths.hpp"
+#include "core/perfect_hash.hpp"
+#include "core/pronunciation.hpp"
+#include "core/query.hpp"
+#include "core/recent.hpp"
 #include "core/rng.hpp"
+#include "core/romanization.hpp"
+#include "core/shuffle_bag.hpp"
 #include "core/string.hpp"
+#include "core/trie.hpp"
+#include "core/watch.hpp"
+#include "modules/confusion.hpp"
+#include "modules/deck.hpp"
+#include "modules/exam.hpp"
+#include "modules/history.hpp"
+#include "modules/image.hpp"
+#include "modules/journal.hpp"
+#include "modules/knowledge.hpp"
+#include "modules/profiles.hpp"
+#include "modules/progress.hpp"
+#include "modules/statistics.hpp"
+#include "modules/thompson.hpp"
+#include "modules/typing.hpp"
 #include "modules/vocabulary.hpp"
+#include "modules/worksheet.hpp"
 #if defined(_WIN32)
 #include "core/io.hpp"
 #endif
@@ -25,21 +66,153 @@ namespace test_assets {
 [[nodiscard]] int load_font();
 }
 
+namespace test_bitmap {
+[[nodiscard]] int operations();
+}
+
+namespace test_confusion {
+[[nodiscard]] int dense();
+[[nodiscard]] int sparse();
+[[nodiscard]] int distractors();
+}  // namespace test_confusion
+
+namespace test_csv {
+[[nodiscard]] int parse();
+}
+
+namespace test_deck {
+[[nodiscard]] int import();
+[[nodiscard]] int reload();
+[[nodiscard]] int share();
+}  // namespace test_deck
+
+namespace test_fenwick {
+[[nodiscard]] int tree();
+}
+
+namespace test_file {
+[[nodiscard]] int mapped_file();
+[[nodiscard]] int write_atomically();
+}  // namespace test_file
+
+namespace test_hangul {
+[[nodiscard]] int compose();
+[[nodiscard]] int dubeolsik();
+}  // namespace test_hangul
+
+namespace test_normalization {
+[[nodiscard]] int compose();
+[[nodiscard]] int decompose();
+}  // namespace test_normalization
+
+namespace test_paths {
+[[nodiscard]] int get_data_directory();
+}
+
+namespace test_perfect_hash {
+[[nodiscard]] int find();
+}
+
+namespace test_pronunciation {
+[[nodiscard]] int pronounce();
+}
+
+namespace test_query {
+[[nodiscard]] int evaluate();
+}
+
+namespace test_recent {
+[[nodiscard]] int window();
+[[nodiscard]] int vocabulary();
+}  // namespace test_recent
+
 namespace test_rng {
 [[nodiscard]] int instance();
 [[nodiscard]] int get_random_number();
 [[nodiscard]] int get_random_bool();
+[[nodiscard]] int state();
+[[nodiscard]] int gamma_and_beta();
 }  // namespace test_rng
 
+namespace test_romanization {
+[[nodiscard]] int romanize();
+}
+
+namespace test_shuffle_bag {
+[[nodiscard]] int rounds();
+[[nodiscard]] int insert_and_erase();
+}  // namespace test_shuffle_bag
+
 namespace test_string {
 [[nodiscard]] int to_sfml_string();
+[[nodiscard]] int utf8_to_utf32();
 }
 
+namespace test_trie {
+[[nodiscard]] int match();
+}  // namespace test_trie
+
 namespace test_vocabulary {
 [[nodiscard]] int entry();
 [[nodiscard]] int category_count();
+[[nodiscard]] int question_options();
+[[nodiscard]] int tags();
+[[nodiscard]] int query();
+[[nodiscard]] int update();
 }  // namespace test_vocabulary
 
+namespace test_history {
+[[nodiscard]] int accuracy_and_streak();
+[[nodiscard]] int weakest();
+}  // namespace test_history
+
+namespace test_journal {
+[[nodiscard]] int append_and_recover();
+[[nodiscard]] int torn_tail();
+[[nodiscard]] int checkpoint();
+}  // namespace test_journal
+
+namespace test_knowledge {
+[[nodiscard]] int update();
+[[nodiscard]] int rebuild();
+}  // namespace test_knowledge
+
+namespace test_profiles {
+[[nodiscard]] int find();
+}  // namespace test_profiles
+
+namespace test_progress {
+[[nodiscard]] int compaction();
+[[nodiscard]] int replay_tail();
+[[nodiscard]] int settings();
+[[nodiscard]] int remap();
+[[nodiscard]] int grow();
+[[nodiscard]] int corrupt();
+[[nodiscard]] int lock();
+}  // namespace test_progress
+
+namespace test_thompson {
+[[nodiscard]] int pick();
+}  // namespace test_thompson
+
+namespace test_statistics {
+[[nodiscard]] int record();
+[[nodiscard]] int concurrent();
+}  // namespace test_statistics
+
+namespace test_exam {
+[[nodiscard]] int coverage();
+[[nodiscard]] int seed();
+}  // namespace test_exam
+
+namespace test_worksheet {
+[[nodiscard]] int write();
+}  // namespace test_worksheet
+
+namespace test_typing {
+[[nodiscard]] int feedback();
+}  // namespace test_typing
+
 /**
  * @brief Entry-point of the test application.
  *
@@ -77,12 +250,66 @@ int main(int argc,
     // Otherwise, define argument to function mapping
     const std::unordered_map<std::string, std::function<int()>> tests = {
         {"test_assets::load_font", test_assets::load_font},
+        {"test_bitmap::operations", test_bitmap::operations},
+        {"test_confusion::dense", test_confusion::dense},
+        {"test_confusion::sparse", test_confusion::sparse},
+        {"test_confusion::distractors", test_confusion::distractors},
+        {"test_csv::parse", test_csv::parse},
+        {"test_deck::import", test_deck::import},
+        {"test_deck::reload", test_deck::reload},
+        {"test_deck::share", test_deck::share},
+        {"test_fenwick::tree", test_fenwick::tree},
+        {"test_file::mapped_file", test_file::mapped_file},
+        {"test_file::write_atomically", test_file::write_atomically},
+        {"test_hangul::compose", test_hangul::compose},
+        {"test_hangul::dubeolsik", test_hangul::dubeolsik},
+        {"test_normalization::compose", test_normalization::compose},
+        {"test_normalization::decompose", test_normalization::decompose},
+        {"test_paths::get_data_directory", test_paths::get_data_directory},
+        {"test_perfect_hash::find", test_perfect_hash::find},
+        {"test_pronunciation::pronounce", test_pronunciation::pronounce},
+        {"test_query::evaluate", test_query::evaluate},
+        {"test_recent::window", test_recent::window},
+        {"test_recent::vocabulary", test_recent::vocabulary},
         {"test_rng::instance", test_rng::instance},
         {"test_rng::get_random_number", test_rng::get_random_number},
         {"test_rng::get_random_bool", test_rng::get_random_bool},
+        {"test_rng::state", test_rng::state},
+        {"test_rng::gamma_and_beta", test_rng::gamma_and_beta},
+        {"test_romanization::romanize", test_romanization::romanize},
+        {"test_shuffle_bag::rounds", test_shuffle_bag::rounds},
+        {"test_shuffle_bag::insert_and_erase", test_shuffle_bag::insert_and_erase},
         {"test_string::to_sfml_string", test_string::to_sfml_string},
+        {"test_string::utf8_to_utf32", test_string::utf8_to_utf32},
+        {"test_trie::match", test_trie::match},
         {"test_vocabulary::entry", test_vocabulary::entry},
         {"test_vocabulary::category_count", test_vocabulary::category_count},
+        {"test_vocabulary::question_options", test_vocabulary::question_options},
+        {"test_vocabulary::tags", test_vocabulary::tags},
+        {"test_vocabulary::query", test_vocabulary::query},
+        {"test_vocabulary::update", test_vocabulary::update},
+        {"test_history::accuracy_and_streak", test_history::accuracy_and_streak},
+        {"test_history::weakest", test_history::weakest},
+        {"test_journal::append_and_recover", test_journal::append_and_recover},
+        {"test_journal::torn_tail", test_journal::torn_tail},
+        {"test_journal::checkpoint", test_journal::checkpoint},
+        {"test_knowledge::update", test_knowledge::update},
+        {"test_knowledge::rebuild", test_knowledge::rebuild},
+        {"test_profiles::find", test_profiles::find},
+        {"test_progress::compaction", test_progress::compaction},
+        {"test_progress::replay_tail", test_progress::replay_tail},
+        {"test_progress::settings", test_progress::settings},
+        {"test_progress::remap", test_progress::remap},
+        {"test_progress::grow", test_progress::grow},
+        {"test_progress::corrupt", test_progress::corrupt},
+        {"test_progress::lock", test_progress::lock},
+        {"test_statistics::record", test_statistics::record},
+        {"test_statistics::concurrent", test_statistics::concurrent},
+        {"test_thompson::pick", test_thompson::pick},
+        {"test_exam::coverage", test_exam::coverage},
+        {"test_exam::seed", test_exam::seed},
+        {"test_worksheet::write", test_worksheet::write},
+        {"test_typing::feedback", test_typing::feedback},
     };
 
     // Get the test name from the command-line arguments
@@ -150,131 +377,2886 @@ int test_assets::load_font()
     }
 }
 
-int test_rng::instance()
+int test_bitmap::operations()
 {
     try {
-        // Define a vector of cars
-        std::vector<std::string> cars = {"Nissan Skyline GT-R R32", "Toyota Supra Mk4", "Mazda RX-7 FD", "Honda NSX"};
+        // Random sets over three chunks, from sparse arrays to dense bitsets, are checked against std::set
+        std::mt19937 engine(42);
+        const auto make_set = [&engine](const std::uint32_t modulus,
+                                        const std::size_t count) {
+            std::set<std::uint32_t> values;
+            for (std::size_t idx = 0; idx < count; ++idx) {
+                values.insert(static_cast<std::uint32_t>(engine() % modulus));
+            }
+            return values;
+        };
+        const auto make_bitmap = [](const std::set<std::uint32_t> &values) {
+            core::bitmap::Bitmap bitmap;
+            for (const std::uint32_t value : values) {
+                bitmap.add(value);
+            }
+            return bitmap;
+        };
+        const auto check = [](const core::bitmap::Bitmap &bitmap,
+                              const std::set<std::uint32_t> &expected,
+                              const std::string_view name) {
+            const std::vector<std::uint32_t> values = bitmap.to_vector();
+            if (bitmap.get_cardinality() != expected.size() || !std::equal(values.cbegin(), values.cend(), expected.cbegin(), expected.cend())) {
+                throw std::runtime_error(fmt::format("{} has '{}' integers, expected '{}'", name, bitmap.get_cardinality(), expected.size()));
+            }
+            std::size_t rank = 0;
+            for (const std::uint32_t value : expected) {
+                if (!bitmap.contains(value) || bitmap.select(rank++) != value) {
+                    throw std::runtime_error(fmt::format("{} does not find '{}' at rank '{}'", name, value, rank - 1));
+                }
+            }
+            if (bitmap.select(expected.size()).has_value()) {
+                throw std::runtime_error(fmt::format("{} selects past its cardinality", name));
+            }
+        };
+        for (const std::size_t count : {100u, 3000u, 5000u, 60000u, 150000u}) {
+            const std::set<std::uint32_t> lhs = make_set(3 * 65536, count);
+            const std::set<std::uint32_t> rhs = make_set(3 * 65536, count / 2 + 10);
+            std::set<std::uint32_t> both;
+            std::set<std::uint32_t> either = lhs;
+            std::set<std::uint32_t> only = lhs;
+            for (const std::uint32_t value : rhs) {
+                either.insert(value);
+                only.erase(value);
+                if (lhs.count(value) != 0) {
+                    both.insert(value);
+                }
+            }
+            const core::bitmap::Bitmap lhs_bitmap = make_bitmap(lhs);
+            const core::bitmap::Bitmap rhs_bitmap = make_bitmap(rhs);
+            check(lhs_bitmap, lhs, "Bitmap");
+            check(lhs_bitmap & rhs_bitmap, both, "AND");
+            check(lhs_bitmap | rhs_bitmap, either, "OR");
+            check(lhs_bitmap - rhs_bitmap, only, "AND NOT");
+            if ((lhs_bitmap | rhs_bitmap) != (rhs_bitmap | lhs_bitmap) || ((lhs_bitmap - rhs_bitmap) == lhs_bitmap) != both.empty()) {
+                throw std::runtime_error(fmt::format("Bitmaps of '{}' integers are not compared by content", count));
+            }
 
-        // Shuffle the cars using the random number generator
-        std::mt19937 &rng = core::rng::RNG::instance();
-        std::shuffle(cars.begin(), cars.end(), rng);
-        fmt::print("core::rng::RNG::instance() passed.\n");
+            // Removing every integer of the other set turns dense chunks back into arrays, and the result equals AND NOT
+            core::bitmap::Bitmap removed = lhs_bitmap;
+            for (const std::uint32_t value : rhs) {
+                removed.remove(value);
+            }
+            if (removed != (lhs_bitmap - rhs_bitmap)) {
+                throw std::runtime_error(fmt::format("Removing from '{}' integers does not match AND NOT", count));
+            }
+            check(removed, only, "Removal");
+        }
+
+        // Operations with itself and with an empty bitmap
+        core::bitmap::Bitmap bitmap = make_bitmap(make_set(1000000, 10000));
+        const core::bitmap::Bitmap copy = bitmap;
+        bitmap &= bitmap;
+        bitmap |= bitmap;
+        if (bitmap != copy || (bitmap | core::bitmap::Bitmap()) != copy || (bitmap & core::bitmap::Bitmap()).get_cardinality() != 0) {
+            throw std::runtime_error("Operations with itself or an empty bitmap changed the result");
+        }
+        bitmap -= bitmap;
+        if (bitmap.get_cardinality() != 0 || bitmap != core::bitmap::Bitmap()) {
+            throw std::runtime_error("Subtracting a bitmap from itself did not empty it");
+        }
+        fmt::print("core::bitmap::Bitmap operations passed.\n");
         return EXIT_SUCCESS;
     }
     catch (const std::exception &e) {
-        fmt::print(stderr, "core::rng::RNG::instance() failed: {}\n", e.what());
+        fmt::print(stderr, "core::bitmap::Bitmap operations failed: {}\n", e.what());
         return EXIT_FAILURE;
     }
 }
 
-int test_rng::get_random_number()
+int test_confusion::dense()
 {
     try {
-        // Generate random numbers
-        constexpr int min = 0;
-        constexpr int max = 10;
-        const int random_number = core::rng::RNG::get_random_number<int>(min, max);
-        if (random_number < min || random_number > max) {
-            throw std::runtime_error(fmt::format("The actual random number '{}' is not in the range [{}, {}]", random_number, min, max));
+        modules::confusion::Confusion confusion(10);
+        if (!confusion.is_dense()) {
+            throw std::runtime_error("A small deck does not use a dense matrix");
         }
-        fmt::print("core::rng::RNG::get_random_number() passed.\n");
+        for (std::size_t idx = 0; idx < 3; ++idx) {
+            confusion.record(1, 4);
+        }
+        confusion.record(1, 2);
+        confusion.record(1, 1);   // Equal IDs, ignored
+        confusion.record(1, 10);  // Out of range, ignored
+        confusion.add({1, 7, 2});
+
+        if (confusion.get_count(1, 4) != 3 || confusion.get_count(4, 1) != 0) {
+            throw std::runtime_error(fmt::format("Entry 1 was mistaken for entry 4 '{}' times, expected '3'", confusion.get_count(1, 4)));
+        }
+        if (confusion.get_confusions(1) != std::vector<std::size_t>{4, 7, 2}) {
+            throw std::runtime_error("The confusions of entry 1 are not ordered by frequency");
+        }
+        if (confusion.get_pairs().size() != 3) {
+            throw std::runtime_error(fmt::format("Got '{}' pairs, expected '3'", confusion.get_pairs().size()));
+        }
+        fmt::print("modules::confusion::Confusion dense matrix passed.\n");
         return EXIT_SUCCESS;
     }
     catch (const std::exception &e) {
-        fmt::print(stderr, "core::rng::RNG::get_random_number() failed: {}\n", e.what());
+        fmt::print(stderr, "modules::confusion::Confusion dense matrix failed: {}\n", e.what());
         return EXIT_FAILURE;
     }
 }
 
-int test_rng::get_random_bool()
+int test_confusion::sparse()
 {
     try {
-        // Generate random boolean values
-        constexpr double probability = 0.5;
-        const bool random_bool = core::rng::RNG::get_random_bool(probability);
-        static_cast<void>(random_bool);  // Ignore [[nodiscard]] attribute
-        fmt::print("core::rng::RNG::get_random_bool() passed.\n");
+        // A deck of 11k syllables with room for only 1000 pairs
+        constexpr std::size_t num_entries = 11172;
+        constexpr std::size_t max_pairs = 1000;
+        modules::confusion::Confusion confusion(num_entries, 256, max_pairs);
+        if (confusion.is_dense()) {
+            throw std::runtime_error("A large deck uses a dense matrix");
+        }
+
+        // One frequent mistake among many one-off mistakes
+        for (std::size_t idx = 0; idx < 50000; ++idx) {
+            confusion.record(idx % num_entries, (idx * 7 + 1) % num_entries);
+            if (idx % 10 == 0) {
+                confusion.record(5, 6);
+            }
+        }
+        const auto pairs = confusion.get_pairs();
+        if (pairs.size() > max_pairs) {
+            throw std::runtime_error(fmt::format("Kept '{}' pairs, expected at most '{}'", pairs.size(), max_pairs));
+        }
+        if (confusion.get_count(5, 6) == 0 || confusion.get_confusions(5).empty() || confusion.get_confusions(5).front() != 6) {
+            throw std::runtime_error("The frequent mistake was evicted");
+        }
+        fmt::print("modules::confusion::Confusion sparse table passed.\n");
         return EXIT_SUCCESS;
     }
     catch (const std::exception &e) {
-        fmt::print(stderr, "core::rng::RNG::get_random_bool() failed: {}\n", e.what());
+        fmt::print(stderr, "modules::confusion::Confusion sparse table failed: {}\n", e.what());
         return EXIT_FAILURE;
     }
 }
 
-int test_string::to_sfml_string()
+int test_confusion::distractors()
 {
     try {
-        // Convert a UTF-8 string to an SFML string
-        const std::string utf8_str = "Dzień dobry";
-        const sf::String sfml_str = core::string::to_sfml_string(utf8_str);
-        if (sfml_str.isEmpty()) {
-            throw std::runtime_error("The SFML string is empty");
+        modules::vocabulary::Vocabulary vocabulary;
+        const modules::vocabulary::Entry correct_entry = vocabulary.get_entry(0);
+        const std::size_t confused_id = vocabulary.get_num_entries() - 1;
+
+        // Without confusions, each of the other entries is an option about 3 / (N - 1) of the time
+        constexpr std::size_t num_trials = 1000;
+        std::size_t num_plain = 0;
+        std::size_t num_confused = 0;
+        for (std::size_t idx = 0; idx < num_trials; ++idx) {
+            for (const auto &option : vocabulary.generate_enabled_question_options(correct_entry)) {
+                num_plain += option.id == confused_id;
+            }
+            for (const auto &option : vocabulary.generate_enabled_question_options(correct_entry, 4, {confused_id})) {
+                num_confused += option.id == confused_id;
+            }
         }
-        fmt::print("core::string::to_sfml_string() passed.\n");
+        if (num_confused < num_trials / 3 || num_confused <= num_plain * 3) {
+            throw std::runtime_error(fmt::format("The confused entry was an option '{}' times, against '{}' times without confusions", num_confused, num_plain));
+        }
+
+        // With 2 options, the only wrong option is left to chance, so the confusion gets no better chance
+        std::size_t num_pair_plain = 0;
+        std::size_t num_pair_confused = 0;
+        for (std::size_t idx = 0; idx < num_trials; ++idx) {
+            for (const auto &option : vocabulary.generate_enabled_question_options(correct_entry, 2)) {
+                num_pair_plain += option.id == confused_id;
+            }
+            for (const auto &option : vocabulary.generate_enabled_question_options(correct_entry, 2, {confused_id})) {
+                num_pair_confused += option.id == confused_id;
+            }
+        }
+        if (num_pair_confused > num_pair_plain * 2 + num_trials / 20) {
+            throw std::runtime_error(fmt::format("The confused entry was one of 2 options '{}' times, against '{}' times without confusions", num_pair_confused, num_pair_plain));
+        }
+        fmt::print("modules::vocabulary::Vocabulary confusion distractors passed.\n");
         return EXIT_SUCCESS;
     }
     catch (const std::exception &e) {
-        fmt::print(stderr, "core::string::to_sfml_string() failed: {}\n", e.what());
+        fmt::print(stderr, "modules::vocabulary::Vocabulary confusion distractors failed: {}\n", e.what());
         return EXIT_FAILURE;
     }
 }
 
-int test_vocabulary::entry()
+int test_csv::parse()
 {
     try {
-        // Create a vocabulary entry
-        const modules::vocabulary::Entry entry = {"ㅏ", "a", "Looks like an 'a' without the crossbar", modules::vocabulary::Category::BasicVowel};
-        if (entry.hangul != "ㅏ") {
-            throw std::runtime_error(fmt::format("The actual Korean character '{}' is not equal to expected 'ㅏ'", entry.hangul));
+        const auto check_row = [](const core::csv::Table &table,
+                                  const std::size_t row,
+                                  const std::vector<std::string> &expected) {
+            if (table.get_num_fields(row) != expected.size()) {
+                throw std::runtime_error(fmt::format("Row '{}' has '{}' fields, expected '{}'", row, table.get_num_fields(row), expected.size()));
+            }
+            for (std::size_t column = 0; column < expected.size(); ++column) {
+                if (table.get_field(row, column) != expected[column]) {
+                    throw std::runtime_error(fmt::format("Field '{}' of row '{}' is '{}', expected '{}'", column, row, table.get_field(row, column), expected[column]));
+                }
+            }
+        };
+
+        // Quoting, doubled quotes, line breaks in quotes, CRLF, blank lines, and a missing final line break
+        const core::csv::Table table("\xEF\xBB\xBFㅏ,a,\"Looks like \"\"a\"\", without the bar\"\r\n\r\n\"ㅑ\",\"ya\nyah\",\n\nㅓ,eo\"x,\"\",tail\"q\"", ',');
+        if (table.get_num_rows() != 3) {
+            throw std::runtime_error(fmt::format("The table has '{}' rows, expected '3'", table.get_num_rows()));
         }
-        if (entry.latin != "a") {
-            throw std::runtime_error(fmt::format("The actual Latin transliteration '{}' is not equal to expected 'a'", entry.latin));
+        check_row(table, 0, {"ㅏ", "a", "Looks like \"a\", without the bar"});
+        check_row(table, 1, {"ㅑ", "ya\nyah", ""});
+        check_row(table, 2, {"ㅓ", "eo\"x", "", "tail\"q\""});
+        if (table.get_line(0) != 1 || table.get_line(1) != 3 || table.get_line(2) != 6 || table.get_field(0, 9) != "" || table.get_field(9, 0) != "") {
+            throw std::runtime_error(fmt::format("Rows start on lines '{}', '{}' and '{}', expected '1', '3' and '6'", table.get_line(0), table.get_line(1), table.get_line(2)));
         }
-        if (entry.memo != "Looks like an 'a' without the crossbar") {
-            throw std::runtime_error(fmt::format("The actual memo '{}' is not equal to expected 'Looks like an 'a' without the crossbar'", entry.memo));
+
+        // Long fields cross the 16-byte blocks of the scan, and Anki header lines give the delimiter
+        std::string long_text = "#separator:tab\n#html:false\n";
+        std::vector<std::string> expected;
+        for (std::size_t idx = 0; idx < 50; ++idx) {
+            expected.emplace_back(std::string(idx, 'x') + (idx % 3 == 0 ? "한글" : "") + std::string(idx % 7, ','));
+            long_text += expected.back() + (idx % 10 == 9 ? "\n" : "\t");
         }
-        if (entry.category != modules::vocabulary::Category::BasicVowel) {
-            throw std::runtime_error(fmt::format("The actual category '{}' is not equal to expected 'Category::BasicVowel'", static_cast<int>(entry.category)));
+        if (core::csv::detect_delimiter(long_text) != '\t' || core::csv::detect_delimiter("a;b;c,d\n") != ';' || core::csv::detect_delimiter("abc") != ',') {
+            throw std::runtime_error("The delimiter was not detected");
         }
-        fmt::print("modules::vocabulary::Entry passed.\n");
+        const core::csv::Table long_table(long_text, '\t');
+        for (std::size_t row = 0; row < 5; ++row) {
+            check_row(long_table, row, std::vector<std::string>(expected.cbegin() + static_cast<std::ptrdiff_t>(row * 10), expected.cbegin() + static_cast<std::ptrdiff_t>(row * 10 + 10)));
+        }
+
+        // Invalid UTF-8 (a truncated sequence, an overlong form, a surrogate) and unterminated quotes report their line
+        for (const auto &[text, message] : std::vector<std::pair<std::string, std::string>>{{"a,b\n\xED\x95,c\n", "Invalid UTF-8 on line 2"},
+                                                                                            {"a,b\nc,\"\xC0\xAF\"\n", "Invalid UTF-8 on line 2"},
+                                                                                            {"a\n\n\xED\xA0\x80\n", "Invalid UTF-8 on line 3"},
+                                                                                            {"a,b\n\"c\nd,e\n", "Unterminated quoted field on line 2"}}) {
+            bool threw = false;
+            try {
+                const core::csv::Table invalid(text, ',');
+            }
+            catch (const std::runtime_error &e) {
+                threw = e.what() == message;
+            }
+            if (!threw) {
+                throw std::runtime_error(fmt::format("Invalid text did not fail with '{}'", message));
+            }
+        }
+        fmt::print("core::csv::Table passed.\n");
         return EXIT_SUCCESS;
     }
     catch (const std::exception &e) {
-        fmt::print(stderr, "modules::vocabulary::Entry failed: {}\n", e.what());
+        fmt::print(stderr, "core::csv::Table failed: {}\n", e.what());
         return EXIT_FAILURE;
     }
 }
 
-int test_vocabulary::category_count()
+int test_deck::import()
 {
     try {
-        // Create a vocabulary object
-        modules::vocabulary::Vocabulary vocabulary;
+        // A TSV export with a header, tags, and a row without memo or tags
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "aegyo_test_deck.tsv";
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << "korean\tlatin\tmemo\ttags\n"
+                << "한국\thanguk\tKorea\tnoun  lesson:1\n"
+                << "사랑\tsarang\t\"Love, as in \"\"I love you\"\"\"\tnoun lesson:2\n"
+                << "가다\tgada\n"
+                << "먹다\tmeokda\tTo eat\tverb lesson:2 category:dcon\n";
+        }
+        modules::deck::Options options;
+        options.has_header = true;
+        options.category = modules::vocabulary::Category::BasicConsonant;
+        std::vector<modules::vocabulary::Entry> entries;
+        const auto summary = modules::deck::import(path, options, entries);
+        if (summary.num_rows != 4 || entries.size() != 4 || summary.num_bytes != std::filesystem::file_size(path)) {
+            throw std::runtime_error(fmt::format("Imported '{}' entries, expected '4'", entries.size()));
+        }
+        if (entries[1].memo != "Love, as in \"I love you\"" || entries[2].memo != "" || !entries[2].tags.empty() || entries[0].tags != std::vector<std::string>{"noun", "lesson:1"} || entries[0].category != modules::vocabulary::Category::BasicConsonant || entries[3].category != modules::vocabulary::Category::DoubleConsonant) {
+            throw std::runtime_error("The fields of the entries were not imported");
+        }
 
-        // Map to store the count of entries for each category
-        std::unordered_map<modules::vocabulary::Category, std::size_t> category_counts;
+        // The vocabulary indexes the imported entries by character and by tag
+        modules::vocabulary::Vocabulary vocabulary(entries);
+        vocabulary.set_query("noun & lesson>=2 | verb");
+        if (vocabulary.find_id("가다") != 2u || vocabulary.get_num_enabled() != 2 || !vocabulary.is_enabled(1) || !vocabulary.is_enabled(3)) {
+            throw std::runtime_error(fmt::format("The imported vocabulary has '{}' enabled entries, expected '2'", vocabulary.get_num_enabled()));
+        }
 
-        // Count the number of entries for each category
-        for (const auto &entry : vocabulary.get_entries()) {
-            ++category_counts[entry.category];
+        // A row without a transliteration is rejected with its line and the path
+        std::vector<modules::vocabulary::Entry> rejected;
+        bool threw = false;
+        try {
+            static_cast<void>(modules::deck::parse("ㅏ,a\n\n\"ㅓ\",\"\"\n", {}, rejected));
+        }
+        catch (const std::runtime_error &e) {
+            threw = std::string(e.what()) == "Line 3 has no transliteration in column 2";
+        }
+        if (!threw) {
+            throw std::runtime_error("A row without a transliteration was accepted");
         }
 
-        // Ensure each category has more than 3 entries
-        const std::size_t min_category_entries = 4;
-        for (const auto &[category, count] : category_counts) {
-            if (count < min_category_entries) {
-                throw std::runtime_error(fmt::format("Category '{}' has less than {} entries (found {})", static_cast<int>(category), min_category_entries, count));
+        // So is a row whose category tag names no category
+        threw = false;
+        try {
+            static_cast<void>(modules::deck::parse("ㅏ,a,,category:vow\nㄲ,kk,,category:double\n", {}, rejected));
+        }
+        catch (const std::runtime_error &e) {
+            threw = std::string(e.what()).rfind("Line 2 has unknown category tag 'category:double'", 0) == 0;
+        }
+        std::filesystem::remove(path);
+        if (!threw) {
+            throw std::runtime_error("A row with an unknown category tag was accepted");
+        }
+        threw = false;
+        try {
+            static_cast<void>(modules::deck::import(path, {}, rejected));
+        }
+        catch (const std::runtime_error &e) {
+            threw = std::string(e.what()).find(path.string()) != std::string::npos;
+        }
+        if (!threw) {
+            throw std::runtime_error("A missing file did not fail with its path");
+        }
+        fmt::print("modules::deck::import() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::deck::import() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_deck::reload()
+{
+    try {
+        // Comparing a deck with itself finds nothing, even if the characters are encoded differently
+        const std::vector<modules::vocabulary::Entry> deck = {{"한", "han", "", modules::vocabulary::Category::BasicVowel, {"noun"}}};
+        const std::vector<modules::vocabulary::Entry> decomposed = {{core::normalization::decompose("한"), "han", "", modules::vocabulary::Category::BasicVowel, {"noun"}}};
+        if (!modules::deck::diff(modules::image::Image(deck), modules::image::Image(decomposed)).is_empty()) {
+            throw std::runtime_error("Identical decks have changes");
+        }
+
+        // Both watch modes see an edit that changes a row, removes one and adds one
+        for (const core::watch::Mode mode : {core::watch::Mode::Auto, core::watch::Mode::Polling}) {
+            const std::filesystem::path path = std::filesystem::temp_directory_path() / "aegyo_test_reload.tsv";
+            const std::filesystem::path image_path = std::filesystem::temp_directory_path() / "aegyo_test_reload.img";
+            const auto write = [&path](const std::string &contents) {
+                std::ofstream out(path, std::ios::binary | std::ios::trunc);
+                out << contents;
+            };
+            write("한국\thanguk\tKorea\tnoun\n사랑\tsarang\tLove\tnoun\n가다\tgada\n");
+            const modules::image::Image image = modules::deck::load(path, {}, image_path);
+            modules::vocabulary::Vocabulary vocabulary(image);
+            modules::deck::Reloader reloader(path, {}, image_path, image, mode);
+            if (reloader.poll().has_value()) {
+                throw std::runtime_error("An unchanged deck was reloaded");
             }
-            fmt::print("modules::vocabulary::Vocabulary: Category '{}' has {} entries.\n", static_cast<int>(category), count);
+
+            write("한국\thanguk\tThe country\tnoun\n가다\tgada\n먹다\tmeokda\tTo eat\tverb\n");
+            std::optional<modules::vocabulary::Update> update;
+            for (int attempt = 0; attempt < 500 && !update.has_value(); ++attempt) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                update = reloader.poll();
+            }
+            std::filesystem::remove(path);
+            std::filesystem::remove(image_path);
+            if (!update.has_value() || update->entries.size() != 2 || update->removed != std::vector<std::string>{"사랑"}) {
+                throw std::runtime_error(fmt::format("The edited deck was not reloaded in mode '{}'", static_cast<int>(mode)));
+            }
+
+            // Entries keep their IDs, so statistics indexed by ID stay with them
+            if (!vocabulary.update(*update) || vocabulary.find_id("한국") != 0u || vocabulary.find_id("가다") != 2u || vocabulary.find_id("먹다") != 3u || vocabulary.find_id("사랑").has_value()) {
+                throw std::runtime_error("The reloaded entries did not keep their IDs");
+            }
+            if (vocabulary.get_entry(0).memo != "The country" || vocabulary.get_num_enabled() != 3 || vocabulary.is_enabled(1)) {
+                throw std::runtime_error("The reloaded entries were not applied");
+            }
+        }
+        fmt::print("modules::deck::Reloader passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::deck::Reloader failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_deck::share()
+{
+    try {
+        using modules::vocabulary::Category;
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "aegyo_test_share.tsv";
+        const std::filesystem::path image_path = std::filesystem::temp_directory_path() / "aegyo_test_share.img";
+        std::filesystem::remove(image_path);
+        const auto write = [](const std::filesystem::path &target, const std::string &contents) {
+            std::ofstream out(target, std::ios::binary | std::ios::trunc);
+            out << contents;
+        };
+        const auto check_entry = [](const modules::image::Image &image,
+                                    const std::size_t id,
+                                    const modules::vocabulary::Entry &expected) {
+            const modules::vocabulary::Entry entry = image.get_entry(id);
+            if (entry.hangul != expected.hangul || entry.latin != expected.latin || entry.memo != expected.memo || entry.category != expected.category || entry.tags != expected.tags || entry.id != id) {
+                throw std::runtime_error(fmt::format("Entry '{}' of the image is '{}', expected '{}'", id, entry.hangul, expected.hangul));
+            }
+        };
+
+        // An image keeps every field, with the Korean text in canonical form and shared tags stored once
+        const std::vector<modules::vocabulary::Entry> entries = {
+            {core::normalization::decompose("한국"), "hanguk", "Korea", Category::BasicConsonant, {"noun", "lesson:1"}},
+            {"사랑", "sarang", "", Category::CompoundVowel, {"noun"}},
+            {"가다", "gada", "To go", Category::BasicVowel, {}}};
+        const modules::image::Image compiled(entries);
+        if (compiled.is_mapped() || compiled.get_num_entries() != 3 || compiled.get_hangul(0) != "한국" || compiled.get_tags(1) != std::vector<std::string_view>{"noun"}) {
+            throw std::runtime_error("The compiled image does not match its entries");
         }
 
-        fmt::print("modules::vocabulary::Vocabulary passed.\n");
+        // A saved image maps to the same entries, and a truncated one is rejected
+        compiled.save(image_path);
+        const modules::image::Image mapped(image_path);
+        if (!mapped.is_mapped() || mapped.get_size() != compiled.get_size() || mapped.get_num_entries() != 3) {
+            throw std::runtime_error("The mapped image does not match the saved one");
+        }
+        check_entry(mapped, 0, {"한국", "hanguk", "Korea", Category::BasicConsonant, {"noun", "lesson:1"}});
+        check_entry(mapped, 1, entries[1]);
+        check_entry(mapped, 2, entries[2]);
+        std::filesystem::resize_file(image_path, compiled.get_size() - 1);
+        bool threw = false;
+        try {
+            static_cast<void>(modules::image::Image(image_path));
+        }
+        catch (const std::runtime_error &) {
+            threw = true;
+        }
+        if (!threw) {
+            throw std::runtime_error("A truncated image was mapped");
+        }
+
+        // Loading a deck writes its image once, replacing the truncated one, and maps it from then on, until the deck or the options change
+        write(path, "한국\thanguk\tKorea\tnoun\n가다\tgada\n");
+        const modules::image::Image first = modules::deck::load(path, {}, image_path);
+        const auto written_at = std::filesystem::last_write_time(image_path);
+        const modules::image::Image second = modules::deck::load(path, {}, image_path);
+        if (!first.is_mapped() || !second.is_mapped() || std::filesystem::last_write_time(image_path) != written_at || second.get_latin(1) != "gada") {
+            throw std::runtime_error("The image of an unchanged deck was not reused");
+        }
+        modules::deck::Options options;
+        options.category = Category::DoubleConsonant;
+        if (modules::deck::load(path, options, image_path).get_category(0) != Category::DoubleConsonant) {
+            throw std::runtime_error("The image was reused with other options");
+        }
+        write(path, "한국\thanguk\tThe country\tnoun\n가다\tgada\n먹다\tmeokda\n");
+        std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+        const modules::image::Image edited = modules::deck::load(path, {}, image_path);
+        if (edited.get_num_entries() != 3 || edited.get_memo(0) != "The country") {
+            throw std::runtime_error("The image of an edited deck was reused");
+        }
+
+        // A vocabulary reads the mapped entries in place, and copies that outlive the vocabulary keep the mapping alive
+        std::optional<modules::vocabulary::Entry> picked;
+        {
+            modules::vocabulary::Vocabulary vocabulary(edited);
+            if (vocabulary.find_id("먹다") != 2u || vocabulary.get_hangul(2) != "먹다" || vocabulary.get_latin(0) != "hanguk" || !vocabulary.get_image().is_mapped()) {
+                throw std::runtime_error("The vocabulary does not read the mapped entries");
+            }
+            picked = vocabulary.get_enabled_entry(2);
+        }
+        std::filesystem::remove(path);
+        std::filesystem::remove(image_path);
+        if (!picked.has_value() || picked->latin != "meokda" || edited.get_hangul(2) != "먹다") {
+            throw std::runtime_error("An entry did not outlive its vocabulary");
+        }
+        fmt::print("modules::deck::load() passed.\n");
         return EXIT_SUCCESS;
     }
     catch (const std::exception &e) {
-        fmt::print(stderr, "modules::vocabulary::Vocabulary failed: {}\n", e.what());
+        fmt::print(stderr, "modules::deck::load() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_fenwick::tree()
+{
+    try {
+        // Items 0, 2 and 5 weigh 1, 2 and 3, so the running sums end at 1, 3 and 6
+        core::fenwick::FenwickTree tree(7);
+        tree.set(0, 1.0);
+        tree.set(2, 2.0);
+        tree.set(5, 3.0);
+        tree.set(9, 5.0);
+        if (tree.get_total() != 6.0 || tree.get(2) != 2.0 || tree.get(9) != 0.0) {
+            throw std::runtime_error(fmt::format("The total weight is '{}', expected '6'", tree.get_total()));
+        }
+        for (const auto &[point, expected] : std::vector<std::pair<double, std::size_t>>{{0.0, 0}, {0.99, 0}, {1.0, 2}, {2.5, 2}, {3.0, 5}, {5.99, 5}}) {
+            if (const std::size_t item = tree.find(point); item != expected) {
+                throw std::runtime_error(fmt::format("Point '{}' found item '{}', expected '{}'", point, item, expected));
+            }
+        }
+
+        // Changing a weight, growing the tree, and many changes (which rebuild the tree) keep the sums exact
+        tree.set(2, 0.0);
+        tree.reserve(12);
+        tree.set(11, 4.0);
+        if (tree.get_size() != 12 || tree.get_total() != 8.0 || tree.find(1.0) != 5 || tree.find(4.0) != 11) {
+            throw std::runtime_error("The tree does not match its weights after a change and a growth");
+        }
+        for (std::size_t idx = 0; idx < 100; ++idx) {
+            tree.set(idx % 12, static_cast<double>(idx % 5));
+        }
+        double total = 0.0;
+        for (std::size_t item = 0; item < tree.get_size(); ++item) {
+            total += tree.get(item);
+        }
+        if (tree.get_total() != total) {
+            throw std::runtime_error(fmt::format("The total weight is '{}', expected '{}'", tree.get_total(), total));
+        }
+        fmt::print("core::fenwick::FenwickTree passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::fenwick::FenwickTree failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_file::mapped_file()
+{
+    try {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "aegyo_test_mapped_file.bin";
+        const std::string contents = "한국어 mapped file";
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << contents;
+        }
+
+        // Map the file and compare its contents
+        const core::file::MappedFile mapping(path);
+        const std::string mapped(reinterpret_cast<const char *>(mapping.get_data()), mapping.get_size());
+        if (mapped != contents) {
+            throw std::runtime_error(fmt::format("The mapped contents '{}' are not equal to expected '{}'", mapped, contents));
+        }
+
+        // Moving the mapping should leave the source empty
+        core::file::MappedFile moved = core::file::MappedFile(path);
+        core::file::MappedFile other = std::move(moved);
+        if (moved.get_data() != nullptr || moved.get_size() != 0 || other.get_size() != contents.size()) {
+            throw std::runtime_error("Moving the mapping did not transfer ownership");
+        }
+        fmt::print("core::file::MappedFile passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::file::MappedFile failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_file::write_atomically()
+{
+    try {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "aegyo_test_write_atomically.bin";
+        const std::string first = "first version";
+        const std::string second = "second";
+
+        // Write twice; the second write should replace the first one completely
+        core::file::write_atomically(path, reinterpret_cast<const std::uint8_t *>(first.data()), first.size());
+        core::file::write_atomically(path, reinterpret_cast<const std::uint8_t *>(second.data()), second.size());
+
+        const core::file::MappedFile mapping(path);
+        const std::string mapped(reinterpret_cast<const char *>(mapping.get_data()), mapping.get_size());
+        if (mapped != second) {
+            throw std::runtime_error(fmt::format("The file contents '{}' are not equal to expected '{}'", mapped, second));
+        }
+        fmt::print("core::file::write_atomically() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::file::write_atomically() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_hangul::compose()
+{
+    try {
+        const auto compose = [](const std::u32string &input) {
+            std::u32string out;
+            core::hangul::compose(input, out);
+            return out;
+        };
+
+        // Compound vowels, double finals and finals that move to the next syllable
+        const std::vector<std::pair<std::u32string, std::u32string>> cases = {
+            {U"ㅎㅏㄴㄱㅡㄹ", U"한글"},
+            {U"ㅎㅗㅏㄴㅇㅕㅇ", U"환영"},
+            {U"ㄷㅏㄹㄱ", U"닭"},
+            {U"ㄷㅏㄹㄱㅣ", U"달기"},
+            {U"ㅇㅣㄹㄱㅇㅓ", U"읽어"},
+            {U"ㅇㅏㄴㅈㅏ", U"안자"},
+            {U"ㄱㅏㅂㅅ", U"값"},
+            {U"ㄷㅏㄸㅏ", U"다따"},
+            {U"ㅘㅏ", U"ㅘㅏ"},
+            {U"ㄱㄱㅏ", U"ㄱ가"},
+            {U"ㅢㅅ", U"ㅢㅅ"},
+            {U"ㄳㅏ", U"ㄳㅏ"},
+            {U"ㅇㅏ ㄴㅔ!", U"아 네!"},
+        };
+        for (const auto &[input, expected] : cases) {
+            if (compose(input) != expected) {
+                throw std::runtime_error(fmt::format("Composing '{}' jamo gave '{}' characters, expected '{}'", input.size(), compose(input).size(), expected.size()));
+            }
+        }
+
+        // The syllable being typed is shown as it grows, and erasing takes compounds apart one jamo at a time
+        core::hangul::Composer composer;
+        std::u32string out;
+        for (const char32_t c : std::u32string(U"ㅎㅗㅏㄴ")) {
+            composer.push(c, out);
+        }
+        if (composer.get_preedit() != U'환' || !out.empty()) {
+            throw std::runtime_error("The syllable being typed is not '환'");
+        }
+        for (const char32_t expected : std::u32string(U"화호ㅎ")) {
+            if (!composer.pop() || composer.get_preedit() != expected) {
+                throw std::runtime_error("Erasing a jamo did not give the previous syllable");
+            }
+        }
+        if (!composer.pop() || composer.pop() || composer.get_preedit() != 0) {
+            throw std::runtime_error("Erasing past the first jamo did not stop");
+        }
+        fmt::print("core::hangul::compose() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::hangul::compose() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_hangul::dubeolsik()
+{
+    try {
+        // "dkssudgktpdy" is how "안녕하세요" is typed on a 2-beolsik keyboard
+        std::u32string jamo;
+        for (const char key : std::string("dkssudgktpdy")) {
+            jamo.push_back(core::hangul::get_dubeolsik_jamo(key));
+        }
+        std::u32string out;
+        core::hangul::compose(jamo, out);
+        if (out != U"안녕하세요") {
+            throw std::runtime_error("Typing 'dkssudgktpdy' did not give '안녕하세요'");
+        }
+        if (core::hangul::get_dubeolsik_jamo('R') != U'ㄲ' || core::hangul::get_dubeolsik_jamo('K') != U'ㅏ' || core::hangul::get_dubeolsik_jamo('1') != 0 || core::hangul::get_dubeolsik_jamo('\x80') != 0) {
+            throw std::runtime_error("The 2-beolsik keys are wrong");
+        }
+        fmt::print("core::hangul::get_dubeolsik_jamo() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::hangul::get_dubeolsik_jamo() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_normalization::compose()
+{
+    try {
+        // Conjoining jamo compose into syllables, even after a precomposed syllable, and lone ones become compatibility jamo
+        const std::vector<std::pair<std::string, std::string>> cases = {
+            {"\u1112\u1161\u11AB\u1100\u1173\u11AF", "한글"},
+            {"하\u11AB", "한"},
+            {"한\u11AB", "한ㄴ"},
+            {"\u1161", "ㅏ"},
+            {"\u1100\u1100\u1161", "ㄱ가"},
+            {"\u11AA", "ㄳ"},
+            {"\u1112 \u1161", "ㅎ ㅏ"},
+            {"ㅎㅏ", "ㅎㅏ"},
+            {"Tiếng Việt \u1100", "Tiếng Việt ㄱ"},
+            {"The quick brown fox jumps over the lazy dog \u1100\u1161", "The quick brown fox jumps over the lazy dog 가"},
+            {"\xE1\x84", "\xE1\x84"},
+            {"", ""},
+        };
+        for (const auto &[text, expected] : cases) {
+            if (const std::string composed = core::normalization::compose(text); composed != expected) {
+                throw std::runtime_error(fmt::format("Composing '{}' gave '{}', expected '{}'", text, composed, expected));
+            }
+        }
+
+        // The vocabulary keeps its Hangul in this form, so the built-in deck must already be in it
+        const modules::vocabulary::Vocabulary vocabulary;
+        for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+            const modules::vocabulary::Entry entry = vocabulary.get_entry(id);
+            if (core::normalization::compose(entry.hangul) != entry.hangul) {
+                throw std::runtime_error(fmt::format("Entry '{}' is not in canonical form", entry.hangul));
+            }
+        }
+        fmt::print("core::normalization::compose() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::normalization::compose() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_normalization::decompose()
+{
+    try {
+        if (core::normalization::decompose("한글 ㅏㄳㄸ!") != "\u1112\u1161\u11AB\u1100\u1173\u11AF \u1161\u11AA\u1104!") {
+            throw std::runtime_error("Decomposing '한글 ㅏㄳㄸ!' gave the wrong jamo");
+        }
+
+        // Every syllable survives a round-trip through conjoining jamo, in one long text so the vectorized runs are crossed too
+        std::string text;
+        for (std::uint32_t c = 0xAC00; c <= 0xD7A3; ++c) {
+            text += static_cast<char>(0xE0 | (c >> 12));
+            text += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            text += static_cast<char>(0x80 | (c & 0x3F));
+            if (c % 7 == 0) {
+                text += " ascii ";
+            }
+        }
+        if (core::normalization::compose(core::normalization::decompose(text)) != text) {
+            throw std::runtime_error("A round-trip through conjoining jamo changed the syllables");
+        }
+        fmt::print("core::normalization::decompose() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::normalization::decompose() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_paths::get_data_directory()
+{
+    try {
+        // Get the data directory, which should be created if it does not exist
+        const std::filesystem::path directory = core::paths::get_data_directory();
+        if (!std::filesystem::is_directory(directory)) {
+            throw std::runtime_error(fmt::format("The data directory '{}' does not exist", directory.string()));
+        }
+        fmt::print("core::paths::get_data_directory() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::paths::get_data_directory() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_perfect_hash::find()
+{
+    try {
+        // Every key is found at its index, and strings that are not keys are not found
+        std::vector<std::string> strings;
+        for (std::size_t idx = 0; idx < 100000; ++idx) {
+            strings.emplace_back(fmt::format("key-{}", idx * 7919));
+        }
+        const std::vector<std::string_view> keys(strings.cbegin(), strings.cend());
+        const core::perfect_hash::PerfectHash hash(keys);
+        if (hash.get_num_keys() != keys.size()) {
+            throw std::runtime_error(fmt::format("The number of keys '{}' is not equal to expected '{}'", hash.get_num_keys(), keys.size()));
+        }
+        for (std::size_t idx = 0; idx < keys.size(); ++idx) {
+            if (hash.find(keys[idx]) != static_cast<std::uint32_t>(idx)) {
+                throw std::runtime_error(fmt::format("Key '{}' was not found at index '{}'", keys[idx], idx));
+            }
+            if (hash.find(fmt::format("key-{}", idx * 7919 + 1)).has_value()) {
+                throw std::runtime_error(fmt::format("Non-key 'key-{}' was found", idx * 7919 + 1));
+            }
+        }
+        if (core::perfect_hash::PerfectHash().find("").has_value() || core::perfect_hash::PerfectHash({""}).find("") != 0u) {
+            throw std::runtime_error("The empty string was not handled");
+        }
+
+        // Duplicate keys are rejected
+        bool threw = false;
+        try {
+            const core::perfect_hash::PerfectHash duplicate({"ㄱ", "ㄴ", "ㄱ"});
+        }
+        catch (const std::runtime_error &) {
+            threw = true;
+        }
+        if (!threw) {
+            throw std::runtime_error("Duplicate keys were accepted");
+        }
+
+        // The vocabulary finds every entry by its character
+        const modules::vocabulary::Vocabulary vocabulary;
+        for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+            const modules::vocabulary::Entry entry = vocabulary.get_entry(id);
+            if (vocabulary.find_id(entry.hangul) != entry.id) {
+                throw std::runtime_error(fmt::format("Entry '{}' was not found by its character", entry.hangul));
+            }
+        }
+        if (vocabulary.find_id("a").has_value()) {
+            throw std::runtime_error("A romanization was found as a character");
+        }
+        fmt::print("core::perfect_hash::PerfectHash::find() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::perfect_hash::PerfectHash::find() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_pronunciation::pronounce()
+{
+    try {
+        // Liaison, nasalization, lateralization, tensification, aspiration, palatalization and neutralization (with the cluster exceptions of verb stems and of "밟"), and anything else copied as is
+        const std::vector<std::pair<std::string, std::string>> cases = {
+            {"한국말", "한궁말"},
+            {"한국어", "한구거"},
+            {"없어", "업써"},
+            {"읽어", "일거"},
+            {"좋아", "조아"},
+            {"종로", "종노"},
+            {"협력", "혐녁"},
+            {"신라", "실라"},
+            {"설날", "설랄"},
+            {"학교", "학꾜"},
+            {"국밥", "국빱"},
+            {"앉다", "안따"},
+            {"좋고", "조코"},
+            {"많네", "만네"},
+            {"입학", "이팍"},
+            {"같이", "가치"},
+            {"굳히다", "구치다"},
+            {"닭", "닥"},
+            {"늙고", "늘꼬"},
+            {"읽다", "익따"},
+            {"닭고기", "닥꼬기"},
+            {"흙과", "흑꽈"},
+            {"밟다", "밥따"},
+            {"밟는", "밤는"},
+            {"넓다", "널따"},
+            {"꽃 한 송이", "꼳 한 송이"},
+            {"안녕하세요", "안녕하세요"},
+            {"ㅏ닭ㄱ", "ㅏ닥ㄱ"},
+            {"", ""},
+        };
+        for (const auto &[text, expected] : cases) {
+            if (const std::string pronounced = core::pronunciation::pronounce(text); pronounced != expected) {
+                throw std::runtime_error(fmt::format("Pronouncing '{}' gave '{}', expected '{}'", text, pronounced, expected));
+            }
+        }
+
+        // Results are appended, and truncated or invalid sequences are copied as is
+        std::string out = "> ";
+        core::pronunciation::pronounce("닭\xED\x9E", out);
+        if (out != "> 닥\xED\x9E") {
+            throw std::runtime_error("Pronouncing a truncated sequence did not copy it as is");
+        }
+        fmt::print("core::pronunciation::pronounce() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::pronunciation::pronounce() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_query::evaluate()
+{
+    try {
+        // Queries over four random sets are checked against the same logic on each integer
+        std::mt19937 engine(7);
+        constexpr std::uint32_t num_values = 5000;
+        std::vector<core::bitmap::Bitmap> sets(4);
+        core::bitmap::Bitmap universe;
+        for (std::uint32_t value = 0; value < num_values; ++value) {
+            universe.add(value);
+            for (std::size_t idx = 0; idx < sets.size(); ++idx) {
+                if (engine() % (idx + 2) == 0) {
+                    sets[idx].add(value);
+                }
+            }
+        }
+        const std::vector<std::pair<std::string, std::function<bool(bool, bool, bool, bool)>>> cases = {
+            {"a", [](bool a, bool, bool, bool) { return a; }},
+            {"a & b", [](bool a, bool b, bool, bool) { return a && b; }},
+            {"a & b | c", [](bool a, bool b, bool c, bool) { return (a && b) || c; }},
+            {"a | b & c", [](bool a, bool b, bool c, bool) { return a || (b && c); }},
+            {"(a | b) & !c", [](bool a, bool b, bool c, bool) { return (a || b) && !c; }},
+            {"!a", [](bool a, bool, bool, bool) { return !a; }},
+            {"!!a | !(b & c)", [](bool a, bool b, bool c, bool) { return a || !(b && c); }},
+            {" a&!(b|!c) | d & !a ", [](bool a, bool b, bool c, bool d) { return (a && !(b || !c)) || (d && !a); }},
+            {"((a)) & (b | (c & !d)) | !(!d)", [](bool a, bool b, bool c, bool d) { return (a && (b || (c && !d))) || d; }},
+        };
+        for (const auto &[expression, expected] : cases) {
+            const core::query::Query query(expression);
+            std::vector<const core::bitmap::Bitmap *> inputs;
+            for (const core::query::Term &term : query.get_terms()) {
+                inputs.emplace_back(&sets[static_cast<std::size_t>(term.name[0] - 'a')]);
+            }
+            const core::bitmap::Bitmap result = query.evaluate(inputs, universe);
+            for (std::uint32_t value = 0; value < num_values; ++value) {
+                if (result.contains(value) != expected(sets[0].contains(value), sets[1].contains(value), sets[2].contains(value), sets[3].contains(value))) {
+                    throw std::runtime_error(fmt::format("Query '{}' is wrong for '{}'", expression, value));
+                }
+            }
+        }
+
+        // Repeated terms are one input, and comparisons select numbered tags
+        const core::query::Query query("(lesson<=5 & vowel) | review-due | vowel & lesson>=-1");
+        const auto &terms = query.get_terms();
+        if (terms.size() != 4 || terms[0].name != "lesson" || terms[0].comparison != core::query::Comparison::LessEqual || terms[0].value != 5 || terms[3].value != -1) {
+            throw std::runtime_error(fmt::format("The query has '{}' terms, expected '4'", terms.size()));
+        }
+        if (!core::query::matches(terms[0], "lesson:5") || core::query::matches(terms[0], "lesson:6") || core::query::matches(terms[0], "lesson") || core::query::matches(terms[0], "lessons:1") || core::query::matches(terms[0], "lesson:1a")) {
+            throw std::runtime_error("The term 'lesson<=5' does not match the right tags");
+        }
+        if (!core::query::matches(terms[2], "review-due") || core::query::matches(terms[2], "review-due:1")) {
+            throw std::runtime_error("The term 'review-due' does not match the right tags");
+        }
+
+        // Invalid queries report the position of the error
+        for (const auto &[expression, position] : std::vector<std::pair<std::string, std::size_t>>{{"", 0}, {"a &", 3}, {"(a | b", 6}, {"a)", 1}, {"a b", 2}, {"lesson <= x", 10}, {"!", 1}}) {
+            bool threw = false;
+            try {
+                const core::query::Query invalid(expression);
+            }
+            catch (const std::runtime_error &e) {
+                threw = std::string(e.what()).find(fmt::format("at position {} ", position)) != std::string::npos;
+            }
+            if (!threw) {
+                throw std::runtime_error(fmt::format("Query '{}' did not fail at position '{}'", expression, position));
+            }
+        }
+        fmt::print("core::query::Query::evaluate() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::query::Query::evaluate() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_recent::window()
+{
+    try {
+        core::recent::RecentWindow window(10, 3);
+        for (const std::size_t item : {1u, 2u, 3u, 4u, 20u}) {
+            window.push(item);
+        }
+
+        // Only the last 3 picks are remembered, and items out of range are ignored
+        if (window.contains(1) || !window.contains(2) || !window.contains(3) || !window.contains(4) || window.contains(20)) {
+            throw std::runtime_error("The window does not contain exactly the last 3 picks");
+        }
+        if (window.get_items() != std::vector<std::size_t>{4, 3, 2}) {
+            throw std::runtime_error("The window does not list its picks most recent first");
+        }
+
+        // A limit shrinks the window, and picking an item again refreshes it
+        if (window.contains(3, 1) || !window.contains(4, 1)) {
+            throw std::runtime_error("The limit did not shrink the window to the last pick");
+        }
+        window.push(2);
+        if (!window.contains(2, 1) || window.contains(3, 2) || !window.contains(4, 2)) {
+            throw std::runtime_error("Picking an item again did not refresh it");
+        }
+        fmt::print("core::recent::RecentWindow window passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::recent::RecentWindow window failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_recent::vocabulary()
+{
+    try {
+        // Enable only the 5 double consonants
+        modules::vocabulary::Vocabulary vocabulary;
+        for (const auto category : {modules::vocabulary::Category::BasicVowel, modules::vocabulary::Category::BasicConsonant, modules::vocabulary::Category::CompoundVowel}) {
+            vocabulary.set_category_enabled(category, false);
+        }
+        std::vector<float> weights(vocabulary.get_num_entries(), 0.0f);
+        weights[26] = 1.0f;
+        weights[27] = 1.0f;
+        vocabulary.set_weights(weights);
+        const std::vector<std::function<std::optional<modules::vocabulary::Entry>()>> policies = {
+            [&vocabulary]() { return vocabulary.get_random_enabled_entry(); },
+            [&vocabulary]() { return vocabulary.get_weighted_enabled_entry(); },
+            [&vocabulary]() { return vocabulary.get_next_enabled_entry(); },
+            [&vocabulary]() { return vocabulary.get_enabled_entry(26); }};
+
+        // No entry comes up again within the last 3 questions, with every policy that can choose
+        for (std::size_t policy = 0; policy < 3; ++policy) {
+            std::vector<std::size_t> picks;
+            for (std::size_t idx = 0; idx < 200; ++idx) {
+                const auto entry = policies[policy]();
+                if (!entry.has_value() || entry->category != modules::vocabulary::Category::DoubleConsonant) {
+                    throw std::runtime_error(fmt::format("Policy '{}' did not pick an enabled entry", policy));
+                }
+                for (std::size_t back = 1; back <= 3 && back <= picks.size(); ++back) {
+                    if (picks[picks.size() - back] == entry->id) {
+                        throw std::runtime_error(fmt::format("Policy '{}' picked entry '{}' again after '{}' questions", policy, entry->id, back));
+                    }
+                }
+                picks.emplace_back(entry->id);
+            }
+        }
+
+        // Entries picked elsewhere count as recent too
+        static_cast<void>(policies[3]());
+        if (!vocabulary.is_recent(26)) {
+            throw std::runtime_error("An entry picked by ID was not remembered");
+        }
+
+        // A window larger than the enabled set shrinks to 4, so the 5 entries come up in strict rotation
+        vocabulary.set_recent_window(10);
+        std::vector<std::size_t> picks;
+        for (std::size_t idx = 0; idx < 20; ++idx) {
+            picks.emplace_back(vocabulary.get_random_enabled_entry().value().id);
+            if (idx >= 5 && picks[idx] != picks[idx - 5]) {
+                throw std::runtime_error(fmt::format("Entry '{}' was picked instead of '{}' with the window shrunk to 4", picks[idx], picks[idx - 5]));
+            }
+        }
+        fmt::print("core::recent::RecentWindow vocabulary passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::recent::RecentWindow vocabulary failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_rng::instance()
+{
+    try {
+        // Define a vector of cars
+        std::vector<std::string> cars = {"Nissan Skyline GT-R R32", "Toyota Supra Mk4", "Mazda RX-7 FD", "Honda NSX"};
+
+        // Shuffle the cars using the random number generator
+        std::mt19937 &rng = core::rng::RNG::instance();
+        std::shuffle(cars.begin(), cars.end(), rng);
+        fmt::print("core::rng::RNG::instance() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::rng::RNG::instance() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_rng::get_random_number()
+{
+    try {
+        // Generate random numbers
+        constexpr int min = 0;
+        constexpr int max = 10;
+        const int random_number = core::rng::RNG::get_random_number<int>(min, max);
+        if (random_number < min || random_number > max) {
+            throw std::runtime_error(fmt::format("The actual random number '{}' is not in the range [{}, {}]", random_number, min, max));
+        }
+        fmt::print("core::rng::RNG::get_random_number() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::rng::RNG::get_random_number() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_rng::get_random_bool()
+{
+    try {
+        // Generate random boolean values
+        constexpr double probability = 0.5;
+        const bool random_bool = core::rng::RNG::get_random_bool(probability);
+        static_cast<void>(random_bool);  // Ignore [[nodiscard]] attribute
+        fmt::print("core::rng::RNG::get_random_bool() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::rng::RNG::get_random_bool() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_rng::state()
+{
+    try {
+        // Save the state, draw some numbers, restore the state and draw again
+        const auto state = core::rng::RNG::get_state();
+        std::vector<int> first;
+        for (int idx = 0; idx < 10; ++idx) {
+            first.emplace_back(core::rng::RNG::get_random_number<int>(0, 1000000));
+        }
+        if (!core::rng::RNG::set_state(state)) {
+            throw std::runtime_error("Failed to restore the saved state");
+        }
+        std::vector<int> second;
+        for (int idx = 0; idx < 10; ++idx) {
+            second.emplace_back(core::rng::RNG::get_random_number<int>(0, 1000000));
+        }
+        if (first != second) {
+            throw std::runtime_error("The restored generator produced a different sequence");
+        }
+
+        // An invalid state should be rejected
+        if (core::rng::RNG::set_state({1, 2, 3})) {
+            throw std::runtime_error("An invalid state was accepted");
+        }
+        fmt::print("core::rng::RNG::get_state() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::rng::RNG::get_state() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_rng::gamma_and_beta()
+{
+    try {
+        // The sample means should be close to the distribution means
+        constexpr std::size_t num_samples = 20000;
+        for (const double shape : {0.5, 1.0, 4.0}) {
+            double sum = 0.0;
+            for (std::size_t idx = 0; idx < num_samples; ++idx) {
+                const double sample = core::rng::RNG::get_random_gamma(shape);
+                if (!(sample >= 0.0)) {
+                    throw std::runtime_error(fmt::format("Got a negative gamma variate '{}'", sample));
+                }
+                sum += sample;
+            }
+            if (const double mean = sum / num_samples; mean < shape * 0.9 || mean > shape * 1.1) {
+                throw std::runtime_error(fmt::format("The mean of Gamma({}) is '{}', expected about '{}'", shape, mean, shape));
+            }
+        }
+        double sum = 0.0;
+        for (std::size_t idx = 0; idx < num_samples; ++idx) {
+            const double sample = core::rng::RNG::get_random_beta(3.0, 1.0);
+            if (sample < 0.0 || sample > 1.0) {
+                throw std::runtime_error(fmt::format("Got a beta variate '{}' outside of [0, 1]", sample));
+            }
+            sum += sample;
+        }
+        if (const double mean = sum / num_samples; mean < 0.72 || mean > 0.78) {
+            throw std::runtime_error(fmt::format("The mean of Beta(3, 1) is '{}', expected about '0.75'", mean));
+        }
+        fmt::print("core::rng::RNG::get_random_gamma() and get_random_beta() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::rng::RNG::get_random_gamma() and get_random_beta() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_romanization::romanize()
+{
+    try {
+        // Liaison, nasalization, lateralization, aspiration and palatalization, and anything else copied as is
+        const std::vector<std::pair<std::string, std::string>> cases = {
+            {"안녕하세요", "annyeonghaseyo"},
+            {"한국어", "hangugeo"},
+            {"읽어", "ilgeo"},
+            {"없어", "eopseo"},
+            {"많아", "mana"},
+            {"닭", "dak"},
+            {"국물", "gungmul"},
+            {"백마", "baengma"},
+            {"종로", "jongno"},
+            {"협력", "hyeomnyeok"},
+            {"신라", "silla"},
+            {"설날", "seollal"},
+            {"좋고", "joko"},
+            {"맞히다", "machida"},
+            {"밝히다", "balkida"},
+            {"같이", "gachi"},
+            {"해돋이", "haedoji"},
+            {"의사", "uisa"},
+            {"서울 Seoul, 부산!", "seoul Seoul, busan!"},
+            {"ㅏ한ㄱ", "ㅏhanㄱ"},
+            {"", ""},
+        };
+        for (const auto &[text, expected] : cases) {
+            if (const std::string romanized = core::romanization::romanize(text); romanized != expected) {
+                throw std::runtime_error(fmt::format("Romanizing '{}' gave '{}', expected '{}'", text, romanized, expected));
+            }
+        }
+
+        // Results are appended, and truncated or invalid sequences are copied as is
+        std::string out = "> ";
+        core::romanization::romanize("한\xED\x9E", out);
+        if (out != "> han\xED\x9E") {
+            throw std::runtime_error("Romanizing a truncated sequence did not copy it as is");
+        }
+        fmt::print("core::romanization::romanize() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::romanization::romanize() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_shuffle_bag::rounds()
+{
+    try {
+        constexpr std::size_t num_items = 10;
+        core::shuffle_bag::ShuffleBag bag(num_items);
+        for (std::size_t idx = 0; idx < num_items; ++idx) {
+            bag.insert(idx);
+        }
+
+        // Every item is drawn exactly once per round, and rounds never repeat an item back to back
+        std::size_t previous = num_items;
+        for (std::size_t round = 0; round < 50; ++round) {
+            std::vector<std::size_t> counts(num_items, 0);
+            for (std::size_t idx = 0; idx < num_items; ++idx) {
+                const auto item = bag.draw();
+                if (!item.has_value() || *item >= num_items) {
+                    throw std::runtime_error("No valid item was drawn");
+                }
+                if (*item == previous) {
+                    throw std::runtime_error(fmt::format("Item '{}' was drawn twice in a row", *item));
+                }
+                previous = *item;
+                ++counts[*item];
+            }
+            for (std::size_t idx = 0; idx < num_items; ++idx) {
+                if (counts[idx] != 1) {
+                    throw std::runtime_error(fmt::format("Item '{}' was drawn '{}' times in round '{}', expected '1'", idx, counts[idx], round));
+                }
+            }
+        }
+        fmt::print("core::shuffle_bag::ShuffleBag rounds passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::shuffle_bag::ShuffleBag rounds failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_shuffle_bag::insert_and_erase()
+{
+    try {
+        core::shuffle_bag::ShuffleBag bag(8);
+        if (bag.draw().has_value()) {
+            throw std::runtime_error("An empty bag returned an item");
+        }
+        for (std::size_t idx = 0; idx < 4; ++idx) {
+            bag.insert(idx);
+        }
+
+        // Erase one item mid-round and insert two new ones; the round then covers exactly the items present
+        const std::size_t first = bag.draw().value();
+        const std::size_t erased = (first + 1) % 4;
+        bag.erase(erased);
+        bag.insert(6);
+        bag.insert(7);
+        bag.insert(6);  // Already present, ignored
+        if (bag.get_size() != 5 || bag.get_remaining() != 4 || bag.contains(erased)) {
+            throw std::runtime_error(fmt::format("The bag has '{}' items with '{}' remaining, expected '5' with '4'", bag.get_size(), bag.get_remaining()));
+        }
+        std::vector<std::size_t> drawn;
+        for (std::size_t idx = 0; idx < 4; ++idx) {
+            drawn.emplace_back(bag.draw().value());
+        }
+        std::sort(drawn.begin(), drawn.end());
+        std::vector<std::size_t> expected;
+        for (const std::size_t item : {0u, 1u, 2u, 3u, 6u, 7u}) {
+            if (item != first && item != erased) {
+                expected.emplace_back(item);
+            }
+        }
+        if (drawn != expected) {
+            throw std::runtime_error("The rest of the round did not return the remaining items exactly once");
+        }
+
+        // Categories can be toggled mid-round in the vocabulary
+        modules::vocabulary::Vocabulary vocabulary;
+        static_cast<void>(vocabulary.get_next_enabled_entry());
+        vocabulary.set_category_enabled(modules::vocabulary::Category::BasicVowel, false);
+        for (std::size_t idx = 0; idx < vocabulary.get_num_entries(); ++idx) {
+            if (const auto entry = vocabulary.get_next_enabled_entry(); !entry.has_value() || entry->category == modules::vocabulary::Category::BasicVowel) {
+                throw std::runtime_error("An entry of a disabled category was drawn");
+            }
+        }
+        fmt::print("core::shuffle_bag::ShuffleBag insert and erase passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::shuffle_bag::ShuffleBag insert and erase failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_string::to_sfml_string()
+{
+    try {
+        // Convert a UTF-8 string to an SFML string
+        const std::string utf8_str = "Dzień dobry";
+        const sf::String sfml_str = core::string::to_sfml_string(utf8_str);
+        if (sfml_str.isEmpty()) {
+            throw std::runtime_error("The SFML string is empty");
+        }
+        fmt::print("core::string::to_sfml_string() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::string::to_sfml_string() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_string::utf8_to_utf32()
+{
+    try {
+        const auto decode = [](const std::string &utf8_str) {
+            std::vector<std::uint32_t> out(utf8_str.size());
+            out.resize(core::string::utf8_to_utf32(utf8_str, out.data()));
+            return out;
+        };
+        const auto encode = [](const std::vector<std::uint32_t> &code_points) {
+            std::string utf8_str;
+            for (const std::uint32_t cp : code_points) {
+                if (cp < 0x80) {
+                    utf8_str.push_back(static_cast<char>(cp));
+                }
+                else if (cp < 0x800) {
+                    utf8_str.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+                    utf8_str.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+                }
+                else if (cp < 0x10000) {
+                    utf8_str.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+                    utf8_str.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                    utf8_str.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+                }
+                else {
+                    utf8_str.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+                    utf8_str.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+                    utf8_str.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                    utf8_str.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+                }
+            }
+            return utf8_str;
+        };
+
+        // Random valid text round-trips, with long runs of ASCII and Hangul for the vectorized paths and other characters in between
+        std::mt19937 engine(7);
+        for (std::size_t round = 0; round < 200; ++round) {
+            std::vector<std::uint32_t> code_points;
+            while (code_points.size() < 300) {
+                const auto kind = static_cast<std::uint32_t>(engine() % 8);
+                const auto run_length = static_cast<std::uint32_t>(1 + engine() % 40);
+                for (std::uint32_t idx = 0; idx < run_length; ++idx) {
+                    switch (kind) {
+                    case 0:
+                        code_points.emplace_back(static_cast<std::uint32_t>(0x80 + engine() % 0x780));
+                        break;
+                    case 1:
+                        code_points.emplace_back(static_cast<std::uint32_t>(0x10000 + engine() % 0x100000));
+                        break;
+                    case 2:
+                        code_points.emplace_back(static_cast<std::uint32_t>(0xE000 + engine() % 0x2000));
+                        break;
+                    case 3:
+                    case 4:
+                        code_points.emplace_back(static_cast<std::uint32_t>(engine() % 0x80));
+                        break;
+                    default:
+                        code_points.emplace_back(static_cast<std::uint32_t>(0xAC00 + engine() % 11172));
+                        break;
+                    }
+                }
+            }
+            if (decode(encode(code_points)) != code_points) {
+                throw std::runtime_error(fmt::format("Round '{}' of random text did not round-trip", round));
+            }
+        }
+
+        // Each maximal invalid subsequence becomes one U+FFFD, including within long runs of Hangul
+        const std::string hangul = "가나다라마바사아자차카타파하가나다라";
+        const std::vector<std::pair<std::string, std::vector<std::uint32_t>>> cases = {
+            {"\xE0\x80\x80", {0xFFFD, 0xFFFD, 0xFFFD}},
+            {"\xED\xA0\x80", {0xFFFD, 0xFFFD, 0xFFFD}},
+            {"\xF4\x90\x80\x80", {0xFFFD, 0xFFFD, 0xFFFD, 0xFFFD}},
+            {"\xC0\xAF", {0xFFFD, 0xFFFD}},
+            {"\xE1\x80", {0xFFFD}},
+            {"\xE1\x80" "a", {0xFFFD, 'a'}},
+            {"\x80\xBF", {0xFFFD, 0xFFFD}},
+            {"\xFF", {0xFFFD}},
+        };
+        for (const auto &[bytes, expected] : cases) {
+            if (decode(bytes) != expected) {
+                throw std::runtime_error(fmt::format("Decoding '{}' invalid bytes gave '{}' code points, expected '{}'", bytes.size(), decode(bytes).size(), expected.size()));
+            }
+            const auto decoded = decode(hangul + bytes + hangul);
+            if (decoded.size() != 36 + expected.size() || !std::equal(expected.cbegin(), expected.cend(), decoded.cbegin() + 18) || decoded.front() != 0xAC00 || decoded.back() != 0xB77C) {
+                throw std::runtime_error(fmt::format("Decoding '{}' invalid bytes within Hangul gave the wrong code points", bytes.size()));
+            }
+        }
+        fmt::print("core::string::utf8_to_utf32() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::string::utf8_to_utf32() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_trie::match()
+{
+    try {
+        const core::trie::Trie trie({{"g", 0}, {"k", 0}, {"k", 1}, {"kk", 2}, {"ya", 3}, {"yae", 4}, {"", 5}});
+        const auto walk = [&trie](const std::string &text) {
+            core::trie::Trie::State state = core::trie::Trie::root;
+            for (const char c : text) {
+                state = trie.step(state, c);
+            }
+            return state;
+        };
+
+        // Shared prefixes share nodes, and the empty key is ignored: root, g, k, kk, y, ya and yae
+        if (trie.get_num_nodes() != 7) {
+            throw std::runtime_error(fmt::format("The trie has '{}' nodes, expected '7'", trie.get_num_nodes()));
+        }
+
+        // A key can map to several values, and a value can have several keys
+        if (!trie.contains(walk("k"), 0) || !trie.contains(walk("k"), 1) || !trie.contains(walk("g"), 0) || trie.contains(walk("kk"), 0) || trie.get_value(walk("kk")) != 2u) {
+            throw std::runtime_error("The values of the keys are wrong");
+        }
+
+        // A prefix can still reach the values below it, but not the ones it has passed
+        if (!trie.can_reach(walk("y"), 3) || !trie.can_reach(walk("y"), 4) || !trie.can_reach(walk("ya"), 4) || trie.can_reach(walk("yae"), 3) || trie.can_reach(walk("k"), 3) || !trie.can_reach(walk("k"), 2)) {
+            throw std::runtime_error("The reachable values are wrong");
+        }
+        if (trie.contains(walk("y"), 3) || trie.get_value(walk("y")).has_value() || trie.can_reach(walk("y"), 5) || trie.can_reach(walk("y"), 100)) {
+            throw std::runtime_error("A prefix matched a value of no key below it");
+        }
+
+        // Characters that no key continues with lead to the dead state, which is never left
+        if (walk("x") != core::trie::Trie::dead || walk("gg") != core::trie::Trie::dead || trie.step(core::trie::Trie::dead, 'g') != core::trie::Trie::dead || trie.can_reach(walk("x"), 0)) {
+            throw std::runtime_error("An unknown character did not lead to the dead state");
+        }
+        fmt::print("core::trie::Trie match passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "core::trie::Trie match failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_vocabulary::entry()
+{
+    try {
+        // Create a vocabulary entry
+        const modules::vocabulary::Entry entry = {"ㅏ", "a", "Looks like an 'a' without the crossbar", modules::vocabulary::Category::BasicVowel};
+        if (entry.hangul != "ㅏ") {
+            throw std::runtime_error(fmt::format("The actual Korean character '{}' is not equal to expected 'ㅏ'", entry.hangul));
+        }
+        if (entry.latin != "a") {
+            throw std::runtime_error(fmt::format("The actual Latin transliteration '{}' is not equal to expected 'a'", entry.latin));
+        }
+        if (entry.memo != "Looks like an 'a' without the crossbar") {
+            throw std::runtime_error(fmt::format("The actual memo '{}' is not equal to expected 'Looks like an 'a' without the crossbar'", entry.memo));
+        }
+        if (entry.category != modules::vocabulary::Category::BasicVowel) {
+            throw std::runtime_error(fmt::format("The actual category '{}' is not equal to expected 'Category::BasicVowel'", static_cast<int>(entry.category)));
+        }
+        fmt::print("modules::vocabulary::Entry passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::vocabulary::Entry failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_vocabulary::category_count()
+{
+    try {
+        // Create a vocabulary object
+        modules::vocabulary::Vocabulary vocabulary;
+
+        // Map to store the count of entries for each category
+        std::unordered_map<modules::vocabulary::Category, std::size_t> category_counts;
+
+        // Count the number of entries for each category
+        for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+            const modules::vocabulary::Entry entry = vocabulary.get_entry(id);
+            ++category_counts[entry.category];
+        }
+
+        // Ensure each category has more than 3 entries
+        const std::size_t min_category_entries = 4;
+        for (const auto &[category, count] : category_counts) {
+            if (count < min_category_entries) {
+                throw std::runtime_error(fmt::format("Category '{}' has less than {} entries (found {})", static_cast<int>(category), min_category_entries, count));
+            }
+            fmt::print("modules::vocabulary::Vocabulary: Category '{}' has {} entries.\n", static_cast<int>(category), count);
+        }
+
+        fmt::print("modules::vocabulary::Vocabulary passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::vocabulary::Vocabulary failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_vocabulary::question_options()
+{
+    try {
+        modules::vocabulary::Vocabulary vocabulary;
+        const auto check_options = [&vocabulary](const modules::vocabulary::Entry &correct_entry,
+                                                 const std::size_t num_options) {
+            const auto options = vocabulary.generate_enabled_question_options(correct_entry, num_options);
+            std::vector<std::size_t> ids;
+            for (const auto &option : options) {
+                if (!vocabulary.is_category_enabled(option.category)) {
+                    throw std::runtime_error(fmt::format("Option '{}' belongs to a disabled category", option.hangul));
+                }
+                ids.emplace_back(option.id);
+            }
+            std::sort(ids.begin(), ids.end());
+            if (options.size() != num_options || std::adjacent_find(ids.cbegin(), ids.cend()) != ids.cend() || !std::binary_search(ids.cbegin(), ids.cend(), correct_entry.id)) {
+                throw std::runtime_error(fmt::format("'{}' options for '{}' are not unique or miss the correct entry", num_options, correct_entry.hangul));
+            }
+        };
+
+        // Every number of options from 2 to 9, drawn by rejection sampling from the whole vocabulary
+        for (std::size_t num_options = 2; num_options <= 9; ++num_options) {
+            for (std::size_t idx = 0; idx < 200; ++idx) {
+                check_options(vocabulary.get_entry(idx % vocabulary.get_num_entries()), num_options);
+            }
+        }
+
+        // With only the 5 double consonants, the options are drawn from every possible wrong entry
+        for (const auto category : {modules::vocabulary::Category::BasicVowel, modules::vocabulary::Category::BasicConsonant, modules::vocabulary::Category::CompoundVowel}) {
+            vocabulary.set_category_enabled(category, false);
+        }
+        for (std::size_t idx = 0; idx < 200; ++idx) {
+            check_options(vocabulary.get_entry(26 + idx % 5), 5);
+        }
+        bool threw = false;
+        try {
+            static_cast<void>(vocabulary.generate_enabled_question_options(vocabulary.get_entry(26), 6));
+        }
+        catch (const std::runtime_error &) {
+            threw = true;
+        }
+        if (!threw || vocabulary.get_num_enabled() != 5) {
+            throw std::runtime_error("Asking for more options than enabled entries did not throw");
+        }
+        fmt::print("modules::vocabulary::Vocabulary question options passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::vocabulary::Vocabulary question options failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_vocabulary::tags()
+{
+    try {
+        modules::vocabulary::Vocabulary vocabulary;
+        const std::vector<std::string> expected_tags = {"aspirated", "compound", "consonant", "iotized", "tense", "vowel"};
+        if (vocabulary.get_tags() != expected_tags) {
+            throw std::runtime_error(fmt::format("The '{}' tags are not equal to the '{}' expected", vocabulary.get_tags().size(), expected_tags.size()));
+        }
+        for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+            const modules::vocabulary::Entry entry = vocabulary.get_entry(id);
+            for (const std::string &tag : expected_tags) {
+                const bool tagged = std::find(entry.tags.cbegin(), entry.tags.cend(), tag) != entry.tags.cend();
+                if (vocabulary.get_tag_ids(tag).contains(static_cast<std::uint32_t>(entry.id)) != tagged) {
+                    throw std::runtime_error(fmt::format("The bitmap of tag '{}' does not match entry '{}'", tag, entry.hangul));
+                }
+            }
+        }
+        if (vocabulary.get_tag_ids("noun").get_cardinality() != 0) {
+            throw std::runtime_error("An unknown tag has entries");
+        }
+
+        // Iotized vowels that are not compound: ㅑ, ㅕ, ㅛ, ㅠ
+        const core::bitmap::Bitmap filter = vocabulary.get_tag_ids("iotized") - vocabulary.get_tag_ids("compound");
+        vocabulary.set_filter(filter);
+        if (vocabulary.get_num_enabled() != 4 || vocabulary.get_enabled_ids() != filter) {
+            throw std::runtime_error(fmt::format("The number of filtered entries '{}' is not equal to expected '4'", vocabulary.get_num_enabled()));
+        }
+
+        // The filter applies on top of the categories, and every way of picking an entry respects both
+        vocabulary.set_category_enabled(modules::vocabulary::Category::BasicVowel, false);
+        vocabulary.set_category_enabled(modules::vocabulary::Category::BasicVowel, true);
+        vocabulary.set_category_enabled(modules::vocabulary::Category::CompoundVowel, false);
+        for (std::size_t idx = 0; idx < 200; ++idx) {
+            for (const auto &entry : {vocabulary.get_random_enabled_entry(), vocabulary.get_weighted_enabled_entry(), vocabulary.get_next_enabled_entry()}) {
+                if (!entry.has_value() || !filter.contains(static_cast<std::uint32_t>(entry->id))) {
+                    throw std::runtime_error("An entry outside of the filter was picked");
+                }
+            }
+        }
+        if (vocabulary.get_enabled_entry(0).has_value() || !vocabulary.get_enabled_entry(1).has_value()) {
+            throw std::runtime_error("Entries were not enabled by the filter");
+        }
+
+        // A filter without enabled entries leaves nothing to pick, and removing it enables the categories again
+        vocabulary.set_category_enabled(modules::vocabulary::Category::BasicVowel, false);
+        if (vocabulary.get_num_enabled() != 0 || vocabulary.get_random_enabled_entry().has_value() || vocabulary.get_next_enabled_entry().has_value()) {
+            throw std::runtime_error("An entry was picked although none is enabled");
+        }
+        vocabulary.set_filter(std::nullopt);
+        if (vocabulary.get_num_enabled() != 19 || vocabulary.get_enabled_ids() != vocabulary.get_tag_ids("consonant")) {
+            throw std::runtime_error(fmt::format("The number of enabled entries '{}' is not equal to expected '19'", vocabulary.get_num_enabled()));
+        }
+
+        // The shuffle bag follows the enabled entries, so a round returns each of them once
+        std::vector<std::size_t> ids;
+        for (std::size_t idx = 0; idx < 19; ++idx) {
+            ids.emplace_back(vocabulary.get_next_enabled_entry()->id);
+        }
+        std::sort(ids.begin(), ids.end());
+        if (std::adjacent_find(ids.cbegin(), ids.cend()) != ids.cend() || ids.front() != 12 || ids.back() != 30) {
+            throw std::runtime_error("A round of the shuffle bag does not return every consonant once");
+        }
+        fmt::print("modules::vocabulary::Vocabulary tags passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::vocabulary::Vocabulary tags failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_vocabulary::query()
+{
+    try {
+        modules::vocabulary::Vocabulary vocabulary;
+        const auto ids_of = [&vocabulary](const std::vector<std::string> &hangul) {
+            core::bitmap::Bitmap ids;
+            for (const std::string &character : hangul) {
+                ids.add(static_cast<std::uint32_t>(*vocabulary.find_id(character)));
+            }
+            return ids;
+        };
+
+        // Non-compound iotized vowels, plus the aspirated consonants
+        vocabulary.set_query("(iotized & !compound) | aspirated");
+        if (vocabulary.get_enabled_ids() != ids_of({"ㅑ", "ㅕ", "ㅛ", "ㅠ", "ㅊ", "ㅋ", "ㅌ", "ㅍ"})) {
+            throw std::runtime_error(fmt::format("The query enabled '{}' entries, expected '8'", vocabulary.get_num_enabled()));
+        }
+
+        // Numbered and changing tags are resolved again only when they change
+        vocabulary.set_tag_ids("lesson:1", ids_of({"ㅏ", "ㅓ"}));
+        vocabulary.set_tag_ids("lesson:2", ids_of({"ㄱ", "ㄴ"}));
+        vocabulary.set_tag_ids("lesson:7", ids_of({"ㅢ"}));
+        vocabulary.set_query("(lesson<=5 & vowel) | review-due");
+        if (vocabulary.get_enabled_ids() != ids_of({"ㅏ", "ㅓ"})) {
+            throw std::runtime_error(fmt::format("The lesson query enabled '{}' entries, expected '2'", vocabulary.get_num_enabled()));
+        }
+        vocabulary.set_tag_ids("review-due", ids_of({"ㅉ"}));
+        vocabulary.set_tag_ids("lesson:3", ids_of({"ㅗ"}));
+        if (vocabulary.get_enabled_ids() != ids_of({"ㅏ", "ㅓ", "ㅗ", "ㅉ"})) {
+            throw std::runtime_error(fmt::format("Changed tags enabled '{}' entries, expected '4'", vocabulary.get_num_enabled()));
+        }
+        vocabulary.set_tag_ids("review-due", core::bitmap::Bitmap());
+        vocabulary.set_category_enabled(modules::vocabulary::Category::BasicVowel, false);
+        vocabulary.set_category_enabled(modules::vocabulary::Category::BasicVowel, true);
+        if (vocabulary.get_enabled_ids() != ids_of({"ㅏ", "ㅓ", "ㅗ"}) || vocabulary.get_tag_ids("review-due").get_cardinality() != 0) {
+            throw std::runtime_error(fmt::format("Removing a tag enabled '{}' entries, expected '3'", vocabulary.get_num_enabled()));
+        }
+
+        // An invalid query keeps the current one, and an empty one enables every entry
+        bool threw = false;
+        try {
+            vocabulary.set_query("vowel &");
+        }
+        catch (const std::runtime_error &) {
+            threw = true;
+        }
+        if (!threw || vocabulary.get_num_enabled() != 3) {
+            throw std::runtime_error("An invalid query changed the enabled entries");
+        }
+        vocabulary.set_query(" ");
+        if (vocabulary.get_num_enabled() != vocabulary.get_num_entries()) {
+            throw std::runtime_error(fmt::format("An empty query enabled '{}' entries, expected all", vocabulary.get_num_enabled()));
+        }
+        fmt::print("modules::vocabulary::Vocabulary query passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::vocabulary::Vocabulary query failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_vocabulary::update()
+{
+    try {
+        using modules::vocabulary::Category;
+        modules::vocabulary::Vocabulary vocabulary;
+        vocabulary.set_query("iotized");
+        const std::size_t num_entries = vocabulary.get_num_entries();
+        const std::size_t ya = *vocabulary.find_id("ㅑ");
+
+        // Tag an entry, add one and remove one; the query follows the changed tags
+        modules::vocabulary::Update update;
+        update.entries = {{"ㅏ", "a", "Changed", Category::BasicVowel, {"vowel", "iotized"}}, {"가", "ga", "", Category::BasicConsonant, {"iotized"}}};
+        update.removed = {"ㅑ"};
+        if (!vocabulary.update(update)) {
+            throw std::runtime_error("Adding and removing entries did not change the layout");
+        }
+        const auto ga = vocabulary.find_id("가");
+        if (ga != num_entries || vocabulary.get_num_entries() != num_entries + 1 || vocabulary.get_entry(0).memo != "Changed") {
+            throw std::runtime_error("The new or changed entries were not applied");
+        }
+        if (vocabulary.find_id("ㅑ").has_value() || vocabulary.contains(ya) || vocabulary.is_enabled(ya) || vocabulary.get_tag_ids("iotized").contains(static_cast<std::uint32_t>(ya))) {
+            throw std::runtime_error("The removed entry is still indexed");
+        }
+        if (vocabulary.get_num_enabled() != 7 || !vocabulary.is_enabled(0) || !vocabulary.is_enabled(*ga)) {
+            throw std::runtime_error(fmt::format("The query enabled '{}' entries after the update, expected '7'", vocabulary.get_num_enabled()));
+        }
+
+        // The shuffle bag holds exactly the enabled entries, including the new one
+        std::set<std::size_t> drawn;
+        for (std::size_t idx = 0; idx < vocabulary.get_num_enabled(); ++idx) {
+            drawn.insert(vocabulary.get_next_enabled_entry()->id);
+        }
+        if (drawn.size() != 7 || drawn.count(*ga) == 0) {
+            throw std::runtime_error("The shuffle bag does not match the enabled entries");
+        }
+
+        // A memo changes nothing else, and a removed entry that comes back keeps its ID
+        update.entries = {{"ㅓ", "eo", "Changed", Category::BasicVowel, {"vowel"}}};
+        update.removed.clear();
+        if (vocabulary.update(update)) {
+            throw std::runtime_error("Changing a memo changed the layout");
+        }
+        update.entries = {{"ㅑ", "ya", "", Category::BasicVowel, {"vowel", "iotized"}}};
+        if (!vocabulary.update(update) || vocabulary.find_id("ㅑ") != ya || !vocabulary.is_enabled(ya) || vocabulary.get_num_entries() != num_entries + 1) {
+            throw std::runtime_error("The entry that came back did not keep its ID");
+        }
+        fmt::print("modules::vocabulary::Vocabulary update passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::vocabulary::Vocabulary update failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_history::accuracy_and_streak()
+{
+    try {
+        modules::history::History history(2);
+        for (const bool correct : {true, false, true, true, true}) {
+            history.record(0, correct);
+        }
+        history.record(5, true);  // Out of range, ignored
+
+        if (history.get_outcomes(0) != 0b10111 || history.get_length(0) != 5) {
+            throw std::runtime_error(fmt::format("The history is '{:#b}' of length '{}', expected '0b10111' of length '5'", history.get_outcomes(0), history.get_length(0)));
+        }
+        if (history.get_accuracy(0) != 0.8 || history.get_streak(0) != 3) {
+            throw std::runtime_error(fmt::format("The accuracy is '{}' with streak '{}', expected '0.8' with streak '3'", history.get_accuracy(0), history.get_streak(0)));
+        }
+        history.record(1, false);
+        history.record(1, false);
+        if (history.get_streak(1) != -2 || history.get_accuracy(1) != 0.0) {
+            throw std::runtime_error(fmt::format("The streak is '{}', expected '-2'", history.get_streak(1)));
+        }
+
+        // Only the last 64 outcomes are kept
+        for (std::size_t idx = 0; idx < 100; ++idx) {
+            history.record(0, true);
+        }
+        if (history.get_length(0) != 64 || history.get_accuracy(0) != 1.0 || history.get_streak(0) != 64) {
+            throw std::runtime_error(fmt::format("The history has length '{}' and streak '{}', expected '64' and '64'", history.get_length(0), history.get_streak(0)));
+        }
+        fmt::print("modules::history::History accuracy and streak passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::history::History accuracy and streak failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_history::weakest()
+{
+    try {
+        // Every entry has a history of 8 outcomes, with "idx % 9" correct answers; entry 7 is never asked
+        constexpr std::size_t num_entries = 100000;
+        modules::history::History history(num_entries);
+        for (std::size_t idx = 0; idx < num_entries; ++idx) {
+            if (idx != 7) {
+                history.set(idx, (std::uint64_t{1} << (idx % 9)) - 1, 8);
+            }
+        }
+
+        const auto weakest = history.get_weakest(20);
+        if (weakest.size() != 20) {
+            throw std::runtime_error(fmt::format("Got '{}' entries, expected '20'", weakest.size()));
+        }
+        for (const std::size_t id : weakest) {
+            // Only entries with no correct answers are this weak
+            if (id % 9 != 0 || id == 7) {
+                throw std::runtime_error(fmt::format("Entry '{}' with accuracy '{}' was ranked among the weakest", id, history.get_accuracy(id)));
+            }
+        }
+
+        // Answering correctly moves an entry up the ranking
+        history.set(0, 0, 8);
+        history.record(0, true);
+        const auto all = history.get_weakest(num_entries);
+        if (all.size() != num_entries - 1 || history.get_accuracy(all.back()) != 1.0) {
+            throw std::runtime_error(fmt::format("Ranked '{}' entries, expected '{}'", all.size(), num_entries - 1));
+        }
+        for (std::size_t idx = 1; idx < all.size(); ++idx) {
+            if (history.get_accuracy(all[idx - 1]) > history.get_accuracy(all[idx])) {
+                throw std::runtime_error(fmt::format("Entry '{}' is ranked before the weaker entry '{}'", all[idx - 1], all[idx]));
+            }
+        }
+
+        modules::history::History small(3);
+        small.record(2, true);
+        if (small.get_weakest(10) != std::vector<std::size_t>{2}) {
+            throw std::runtime_error("Entries without a history were ranked");
+        }
+        fmt::print("modules::history::History::get_weakest() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::history::History::get_weakest() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_journal::append_and_recover()
+{
+    try {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "aegyo_test_journal_append.bin";
+        std::filesystem::remove(path);
+
+        // Append records and wait until they are on disk
+        constexpr std::uint32_t num_records = 100;
+        constexpr std::uint64_t base_timestamp = 1729123200000;
+        {
+            modules::journal::Journal journal(path);
+            if (!journal.get_recovered_records().empty()) {
+                throw std::runtime_error(fmt::format("A new journal recovered '{}' records, expected '0'", journal.get_recovered_records().size()));
+            }
+            for (std::uint32_t idx = 0; idx < num_records; ++idx) {
+                journal.append({base_timestamp + idx, idx, idx + 1, 500 + idx, idx % 2 == 0});
+            }
+            if (!journal.flush()) {
+                throw std::runtime_error("The records were not committed");
+            }
+        }
+
+        // Reopen the journal and replay the records
+        modules::journal::Journal journal(path);
+        const auto &records = journal.get_recovered_records();
+        if (records.size() != num_records) {
+            throw std::runtime_error(fmt::format("The journal recovered '{}' records, expected '{}'", records.size(), num_records));
+        }
+        for (std::uint32_t idx = 0; idx < num_records; ++idx) {
+            const auto &record = records[idx];
+            if (record.timestamp_ms != base_timestamp + idx || record.entry_id != idx || record.chosen_id != idx + 1 || record.latency_ms != 500 + idx || record.correct != (idx % 2 == 0)) {
+                throw std::runtime_error(fmt::format("Record '{}' does not match what was appended", idx));
+            }
+        }
+        fmt::print("modules::journal::Journal::append() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::journal::Journal::append() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_journal::torn_tail()
+{
+    try {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "aegyo_test_journal_torn.bin";
+        std::filesystem::remove(path);
+
+        // Write two records
+        {
+            modules::journal::Journal journal(path);
+            journal.append({1, 2, 3, 4, true});
+            journal.append({5, 6, 7, 8, false});
+        }
+        const auto valid_size = std::filesystem::file_size(path);
+
+        // Simulate a power loss in the middle of a write
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::app);
+            out << "torn";
+        }
+
+        // Reopen the journal, which should drop the torn tail and keep appending after the last valid record
+        {
+            modules::journal::Journal journal(path);
+            if (journal.get_recovered_records().size() != 2) {
+                throw std::runtime_error(fmt::format("The journal recovered '{}' records, expected '2'", journal.get_recovered_records().size()));
+            }
+            if (std::filesystem::file_size(path) != valid_size) {
+                throw std::runtime_error("The torn tail was not truncated");
+            }
+            journal.append({9, 10, 11, 12, true});
+        }
+        modules::journal::Journal journal(path);
+        if (journal.get_recovered_records().size() != 3) {
+            throw std::runtime_error(fmt::format("The journal recovered '{}' records after repair, expected '3'", journal.get_recovered_records().size()));
+        }
+        fmt::print("modules::journal::Journal recovery passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::journal::Journal recovery failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_journal::checkpoint()
+{
+    try {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "aegyo_test_journal_checkpoint.bin";
+        std::filesystem::remove(path);
+
+        // A successful checkpoint truncates the journal and starts a new generation
+        std::uint32_t snapshot_generation = 0;
+        {
+            modules::journal::Journal journal(path);
+            journal.append({1, 2, 3, 4, true});
+            journal.checkpoint([&snapshot_generation](const std::uint32_t generation) {
+                snapshot_generation = generation;
+                return true;
+            });
+            journal.append({5, 6, 7, 8, false});
+            // A failed checkpoint keeps everything
+            journal.checkpoint([](const std::uint32_t) { return false; });
+            journal.append({9, 10, 11, 12, true});
+            if (!journal.flush()) {
+                throw std::runtime_error("The records were not committed");
+            }
+            if (journal.get_generation() != 1 || snapshot_generation != 1) {
+                throw std::runtime_error(fmt::format("The generation is '{}' (snapshot '{}'), expected '1'", journal.get_generation(), snapshot_generation));
+            }
+        }
+        {
+            modules::journal::Journal journal(path);
+            if (journal.get_recovered_records().size() != 2 || journal.get_recovered_records().front().timestamp_ms != 5) {
+                throw std::runtime_error(fmt::format("The journal recovered '{}' records after the checkpoint, expected '2'", journal.get_recovered_records().size()));
+            }
+        }
+
+        // A journal older than the snapshot was already folded into it
+        modules::journal::Journal journal(path, 2);
+        if (!journal.get_recovered_records().empty() || journal.get_generation() != 2) {
+            throw std::runtime_error("A stale journal was not discarded");
+        }
+        fmt::print("modules::journal::Journal::checkpoint() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::journal::Journal::checkpoint() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_knowledge::update()
+{
+    try {
+        modules::knowledge::Knowledge knowledge(3);
+        const float initial = knowledge.get_mastery(0);
+        knowledge.update(0, true);
+        knowledge.update(1, false);
+        knowledge.update(9, true);  // Out of range, ignored
+
+        if (!(knowledge.get_mastery(0) > initial) || !(knowledge.get_mastery(1) < knowledge.get_mastery(0))) {
+            throw std::runtime_error(fmt::format("The mastery is '{}' after a correct answer and '{}' after a wrong one, starting from '{}'", knowledge.get_mastery(0), knowledge.get_mastery(1), initial));
+        }
+        const auto &scores = knowledge.get_scores();
+        if (scores.size() != 3 || !(scores[0] < scores[2]) || !(scores[2] < scores[1])) {
+            throw std::runtime_error("The selection scores do not favor the entry answered incorrectly");
+        }
+
+        // Changing the guess probability rescores every entry
+        const float unanswered = scores[2];
+        knowledge.set_parameters({0.2f, 0.15f, 0.1f, 0.5f});
+        if (!(knowledge.get_scores()[2] < unanswered)) {
+            throw std::runtime_error("The selection scores were not recomputed");
+        }
+
+        // A correct answer is stronger evidence with more options, as guessing it is less likely
+        modules::knowledge::Knowledge two(1);
+        modules::knowledge::Knowledge nine(1);
+        two.update(0, true, 1.0f / 2.0f);
+        nine.update(0, true, 1.0f / 9.0f);
+        if (!(nine.get_mastery(0) > two.get_mastery(0))) {
+            throw std::runtime_error(fmt::format("The mastery is '{}' after a correct answer among 9 options, and '{}' among 2", nine.get_mastery(0), two.get_mastery(0)));
+        }
+        fmt::print("modules::knowledge::Knowledge::update() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::knowledge::Knowledge::update() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_knowledge::rebuild()
+{
+    try {
+        modules::history::History history(2);
+        modules::knowledge::Knowledge live(2);
+        for (const bool correct : {false, true, true, false, true}) {
+            history.record(1, correct);
+            live.update(1, correct);
+        }
+
+        // Replaying the history oldest first gives the same estimate as updating live
+        modules::knowledge::Knowledge rebuilt(2);
+        rebuilt.rebuild(history);
+        if (rebuilt.get_mastery(1) != live.get_mastery(1) || rebuilt.get_mastery(0) != live.get_mastery(0)) {
+            throw std::runtime_error(fmt::format("The rebuilt mastery is '{}', expected '{}'", rebuilt.get_mastery(1), live.get_mastery(1)));
+        }
+        if (rebuilt.get_scores() != live.get_scores()) {
+            throw std::runtime_error("The rebuilt selection scores differ from the live ones");
+        }
+
+        // Weighted selection never picks an entry with zero weight, once recently asked entries are no longer excluded
+        modules::vocabulary::Vocabulary vocabulary;
+        vocabulary.set_recent_window(0);
+        std::vector<float> weights;
+        for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+            const modules::vocabulary::Entry entry = vocabulary.get_entry(id);
+            weights.emplace_back(entry.id == 5 ? 1.0f : 0.0f);
+        }
+        vocabulary.set_weights(weights);
+        for (std::size_t idx = 0; idx < 100; ++idx) {
+            if (const auto entry = vocabulary.get_weighted_enabled_entry(); !entry.has_value() || entry->id != 5) {
+                throw std::runtime_error("An entry with zero weight was picked");
+            }
+        }
+
+        // Changing one weight moves the picks without passing every weight again
+        vocabulary.set_weight(5, 0.0f);
+        vocabulary.set_weight(7, 2.0f);
+        for (std::size_t idx = 0; idx < 100; ++idx) {
+            if (const auto entry = vocabulary.get_weighted_enabled_entry(); !entry.has_value() || entry->id != 7) {
+                throw std::runtime_error("An entry with zero weight was picked after a weight changed");
+            }
+        }
+        fmt::print("modules::knowledge::Knowledge::rebuild() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::knowledge::Knowledge::rebuild() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_profiles::find()
+{
+    try {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "aegyo_test_profiles_find";
+        std::filesystem::remove_all(directory);
+
+        // Without an index, there are no profiles
+        modules::profiles::Profiles profiles(directory);
+        if (profiles.get_num_profiles() != 0 || profiles.find("Minji").has_value()) {
+            throw std::runtime_error("Found a profile in an empty directory");
+        }
+
+        // Profiles are added out of order, and each gets its own directory
+        const std::vector<std::string> names = {"Minji", "Jisoo", "Hyun Woo", "Ana", "Jisoo 2"};
+        std::vector<std::filesystem::path> directories;
+        for (const auto &name : names) {
+            directories.emplace_back(profiles.add(name));
+            if (!std::filesystem::is_directory(directories.back())) {
+                throw std::runtime_error(fmt::format("Profile '{}' has no directory at '{}'", name, directories.back().string()));
+            }
+        }
+        if (profiles.add("Jisoo") != directories[1] || profiles.get_num_profiles() != names.size()) {
+            throw std::runtime_error("Adding a profile twice gave a new profile");
+        }
+        if (std::set<std::filesystem::path>(directories.cbegin(), directories.cend()).size() != names.size()) {
+            throw std::runtime_error("Two profiles share a directory");
+        }
+        if (profiles.get_name(0) != "Ana" || profiles.get_name(names.size() - 1) != "Minji") {
+            throw std::runtime_error(fmt::format("The index starts with '{}' and ends with '{}', expected 'Ana' and 'Minji'", profiles.get_name(0), profiles.get_name(names.size() - 1)));
+        }
+
+        // Another object, as in another process, finds them in the index
+        const modules::profiles::Profiles reopened(directory);
+        for (std::size_t idx = 0; idx < names.size(); ++idx) {
+            if (reopened.find(names[idx]) != directories[idx]) {
+                throw std::runtime_error(fmt::format("Profile '{}' was not found in the index", names[idx]));
+            }
+        }
+        if (reopened.find("Jiso").has_value() || reopened.find("Minji ").has_value() || reopened.find("").has_value()) {
+            throw std::runtime_error("Found a profile whose name only shares a prefix");
+        }
+
+        // Objects that add profiles at the same time, as in several processes, keep each other's profiles
+        constexpr std::size_t num_threads = 4;
+        constexpr std::size_t num_added = 25;
+        std::vector<std::thread> threads;
+        for (std::size_t thread = 0; thread < num_threads; ++thread) {
+            threads.emplace_back([&directory, thread]() {
+                modules::profiles::Profiles concurrent(directory);
+                for (std::size_t idx = 0; idx < num_added; ++idx) {
+                    static_cast<void>(concurrent.add(fmt::format("Learner {}-{}", thread, idx)));
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        const modules::profiles::Profiles merged(directory);
+        if (merged.get_num_profiles() != names.size() + num_threads * num_added) {
+            throw std::runtime_error(fmt::format("The index has '{}' profiles after concurrent additions, expected '{}'", merged.get_num_profiles(), names.size() + num_threads * num_added));
+        }
+
+        // Names that cannot be stored are rejected
+        for (const std::string &name : {std::string(), std::string(modules::profiles::Profiles::max_name_size + 1, 'a'), std::string("tab\there")}) {
+            bool threw = false;
+            try {
+                static_cast<void>(profiles.add(name));
+            }
+            catch (const std::runtime_error &) {
+                threw = true;
+            }
+            if (!threw) {
+                throw std::runtime_error(fmt::format("Added a profile named '{}'", name));
+            }
+        }
+        const std::string longest(modules::profiles::Profiles::max_name_size, 'z');
+        if (profiles.find(longest).has_value()) {
+            throw std::runtime_error("Found a profile that was never added");
+        }
+        if (const std::filesystem::path longest_directory = profiles.add(longest); profiles.find(longest) != longest_directory) {
+            throw std::runtime_error("A name of the maximum length was not stored");
+        }
+
+        std::filesystem::remove_all(directory);
+        fmt::print("modules::profiles::Profiles::find() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::profiles::Profiles::find() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_progress::compaction()
+{
+    try {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "aegyo_test_progress_compaction";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        // Record enough answers to trigger compactions, then close
+        constexpr std::uint32_t num_entries = 10;
+        const std::vector<std::size_t> entry_categories(num_entries, 0);
+        std::vector<std::string> entry_keys;
+        for (std::uint32_t idx = 0; idx < num_entries; ++idx) {
+            entry_keys.emplace_back(std::to_string(idx));
+        }
+        {
+            modules::progress::Progress progress(directory, entry_categories, entry_keys, 5);
+            for (std::uint32_t idx = 0; idx < 12; ++idx) {
+                progress.record({idx, idx % num_entries, idx % num_entries, 100, idx % 3 != 0});
+            }
+            progress.set_category_mask(0b0101);
+        }
+
+        // Everything should come back from the snapshot alone
+        modules::progress::Progress progress(directory, entry_categories, entry_keys, 5);
+        const auto total = progress.get_statistics().get_total();
+        if (progress.get_replayed_count() != 0) {
+            throw std::runtime_error(fmt::format("Replayed '{}' journal records after a clean shutdown, expected '0'", progress.get_replayed_count()));
+        }
+        if (total.get_attempts() != 12 || total.correct != 8) {
+            throw std::runtime_error(fmt::format("The totals are '{}/{}', expected '8/12'", total.correct, total.get_attempts()));
+        }
+        if (progress.get_category_mask() != 0b0101) {
+            throw std::runtime_error(fmt::format("The category mask is '{:#b}', expected '0b101'", progress.get_category_mask()));
+        }
+        const auto entry = progress.get_statistics().get_entry(0);
+        if (entry.get_attempts() != 2 || entry.correct != 1 || entry.latency_ms != 200) {
+            throw std::runtime_error(fmt::format("Entry 0 has '{}/{}' correct in '{}' ms, expected '1/2' in '200' ms", entry.correct, entry.get_attempts(), entry.latency_ms));
+        }
+        const auto &history = progress.get_history();
+        if (history.get_outcomes(0) != 0b01 || history.get_length(0) != 2) {
+            throw std::runtime_error(fmt::format("Entry 0 has history '{:#b}' of length '{}', expected '0b1' of length '2'", history.get_outcomes(0), history.get_length(0)));
+        }
+        fmt::print("modules::progress::Progress::compact() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::progress::Progress::compact() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_progress::replay_tail()
+{
+    try {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "aegyo_test_progress_tail";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        const std::vector<std::size_t> entry_categories = {0, 0, 1, 1};
+        const std::vector<std::string> entry_keys = {"ㅏ", "ㅓ", "ㄱ", "ㄴ"};
+        {
+            modules::progress::Progress progress(directory, entry_categories, entry_keys);
+            progress.record({1, 1, 1, 100, true});
+        }
+
+        // Simulate a power loss: answers reach the journal, but no snapshot is written
+        {
+            modules::journal::Journal journal(directory / "journal.bin");
+            journal.append({2, 2, 2, 100, true});
+            journal.append({3, 2, 3, 100, false});
+        }
+
+        {
+            modules::progress::Progress progress(directory, entry_categories, entry_keys);
+            if (progress.get_replayed_count() != 2) {
+                throw std::runtime_error(fmt::format("Replayed '{}' journal records, expected '2'", progress.get_replayed_count()));
+            }
+            const auto &statistics = progress.get_statistics();
+            if (statistics.get_total().get_attempts() != 3 || statistics.get_entry(2).get_attempts() != 2 || statistics.get_category(1).get_attempts() != 2) {
+                throw std::runtime_error(fmt::format("The total is '{}', expected '3'", statistics.get_total().get_attempts()));
+            }
+        }
+
+        // The wrong answer in the tail ends up in the confusion matrix of the new snapshot
+        modules::progress::Progress progress(directory, entry_categories, entry_keys);
+        if (progress.get_replayed_count() != 0 || progress.get_confusion().get_count(2, 3) != 1) {
+            throw std::runtime_error(fmt::format("Entry 2 was mistaken for entry 3 '{}' times, expected '1'", progress.get_confusion().get_count(2, 3)));
+        }
+        fmt::print("modules::progress::Progress replay passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::progress::Progress replay failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_progress::settings()
+{
+    try {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "aegyo_test_progress_settings";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        const std::vector<std::size_t> entry_categories = {0, 1};
+        const std::vector<std::string> entry_keys = {"ㅏ", "ㄱ"};
+        {
+            modules::progress::Progress progress(directory, entry_categories, entry_keys);
+            if (progress.get_settings().has_value()) {
+                throw std::runtime_error("New progress has settings");
+            }
+            progress.set_settings({3, true});
+        }
+
+        // Settings alone are saved, without any answers
+        modules::progress::Progress progress(directory, entry_categories, entry_keys);
+        const auto settings = progress.get_settings();
+        if (!settings.has_value() || settings->selection_policy != 3 || !settings->is_typing) {
+            throw std::runtime_error("The settings were not restored from the snapshot");
+        }
+        fmt::print("modules::progress::Progress::set_settings() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::progress::Progress::set_settings() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_progress::remap()
+{
+    try {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "aegyo_test_progress_remap";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        // Load the progress of a deck the way the app does, keyed by the Korean text of each row
+        const auto load = [&directory](const std::string_view deck) {
+            std::vector<modules::vocabulary::Entry> entries;
+            static_cast<void>(modules::deck::parse(deck, {}, entries));
+            const modules::vocabulary::Vocabulary vocabulary(entries);
+            std::vector<std::size_t> entry_categories;
+            std::vector<std::string> entry_keys;
+            for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+                entry_categories.emplace_back(static_cast<std::size_t>(vocabulary.get_category(id)));
+                entry_keys.emplace_back(vocabulary.get_hangul(id));
+            }
+            return std::make_unique<modules::progress::Progress>(directory, entry_categories, entry_keys);
+        };
+        {
+            const auto progress = load("ㄱ\tg\nㄴ\tn\nㄷ\td\n");
+            progress->record({1, 1, 1, 100, true});
+            progress->record({2, 2, 1, 100, false});
+        }
+
+        // Simulate a power loss after one more answer, which the journal keeps with the IDs of the old deck
+        {
+            modules::journal::Journal journal(directory / "journal.bin");
+            journal.append({3, 2, 2, 100, true});
+        }
+
+        // Insert a row in the middle of the deck and restart
+        for (int restart = 0; restart < 2; ++restart) {
+            const auto progress = load("ㄱ\tg\nㅁ\tm\nㄴ\tn\nㄷ\td\n");
+            const auto &statistics = progress->get_statistics();
+            if (statistics.get_entry(1).get_attempts() != 0 || statistics.get_entry(2).correct != 1 || statistics.get_entry(3).get_attempts() != 2) {
+                throw std::runtime_error(fmt::format("The entries have '{}', '{}' and '{}' answers, expected '0', '1' and '2'", statistics.get_entry(1).get_attempts(), statistics.get_entry(2).get_attempts(), statistics.get_entry(3).get_attempts()));
+            }
+            if (progress->get_confusion().get_count(3, 2) != 1 || progress->get_history().get_outcomes(3) != 0b01) {
+                throw std::runtime_error(fmt::format("The confusion and history of 'ㄷ' did not follow it (mistaken for 'ㄴ' '{}' times, expected '1')", progress->get_confusion().get_count(3, 2)));
+            }
+        }
+
+        // Switch to another deck and back; answers to the missing entries only count towards the total
+        {
+            const auto progress = load("ㄷ\td\n");
+            if (progress->get_statistics().get_entry(0).get_attempts() != 2 || progress->get_statistics().get_total().get_attempts() != 3) {
+                throw std::runtime_error(fmt::format("'ㄷ' has '{}' answers after switching decks, expected '2'", progress->get_statistics().get_entry(0).get_attempts()));
+            }
+        }
+        const auto progress = load("ㄴ\tn\nㄷ\td\n");
+        if (progress->get_statistics().get_entry(0).get_attempts() != 0 || progress->get_statistics().get_entry(1).get_attempts() != 2) {
+            throw std::runtime_error(fmt::format("'ㄴ' and 'ㄷ' have '{}' and '{}' answers after switching back, expected '0' and '2'", progress->get_statistics().get_entry(0).get_attempts(), progress->get_statistics().get_entry(1).get_attempts()));
+        }
+        fmt::print("modules::progress::Progress remap passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::progress::Progress remap failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_progress::grow()
+{
+    try {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "aegyo_test_progress_grow";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        // Add an entry while the progress is open, the way a deck reload does, and answer it
+        {
+            modules::progress::Progress progress(directory, {0, 1}, {"ㅏ", "ㄱ"});
+            progress.record({1, 0, 0, 100, true});
+            progress.record({2, 1, 0, 100, false});
+            progress.add_entries({0, 1, 1}, {"ㅏ", "ㄱ", "ㄴ"});
+            progress.record({3, 2, 1, 200, false});
+            progress.record({4, 2, 2, 300, true});
+            if (progress.get_statistics().get_entry(0).get_attempts() != 1 || progress.get_statistics().get_entry(2).get_attempts() != 2 || progress.get_statistics().get_category(1).get_attempts() != 3) {
+                throw std::runtime_error(fmt::format("The entries have '{}' and '{}' answers after adding one, expected '1' and '2'", progress.get_statistics().get_entry(0).get_attempts(), progress.get_statistics().get_entry(2).get_attempts()));
+            }
+        }
+
+        // Simulate a power loss after one more answer to the new entry, then restart with the grown deck
+        {
+            modules::journal::Journal journal(directory / "journal.bin");
+            journal.append({5, 2, 2, 100, true});
+        }
+        const modules::progress::Progress progress(directory, {0, 1, 1}, {"ㅏ", "ㄱ", "ㄴ"});
+        const modules::statistics::Counters counters = progress.get_statistics().get_entry(2);
+        if (counters.correct != 2 || counters.incorrect != 1 || counters.latency_ms != 600) {
+            throw std::runtime_error(fmt::format("'ㄴ' has '{}' correct and '{}' wrong answers after a restart, expected '2' and '1'", counters.correct, counters.incorrect));
+        }
+        if (progress.get_history().get_outcomes(2) != 0b011 || progress.get_confusion().get_count(2, 1) != 1 || progress.get_confusion().get_count(1, 0) != 1) {
+            throw std::runtime_error(fmt::format("The history and confusions of 'ㄴ' were lost after a restart (mistaken for 'ㄱ' '{}' times, expected '1')", progress.get_confusion().get_count(2, 1)));
+        }
+        if (progress.get_statistics().get_entry(1).get_attempts() != 1 || progress.get_statistics().get_total().get_attempts() != 5) {
+            throw std::runtime_error(fmt::format("There are '{}' answers in total after a restart, expected '5'", progress.get_statistics().get_total().get_attempts()));
+        }
+        fmt::print("modules::progress::Progress grow passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::progress::Progress grow failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_progress::corrupt()
+{
+    try {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "aegyo_test_progress_corrupt";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        const std::vector<std::size_t> entry_categories = {0, 1};
+        const std::vector<std::string> entry_keys = {"ㅏ", "ㄱ"};
+        {
+            modules::progress::Progress progress(directory, entry_categories, entry_keys);
+            progress.record({1, 0, 0, 100, true});
+            progress.set_category_mask(0b10);
+        }
+
+        // Truncate the snapshot, and leave an answer in the journal, as if the disk failed after a power loss
+        std::filesystem::resize_file(directory / "snapshot.bin", 100);
+        {
+            modules::journal::Journal journal(directory / "journal.bin");
+            journal.append({2, 1, 1, 100, true});
+        }
+
+        // The app still starts, from the journal alone, and the snapshot is kept aside
+        {
+            modules::progress::Progress progress(directory, entry_categories, entry_keys);
+            if (!std::filesystem::exists(directory / "snapshot.bin.corrupt")) {
+                throw std::runtime_error("The corrupt snapshot was not moved aside");
+            }
+            if (progress.get_statistics().get_total().get_attempts() != 1 || progress.get_statistics().get_entry(1).get_attempts() != 1) {
+                throw std::runtime_error(fmt::format("The total is '{}' after replaying the journal, expected '1'", progress.get_statistics().get_total().get_attempts()));
+            }
+            if (progress.get_category_mask() != std::numeric_limits<std::uint32_t>::max()) {
+                throw std::runtime_error(fmt::format("The category mask is '{:#b}', expected every category", progress.get_category_mask()));
+            }
+        }
+
+        // A new snapshot replaces the corrupt one
+        modules::progress::Progress progress(directory, entry_categories, entry_keys);
+        if (progress.get_replayed_count() != 0 || progress.get_statistics().get_total().get_attempts() != 1) {
+            throw std::runtime_error("The progress was not compacted into a new snapshot");
+        }
+        fmt::print("modules::progress::Progress corrupt snapshot passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::progress::Progress corrupt snapshot failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_progress::lock()
+{
+    try {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "aegyo_test_progress_lock";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        // A second instance on the same directory only reads, so it never truncates the journal under the first one
+        const std::vector<std::size_t> entry_categories = {0, 1};
+        const std::vector<std::string> entry_keys = {"ㅏ", "ㄱ"};
+        {
+            modules::progress::Progress owner(directory, entry_categories, entry_keys);
+            owner.record({1, 0, 0, 100, true});
+            {
+                modules::progress::Progress reader(directory, entry_categories, entry_keys);
+                if (owner.is_read_only() || !reader.is_read_only()) {
+                    throw std::runtime_error("The second instance was not opened read-only");
+                }
+                reader.record({2, 1, 1, 100, true});
+                reader.compact();
+            }
+            owner.record({3, 1, 0, 100, false});
+        }
+
+        // Only the answers of the first instance were saved, and the lock was released with it
+        modules::progress::Progress progress(directory, entry_categories, entry_keys);
+        if (progress.is_read_only() || progress.get_statistics().get_total().get_attempts() != 2) {
+            throw std::runtime_error(fmt::format("The total is '{}' after both instances closed, expected '2'", progress.get_statistics().get_total().get_attempts()));
+        }
+        fmt::print("modules::progress::Progress lock passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::progress::Progress lock failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_statistics::record()
+{
+    try {
+        modules::statistics::Statistics statistics({0, 0, 1}, 2);
+        statistics.record(0, true, 100);
+        statistics.record(0, false, 300);
+        statistics.record(2, true, 50);
+        statistics.add(7, {4, 0, 0});  // Out of range, only counts towards the total
+
+        const auto entry = statistics.get_entry(0);
+        if (entry.correct != 1 || entry.incorrect != 1 || entry.latency_ms != 400) {
+            throw std::runtime_error(fmt::format("Entry 0 has '{}/{}' correct in '{}' ms, expected '1/2' in '400' ms", entry.correct, entry.get_attempts(), entry.latency_ms));
+        }
+        if (statistics.get_category(1).get_attempts() != 1 || statistics.get_category(5).get_attempts() != 0) {
+            throw std::runtime_error("The category counters are wrong");
+        }
+        const auto total = statistics.get_total();
+        if (total.get_attempts() != 7 || total.correct != 6) {
+            throw std::runtime_error(fmt::format("The totals are '{}/{}', expected '6/7'", total.correct, total.get_attempts()));
+        }
+        const auto entries = statistics.get_entries();
+        if (entries.size() != 3 || entries[1].get_attempts() != 0 || entries[2].latency_ms != 50) {
+            throw std::runtime_error("The merged entries do not match the individual counters");
+        }
+        fmt::print("modules::statistics::Statistics::record() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::statistics::Statistics::record() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_statistics::concurrent()
+{
+    try {
+        constexpr std::size_t num_threads = 8;
+        constexpr std::size_t num_answers = 10000;
+        const std::vector<std::size_t> entry_categories = {0, 1, 2, 3};
+        modules::statistics::Statistics statistics(entry_categories, 4);
+
+        // Record from more threads than there are shards, so some threads share one
+        std::vector<std::thread> threads;
+        for (std::size_t tdx = 0; tdx < num_threads; ++tdx) {
+            threads.emplace_back([&statistics, &entry_categories]() {
+                for (std::size_t idx = 0; idx < num_answers; ++idx) {
+                    statistics.record(idx % entry_categories.size(), idx % 2 == 0, 1);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        const auto total = statistics.get_total();
+        if (total.get_attempts() != num_threads * num_answers || total.correct != num_threads * num_answers / 2 || total.latency_ms != num_threads * num_answers) {
+            throw std::runtime_error(fmt::format("The totals are '{}/{}', expected '{}/{}'", total.correct, total.get_attempts(), num_threads * num_answers / 2, num_threads * num_answers));
+        }
+        for (std::size_t idx = 0; idx < entry_categories.size(); ++idx) {
+            if (statistics.get_entry(idx).get_attempts() != num_threads * num_answers / entry_categories.size()) {
+                throw std::runtime_error(fmt::format("Entry '{}' has '{}' attempts, expected '{}'", idx, statistics.get_entry(idx).get_attempts(), num_threads * num_answers / entry_categories.size()));
+            }
+        }
+        fmt::print("modules::statistics::Statistics concurrency passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::statistics::Statistics concurrency failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_thompson::pick()
+{
+    try {
+        // Entry 2 is answered incorrectly most of the time, so it should be picked most often
+        modules::thompson::Thompson thompson({0, 0, 0, 1, 1}, 2);
+        thompson.add(2, {1, 30, 0});
+        for (const std::size_t id : {0u, 1u, 3u, 4u}) {
+            thompson.add(id, {30, 1, 0});
+        }
+        std::vector<std::size_t> counts(5, 0);
+        for (std::size_t idx = 0; idx < 1000; ++idx) {
+            const auto id = thompson.pick();
+            if (!id.has_value() || *id >= counts.size()) {
+                throw std::runtime_error("No valid entry was picked");
+            }
+            ++counts[*id];
+        }
+        if (counts[2] < 500) {
+            throw std::runtime_error(fmt::format("The weakest entry was picked '{}' times out of '1000'", counts[2]));
+        }
+
+        // Disabled categories are never picked
+        thompson.set_category_enabled(0, false);
+        for (std::size_t idx = 0; idx < 200; ++idx) {
+            if (const auto id = thompson.pick(); !id.has_value() || *id < 3) {
+                throw std::runtime_error("An entry of a disabled category was picked");
+            }
+        }
+        thompson.set_category_enabled(1, false);
+        if (thompson.pick().has_value()) {
+            throw std::runtime_error("An entry was picked with every category disabled");
+        }
+
+        // Entries that are not allowed are never picked while any other entry is, even if they fill the group that is sampled
+        modules::thompson::Thompson grouped(std::vector<std::size_t>(40, 0));
+        for (std::size_t id = 0; id < 16; ++id) {
+            grouped.add(id, {0, 30, 0});
+        }
+        for (std::size_t idx = 0; idx < 1000; ++idx) {
+            if (const auto id = grouped.pick([](const std::size_t candidate) { return candidate >= 16; }); !id.has_value() || *id < 16) {
+                throw std::runtime_error("An entry that is not allowed was picked while others were");
+            }
+        }
+        if (!grouped.pick([](const std::size_t) { return false; }).has_value()) {
+            throw std::runtime_error("No entry was picked with every entry excluded");
+        }
+
+        // Entries that are not eligible (e.g., removed from the deck) are never picked, not even when no entry is allowed
+        const auto is_eligible = [](const std::size_t candidate) { return candidate >= 16; };
+        for (std::size_t idx = 0; idx < 1000; ++idx) {
+            if (const auto id = grouped.pick([](const std::size_t) { return false; }, is_eligible); !id.has_value() || *id < 16) {
+                throw std::runtime_error("An entry that is not eligible was picked");
+            }
+        }
+        if (grouped.pick({}, [](const std::size_t) { return false; }).has_value()) {
+            throw std::runtime_error("An entry was picked with no entry eligible");
+        }
+
+        // A large deck builds a deep tree, and every entry stays reachable
+        std::vector<std::size_t> categories(100000, 0);
+        categories.back() = 1;
+        modules::thompson::Thompson large(categories);
+        large.set_category_enabled(0, false);
+        if (large.pick() != std::optional<std::size_t>{categories.size() - 1}) {
+            throw std::runtime_error("The only enabled entry of a large deck was not picked");
+        }
+        fmt::print("modules::thompson::Thompson::pick() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::thompson::Thompson::pick() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_exam::coverage()
+{
+    try {
+        // 10 entries in category 0, 5 in category 1, 2 in category 2 and 3 in category 3
+        std::vector<std::size_t> categories;
+        for (const auto &[category, count] : std::vector<std::pair<std::size_t, std::size_t>>{{0, 10}, {1, 5}, {2, 2}, {3, 3}}) {
+            categories.insert(categories.end(), count, category);
+        }
+        modules::exam::Exam exam(categories);
+        const auto count_categories = [&categories](const std::vector<std::size_t> &questions) {
+            std::vector<std::size_t> counts(4, 0);
+            std::vector<bool> seen(categories.size(), false);
+            for (const std::size_t id : questions) {
+                if (id >= categories.size() || seen[id]) {
+                    throw std::runtime_error(fmt::format("Entry '{}' is out of range or repeated", id));
+                }
+                seen[id] = true;
+                ++counts[categories[id]];
+            }
+            return counts;
+        };
+
+        // Proportional coverage rounds half shares up for the lower category first: 5, 2.5, 1 and 1.5 questions
+        for (std::uint32_t seed = 0; seed < 20; ++seed) {
+            if (const auto counts = count_categories(exam.generate(10, seed)); counts != std::vector<std::size_t>{5, 3, 1, 1}) {
+                throw std::runtime_error(fmt::format("Proportional coverage gave '{}', '{}', '{}' and '{}' questions, expected '5', '3', '1' and '1'", counts[0], counts[1], counts[2], counts[3]));
+            }
+        }
+
+        // Equal coverage takes every entry of the small categories and splits the rest between the large ones
+        for (std::uint32_t seed = 0; seed < 20; ++seed) {
+            if (const auto counts = count_categories(exam.generate(12, seed, modules::exam::Coverage::Equal)); counts[2] != 2 || counts[3] != 3 || counts[0] + counts[1] != 7 || counts[0] < 3 || counts[1] < 3) {
+                throw std::runtime_error(fmt::format("Equal coverage gave '{}', '{}', '{}' and '{}' questions", counts[0], counts[1], counts[2], counts[3]));
+            }
+        }
+
+        // Disabled categories are left out, and an exam never asks more questions than there are entries
+        exam.set_category_enabled(0, false);
+        if (const auto counts = count_categories(exam.generate(10, 1, modules::exam::Coverage::Equal)); counts[0] != 0 || exam.get_num_enabled() != 10) {
+            throw std::runtime_error("A disabled category was part of an exam");
+        }
+        bool threw = false;
+        try {
+            static_cast<void>(exam.generate(11, 1));
+        }
+        catch (const std::runtime_error &) {
+            threw = true;
+        }
+        if (!threw) {
+            throw std::runtime_error("An exam longer than the enabled entries did not throw");
+        }
+        fmt::print("modules::exam::Exam coverage passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::exam::Exam coverage failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_exam::seed()
+{
+    try {
+        modules::vocabulary::Vocabulary vocabulary;
+        std::vector<std::size_t> categories;
+        for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+            const modules::vocabulary::Entry entry = vocabulary.get_entry(id);
+            categories.emplace_back(static_cast<std::size_t>(entry.category));
+        }
+        modules::exam::Exam exam(categories);
+
+        // The same seed gives the same exam, even after other exams were generated
+        const auto first = exam.generate(20, 42);
+        static_cast<void>(exam.generate(30, 7, modules::exam::Coverage::Equal));
+        if (exam.generate(20, 42) != first || exam.generate(20, 43) == first) {
+            throw std::runtime_error("The exam does not depend on the seed alone");
+        }
+
+        // The exam is the same on every standard library
+        const std::vector<std::size_t> expected = {26, 24, 38, 29, 14};
+        if (std::vector<std::size_t>(first.cbegin(), first.cbegin() + 5) != expected) {
+            throw std::runtime_error(fmt::format("The exam starts with '{}', '{}', '{}', '{}' and '{}'", first[0], first[1], first[2], first[3], first[4]));
+        }
+
+        // Each exam of a class can be generated again on its own
+        const auto exams = exam.generate_class(3, 20, 41);
+        if (exams.size() != 3 || exams[1] != first || exams[0] == exams[2]) {
+            throw std::runtime_error("The exams of a class do not match the exams of their seeds");
+        }
+        fmt::print("modules::exam::Exam seed passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::exam::Exam seed failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_worksheet::write()
+{
+    try {
+        modules::vocabulary::Vocabulary vocabulary;
+        vocabulary.set_category_enabled(modules::vocabulary::Category::BasicConsonant, false);
+        const auto export_to_string = [&vocabulary](const modules::worksheet::Options &options) {
+            std::FILE *file = std::tmpfile();
+            if (file == nullptr) {
+                throw std::runtime_error("Failed to create a temporary file");
+            }
+            const auto summary = modules::worksheet::write(vocabulary, options, file);
+            std::string contents(static_cast<std::size_t>(summary.num_bytes), '\0');
+            std::rewind(file);
+            const std::size_t read = std::fread(contents.data(), 1, contents.size(), file);
+            std::fclose(file);
+            if (summary.num_rows != options.num_rows || read != contents.size()) {
+                throw std::runtime_error(fmt::format("Exported '{}' rows and read '{}' of '{}' bytes", summary.num_rows, read, contents.size()));
+            }
+            return contents;
+        };
+
+        // The output depends on the seed alone, not on the number of threads, across several blocks
+        const std::string single = export_to_string({40000, 3, 9, 1, modules::worksheet::Format::Tsv});
+        if (export_to_string({40000, 3, 9, 4, modules::worksheet::Format::Tsv}) != single) {
+            throw std::runtime_error("The export differs between 1 and 4 threads");
+        }
+        if (single.rfind("id\tprompt\toption_1\toption_2\toption_3\tanswer\n", 0) != 0 || std::count(single.cbegin(), single.cend(), '\n') != 40001) {
+            throw std::runtime_error("The TSV export does not have a header and one line per question");
+        }
+
+        // Every JSONL question has an enabled prompt, and its answer points at the option that matches it
+        const std::string jsonl = export_to_string({100, 4, 9, 2, modules::worksheet::Format::Jsonl});
+        std::size_t begin = 0;
+        for (std::size_t row = 0; row < 100; ++row) {
+            const std::size_t end = jsonl.find('\n', begin);
+            const std::string line = jsonl.substr(begin, end - begin);
+            begin = end + 1;
+            const std::string prompt = line.substr(line.find("\"prompt\":\"") + 10, line.find("\",\"options\"") - line.find("\"prompt\":\"") - 10);
+            const std::size_t answer = std::stoul(line.substr(line.find("\"answer\":") + 9));
+            const auto id = vocabulary.find_id(prompt);
+            const auto entry = id.has_value() ? std::optional<modules::vocabulary::Entry>(vocabulary.get_entry(*id)) : std::nullopt;
+            if (line.rfind(fmt::format("{{\"id\":{},", row), 0) != 0 || !entry.has_value() || entry->category == modules::vocabulary::Category::BasicConsonant || answer < 1 || answer > 4) {
+                throw std::runtime_error(fmt::format("Invalid JSONL row '{}'", line));
+            }
+            std::size_t option_begin = line.find("\"options\":[") + 11;
+            for (std::size_t idx = 1; idx < answer; ++idx) {
+                option_begin = line.find(',', option_begin) + 1;
+            }
+            if (line.compare(option_begin, entry->latin.size() + 2, fmt::format("\"{}\"", entry->latin)) != 0) {
+                throw std::runtime_error(fmt::format("The answer of row '{}' does not point at '{}'", line, entry->latin));
+            }
+        }
+        fmt::print("modules::worksheet::write() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::worksheet::write() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_typing::feedback()
+{
+    try {
+        const modules::vocabulary::Vocabulary vocabulary;
+        modules::typing::Matcher matcher(vocabulary);
+        const auto find_id = [&vocabulary](const std::string &hangul) {
+            for (std::size_t id = 0; id < vocabulary.get_num_entries(); ++id) {
+                const modules::vocabulary::Entry entry = vocabulary.get_entry(id);
+                if (entry.hangul == hangul) {
+                    return entry.id;
+                }
+            }
+            throw std::runtime_error(fmt::format("Entry '{}' not found", hangul));
+        };
+        const auto type = [&matcher](const std::string &text) {
+            for (const char c : text) {
+                static_cast<void>(matcher.push(c));
+            }
+            return matcher.get_feedback();
+        };
+
+        // Typing "yeo" for "ㅕ" goes from on track to complete, case-insensitively
+        matcher.reset(find_id("ㅕ"));
+        if (matcher.get_feedback() != modules::typing::Feedback::Empty || type("Y") != modules::typing::Feedback::OnTrack || type("e") != modules::typing::Feedback::OnTrack || type("o") != modules::typing::Feedback::Complete || !matcher.is_correct() || matcher.get_text() != "yeo") {
+            throw std::runtime_error("Typing 'yeo' for 'ㅕ' gave the wrong feedback");
+        }
+
+        // Erasing goes back to the previous state
+        matcher.pop();
+        if (matcher.get_feedback() != modules::typing::Feedback::OnTrack || matcher.get_text() != "ye" || matcher.get_match() != find_id("ㅖ")) {
+            throw std::runtime_error("Erasing a character did not restore the previous state");
+        }
+
+        // Every alternate of a "latin" form is accepted, and shared romanizations prefer the expected entry
+        matcher.reset(find_id("ㄱ"));
+        if (type("k") != modules::typing::Feedback::Complete || matcher.get_match() != find_id("ㄱ")) {
+            throw std::runtime_error("Typing 'k' for 'ㄱ' was not accepted");
+        }
+        matcher.reset(find_id("ㅋ"));
+        if (type("k") != modules::typing::Feedback::Complete || matcher.get_match() != find_id("ㅋ")) {
+            throw std::runtime_error("Typing 'k' for 'ㅋ' was not accepted");
+        }
+        matcher.reset(find_id("ㅇ"));
+        if (type("-") != modules::typing::Feedback::Complete) {
+            throw std::runtime_error("Typing '-' for 'ㅇ' was not accepted");
+        }
+
+        // Romanizations of other entries are wrong, and text that matches nothing is invalid
+        matcher.reset(find_id("ㅏ"));
+        if (type("y") != modules::typing::Feedback::Wrong || type("a") != modules::typing::Feedback::Wrong || matcher.get_match() != find_id("ㅑ")) {
+            throw std::runtime_error("Typing 'ya' for 'ㅏ' was not wrong");
+        }
+        matcher.reset(find_id("ㅏ"));
+        if (type("ax") != modules::typing::Feedback::Invalid || matcher.get_match().has_value() || matcher.is_correct()) {
+            throw std::runtime_error("Typing 'ax' for 'ㅏ' was not invalid");
+        }
+
+        // Input beyond the maximum length is ignored
+        matcher.reset(find_id("ㅏ"));
+        for (std::size_t idx = 0; idx < modules::typing::Matcher::max_length; ++idx) {
+            static_cast<void>(matcher.push('a'));
+        }
+        if (matcher.push('a') || matcher.get_text().size() != modules::typing::Matcher::max_length) {
+            throw std::runtime_error("Input beyond the maximum length was not ignored");
+        }
+        fmt::print("modules::typing::Matcher feedback passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "modules::typing::Matcher feedback failed: {}\n", e.what());
         return EXIT_FAILURE;
     }
 }